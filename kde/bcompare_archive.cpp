@@ -0,0 +1,600 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QFile>
+#include <QThreadPool>
+#include <QRunnable>
+#include <string.h>
+#include "bcompare_archive.h"
+#include "bcompare_delta.h"
+#include "bcompare_hash.h"
+
+/** Bounds of the listings, beyond them archives are left to Beyond Compare */
+static const int MAX_ARCHIVE_ENTRIES = 500000;
+static const int MAX_ARCHIVE_FILTERS = 256;
+static const qint64 MAX_TAR_EXTENDED_HEADER = 64 * 1024;
+static const quint64 MAX_ZIP_DIRECTORY_SIZE = 128 * 1024 * 1024;
+
+/** Bound of the cache, it is simply emptied when reached */
+static const int MAX_CACHED_ARCHIVES = 256;
+
+/** ZIP records, see APPNOTE.TXT */
+static const quint32 ZIP_LOCAL_SIGNATURE = 0x04034b50;
+static const quint32 ZIP_EOCD_SIGNATURE = 0x06054b50;
+static const quint32 ZIP_CENTRAL_SIGNATURE = 0x02014b50;
+static const quint32 ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+static const quint32 ZIP64_EOCD_SIGNATURE = 0x06064b50;
+static const qint64 ZIP_EOCD_SIZE = 22;
+static const qint64 ZIP_MAX_COMMENT = 0xFFFF;
+static const qint64 ZIP64_LOCATOR_SIZE = 20;
+static const qint64 ZIP64_EOCD_SIZE = 56;
+static const qint64 ZIP_CENTRAL_SIZE = 46;
+
+static const qint64 TAR_BLOCK_SIZE = 512;
+
+static inline quint16 le16(const uchar *p)
+{
+    return static_cast<quint16>(p[0] | (p[1] << 8));
+}
+
+static inline quint32 le32(const uchar *p)
+{
+    return static_cast<quint32>(le16(p)) | (static_cast<quint32>(le16(p + 2)) << 16);
+}
+
+static inline quint64 le64(const uchar *p)
+{
+    return static_cast<quint64>(le32(p)) | (static_cast<quint64>(le32(p + 4)) << 32);
+}
+
+/*************************************************************
+ * ZIP central directory
+ *************************************************************/
+
+bool BCompareArchiveIndex::readZip(const QString &pathArchive, Listing &listing)
+{
+    QFile f(pathArchive);
+    if (!f.open(QIODevice::ReadOnly) || f.size() < ZIP_EOCD_SIZE)
+    {
+        return false;
+    }
+
+    /*
+     * The end of central directory record is in the last 64 KB, before the comment.
+     * The archive is read rather than mapped, a file truncated meanwhile only
+     * makes the listing fail.
+     */
+    qint64 fileSize = f.size();
+    qint64 tailSize = qMin(fileSize, ZIP_EOCD_SIZE + ZIP_MAX_COMMENT);
+    qint64 tailOffset = fileSize - tailSize;
+    QByteArray tailData;
+    const uchar *eocd = nullptr;
+
+    if (!f.seek(tailOffset) || (tailData = f.read(tailSize)).size() != tailSize)
+    {
+        return false;
+    }
+    const uchar *tail = reinterpret_cast<const uchar *>(tailData.constData());
+    for (qint64 i = tailSize - ZIP_EOCD_SIZE; i >= 0; --i)
+    {
+        if (le32(tail + i) == ZIP_EOCD_SIGNATURE)
+        {
+            eocd = tail + i;
+            break;
+        }
+    }
+    if (eocd == nullptr)
+    {
+        return false;
+    }
+
+    quint64 nbEntries = le16(eocd + 10);
+    quint64 cdSize = le32(eocd + 12);
+    quint64 cdOffset = le32(eocd + 16);
+
+    /* ZIP64 archives keep the real values in another record, found with its locator */
+    if (nbEntries == 0xFFFF || cdSize == 0xFFFFFFFF || cdOffset == 0xFFFFFFFF)
+    {
+        qint64 locatorOffset = tailOffset + (eocd - tail) - ZIP64_LOCATOR_SIZE;
+        uchar locator[ZIP64_LOCATOR_SIZE];
+        uchar record[ZIP64_EOCD_SIZE];
+
+        if (locatorOffset < 0 || !f.seek(locatorOffset) ||
+            f.read(reinterpret_cast<char *>(locator), ZIP64_LOCATOR_SIZE) != ZIP64_LOCATOR_SIZE ||
+            le32(locator) != ZIP64_LOCATOR_SIGNATURE ||
+            !f.seek(static_cast<qint64>(le64(locator + 8))) ||
+            f.read(reinterpret_cast<char *>(record), ZIP64_EOCD_SIZE) != ZIP64_EOCD_SIZE ||
+            le32(record) != ZIP64_EOCD_SIGNATURE)
+        {
+            return false;
+        }
+
+        nbEntries = le64(record + 32);
+        cdSize = le64(record + 40);
+        cdOffset = le64(record + 48);
+    }
+
+    if (nbEntries > static_cast<quint64>(MAX_ARCHIVE_ENTRIES) || cdSize > MAX_ZIP_DIRECTORY_SIZE ||
+        cdOffset > static_cast<quint64>(fileSize) ||
+        cdSize > static_cast<quint64>(fileSize) - cdOffset)
+    {
+        return false;
+    }
+    if (cdSize == 0)
+    {
+        return (nbEntries == 0);
+    }
+
+    QByteArray directory;
+    if (!f.seek(static_cast<qint64>(cdOffset)) ||
+        (directory = f.read(static_cast<qint64>(cdSize))).size() != static_cast<int>(cdSize))
+    {
+        return false;
+    }
+    const uchar *p = reinterpret_cast<const uchar *>(directory.constData());
+    const uchar *end = p + cdSize;
+
+    for (quint64 i = 0; i < nbEntries; ++i)
+    {
+        if (end - p < ZIP_CENTRAL_SIZE || le32(p) != ZIP_CENTRAL_SIGNATURE)
+        {
+            return false;
+        }
+
+        int nameLen = le16(p + 28);
+        int extraLen = le16(p + 30);
+        int commentLen = le16(p + 32);
+        if (end - p < ZIP_CENTRAL_SIZE + nameLen + extraLen + commentLen)
+        {
+            return false;
+        }
+
+        Entry entry;
+        entry.hasCrc = true;
+        entry.crc = le32(p + 16);
+        entry.size = le32(p + 24);
+        entry.mtime = (static_cast<qint64>(le16(p + 14)) << 16) | le16(p + 12);
+        entry.mode = le32(p + 38) >> 16;
+
+        /* The 64 bit uncompressed size comes first in the ZIP64 extra field */
+        if (entry.size == 0xFFFFFFFF)
+        {
+            const uchar *extra = p + ZIP_CENTRAL_SIZE + nameLen;
+            const uchar *extraEnd = extra + extraLen;
+
+            while (extraEnd - extra >= 4)
+            {
+                int len = le16(extra + 2);
+                if (le16(extra) == 0x0001 && len >= 8 && extraEnd - extra >= 4 + len)
+                {
+                    entry.size = static_cast<qint64>(le64(extra + 4));
+                    break;
+                }
+                extra += 4 + len;
+            }
+        }
+
+        QByteArray name(reinterpret_cast<const char *>(p + ZIP_CENTRAL_SIZE), nameLen);
+        if (!name.endsWith('/'))
+        {
+            listing.insert(name, entry);
+        }
+
+        p += ZIP_CENTRAL_SIZE + nameLen + extraLen + commentLen;
+    }
+
+    return true;
+}
+
+/*************************************************************
+ * TAR headers
+ *************************************************************/
+
+/** Octal number of a header field, or base-256 when the high bit is set */
+static qint64 tarNumber(const uchar *field, int len)
+{
+    qint64 value = 0;
+
+    if (field[0] & 0x80)
+    {
+        value = field[0] & 0x7F;
+        for (int i = 1; i < len; ++i)
+        {
+            value = (value << 8) | field[i];
+        }
+        return value;
+    }
+
+    for (int i = 0; i < len && field[i] != '\0'; ++i)
+    {
+        if (field[i] >= '0' && field[i] <= '7')
+        {
+            value = (value << 3) | (field[i] - '0');
+        }
+        else if (field[i] != ' ')
+        {
+            return -1;
+        }
+    }
+    return value;
+}
+
+static bool tarChecksumValid(const uchar *header)
+{
+    qint64 sum = 0;
+
+    for (int i = 0; i < TAR_BLOCK_SIZE; ++i)
+    {
+        sum += (i >= 148 && i < 156) ? ' ' : header[i];
+    }
+    return sum == tarNumber(header + 148, 8);
+}
+
+static QByteArray tarString(const uchar *field, int len)
+{
+    const void *nul = memchr(field, '\0', len);
+    return QByteArray(reinterpret_cast<const char *>(field),
+                      (nul != nullptr) ? static_cast<const uchar *>(nul) - field : len);
+}
+
+/** Applies the "path" and "size" records of a PAX extended header */
+static void parsePaxRecords(const QByteArray &data, QByteArray &path, qint64 &size)
+{
+    int pos = 0;
+
+    while (pos < data.size())
+    {
+        int space = data.indexOf(' ', pos);
+        int len = (space > pos) ? data.mid(pos, space - pos).toInt() : 0;
+        if (len <= 0 || pos + len > data.size())
+        {
+            return;
+        }
+
+        QByteArray record = data.mid(space + 1, pos + len - space - 2);
+        if (record.startsWith("path="))
+        {
+            path = record.mid(5);
+        }
+        else if (record.startsWith("size="))
+        {
+            size = record.mid(5).toLongLong();
+        }
+        pos += len;
+    }
+}
+
+bool BCompareArchiveIndex::readTar(const QString &pathArchive, Listing &listing)
+{
+    QFile f(pathArchive);
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    /* Only the headers are read, the content of the entries is seeked over */
+    uchar header[TAR_BLOCK_SIZE];
+    QByteArray nextPath;
+    qint64 nextSize = -1;
+    qint64 pos = 0;
+
+    while (f.seek(pos) &&
+           f.read(reinterpret_cast<char *>(header), TAR_BLOCK_SIZE) == TAR_BLOCK_SIZE)
+    {
+        if (header[0] == '\0')
+        {
+            return pos > 0;
+        }
+        if (!tarChecksumValid(header))
+        {
+            return false;
+        }
+
+        char type = static_cast<char>(header[156]);
+        qint64 size = (nextSize >= 0) ? nextSize : tarNumber(header + 124, 12);
+        if (size < 0)
+        {
+            return false;
+        }
+
+        qint64 dataPos = pos + TAR_BLOCK_SIZE;
+        pos = dataPos + ((size + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE) * TAR_BLOCK_SIZE;
+
+        /* GNU long names and PAX extended headers describe the next entry */
+        if (type == 'L' || type == 'x')
+        {
+            if (size > MAX_TAR_EXTENDED_HEADER || !f.seek(dataPos))
+            {
+                return false;
+            }
+
+            QByteArray data = f.read(size);
+            if (type == 'L')
+            {
+                nextPath = tarString(reinterpret_cast<const uchar *>(data.constData()), data.size());
+            }
+            else
+            {
+                parsePaxRecords(data, nextPath, nextSize);
+            }
+            continue;
+        }
+        if (type == 'g')
+        {
+            continue;
+        }
+
+        QByteArray name = nextPath;
+        if (name.isEmpty())
+        {
+            name = tarString(header, 100);
+            if (memcmp(header + 257, "ustar", 5) == 0 && header[345] != '\0')
+            {
+                name = tarString(header + 345, 155) + '/' + name;
+            }
+        }
+        nextPath.clear();
+        nextSize = -1;
+
+        if (type == '5' || name.endsWith('/'))
+        {
+            continue;
+        }
+        if (listing.size() >= MAX_ARCHIVE_ENTRIES)
+        {
+            return false;
+        }
+
+        Entry entry;
+        entry.hasCrc = false;
+        entry.crc = 0;
+        entry.size = size;
+        entry.mtime = tarNumber(header + 136, 12);
+        entry.mode = static_cast<quint32>(tarNumber(header + 100, 8));
+        listing.insert(name, entry);
+    }
+
+    /* Archives ending without their two zero blocks are still fine */
+    return pos > 0;
+}
+
+bool BCompareArchiveIndex::readListing(const QString &pathArchive, Listing &listing)
+{
+    QFile f(pathArchive);
+    uchar magic[4];
+
+    if (!f.open(QIODevice::ReadOnly) || f.read(reinterpret_cast<char *>(magic), 4) != 4)
+    {
+        return false;
+    }
+    f.close();
+
+    if (le32(magic) == ZIP_LOCAL_SIGNATURE || le32(magic) == ZIP_EOCD_SIGNATURE)
+    {
+        return readZip(pathArchive, listing);
+    }
+
+    /* Compressed TAR files have no readable header, their checksum fails */
+    return readTar(pathArchive, listing);
+}
+
+/*************************************************************
+ * Comparison
+ *************************************************************/
+
+BCompareArchiveIndex& BCompareArchiveIndex::get()
+{
+    static BCompareArchiveIndex m_index;
+    return m_index;
+}
+
+/** Without a CRC, TAR entries of the same size and time are taken as identical */
+static bool sameContent(const BCompareArchiveIndex::Entry &a, const BCompareArchiveIndex::Entry &b)
+{
+    if (a.size != b.size)
+    {
+        return false;
+    }
+    if (a.hasCrc && b.hasCrc)
+    {
+        return a.crc == b.crc;
+    }
+    return a.mtime == b.mtime;
+}
+
+bool BCompareArchiveIndex::pairKey(const QString &pathLeft, const QString &pathRight, QByteArray &key)
+{
+    BCompareHashCache::FileId idLeft;
+    BCompareHashCache::FileId idRight;
+
+    if (!BCompareHashCache::fileId(pathLeft, idLeft) ||
+        !BCompareHashCache::fileId(pathRight, idRight))
+    {
+        return false;
+    }
+
+    key = QByteArray(reinterpret_cast<const char *>(&idLeft), sizeof(idLeft));
+    key.append(reinterpret_cast<const char *>(&idRight), sizeof(idRight));
+    return true;
+}
+
+BCompareArchiveIndex::Result BCompareArchiveIndex::compare(const QString &pathLeft,
+                                                            const QString &pathRight)
+{
+    QByteArray key;
+
+    if (!pairKey(pathLeft, pathRight, key))
+    {
+        return Result();
+    }
+
+    {
+        QMutexLocker lock(&m_mutex);
+        auto it = m_results.constFind(key);
+        if (it != m_results.constEnd())
+        {
+            return it.value();
+        }
+    }
+
+    Listing listingLeft;
+    Listing listingRight;
+    Result result;
+
+    if (readListing(pathLeft, listingLeft) && readListing(pathRight, listingRight))
+    {
+        bool metadataDiffers = false;
+
+        for (auto it = listingLeft.constBegin(); it != listingLeft.constEnd(); ++it)
+        {
+            auto other = listingRight.constFind(it.key());
+            if (other == listingRight.constEnd() || !sameContent(it.value(), other.value()))
+            {
+                result.differing.append(QString::fromUtf8(it.key()));
+            }
+            else if (it.value().mtime != other.value().mtime ||
+                     it.value().mode != other.value().mode)
+            {
+                metadataDiffers = true;
+            }
+        }
+        for (auto it = listingRight.constBegin(); it != listingRight.constEnd(); ++it)
+        {
+            if (!listingLeft.contains(it.key()))
+            {
+                result.differing.append(QString::fromUtf8(it.key()));
+            }
+        }
+
+        result.differing.sort();
+        result.state = !result.differing.isEmpty() ? ARCHIVE_ENTRIES_DIFFER :
+                       (metadataDiffers ? ARCHIVE_METADATA_DIFFERS : ARCHIVE_IDENTICAL);
+    }
+
+    QMutexLocker lock(&m_mutex);
+    if (m_results.size() >= MAX_CACHED_ARCHIVES)
+    {
+        m_results.clear();
+    }
+    m_results.insert(key, result);
+
+    return result;
+}
+
+QStringList BCompareArchiveIndex::narrowingArgs(const QString &pathLeft, const QString &pathRight)
+{
+    QByteArray key;
+    Result result;
+    QStringList filters;
+
+    if (!pairKey(pathLeft, pathRight, key))
+    {
+        return QStringList();
+    }
+
+    {
+        QMutexLocker lock(&m_mutex);
+        result = m_results.value(key);
+    }
+
+    if (result.state != ARCHIVE_ENTRIES_DIFFER || result.differing.size() > MAX_ARCHIVE_FILTERS)
+    {
+        return QStringList();
+    }
+
+    for (const QString &entry : result.differing)
+    {
+        /* The separator of the filters can not be escaped */
+        if (entry.contains(QLatin1Char(';')))
+        {
+            return QStringList();
+        }
+        filters.append(QLatin1String("/") + entry);
+    }
+
+    return BCompareDeltaScope::filterArgs(filters);
+}
+
+/*************************************************************
+ * Background check
+ *************************************************************/
+
+struct BCompareArchiveCheckState
+{
+    /** Protects check, cleared when it is destroyed */
+    QMutex mutex;
+    BCompareArchiveCheck *check = nullptr;
+
+    QString pathLeft;
+    QString pathRight;
+};
+
+class BCompareArchiveTask : public QRunnable
+{
+public:
+    explicit BCompareArchiveTask(const std::shared_ptr<BCompareArchiveCheckState> &state) :
+        m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        BCompareArchiveIndex::Result result =
+            BCompareArchiveIndex::get().compare(m_state->pathLeft, m_state->pathRight);
+        int state = result.state;
+        int nbDiffering = result.differing.size();
+
+        /* The result is queued to the check itself, dropped if it is destroyed meanwhile */
+        QMutexLocker lock(&m_state->mutex);
+        BCompareArchiveCheck *check = m_state->check;
+
+        if (check != nullptr)
+        {
+            QMetaObject::invokeMethod(check, [check, state, nbDiffering]() {
+                Q_EMIT check->finished(state, nbDiffering);
+            }, Qt::QueuedConnection);
+        }
+    }
+
+private:
+    std::shared_ptr<BCompareArchiveCheckState> m_state;
+};
+
+BCompareArchiveCheck::BCompareArchiveCheck(const QString &pathLeft, const QString &pathRight,
+                                           QObject *pParent) :
+    QObject(pParent), m_state(std::make_shared<BCompareArchiveCheckState>())
+{
+    m_state->check = this;
+    m_state->pathLeft = pathLeft;
+    m_state->pathRight = pathRight;
+}
+
+BCompareArchiveCheck::~BCompareArchiveCheck()
+{
+    QMutexLocker lock(&m_state->mutex);
+    m_state->check = nullptr;
+}
+
+void BCompareArchiveCheck::start()
+{
+    QThreadPool::globalInstance()->start(new BCompareArchiveTask(m_state));
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_ARCHIVE_H
+#define BCOMPARE_ARCHIVE_H
+
+#include <QObject>
+#include <QStringList>
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <memory>
+
+struct BCompareArchiveCheckState;
+
+/**
+ * Compares two archives from their listings only: the central directory of
+ * ZIP files (CRC-32 and sizes) and the headers of uncompressed TAR files
+ * (sizes and times). Nothing is extracted, so the answer takes milliseconds
+ * even for archives of several GB.
+ */
+class BCompareArchiveIndex
+{
+public:
+    /** Get a reference to the global archive listing cache */
+    static BCompareArchiveIndex& get();
+
+    typedef enum {
+        ARCHIVE_UNKNOWN = 0,
+        ARCHIVE_IDENTICAL,
+        ARCHIVE_METADATA_DIFFERS,
+        ARCHIVE_ENTRIES_DIFFER
+    } States;
+
+    struct Result
+    {
+        States state = ARCHIVE_UNKNOWN;
+
+        /** Entries only in one archive or with a different content */
+        QStringList differing;
+    };
+
+    /**
+     * Compares the listings of both archives, computed once per pair of
+     * archive identities. ARCHIVE_UNKNOWN is returned for compressed TAR
+     * files and other formats.
+     */
+    Result compare(const QString &pathLeft, const QString &pathRight);
+
+    /**
+     * Arguments narrowing a session of both archives to their differing
+     * entries, empty if they are not known yet or too many. Only the result
+     * found while the menu was shown is used, the session is never delayed.
+     */
+    QStringList narrowingArgs(const QString &pathLeft, const QString &pathRight);
+
+    struct Entry
+    {
+        bool hasCrc;
+        quint32 crc;
+        qint64 size;
+        qint64 mtime;
+        quint32 mode;
+    };
+
+    typedef QHash<QByteArray, Entry> Listing;
+
+private:
+    BCompareArchiveIndex() = default;
+
+    static bool readZip(const QString &pathArchive, Listing &listing);
+    static bool readTar(const QString &pathArchive, Listing &listing);
+    static bool readListing(const QString &pathArchive, Listing &listing);
+
+    /** Key of the results, from the identities of both archives */
+    static bool pairKey(const QString &pathLeft, const QString &pathRight, QByteArray &key);
+
+    /** Mutex protecting the cache */
+    QMutex m_mutex;
+
+    /** Result for each pair of archive identities (raw FileId bytes of both) */
+    QHash<QByteArray, Result> m_results;
+};
+
+/**
+ * Compares two archives in the background with BCompareArchiveIndex, so
+ * that their listings are never read while a menu is built. The result is
+ * dropped when this object is destroyed.
+ */
+class BCompareArchiveCheck : public QObject
+{
+    Q_OBJECT
+public:
+    BCompareArchiveCheck(const QString &pathLeft, const QString &pathRight, QObject *pParent);
+    ~BCompareArchiveCheck() override;
+
+    void start();
+
+Q_SIGNALS:
+    /** One of BCompareArchiveIndex::States, and the number of differing entries */
+    void finished(int state, int nbDiffering);
+
+private:
+    std::shared_ptr<BCompareArchiveCheckState> m_state;
+};
+
+#endif // BCOMPARE_ARCHIVE_H
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Decodes the menu icons into the blob mapped by BCompareSharedIcons.
+ * Usage: bcompare_blob_tool <output path>
+ */
+
+#include <QCoreApplication>
+#include <QImage>
+#include <QFile>
+#include <QVector>
+#include <cstdio>
+#include <cstring>
+#include "bcompare_shared.h"
+
+static const char *const s_iconNames[] = { "Edit32", "Full32", "Half32", "Merge32", "Sync32" };
+
+static quint32 alignOffset(quint32 offset)
+{
+    return (offset + 15) & ~quint32(15);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s <output path>\n", argv[0]);
+        return 1;
+    }
+
+    QVector<BCompareSharedBlob::Icon> entries;
+    QVector<QImage> images;
+
+    for (const char *name : s_iconNames)
+    {
+        for (quint32 ratio = 1; ratio <= 2; ++ratio)
+        {
+            QString path = QStringLiteral(":/bcompare/icon/") + QLatin1String(name) +
+                           QLatin1String(ratio == 1 ? ".png" : "@2x.png");
+            QImage image(path);
+
+            if (image.isNull())
+            {
+                fprintf(stderr, "Can not decode %s\n", qPrintable(path));
+                return 1;
+            }
+
+            BCompareSharedBlob::Icon entry;
+            memset(&entry, 0, sizeof(entry));
+            strncpy(entry.name, name, sizeof(entry.name) - 1);
+            entry.width = quint32(image.width());
+            entry.height = quint32(image.height());
+            entry.devicePixelRatio = ratio;
+
+            entries.append(entry);
+            images.append(image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+        }
+    }
+
+    BCompareSharedBlob::Header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = BCompareSharedBlob::MAGIC;
+    header.version = BCompareSharedBlob::VERSION;
+    header.nbIcons = quint32(entries.size());
+
+    quint32 offset = alignOffset(sizeof(header) + entries.size() * sizeof(BCompareSharedBlob::Icon));
+    for (BCompareSharedBlob::Icon &entry : entries)
+    {
+        entry.offset = offset;
+        offset = alignOffset(offset + entry.width * entry.height * 4);
+    }
+
+    QByteArray blob(int(offset), '\0');
+    memcpy(blob.data(), &header, sizeof(header));
+    memcpy(blob.data() + sizeof(header), entries.constData(), entries.size() * sizeof(BCompareSharedBlob::Icon));
+
+    for (int i = 0; i < entries.size(); ++i)
+    {
+        const QImage &image = images.at(i);
+        char *pixels = blob.data() + entries.at(i).offset;
+
+        for (int y = 0; y < image.height(); ++y)
+        {
+            memcpy(pixels + y * image.width() * 4, image.constScanLine(y), size_t(image.width()) * 4);
+        }
+    }
+
+    QFile f(QString::fromLocal8Bit(argv[1]));
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate) || f.write(blob) != blob.size())
+    {
+        fprintf(stderr, "Can not write %s\n", argv[1]);
+        return 1;
+    }
+
+    return 0;
+}
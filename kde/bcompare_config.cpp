@@ -26,6 +26,7 @@
 #include <QSettings>
 #include <QFile>
 #include "bcompare_config.h"
+#include "bcompare_shared.h"
 
 
 class BCompareIconCache
@@ -33,50 +34,44 @@ class BCompareIconCache
 public:
     const QIcon& iconEdit()
     {
-        if (m_iconEdit.isNull())
-        {
-            m_iconEdit.addFile(QLatin1String(":/bcompare/icon/Edit32.png"));
-        }
-        return m_iconEdit;
+        return loadIcon(m_iconEdit, "Edit32");
     }
 
     const QIcon& iconFull()
     {
-        if (m_iconFull.isNull())
-        {
-            m_iconFull.addFile(QLatin1String(":/bcompare/icon/Full32.png"));
-        }
-        return m_iconFull;
+        return loadIcon(m_iconFull, "Full32");
     }
 
     const QIcon& iconHalf()
     {
-        if (m_iconHalf.isNull())
-        {
-            m_iconHalf.addFile(QLatin1String(":/bcompare/icon/Half32.png"));
-        }
-        return m_iconHalf;
+        return loadIcon(m_iconHalf, "Half32");
     }
 
     const QIcon& iconMerge()
     {
-        if (m_iconMerge.isNull())
-        {
-            m_iconMerge.addFile(QLatin1String(":/bcompare/icon/Merge32.png"));
-        }
-        return m_iconMerge;
+        return loadIcon(m_iconMerge, "Merge32");
     }
 
     const QIcon& iconSync()
     {
-        if (m_iconSync.isNull())
+        return loadIcon(m_iconSync, "Sync32");
+    }
+
+private:
+    /* Prefer the pixels shared by all the processes, decode the resource otherwise */
+    static const QIcon& loadIcon(QIcon &icon, const char *name)
+    {
+        if (icon.isNull())
         {
-            m_iconSync.addFile(QLatin1String(":/bcompare/icon/Sync32.png"));
+            icon = BCompareSharedIcons::get().icon(name);
         }
-        return m_iconSync;
+        if (icon.isNull())
+        {
+            icon.addFile(QStringLiteral(":/bcompare/icon/") + QLatin1String(name) + QLatin1String(".png"));
+        }
+        return icon;
     }
 
-private:
     QIcon m_iconEdit;
     QIcon m_iconFull;
     QIcon m_iconHalf;
@@ -165,8 +160,18 @@ static QDateTime getFileModifiedTime(const QString &p)
     );
 }
 
+/** Backup copies left by editors, patch and the package managers */
+static QStringList defaultBackupSuffixes()
+{
+    return QStringList{ QStringLiteral(".orig"), QStringLiteral(".bak"), QStringLiteral("~"),
+                        QStringLiteral(".rej"), QStringLiteral(".old"), QStringLiteral(".dpkg-old"),
+                        QStringLiteral(".dpkg-dist"), QStringLiteral(".rpmsave"),
+                        QStringLiteral(".rpmnew") };
+}
+
 BCompareConfig::BCompareConfig() :
-    m_menuEnabled(false), m_menuCompare(MENU_NONE), m_menuCompareUsing(MENU_NONE),
+    m_menuEnabled(false), m_listBackupSuffixes(defaultBackupSuffixes()),
+    m_menuCompare(MENU_NONE), m_menuCompareUsing(MENU_NONE),
     m_menuMerge(MENU_NONE), m_menuSync(MENU_NONE), m_menuEdit(MENU_NONE),
     m_icons(new BCompareIconCache())
 {
@@ -215,6 +220,7 @@ void BCompareConfig::findMenuConfigPath()
                 m_menuIniPath = cfgPath;
                 m_leftFileSavePath = cfgDir.absoluteFilePath(QLatin1String("left_file"));
                 m_centerFileSavePath = cfgDir.absoluteFilePath(QLatin1String("center_file"));
+                m_showUnchangedSavePath = cfgDir.absoluteFilePath(QLatin1String("show_unchanged"));
             }
 
             break;
@@ -255,6 +261,9 @@ void BCompareConfig::reloadMenuConfig()
             menuSettings.value(QLatin1String("ArchiveMasks")).toStringList());
 
         m_listViewer = menuSettings.value(QLatin1String("Viewers")).toStringList();
+
+        m_listBackupSuffixes = menuSettings.value(QLatin1String("BackupSuffixes"),
+                                                  defaultBackupSuffixes()).toStringList();
     }
 
     menuSettings.endGroup();
@@ -333,6 +342,23 @@ void BCompareConfig::forgetCenterFile() const
     QFile::remove(m_centerFileSavePath);
 }
 
+bool BCompareConfig::showUnchanged() const
+{
+    return !m_showUnchangedSavePath.isEmpty() && QFileInfo::exists(m_showUnchangedSavePath);
+}
+
+void BCompareConfig::saveShowUnchanged(bool show) const
+{
+    if (show)
+    {
+        savePathToFile(m_showUnchangedSavePath, QString());
+    }
+    else
+    {
+        QFile::remove(m_showUnchangedSavePath);
+    }
+}
+
 const QIcon& BCompareConfig::iconEdit() const
 {
     return m_icons->iconEdit();
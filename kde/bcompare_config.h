@@ -22,6 +22,7 @@
  * SOFTWARE.
  */
 
+#ifndef BCOMPARE_CONFIG_H
 #define BCOMPARE_CONFIG_H
 
 #include <QStringList>
@@ -52,10 +53,20 @@ public:
     void savePathLeftFile(const QString &path) const;
     void forgetLeftFile() const;
 
+    /** The file the left path is saved to, to watch the selection */
+    inline const QString& leftFileSavePath() const
+    {
+        return m_leftFileSavePath;
+    }
+
     QString readPathCenterFile() const;
     void savePathCenterFile(const QString &path) const;
     void forgetCenterFile() const;
 
+    /** Indicates if folder sessions should also scan the unchanged subtrees */
+    bool showUnchanged() const;
+    void saveShowUnchanged(bool show) const;
+
     inline bool menuEnabled() const
     {
         return m_menuEnabled;
@@ -66,6 +77,12 @@ public:
         return m_listViewer;
     }
 
+    /** Suffixes of the backup copies offered for comparison, such as ".orig" or "~" */
+    inline const QStringList& listBackupSuffixes() const
+    {
+        return m_listBackupSuffixes;
+    }
+
     inline MenuTypes menuCompare() const
     {
         return m_menuCompare;
@@ -116,6 +133,9 @@ private:
     /** The storage path to save the center file path */
     QString m_centerFileSavePath;
 
+    /** The storage path of the "Show Unchanged Too" flag, present if set */
+    QString m_showUnchangedSavePath;
+
     /** Indicates if beyond compare is integrated in the file manager context menus */
     bool m_menuEnabled;
 
@@ -125,6 +145,9 @@ private:
     /** The beyond compare viewer types */
     QStringList m_listViewer;
 
+    /** The suffixes of backup copies, from BackupSuffixes in menu.ini */
+    QStringList m_listBackupSuffixes;
+
     /** Indicates the location of the "Compare" menu */
     MenuTypes m_menuCompare;
 
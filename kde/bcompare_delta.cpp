@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QPointer>
+#include <QThread>
+#include <QMutex>
+#include <QFile>
+#include <QSet>
+#include <algorithm>
+#include <atomic>
+#include "bcompare_delta.h"
+#include "bcompare_ignore.h"
+#include "bcompare_walk.h"
+
+/** Bounds of the walk, past them the unchanged subtrees are not skipped */
+static const qint64 MAX_DELTA_WALK_MS = 15 * 1000;
+static const int MAX_DELTA_FILTERS = 256;
+
+/** Ignored paths kept for each side, the folders first */
+static const int MAX_IGNORE_FILTERS = 256;
+
+struct BCompareDeltaState
+{
+    std::atomic<bool> cancelled{false};
+
+    QPointer<BCompareDeltaScope> scope;
+    QByteArray pathLeft;
+    QByteArray pathRight;
+    bool skipUnchanged;
+    QElapsedTimer timer;
+
+    /** Ignored relative paths starting with a slash, folders ending with one */
+    QSet<QByteArray> ignored;
+
+    /** Mutex protecting the members below */
+    QMutex mutex;
+    QList<QByteArray> unchanged;
+    bool changed = false;
+
+    bool isAborted()
+    {
+        if (timer.elapsed() > MAX_DELTA_WALK_MS)
+        {
+            cancelled.store(true);
+        }
+        return cancelled.load();
+    }
+
+    bool isIgnored(const QByteArray &entryPath, const struct stat &st) const
+    {
+        return ignored.contains(S_ISDIR(st.st_mode) ? entryPath + '/' : entryPath);
+    }
+};
+
+static bool sameEntry(const struct stat &stLeft, const struct stat &stRight)
+{
+    return (stLeft.st_mode & S_IFMT) == (stRight.st_mode & S_IFMT) &&
+           (S_ISDIR(stLeft.st_mode) ||
+            (stLeft.st_size == stRight.st_size &&
+             stLeft.st_mtim.tv_sec == stRight.st_mtim.tv_sec &&
+             stLeft.st_mtim.tv_nsec == stRight.st_mtim.tv_nsec));
+}
+
+/**
+ * Returns true if the subtree relPath changed, ignored paths aside. In that
+ * case its unchanged subfolders, at any depth, are added to unchanged. With
+ * a pool, the subfolders are walked by it.
+ */
+static bool walkDelta(BCompareDeltaState &state, const QByteArray &relPath,
+                      QList<QByteArray> &unchanged, QThreadPool *pool);
+
+/* Walks one top level folder present on both sides */
+class BCompareDeltaTask : public QRunnable
+{
+public:
+    BCompareDeltaTask(BCompareDeltaState &state, const QByteArray &relPath) :
+        m_state(state), m_relPath(relPath)
+    {
+    }
+
+    void run() override
+    {
+        QList<QByteArray> unchanged;
+        bool changed = walkDelta(m_state, m_relPath, unchanged, nullptr);
+
+        QMutexLocker lock(&m_state.mutex);
+        if (changed)
+        {
+            m_state.changed = true;
+            m_state.unchanged.append(unchanged);
+        }
+        else
+        {
+            m_state.unchanged.append(m_relPath);
+        }
+    }
+
+private:
+    BCompareDeltaState &m_state;
+    QByteArray m_relPath;
+};
+
+static bool walkDelta(BCompareDeltaState &state, const QByteArray &relPath,
+                      QList<QByteArray> &unchanged, QThreadPool *pool)
+{
+    QMap<QByteArray, struct stat> entriesLeft, entriesRight;
+
+    if (state.isAborted() ||
+        !BCompareFolderWalk::listEntries(BCompareFolderWalk::joinPath(state.pathLeft, relPath),
+                                         entriesLeft) ||
+        !BCompareFolderWalk::listEntries(BCompareFolderWalk::joinPath(state.pathRight, relPath),
+                                         entriesRight))
+    {
+        return true;
+    }
+
+    bool changed = false;
+    QList<QByteArray> unchangedBelow;
+
+    for (auto it = entriesRight.constBegin(); it != entriesRight.constEnd() && !changed; ++it)
+    {
+        changed = !entriesLeft.contains(it.key()) &&
+                  !state.isIgnored(relPath + '/' + it.key(), it.value());
+    }
+
+    for (auto it = entriesLeft.constBegin(); it != entriesLeft.constEnd(); ++it)
+    {
+        QByteArray entryPath = relPath + '/' + it.key();
+        if (state.isIgnored(entryPath, it.value()))
+        {
+            continue;
+        }
+
+        auto other = entriesRight.constFind(it.key());
+        if (other == entriesRight.constEnd() || !sameEntry(it.value(), other.value()))
+        {
+            changed = true;
+        }
+        else if (S_ISDIR(it.value().st_mode))
+        {
+            if (pool != nullptr)
+            {
+                pool->start(new BCompareDeltaTask(state, entryPath));
+            }
+            else if (walkDelta(state, entryPath, unchangedBelow, nullptr))
+            {
+                changed = true;
+            }
+            else
+            {
+                unchangedBelow.append(entryPath);
+            }
+        }
+    }
+
+    if (changed)
+    {
+        unchanged.append(unchangedBelow);
+    }
+    return changed;
+}
+
+class BCompareDeltaWalkTask : public QRunnable
+{
+public:
+    explicit BCompareDeltaWalkTask(const std::shared_ptr<BCompareDeltaState> &state) :
+        m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        BCompareDeltaState &state = *m_state;
+        BCompareIgnoreRules &rules = BCompareIgnoreRules::get();
+
+        state.timer.start();
+        for (const QByteArray &path : rules.ignoredPaths(state.pathLeft, MAX_IGNORE_FILTERS) +
+                                      rules.ignoredPaths(state.pathRight, MAX_IGNORE_FILTERS))
+        {
+            state.ignored.insert('/' + path);
+        }
+
+        QList<QByteArray> skipped = state.ignored.values();
+
+        if (state.skipUnchanged)
+        {
+            /* A private pool, the global one runs this task */
+            QThreadPool pool;
+            pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), 8));
+
+            QList<QByteArray> unchanged;
+            bool changed = walkDelta(state, QByteArray(), unchanged, &pool);
+            pool.waitForDone();
+
+            if (!state.isAborted() && (changed || state.changed) &&
+                state.unchanged.size() <= MAX_DELTA_FILTERS)
+            {
+                for (const QByteArray &path : state.unchanged)
+                {
+                    skipped.append(path + '/');
+                }
+            }
+        }
+
+        std::sort(skipped.begin(), skipped.end());
+
+        QStringList filters;
+        for (const QByteArray &path : skipped)
+        {
+            filters.append(QLatin1String("-") + QFile::decodeName(path));
+        }
+
+        QPointer<BCompareDeltaScope> scope = state.scope;
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [scope, filters]() {
+            if (!scope.isNull())
+            {
+                Q_EMIT scope->finished(filters);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    std::shared_ptr<BCompareDeltaState> m_state;
+};
+
+/*************************************************************
+ * Delta scope
+ *************************************************************/
+
+BCompareDeltaScope::BCompareDeltaScope(const QString &pathLeft, const QString &pathRight,
+                                       bool skipUnchanged, QObject *pParent) :
+    QObject(pParent), m_state(std::make_shared<BCompareDeltaState>())
+{
+    m_state->scope = this;
+    m_state->pathLeft = QFile::encodeName(pathLeft);
+    m_state->pathRight = QFile::encodeName(pathRight);
+    m_state->skipUnchanged = skipUnchanged;
+}
+
+BCompareDeltaScope::~BCompareDeltaScope()
+{
+    cancel();
+}
+
+void BCompareDeltaScope::start()
+{
+    QThreadPool::globalInstance()->start(new BCompareDeltaWalkTask(m_state));
+}
+
+void BCompareDeltaScope::cancel()
+{
+    m_state->cancelled.store(true);
+}
+
+QStringList BCompareDeltaScope::filterArgs(const QStringList &filters)
+{
+    if (filters.isEmpty())
+    {
+        return QStringList();
+    }
+
+    /* Relative exclusions, the skipped folders are not even scanned */
+    return QStringList{ QLatin1String("-filters=") + filters.join(QLatin1Char(';')) };
+}
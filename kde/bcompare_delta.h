@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_DELTA_H
+#define BCOMPARE_DELTA_H
+
+#include <QObject>
+#include <QStringList>
+#include <memory>
+
+struct BCompareDeltaState;
+
+/**
+ * Finds what a Beyond Compare session of two folders can skip: the paths
+ * ignored by their .gitignore and .bcignore files and, if asked, the subtrees
+ * which did not change, comparing only the sizes and modification times.
+ * The top level folders are walked in parallel. The walk is cancelled when
+ * this object is destroyed.
+ */
+class BCompareDeltaScope : public QObject
+{
+    Q_OBJECT
+public:
+    BCompareDeltaScope(const QString &pathLeft, const QString &pathRight,
+                       bool skipUnchanged, QObject *pParent);
+    ~BCompareDeltaScope() override;
+
+    void start();
+    void cancel();
+
+    /** Beyond Compare arguments applying the filters of finished() */
+    static QStringList filterArgs(const QStringList &filters);
+
+Q_SIGNALS:
+    /**
+     * Exclusion filters of the skipped paths. The unchanged subtrees are not
+     * skipped if nothing changed, if there are too many of them, or if the
+     * walk took too long.
+     */
+    void finished(const QStringList &filters);
+
+private:
+    std::shared_ptr<BCompareDeltaState> m_state;
+};
+
+#endif // BCOMPARE_DELTA_H
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QPointer>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QHash>
+#include <QPair>
+#include <QFile>
+#include <string.h>
+#include <vector>
+
+#ifdef USE_XXHASH
+#include <xxhash.h>
+#endif
+
+#include "bcompare_diffstat.h"
+#include "bcompare_hash.h"
+
+/** Bounds of the work done for one pair, beyond them the menu is left as is */
+static const qint64 MAX_DIFFSTAT_FILE_SIZE = 4 * 1024 * 1024;
+static const int MAX_DIFFSTAT_LINES = 50000;
+static const int MAX_DIFFSTAT_EDITS = 2000;
+static const qint64 MAX_DIFFSTAT_MS = 500;
+
+/** Bound of the cache, it is simply emptied when reached */
+static const int MAX_CACHED_DIFFSTATS = 1000;
+
+/** Files holding a NUL byte in their beginning are not text */
+static const qint64 DIFFSTAT_SNIFF_SIZE = 64 * 1024;
+
+struct BCompareDiffStatState
+{
+    std::atomic<bool> cancelled{false};
+
+    QPointer<BCompareDiffStat> diffStat;
+    QString pathLeft;
+    QString pathRight;
+};
+
+/** Counts for each pair of file identities (raw FileId bytes of both files) */
+static QMutex s_cacheMutex;
+static QHash<QByteArray, QPair<int, int> > s_cache;
+
+/*************************************************************
+ * Line diff
+ *************************************************************/
+
+struct TextLine
+{
+    const char *data;
+    int len;
+    quint64 hash;
+};
+
+static inline quint64 lineHash(const char *data, int len)
+{
+#ifdef USE_XXHASH
+    return XXH3_64bits(data, static_cast<size_t>(len));
+#else
+    return static_cast<quint64>(qHashBits(data, static_cast<size_t>(len)));
+#endif
+}
+
+static inline bool sameLine(const TextLine &a, const TextLine &b)
+{
+    return a.hash == b.hash && a.len == b.len && memcmp(a.data, b.data, a.len) == 0;
+}
+
+/** Splits data in lines, returns false if there are too many of them */
+static bool splitLines(const char *data, qint64 size, std::vector<TextLine> &lines)
+{
+    const char *p = data;
+    const char *end = data + size;
+
+    while (p < end)
+    {
+        if (lines.size() >= static_cast<size_t>(MAX_DIFFSTAT_LINES))
+        {
+            return false;
+        }
+
+        /* memchr() is vectorized by the C library */
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+        int len = static_cast<int>(((eol != nullptr) ? eol : end) - p);
+
+        lines.push_back(TextLine{ p, len, lineHash(p, len) });
+        p += len + 1;
+    }
+    return true;
+}
+
+/**
+ * Length of the shortest edit script between a and b with Myers' O(ND)
+ * algorithm, only the furthest reaching paths are kept.
+ * Returns -1 if it is longer than MAX_DIFFSTAT_EDITS or if the time is up.
+ */
+static int editDistance(const TextLine *a, int n, const TextLine *b, int m,
+                        const QElapsedTimer &timer, const std::atomic<bool> *cancelled)
+{
+    const int offset = MAX_DIFFSTAT_EDITS + 1;
+    std::vector<int> v(2 * MAX_DIFFSTAT_EDITS + 3, 0);
+
+    for (int d = 0; d <= MAX_DIFFSTAT_EDITS; ++d)
+    {
+        if ((cancelled != nullptr && cancelled->load()) || timer.elapsed() > MAX_DIFFSTAT_MS)
+        {
+            return -1;
+        }
+
+        for (int k = -d; k <= d; k += 2)
+        {
+            int x = (k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1])) ?
+                    v[offset + k + 1] : v[offset + k - 1] + 1;
+            int y = x - k;
+
+            while (x < n && y < m && sameLine(a[x], b[y]))
+            {
+                ++x;
+                ++y;
+            }
+
+            v[offset + k] = x;
+            if (x >= n && y >= m)
+            {
+                return d;
+            }
+        }
+    }
+
+    return -1;
+}
+
+bool BCompareDiffStat::countLines(const char *left, qint64 leftSize,
+                                  const char *right, qint64 rightSize,
+                                  int &added, int &removed, const std::atomic<bool> *cancelled)
+{
+    QElapsedTimer timer;
+    std::vector<TextLine> linesLeft;
+    std::vector<TextLine> linesRight;
+
+    timer.start();
+    if (!splitLines(left, leftSize, linesLeft) || !splitLines(right, rightSize, linesRight))
+    {
+        return false;
+    }
+
+    /* The common beginning and end are not part of the search */
+    int n = static_cast<int>(linesLeft.size());
+    int m = static_cast<int>(linesRight.size());
+    int first = 0;
+
+    while (first < n && first < m && sameLine(linesLeft[first], linesRight[first]))
+    {
+        ++first;
+    }
+    while (n > first && m > first && sameLine(linesLeft[n - 1], linesRight[m - 1]))
+    {
+        --n;
+        --m;
+    }
+
+    int d = editDistance(linesLeft.data() + first, n - first,
+                         linesRight.data() + first, m - first, timer, cancelled);
+    if (d < 0)
+    {
+        return false;
+    }
+
+    /* Every edit adds or removes one line, and they account for the length change */
+    added = (d + (m - n)) / 2;
+    removed = (d - (m - n)) / 2;
+    return true;
+}
+
+/*************************************************************
+ * Background count
+ *************************************************************/
+
+class BCompareDiffStatTask : public QRunnable
+{
+public:
+    explicit BCompareDiffStatTask(const std::shared_ptr<BCompareDiffStatState> &state) :
+        m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        int added = 0;
+        int removed = 0;
+
+        if (!count(added, removed) || m_state->cancelled.load())
+        {
+            return;
+        }
+
+        QPointer<BCompareDiffStat> diffStat = m_state->diffStat;
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [diffStat, added, removed]() {
+            if (!diffStat.isNull())
+            {
+                Q_EMIT diffStat->finished(added, removed);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    bool count(int &added, int &removed)
+    {
+        BCompareHashCache::FileId idLeft;
+        BCompareHashCache::FileId idRight;
+
+        if (!BCompareHashCache::fileId(m_state->pathLeft, idLeft) ||
+            !BCompareHashCache::fileId(m_state->pathRight, idRight) ||
+            idLeft.size > MAX_DIFFSTAT_FILE_SIZE || idRight.size > MAX_DIFFSTAT_FILE_SIZE)
+        {
+            return false;
+        }
+
+        QByteArray key(reinterpret_cast<const char *>(&idLeft), sizeof(idLeft));
+        key.append(reinterpret_cast<const char *>(&idRight), sizeof(idRight));
+
+        {
+            QMutexLocker lock(&s_cacheMutex);
+            auto it = s_cache.constFind(key);
+            if (it != s_cache.constEnd())
+            {
+                added = it.value().first;
+                removed = it.value().second;
+                return true;
+            }
+        }
+
+        QFile fileLeft(m_state->pathLeft);
+        QFile fileRight(m_state->pathRight);
+        if (!fileLeft.open(QIODevice::ReadOnly) || !fileRight.open(QIODevice::ReadOnly))
+        {
+            return false;
+        }
+
+        QByteArray left = fileLeft.read(MAX_DIFFSTAT_FILE_SIZE);
+        QByteArray right = fileRight.read(MAX_DIFFSTAT_FILE_SIZE);
+
+        if (memchr(left.constData(), '\0', qMin<qint64>(left.size(), DIFFSTAT_SNIFF_SIZE)) != nullptr ||
+            memchr(right.constData(), '\0', qMin<qint64>(right.size(), DIFFSTAT_SNIFF_SIZE)) != nullptr)
+        {
+            return false;
+        }
+
+        if (!BCompareDiffStat::countLines(left.constData(), left.size(),
+                                          right.constData(), right.size(),
+                                          added, removed, &m_state->cancelled))
+        {
+            return false;
+        }
+
+        QMutexLocker lock(&s_cacheMutex);
+        if (s_cache.size() >= MAX_CACHED_DIFFSTATS)
+        {
+            s_cache.clear();
+        }
+        s_cache.insert(key, qMakePair(added, removed));
+        return true;
+    }
+
+    std::shared_ptr<BCompareDiffStatState> m_state;
+};
+
+/*************************************************************
+ * Diff stat
+ *************************************************************/
+
+BCompareDiffStat::BCompareDiffStat(const QString &pathLeft, const QString &pathRight,
+                                   QObject *pParent) :
+    QObject(pParent), m_state(std::make_shared<BCompareDiffStatState>())
+{
+    m_state->diffStat = this;
+    m_state->pathLeft = pathLeft;
+    m_state->pathRight = pathRight;
+}
+
+BCompareDiffStat::~BCompareDiffStat()
+{
+    cancel();
+}
+
+void BCompareDiffStat::start()
+{
+    QThreadPool::globalInstance()->start(new BCompareDiffStatTask(m_state));
+}
+
+void BCompareDiffStat::cancel()
+{
+    m_state->cancelled.store(true);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_DIFFSTAT_H
+#define BCOMPARE_DIFFSTAT_H
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <memory>
+
+struct BCompareDiffStatState;
+
+/**
+ * Counts the lines added and removed between two small text files, so the
+ * compare menu can show the size of the change. The result is cached for
+ * each pair of file identities, and the count is cancelled when this object
+ * is destroyed.
+ */
+class BCompareDiffStat : public QObject
+{
+    Q_OBJECT
+public:
+    BCompareDiffStat(const QString &pathLeft, const QString &pathRight, QObject *pParent);
+    ~BCompareDiffStat() override;
+
+    void start();
+    void cancel();
+
+    /**
+     * Counts the lines of right missing from left (added) and the lines of
+     * left missing from right (removed). Returns false if the buffers are
+     * beyond the work bounds or if cancelled is set.
+     */
+    static bool countLines(const char *left, qint64 leftSize,
+                           const char *right, qint64 rightSize,
+                           int &added, int &removed, const std::atomic<bool> *cancelled);
+
+Q_SIGNALS:
+    /** Only emitted when the count completed */
+    void finished(int added, int removed);
+
+private:
+    std::shared_ptr<BCompareDiffStatState> m_state;
+};
+
+#endif // BCOMPARE_DIFFSTAT_H
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QHash>
+#include <QMap>
+#include <algorithm>
+#include <atomic>
+#include "bcompare_dupes.h"
+#include "bcompare_hash.h"
+
+/** Bounds of the work done for one selection */
+static const int MAX_DUP_FILES = 10000;
+static const qint64 MAX_DUP_HASH_BYTES = 8LL * 1024 * 1024 * 1024;
+static const int MAX_DUP_PAIRS = 25;
+
+struct BCompareDupState
+{
+    std::atomic<bool> cancelled{false};
+    std::atomic<int> pending{0};
+
+    /** Protects finder, cleared when it is destroyed */
+    QMutex finderMutex;
+    BCompareDupFinder *finder = nullptr;
+
+    QStringList listFiles;
+
+    /** Mutex protecting the members below */
+    QMutex mutex;
+    QMap<qint64, QStringList> buckets;
+    QHash<QString, QByteArray> hashes;
+    bool complete = true;
+};
+
+static void finishSearch(const std::shared_ptr<BCompareDupState> &state)
+{
+    BCompareDupFinder::Result result;
+
+    {
+        QMutexLocker lock(&state->mutex);
+        result.complete = state->complete;
+
+        for (auto it = state->buckets.constBegin(); it != state->buckets.constEnd(); ++it)
+        {
+            /* Files of the bucket grouped by content, in selection order */
+            QList<QByteArray> order;
+            QHash<QByteArray, QStringList> byHash;
+
+            for (const QString &path : it.value())
+            {
+                QByteArray h = (it.key() == 0) ? QByteArray("empty") : state->hashes.value(path);
+                if (h.isEmpty())
+                {
+                    continue;
+                }
+                if (!byHash.contains(h))
+                {
+                    order.append(h);
+                }
+                byHash[h].append(path);
+            }
+
+            for (const QByteArray &h : order)
+            {
+                if (byHash[h].size() > 1)
+                {
+                    result.identicalGroups.append(byHash[h]);
+                }
+            }
+
+            for (int i = 0; i < order.size(); ++i)
+            {
+                for (int j = i + 1; j < order.size() && result.differingPairs.size() < MAX_DUP_PAIRS; ++j)
+                {
+                    result.differingPairs.append(qMakePair(byHash[order[i]].first(),
+                                                           byHash[order[j]].first()));
+                }
+            }
+        }
+    }
+
+    /* The result is queued to the finder itself, dropped if it is destroyed meanwhile */
+    QMutexLocker lock(&state->finderMutex);
+    BCompareDupFinder *finder = state->finder;
+
+    if (finder != nullptr)
+    {
+        QMetaObject::invokeMethod(finder, [finder, result]() {
+            Q_EMIT finder->finished(result);
+        }, Qt::QueuedConnection);
+    }
+}
+
+class BCompareDupHashTask : public QRunnable
+{
+public:
+    BCompareDupHashTask(const std::shared_ptr<BCompareDupState> &state, const QString &pathFile) :
+        m_state(state), m_pathFile(pathFile)
+    {
+    }
+
+    void run() override
+    {
+        if (!m_state->cancelled.load())
+        {
+            QByteArray h = BCompareHashCache::get().fileHash(m_pathFile, &m_state->cancelled);
+
+            QMutexLocker lock(&m_state->mutex);
+            m_state->hashes.insert(m_pathFile, h);
+        }
+
+        if (m_state->pending.fetch_sub(1) == 1 && !m_state->cancelled.load())
+        {
+            finishSearch(m_state);
+        }
+    }
+
+private:
+    std::shared_ptr<BCompareDupState> m_state;
+    QString m_pathFile;
+};
+
+/* Looks at the sizes, then dispatches the hashing of the candidates */
+class BCompareDupSizeTask : public QRunnable
+{
+public:
+    explicit BCompareDupSizeTask(const std::shared_ptr<BCompareDupState> &state) :
+        m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        QMap<qint64, QStringList> bySize;
+        bool complete = (m_state->listFiles.size() <= MAX_DUP_FILES);
+
+        for (const QString &path : m_state->listFiles.mid(0, MAX_DUP_FILES))
+        {
+            if (m_state->cancelled.load())
+            {
+                return;
+            }
+
+            BCompareHashCache::FileId id;
+            if (BCompareHashCache::fileId(path, id))
+            {
+                bySize[id.size].append(path);
+            }
+        }
+
+        /* Smallest buckets first, so the byte budget covers as many files as possible */
+        QMap<qint64, QStringList> buckets;
+        QStringList toHash;
+        qint64 budget = MAX_DUP_HASH_BYTES;
+
+        for (auto it = bySize.constBegin(); it != bySize.constEnd(); ++it)
+        {
+            if (it.value().size() < 2)
+            {
+                continue;
+            }
+
+            qint64 cost = it.key() * it.value().size();
+            if (cost > budget)
+            {
+                complete = false;
+                continue;
+            }
+
+            budget -= cost;
+            buckets.insert(it.key(), it.value());
+            if (it.key() > 0)
+            {
+                toHash.append(it.value());
+            }
+        }
+
+        {
+            QMutexLocker lock(&m_state->mutex);
+            m_state->buckets = buckets;
+            m_state->complete = complete;
+        }
+
+        if (toHash.isEmpty())
+        {
+            finishSearch(m_state);
+            return;
+        }
+
+        m_state->pending.store(toHash.size());
+        for (const QString &path : toHash)
+        {
+            QThreadPool::globalInstance()->start(new BCompareDupHashTask(m_state, path));
+        }
+    }
+
+private:
+    std::shared_ptr<BCompareDupState> m_state;
+};
+
+/*************************************************************
+ * Finder
+ *************************************************************/
+
+BCompareDupFinder::BCompareDupFinder(const QStringList &listFiles, QObject *pParent) :
+    QObject(pParent), m_state(std::make_shared<BCompareDupState>())
+{
+    m_state->finder = this;
+    m_state->listFiles = listFiles;
+}
+
+BCompareDupFinder::~BCompareDupFinder()
+{
+    cancel();
+
+    QMutexLocker lock(&m_state->finderMutex);
+    m_state->finder = nullptr;
+}
+
+void BCompareDupFinder::start()
+{
+    if (m_started)
+    {
+        return;
+    }
+
+    m_started = true;
+    QThreadPool::globalInstance()->start(new BCompareDupSizeTask(m_state));
+}
+
+void BCompareDupFinder::cancel()
+{
+    m_state->cancelled.store(true);
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_DUPES_H
+#define BCOMPARE_DUPES_H
+
+#include <QObject>
+#include <QStringList>
+#include <QList>
+#include <QPair>
+#include <memory>
+
+struct BCompareDupState;
+
+/**
+ * Groups files having the same content: files are bucketed by size, then only
+ * the buckets holding several files are hashed, in parallel on the global
+ * thread pool. The search is cancelled when this object is destroyed.
+ */
+class BCompareDupFinder : public QObject
+{
+    Q_OBJECT
+public:
+    struct Result
+    {
+        /** Files with the same content, one list per content */
+        QList<QStringList> identicalGroups;
+
+        /** Files of the same size but with a different content */
+        QList<QPair<QString, QString> > differingPairs;
+
+        /** False if some files were skipped because of the work bounds */
+        bool complete;
+    };
+
+    BCompareDupFinder(const QStringList &listFiles, QObject *pParent);
+    ~BCompareDupFinder() override;
+
+    /** Starts the search, once */
+    void start();
+    void cancel();
+
+Q_SIGNALS:
+    void finished(const BCompareDupFinder::Result &result);
+
+private:
+    std::shared_ptr<BCompareDupState> m_state;
+    bool m_started = false;
+};
+
+#endif // BCOMPARE_DUPES_H
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QPointer>
+#include <QFile>
+#include <string.h>
+#include "bcompare_equiv.h"
+
+/** Files larger than this are left to Beyond Compare */
+static const qint64 MAX_EQUIV_FILE_SIZE = 256LL * 1024 * 1024;
+
+/** Bytes compared between two looks at the cancellation flag */
+static const qint64 EQUIV_SPAN_SIZE = 1024 * 1024;
+
+/** Size of the blocks given to memcmp() while skipping identical bytes */
+static const qint64 EQUIV_STRIDE = 64;
+
+/** Files holding a NUL byte in their beginning are not text */
+static const qint64 EQUIV_SNIFF_SIZE = 64 * 1024;
+
+struct BCompareEquivState
+{
+    std::atomic<bool> cancelled{false};
+
+    QPointer<BCompareEquivChecker> checker;
+    QString pathLeft;
+    QString pathRight;
+};
+
+/*************************************************************
+ * Streaming comparison
+ *************************************************************/
+
+typedef enum {
+    SEP_NONE = 0,
+    SEP_SPACE,
+    SEP_EOL
+} Separator;
+
+struct TextCursor
+{
+    const char *p;
+    const char *end;
+
+    /** First byte at or after p which is not whitespace, null until looked up */
+    const char *text;
+};
+
+static inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/** Length of the identical beginning of a and b */
+static qint64 commonPrefix(const char *a, const char *b, qint64 len)
+{
+    qint64 n = 0;
+
+    /* memcmp() is vectorized by the C library, this is the hot loop */
+    while (n + EQUIV_STRIDE <= len && memcmp(a + n, b + n, EQUIV_STRIDE) == 0)
+    {
+        n += EQUIV_STRIDE;
+    }
+    while (n < len && a[n] == b[n])
+    {
+        ++n;
+    }
+    return n;
+}
+
+/** True if only whitespace and line ends are left, each byte is looked at once */
+static bool atBlankTail(TextCursor &c)
+{
+    if (c.text == nullptr || c.text < c.p)
+    {
+        c.text = c.p;
+        while (c.text < c.end && isSpace(*c.text))
+        {
+            ++c.text;
+        }
+    }
+    return c.text == c.end;
+}
+
+/** Consumes a run of blanks and the line end following it */
+static Separator skipSeparator(TextCursor &c)
+{
+    const char *start = c.p;
+
+    while (c.p < c.end && isBlank(*c.p))
+    {
+        ++c.p;
+    }
+
+    if (c.p < c.end && (*c.p == '\r' || *c.p == '\n'))
+    {
+        if (*c.p == '\r' && c.p + 1 < c.end && c.p[1] == '\n')
+        {
+            ++c.p;
+        }
+        ++c.p;
+        return SEP_EOL;
+    }
+
+    return (c.p != start) ? SEP_SPACE : SEP_NONE;
+}
+
+BCompareEquivChecker::Equivalence BCompareEquivChecker::compareText(
+    const char *left, qint64 leftSize, const char *right, qint64 rightSize,
+    const std::atomic<bool> *cancelled)
+{
+    TextCursor l{ left, left + leftSize, nullptr };
+    TextCursor r{ right, right + rightSize, nullptr };
+    bool sameBytes = true;
+
+    /* Bytes skipped since the last separator, identical on both sides */
+    qint64 run = 0;
+
+    for (;;)
+    {
+        if (cancelled != nullptr && cancelled->load())
+        {
+            return EQUIV_UNKNOWN;
+        }
+
+        qint64 avail = qMin(l.end - l.p, r.end - r.p);
+        qint64 span = qMin(avail, EQUIV_SPAN_SIZE);
+        qint64 n = commonPrefix(l.p, r.p, span);
+
+        l.p += n;
+        r.p += n;
+        run += n;
+        if (n == span && span < avail)
+        {
+            continue;
+        }
+
+        if (l.p == l.end && r.p == r.end)
+        {
+            return sameBytes ? EQUIV_SAME_BYTES : EQUIV_SAME_TEXT;
+        }
+        sameBytes = false;
+
+        /* The whitespace run holding the difference starts the same way on both sides */
+        while (run > 0 && isBlank(l.p[-1]))
+        {
+            --l.p;
+            --r.p;
+            --run;
+        }
+
+        if (atBlankTail(l) && atBlankTail(r))
+        {
+            return EQUIV_SAME_TEXT;
+        }
+
+        Separator sepLeft = skipSeparator(l);
+        Separator sepRight = skipSeparator(r);
+        if (sepLeft != sepRight || sepLeft == SEP_NONE)
+        {
+            return EQUIV_DIFFERENT;
+        }
+        run = 0;
+    }
+}
+
+/*************************************************************
+ * Background check
+ *************************************************************/
+
+class BCompareEquivTask : public QRunnable
+{
+public:
+    explicit BCompareEquivTask(const std::shared_ptr<BCompareEquivState> &state) :
+        m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        int equivalence = check();
+
+        if (m_state->cancelled.load())
+        {
+            return;
+        }
+
+        QPointer<BCompareEquivChecker> checker = m_state->checker;
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [checker, equivalence]() {
+            if (!checker.isNull())
+            {
+                Q_EMIT checker->finished(equivalence);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    BCompareEquivChecker::Equivalence check()
+    {
+        QFile fileLeft(m_state->pathLeft);
+        QFile fileRight(m_state->pathRight);
+
+        if (!fileLeft.open(QIODevice::ReadOnly) || !fileRight.open(QIODevice::ReadOnly) ||
+            fileLeft.size() > MAX_EQUIV_FILE_SIZE || fileRight.size() > MAX_EQUIV_FILE_SIZE)
+        {
+            return BCompareEquivChecker::EQUIV_UNKNOWN;
+        }
+
+        /* Both files are mapped, nothing is copied or normalized in memory */
+        qint64 sizeLeft = fileLeft.size();
+        qint64 sizeRight = fileRight.size();
+        const char *left = (sizeLeft > 0) ? (const char *)fileLeft.map(0, sizeLeft) : "";
+        const char *right = (sizeRight > 0) ? (const char *)fileRight.map(0, sizeRight) : "";
+
+        if (left == nullptr || right == nullptr)
+        {
+            return BCompareEquivChecker::EQUIV_UNKNOWN;
+        }
+
+        BCompareEquivChecker::Equivalence equivalence =
+            BCompareEquivChecker::compareText(left, sizeLeft, right, sizeRight,
+                                              &m_state->cancelled);
+
+        if (equivalence == BCompareEquivChecker::EQUIV_SAME_TEXT &&
+            (memchr(left, '\0', qMin(sizeLeft, EQUIV_SNIFF_SIZE)) != nullptr ||
+             memchr(right, '\0', qMin(sizeRight, EQUIV_SNIFF_SIZE)) != nullptr))
+        {
+            equivalence = BCompareEquivChecker::EQUIV_DIFFERENT;
+        }
+
+        return equivalence;
+    }
+
+    std::shared_ptr<BCompareEquivState> m_state;
+};
+
+/*************************************************************
+ * Checker
+ *************************************************************/
+
+BCompareEquivChecker::BCompareEquivChecker(const QString &pathLeft, const QString &pathRight,
+                                           QObject *pParent) :
+    QObject(pParent), m_state(std::make_shared<BCompareEquivState>())
+{
+    m_state->checker = this;
+    m_state->pathLeft = pathLeft;
+    m_state->pathRight = pathRight;
+}
+
+BCompareEquivChecker::~BCompareEquivChecker()
+{
+    cancel();
+}
+
+void BCompareEquivChecker::start()
+{
+    QThreadPool::globalInstance()->start(new BCompareEquivTask(m_state));
+}
+
+void BCompareEquivChecker::cancel()
+{
+    m_state->cancelled.store(true);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_EQUIV_H
+#define BCOMPARE_EQUIV_H
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <memory>
+
+struct BCompareEquivState;
+
+/**
+ * Checks whether two text files only differ by their line endings and
+ * whitespace, so the compare menu can tell the user a launch is not needed.
+ * The check is cancelled when this object is destroyed.
+ */
+class BCompareEquivChecker : public QObject
+{
+    Q_OBJECT
+public:
+    typedef enum {
+        EQUIV_UNKNOWN = 0,
+        EQUIV_DIFFERENT,
+        EQUIV_SAME_BYTES,
+        EQUIV_SAME_TEXT
+    } Equivalence;
+
+    BCompareEquivChecker(const QString &pathLeft, const QString &pathRight, QObject *pParent);
+    ~BCompareEquivChecker() override;
+
+    void start();
+    void cancel();
+
+    /**
+     * Compares two buffers ignoring CR/LF differences, trailing whitespace,
+     * the length and kind of whitespace runs, and blank lines at the end.
+     * Returns EQUIV_UNKNOWN if cancelled is set during the comparison.
+     */
+    static Equivalence compareText(const char *left, qint64 leftSize,
+                                   const char *right, qint64 rightSize,
+                                   const std::atomic<bool> *cancelled);
+
+Q_SIGNALS:
+    void finished(int equivalence);
+
+private:
+    std::shared_ptr<BCompareEquivState> m_state;
+};
+
+#endif // BCOMPARE_EQUIV_H
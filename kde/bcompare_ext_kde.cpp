@@ -34,17 +34,69 @@
 #include <QAction>
 #include <QMenu>
 #include <QFileInfo>
+#include <QMessageBox>
+#include <QFileDialog>
+#include <QDir>
+#include <QPushButton>
+#include <QLocale>
 #include <QStringList>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QClipboard>
+#include <QMimeData>
+#include <QProcess>
+#include <QTimer>
 #include "bcompare_ext_kde.h"
+#include "bcompare_sniff.h"
+#include "bcompare_equiv.h"
+#include "bcompare_diffstat.h"
+#include "bcompare_image.h"
+#include "bcompare_git.h"
+#include "bcompare_dupes.h"
+#include "bcompare_snapshot.h"
+#include "bcompare_siblings.h"
+#include "bcompare_memfile.h"
+#include "bcompare_verify.h"
+#include "bcompare_index.h"
+#include "bcompare_delta.h"
+#include "bcompare_priority.h"
+#include "bcompare_report.h"
+#include "bcompare_archive.h"
+#include "bcompare_probe.h"
+#include "bcompare_shared.h"
+#include "bcompare_prefetch.h"
 
 
 /*************************************************************
  * Utilities
  *************************************************************/
 
-bool BCompareKde::isPathConsideredFolder(const QString &path) const
+bool BCompareKde::isItemConsideredFolder(const KFileItem &item) const
 {
-    return (!path.isEmpty() && (QFileInfo(path).isDir() || m_config.isFileArchive(path)));
+    /* The file manager already knows the type of the selected items */
+    return item.isDir() || m_config.isFileArchive(item.url().path());
+}
+
+bool BCompareKde::isSavedPathUsable(const QString &path, bool firstIsDir) const
+{
+    if (path.isEmpty())
+    {
+        return false;
+    }
+
+    /* A path on a hung mount is ignored rather than waited for */
+    BCompareProbe::Type type = BCompareProbe::pathType(path);
+    if (type == BCompareProbe::PROBE_UNKNOWN)
+    {
+        return false;
+    }
+    return firstIsDir == (type == BCompareProbe::PROBE_FOLDER || m_config.isFileArchive(path));
+}
+
+bool BCompareKde::isArchivePair() const
+{
+    return m_config.isFileArchive(m_pathLeftFile) && m_config.isFileArchive(m_pathRightFile) &&
+           !QFileInfo(m_pathLeftFile).isDir() && !QFileInfo(m_pathRightFile).isDir();
 }
 
 void BCompareKde::clearSelections()
@@ -61,17 +113,254 @@ static void addItemToListIfNonNull(QList<QAction*> &items, QAction *item)
     }
 }
 
-static void launchBcompare(const QStringList &args)
+/**
+ * memFds are the in-memory files published for this launch only, closed once
+ * Beyond Compare exits or if it cannot be started
+ */
+static void launchBcompare(const QStringList &args, bool lowPriority = false,
+                           const QList<int> &memFds = QList<int>())
 {
+    QString program = QLatin1String("bcompare");
+    QStringList programArgs = args;
+
+    if (lowPriority)
+    {
+        programArgs = BCompareLowPriority::wrapCommand(program, args);
+        program = programArgs.takeFirst();
+    }
+
+    /*
+     * Beyond Compare opens the in-memory files through this process, so they stay
+     * open until it exits, and their descriptors are not reused meanwhile
+     */
+    if (!memFds.isEmpty())
+    {
+        QProcess *process = new QProcess();
+
+        process->setStandardOutputFile(QProcess::nullDevice());
+        process->setStandardErrorFile(QProcess::nullDevice());
+        QObject::connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                         [process, memFds]() {
+            BCompareMemFile::release(memFds);
+            process->deleteLater();
+        });
+        QObject::connect(process, &QProcess::errorOccurred,
+                         [process, memFds](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart)
+            {
+                BCompareMemFile::release(memFds);
+                process->deleteLater();
+            }
+        });
+
+        process->start(program, programArgs);
+        return;
+    }
+
 #ifdef USE_KDEINIT_EXE
-    KToolInvocation::kdeinitExec(QLatin1String("bcompare"), args);
+    KToolInvocation::kdeinitExec(program, programArgs);
 #else
-    auto *job = new KIO::CommandLauncherJob(QLatin1String("bcompare"), args);
+    auto *job = new KIO::CommandLauncherJob(program, programArgs);
     job->setDesktopName(QLatin1String("bcompare"));
     job->start();
 #endif
 }
 
+/**
+ * Adds the state of the folders known from their last index to menuStr,
+ * the indexes are refreshed when a session of the folders is launched
+ */
+static QString withIndexedState(const QString &menuStr, const QString &pathLeft,
+                                const QString &pathRight)
+{
+    BCompareMerkleIndex &index = BCompareMerkleIndex::get();
+    QString str = menuStr;
+    int nbDiffering;
+
+    if (index.compareIndexed(pathLeft, pathRight, nbDiffering))
+    {
+        str = (nbDiffering == 0) ?
+              i18nc("@bc menu of identical folders", "%1 (identical)", menuStr) :
+              i18ncp("@bc menu of differing folders", "%2 (%1 subtree differs)",
+                     "%2 (%1 subtrees differ)", nbDiffering, menuStr);
+    }
+
+    return str;
+}
+
+/**
+ * Compares the listings of the archives in the background, without
+ * extracting anything, and tells their state in the label of act while the
+ * menu is open
+ */
+static void withArchiveState(QAction *act, const QString &menuStr, const QString &pathLeft,
+                             const QString &pathRight)
+{
+    /* The check stops when the menu and its actions are destroyed */
+    BCompareArchiveCheck *check = new BCompareArchiveCheck(pathLeft, pathRight, act);
+
+    QObject::connect(check, &BCompareArchiveCheck::finished, act,
+                     [act, menuStr](int state, int nbDiffering) {
+        switch (state)
+        {
+            case BCompareArchiveIndex::ARCHIVE_IDENTICAL:
+                act->setText(i18nc("@bc menu of identical archives", "%1 (identical contents)", menuStr));
+                break;
+            case BCompareArchiveIndex::ARCHIVE_METADATA_DIFFERS:
+                act->setText(i18nc("@bc menu of archives with the same contents",
+                                   "%1 (only metadata differs)", menuStr));
+                break;
+            case BCompareArchiveIndex::ARCHIVE_ENTRIES_DIFFER:
+                act->setText(i18ncp("@bc menu of differing archives", "%2 (%1 entry differs)",
+                                    "%2 (%1 entries differ)", nbDiffering, menuStr));
+                break;
+            default:
+                break;
+        }
+    });
+
+    check->start();
+}
+
+/**
+ * Checks in the background whether the files only differ by whitespace or
+ * line endings, otherwise counts their changed lines, and tells it in the
+ * label of act while the menu is open
+ */
+static void withEquivalentState(QAction *act, const QString &menuStr, const QString &pathLeft,
+                                const QString &pathRight)
+{
+    /* The checks stop when the menu and its actions are destroyed */
+    BCompareEquivChecker *checker = new BCompareEquivChecker(pathLeft, pathRight, act);
+
+    QObject::connect(checker, &BCompareEquivChecker::finished, act,
+                     [act, menuStr, pathLeft, pathRight](int equivalence) {
+        if (equivalence == BCompareEquivChecker::EQUIV_SAME_BYTES)
+        {
+            act->setText(i18nc("@bc menu of identical files", "%1 (identical)", menuStr));
+        }
+        else if (equivalence == BCompareEquivChecker::EQUIV_SAME_TEXT)
+        {
+            act->setText(i18nc("@bc menu of equivalent files",
+                               "%1 (Identical except whitespace/EOL)", menuStr));
+        }
+        else if (equivalence == BCompareEquivChecker::EQUIV_DIFFERENT)
+        {
+            BCompareDiffStat *diffStat = new BCompareDiffStat(pathLeft, pathRight, act);
+
+            QObject::connect(diffStat, &BCompareDiffStat::finished, act,
+                             [act, menuStr](int added, int removed) {
+                act->setText(i18nc("@bc menu of differing files, added and removed lines",
+                                   "%1 (+%2 -%3)", menuStr, added, removed));
+            });
+
+            diffStat->start();
+        }
+    });
+
+    checker->start();
+}
+
+/**
+ * Disables act until libgit2 confirmed in the background that it applies to
+ * pathFile, and hides it otherwise
+ */
+static void withGitState(QAction *act, BCompareGitCheck::Checks kind, const QString &pathFile)
+{
+    /* The check stops when the menu and its actions are destroyed */
+    BCompareGitCheck *check = new BCompareGitCheck(kind, pathFile, act);
+
+    act->setEnabled(false);
+    QObject::connect(check, &BCompareGitCheck::finished, act, [act](bool found) {
+        act->setEnabled(found);
+        act->setVisible(found);
+    });
+
+    check->start();
+}
+
+static bool hasViewer(const QStringList &listViewer, const QString &name)
+{
+    for (const QString &viewer : listViewer)
+    {
+        if (viewer.trimmed().compare(name, Qt::CaseInsensitive) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Compares the pictures in the background from their perceptual hashes,
+ * and tells the result in the label of act while the menu is open
+ */
+static void withImageState(QAction *act, const QString &menuStr, const QString &pathLeft,
+                           const QString &pathRight)
+{
+    /* The check stops when the menu and its actions are destroyed */
+    BCompareImageCheck *check = new BCompareImageCheck(pathLeft, pathRight, act);
+
+    QObject::connect(check, &BCompareImageCheck::finished, act, [act, menuStr](int similarity) {
+        if (similarity == BCompareImageCheck::IMAGE_PIXEL_IDENTICAL)
+        {
+            act->setText(i18nc("@bc menu of identical pictures", "%1 (pixel-identical)", menuStr));
+        }
+        else if (similarity == BCompareImageCheck::IMAGE_VISUALLY_IDENTICAL)
+        {
+            act->setText(i18nc("@bc menu of similar pictures", "%1 (visually identical)", menuStr));
+        }
+        else
+        {
+            act->setText(i18nc("@bc menu of differing pictures", "%1 (differs)", menuStr));
+        }
+    });
+
+    check->start();
+}
+
+/**
+ * Launches a session of the selected folders without their ignored paths,
+ * limited to their changed subtrees unless the user asked to see the
+ * unchanged ones too
+ */
+void BCompareKde::launchFolderSession(const QStringList &args, bool lowPriority)
+{
+    /* Archives are considered folders but can not be walked */
+    if (!QFileInfo(m_pathLeftFile).isDir() || !QFileInfo(m_pathRightFile).isDir())
+    {
+        if (isArchivePair())
+        {
+            launchBcompare(BCompareArchiveIndex::get().narrowingArgs(m_pathLeftFile, m_pathRightFile)
+                           + args, lowPriority);
+        }
+        else
+        {
+            launchBcompare(args, lowPriority);
+        }
+        return;
+    }
+
+    /* For the state shown by the next menus of these folders */
+    BCompareMerkleIndex::get().refreshAsync(m_pathLeftFile);
+    BCompareMerkleIndex::get().refreshAsync(m_pathRightFile);
+
+    /*
+     * The scope is not a child of the plugin, which may be destroyed with the
+     * menu, the session is launched whatever becomes of it
+     */
+    BCompareDeltaScope *scope = new BCompareDeltaScope(m_pathLeftFile, m_pathRightFile,
+                                                       !m_config.showUnchanged(), nullptr);
+
+    connect(scope, &BCompareDeltaScope::finished, scope,
+            [scope, args, lowPriority](const QStringList &filters) {
+        scope->deleteLater();
+        launchBcompare(BCompareDeltaScope::filterArgs(filters) + args, lowPriority);
+    });
+
+    scope->start();
+}
+
 /*************************************************************
  * Action callbacks
  *************************************************************/
@@ -79,6 +368,9 @@ static void launchBcompare(const QStringList &args)
 void BCompareKde::cbSelectLeft()
 {
     m_config.savePathLeftFile(m_pathRightFile);
+
+    /* A comparison is likely to follow */
+    BCompareWarmStart::warmAsync();
 }
 
 void BCompareKde::cbSelectCenter()
@@ -92,6 +384,34 @@ void BCompareKde::cbEditFile()
     clearSelections();
 }
 
+void BCompareKde::cbCompareClipboard()
+{
+    const QMimeData *mimeData = QGuiApplication::clipboard()->mimeData();
+
+    if (mimeData == nullptr || !mimeData->hasText())
+    {
+        return;
+    }
+
+    /* The UTF-8 bytes offered are written as they are, without a round trip through QString */
+    QByteArray text = mimeData->data(QStringLiteral("text/plain;charset=utf-8"));
+    if (text.isEmpty())
+    {
+        text = mimeData->text().toUtf8();
+    }
+
+    QString title = i18nc("@bc title of the clipboard content", "Clipboard");
+    QList<int> memFds;
+    QString path = BCompareMemFile::fromData(title, text.constData(), text.size(), memFds);
+
+    if (!path.isEmpty())
+    {
+        launchBcompare(QStringList{ QLatin1String("-ro1"),
+                                    QLatin1String("-title1=") + title,
+                                    path, m_pathRightFile }, false, memFds);
+    }
+}
+
 void BCompareKde::cbCompare()
 {
     QAction* srcAction = qobject_cast<QAction*>(sender());
@@ -106,14 +426,20 @@ void BCompareKde::cbCompare()
             args.prepend(QString(QLatin1String("-fv=%1")).arg(viewer));
         }
 
-        launchBcompare(args);
+        launchFolderSession(args);
         clearSelections();
     }
 }
 
 void BCompareKde::cbSync()
 {
-    launchBcompare(QStringList{ m_pathLeftFile, m_pathRightFile });
+    launchFolderSession(QStringList{ m_pathLeftFile, m_pathRightFile });
+    clearSelections();
+}
+
+void BCompareKde::cbSyncBackground()
+{
+    launchFolderSession(QStringList{ m_pathLeftFile, m_pathRightFile }, true);
     clearSelections();
 }
 
@@ -128,6 +454,151 @@ void BCompareKde::cbMerge()
     clearSelections();
 }
 
+void BCompareKde::cbCompareHead()
+{
+    QList<int> memFds;
+    QString headPath = BCompareGit::get().headVersion(m_pathRightFile, memFds);
+
+    if (!headPath.isEmpty())
+    {
+        QString title = i18nc("@bc title of the HEAD version", "%1 (HEAD)",
+                              QFileInfo(m_pathRightFile).fileName());
+
+        launchBcompare(QStringList{ QLatin1String("-ro1"),
+                                    QLatin1String("-title1=") + title,
+                                    headPath, m_pathRightFile }, false, memFds);
+    }
+}
+
+void BCompareKde::cbCompareSnapshot()
+{
+    QAction* srcAction = qobject_cast<QAction*>(sender());
+
+    if (srcAction != nullptr)
+    {
+        QStringList version = srcAction->data().toStringList();
+        QString title = i18nc("@bc title of the snapshot version", "%1 (%2)",
+                              QFileInfo(m_pathRightFile).fileName(), version.value(1));
+
+        launchBcompare(QStringList{ QLatin1String("-ro1"),
+                                    QLatin1String("-title1=") + title,
+                                    version.value(0), m_pathRightFile });
+    }
+}
+
+void BCompareKde::cbResolveConflict()
+{
+    QString base, ours, theirs;
+    QList<int> memFds;
+
+    if (BCompareGit::get().conflictVersions(m_pathRightFile, base, ours, theirs, memFds))
+    {
+        QStringList args{ QLatin1String("-fv=Text Merge"),
+                          QLatin1String("-title1=") + i18nc("@bc merge title", "Ours"),
+                          QLatin1String("-title2=") + i18nc("@bc merge title", "Theirs"),
+                          ours, theirs };
+        if (!base.isEmpty())
+        {
+            args.append(QLatin1String("-title3=") + i18nc("@bc merge title", "Base"));
+            args.append(base);
+        }
+        args.append(QLatin1String("-mergeoutput=") + m_pathRightFile);
+
+        launchBcompare(args, false, memFds);
+    }
+    else
+    {
+        /* Nothing is launched, the stages read so far are released */
+        BCompareMemFile::release(memFds);
+    }
+}
+
+void BCompareKde::cbComparePair()
+{
+    QAction* srcAction = qobject_cast<QAction*>(sender());
+
+    if (srcAction != nullptr)
+    {
+        launchBcompare(srcAction->data().toStringList());
+    }
+}
+
+static QString verifyReport(const BCompareFolderVerifier::Result &result)
+{
+    QString path = result.diffPath;
+
+    switch (result.diffKind)
+    {
+        case BCompareFolderVerifier::DIFF_NONE:
+            return i18np("The folders are identical: %1 file compared, %2 read at %3 GB/s.",
+                         "The folders are identical: %1 files compared, %2 read at %3 GB/s.",
+                         result.nbFiles, QLocale().formattedDataSize(2 * result.nbBytes),
+                         QLocale().toString(result.throughput, 'f', 2));
+        case BCompareFolderVerifier::DIFF_MISSING:
+            return i18n("The folders differ: \"%1\" exists on one side only.", path);
+        case BCompareFolderVerifier::DIFF_TYPE:
+            return i18n("The folders differ: \"%1\" is not of the same type on both sides.", path);
+        case BCompareFolderVerifier::DIFF_SIZE:
+            return i18n("The folders differ: \"%1\" does not have the same size on both sides.", path);
+        case BCompareFolderVerifier::DIFF_CONTENT:
+            return i18n("The folders differ: \"%1\" does not have the same content on both sides.", path);
+        default:
+            return i18n("The folders could not be verified: \"%1\" could not be read.", path);
+    }
+}
+
+void BCompareKde::cbQuickVerify()
+{
+    /* The result is shown by the verifier itself, the plugin may be destroyed with the menu */
+    BCompareFolderVerifier *verifier = new BCompareFolderVerifier(m_pathLeftFile, m_pathRightFile, nullptr);
+    QStringList args{ m_pathLeftFile, m_pathRightFile };
+    QPointer<QWidget> parentWidget = m_parentWidget;
+
+    connect(verifier, &BCompareFolderVerifier::finished, verifier,
+            [verifier, args, parentWidget](const BCompareFolderVerifier::Result &result) {
+        verifier->deleteLater();
+
+        bool identical = (result.diffKind == BCompareFolderVerifier::DIFF_NONE);
+        QMessageBox *box = new QMessageBox(identical ? QMessageBox::Information : QMessageBox::Warning,
+                                           i18n("Quick Verify"), verifyReport(result),
+                                           QMessageBox::Close, parentWidget.data());
+        box->setAttribute(Qt::WA_DeleteOnClose);
+
+        /* Differences are shown by a full folder comparison */
+        if (!identical)
+        {
+            QPushButton *compare = box->addButton(i18nc("@bc compare action", "Compare"),
+                                                  QMessageBox::AcceptRole);
+            connect(compare, &QPushButton::clicked, compare, [args]() {
+                launchBcompare(args);
+            });
+        }
+        box->show();
+    });
+
+    verifier->start();
+    clearSelections();
+}
+
+void BCompareKde::cbDiffReport()
+{
+    QString pathReport = QFileDialog::getSaveFileName(
+        m_parentWidget.data(), i18n("Save Diff Report"),
+        QDir::home().absoluteFilePath(QLatin1String("bcompare-report.html")),
+        i18n("HTML files (*.html *.htm);;Text files (*.txt)"));
+
+    if (!pathReport.isEmpty())
+    {
+        BCompareReportQueue::get().enqueue(m_pathLeftFile, m_pathRightFile, pathReport);
+        clearSelections();
+    }
+}
+
+void BCompareKde::cbShowUnchanged()
+{
+    m_config.saveShowUnchanged(!m_config.showUnchanged());
+}
+
 /*************************************************************
  * Menu Items
  *************************************************************/
@@ -151,51 +622,31 @@ QAction *BCompareKde::createMenuItem(const QString &txt, const QString &hint,
 
 QAction *BCompareKde::createMenuItemSelectLeft(const CreateMenuCtx &ctx)
 {
-    QStringList nextActions;
-
-    if (ctx.nbSelected == 1)
+    if (ctx.items & BCompareMenuTable::ITEM_SELECT_LEFT)
     {
-        BCompareConfig::MenuTypes cfgMenuTyp = BCompareConfig::MENU_SUBMENU;
+        QStringList nextActions;
 
-        if (   m_config.menuCompare() == BCompareConfig::MENU_MAIN
-            || m_config.menuCompareUsing() == BCompareConfig::MENU_MAIN
-            || m_config.menuMerge() == BCompareConfig::MENU_MAIN
-            || m_config.menuSync() == BCompareConfig::MENU_MAIN)
+        if (ctx.items & BCompareMenuTable::LABEL_NEXT_COMPARE)
         {
-            cfgMenuTyp = BCompareConfig::MENU_MAIN;
+            nextActions.append(m_strings.text(BCompareStrings::ACTION_COMPARE));
         }
-
-        if (cfgMenuTyp == ctx.menuType)
+        if (ctx.items & BCompareMenuTable::LABEL_NEXT_MERGE)
         {
-            if ((m_config.menuCompare() != BCompareConfig::MENU_NONE) ||
-                (m_config.menuCompareUsing() != BCompareConfig::MENU_NONE && !ctx.isDir))
-            {
-                nextActions.append(i18nc("@bc compare action", "Compare"));
-            }
-
-            if (m_config.menuMerge() != BCompareConfig::MENU_NONE)
-            {
-                nextActions.append(i18nc("@bc merge action", "Merge"));
-            }
-
-            if (m_config.menuSync() != BCompareConfig::MENU_NONE && ctx.isDir)
-            {
-                nextActions.append(i18nc("@bc sync action", "Sync"));
-            }
+            nextActions.append(m_strings.text(BCompareStrings::ACTION_MERGE));
+        }
+        if (ctx.items & BCompareMenuTable::LABEL_NEXT_SYNC)
+        {
+            nextActions.append(m_strings.text(BCompareStrings::ACTION_SYNC));
         }
-    }
-
-    if (nextActions.size() > 0)
-    {
-        QString itemStr = ctx.isDir ? i18nc("@bc selected folder type", "Folder") :
-                                      i18nc("@bc selected file type", "File");
 
-        QString menuStr = i18n("Select Left %1 for %2", itemStr, nextActions.join(QLatin1Char('/')));
+        const QString &itemStr = m_strings.text(ctx.isDir ? BCompareStrings::TYPE_FOLDER :
+                                                            BCompareStrings::TYPE_FILE);
 
-        QString hintStr = i18n("Remembers selected item for later comparison using Beyond Compare. "
-                               "Right-click another item to start the comparison");
+        QString menuStr = m_strings.format(BCompareStrings::SELECT_LEFT, itemStr,
+                                           nextActions.join(QLatin1Char('/')));
 
-        return createMenuItem(menuStr, hintStr, m_config.iconHalf(), &BCompareKde::cbSelectLeft);
+        return createMenuItem(menuStr, m_strings.text(BCompareStrings::HINT_SELECT),
+                              m_config.iconHalf(), &BCompareKde::cbSelectLeft);
     }
 
     return nullptr;
@@ -203,14 +654,13 @@ QAction *BCompareKde::createMenuItemSelectLeft(const CreateMenuCtx &ctx)
 
 QAction *BCompareKde::createMenuItemSelectCenter(const CreateMenuCtx &ctx)
 {
-    if (m_config.menuMerge() == ctx.menuType && ctx.nbSelected == 1)
+    if (ctx.items & BCompareMenuTable::ITEM_SELECT_CENTER)
     {
-        QString itemStr = ctx.isDir ? i18nc("@bc selected folder type", "Folder") :
-                                      i18nc("@bc selected file type", "File");
+        const QString &itemStr = m_strings.text(ctx.isDir ? BCompareStrings::TYPE_FOLDER :
+                                                            BCompareStrings::TYPE_FILE);
 
-        return createMenuItem(i18n("Select Center %1", itemStr),
-                              i18n("Remembers selected item for later comparison using Beyond Compare. "
-                                   "Right-click another item to start the comparison"),
+        return createMenuItem(m_strings.format(BCompareStrings::SELECT_CENTER, itemStr),
+                              m_strings.text(BCompareStrings::HINT_SELECT),
                               m_config.iconHalf(), &BCompareKde::cbSelectCenter);
     }
     return nullptr;
@@ -218,39 +668,76 @@ QAction *BCompareKde::createMenuItemSelectCenter(const CreateMenuCtx &ctx)
 
 QAction *BCompareKde::createMenuItemEdit(const CreateMenuCtx &ctx)
 {
-    if (m_config.menuEdit() == ctx.menuType && ctx.nbSelected == 1 && !ctx.isDir)
+    if (ctx.items & BCompareMenuTable::ITEM_EDIT)
     {
-        QString menuStr = (ctx.menuType == BCompareConfig::MENU_SUBMENU) ?
-                           i18nc("@bc edit menu", "Edit") : i18n("Edit with Beyond Compare");
+        const QString &menuStr = m_strings.text((ctx.menuType == BCompareConfig::MENU_SUBMENU) ?
+                                                BCompareStrings::MENU_EDIT : BCompareStrings::MENU_EDIT_WITH);
 
-        return createMenuItem(menuStr, i18n("Edit the file using Beyond Compare"),
+        return createMenuItem(menuStr, m_strings.text(BCompareStrings::HINT_EDIT),
                               m_config.iconEdit(), &BCompareKde::cbEditFile);
     }
     return nullptr;
 }
 
-QAction *BCompareKde::createMenuItemCompare(const CreateMenuCtx &ctx)
+QAction *BCompareKde::createMenuItemCompareClipboard(const CreateMenuCtx &ctx)
 {
-    QString menuStr;
-    QString hintStr;
+    if (ctx.items & BCompareMenuTable::ITEM_COMPARE_CLIPBOARD)
+    {
+        return createMenuItem(m_strings.text(BCompareStrings::MENU_COMPARE_CLIPBOARD),
+                              m_strings.text(BCompareStrings::HINT_COMPARE_CLIPBOARD),
+                              m_config.iconFull(), &BCompareKde::cbCompareClipboard);
+    }
+    return nullptr;
+}
 
-    if (m_config.menuCompare() == ctx.menuType)
+QAction *BCompareKde::createMenuItemCompare(const CreateMenuCtx &ctx)
+{
+    if (ctx.items & BCompareMenuTable::ITEM_COMPARE)
     {
-        if (ctx.nbSelected == 1 && !m_pathLeftFile.isEmpty())
+        QString menuStr;
+        QString hintStr;
+
+        if (ctx.items & BCompareMenuTable::LABEL_TO_LEFT)
         {
-            menuStr = i18nc("@bc compare to menu", "Compare to \"%1\"", QFileInfo(m_pathLeftFile).fileName());
-            hintStr = i18n("Compare selected item with previously selected left item, using Beyond Compare");
+            menuStr = m_strings.format(BCompareStrings::COMPARE_TO, ctx.nameLeft);
+            hintStr = m_strings.text(BCompareStrings::HINT_COMPARE_TO_LEFT);
         }
-        else if (ctx.nbSelected == 2)
+        else
         {
-            menuStr = i18nc("@bc compare menu", "Compare");
-            hintStr = i18n("Compare selected items using Beyond Compare");
+            menuStr = m_strings.text(BCompareStrings::MENU_COMPARE);
+            hintStr = m_strings.text(BCompareStrings::HINT_COMPARE);
         }
-    }
 
-    if (!menuStr.isEmpty())
-    {
-        return createMenuItem(menuStr, hintStr, m_config.iconFull(), &BCompareKde::cbCompare);
+        bool archives = ctx.isDir && isArchivePair();
+        if (ctx.isDir && !archives)
+        {
+            menuStr = withIndexedState(menuStr, m_pathLeftFile, m_pathRightFile);
+        }
+
+        QAction *act = createMenuItem(menuStr, hintStr, m_config.iconFull(), &BCompareKde::cbCompare);
+
+        if (archives)
+        {
+            withArchiveState(act, menuStr, m_pathLeftFile, m_pathRightFile);
+        }
+
+        /* Let Beyond Compare skip its own content detection when the type is obvious */
+        if (!ctx.isDir)
+        {
+            BCompareSniffer::get().preselectViewerAsync(act, m_config.listViewer(),
+                                                        m_pathLeftFile, m_pathRightFile);
+            if (hasViewer(m_config.listViewer(), QLatin1String("Picture Compare")) &&
+                BCompareImageCheck::isPicture(m_pathLeftFile) &&
+                BCompareImageCheck::isPicture(m_pathRightFile))
+            {
+                withImageState(act, menuStr, m_pathLeftFile, m_pathRightFile);
+            }
+            else
+            {
+                withEquivalentState(act, menuStr, m_pathLeftFile, m_pathRightFile);
+            }
+        }
+        return act;
     }
     return nullptr;
 }
@@ -258,30 +745,18 @@ QAction *BCompareKde::createMenuItemCompare(const CreateMenuCtx &ctx)
 QAction *BCompareKde::createSubMenuItemCompareUsing(const QString &fileViewer,
                                                      const CreateMenuCtx &ctx)
 {
-    QString hintStr;
+    const QString &hintStr = m_strings.text((ctx.items & BCompareMenuTable::LABEL_TO_LEFT) ?
+                                            BCompareStrings::HINT_COMPARE_TO_LEFT :
+                                            BCompareStrings::HINT_COMPARE);
 
-    if (ctx.nbSelected == 1 && !m_pathLeftFile.isEmpty())
-    {
-        hintStr = i18n("Compare selected item with previously selected left item, "
-                       "using Beyond Compare");
-    }
-    else if (ctx.nbSelected == 2)
-    {
-        hintStr = i18n("Compare selected items using Beyond Compare");
-    }
-
-    if (!hintStr.isEmpty())
-    {
-        QAction *act = createMenuItem(fileViewer, hintStr, QIcon(), &BCompareKde::cbCompare);
-        act->setData(fileViewer);
-        return act;
-    }
-    return nullptr;
+    QAction *act = createMenuItem(fileViewer, hintStr, QIcon(), &BCompareKde::cbCompare);
+    act->setData(fileViewer);
+    return act;
 }
 
 QAction *BCompareKde::createMenuItemCompareUsing(const CreateMenuCtx &ctx)
 {
-    if (m_config.menuCompareUsing() == ctx.menuType && !ctx.isDir)
+    if (ctx.items & BCompareMenuTable::ITEM_COMPARE_USING)
     {
         QList<QAction*> items;
 
@@ -297,13 +772,13 @@ QAction *BCompareKde::createMenuItemCompareUsing(const CreateMenuCtx &ctx)
 
             subMenuAction->setMenu(subMenu);
 
-            if (ctx.nbSelected == 1 && !m_pathLeftFile.isEmpty())
+            if (ctx.items & BCompareMenuTable::LABEL_TO_LEFT)
             {
-                subMenu->setTitle(i18n("Compare to \"%1\" Using", QFileInfo(m_pathLeftFile).fileName()));
+                subMenu->setTitle(m_strings.format(BCompareStrings::COMPARE_TO_USING, ctx.nameLeft));
             }
             else
             {
-                subMenu->setTitle(i18n("Compare Using"));
+                subMenu->setTitle(m_strings.text(BCompareStrings::MENU_COMPARE_USING));
             }
             subMenu->setIcon(m_config.iconFull());
             subMenu->addActions(items);
@@ -316,78 +791,319 @@ QAction *BCompareKde::createMenuItemCompareUsing(const CreateMenuCtx &ctx)
 
 QAction *BCompareKde::createMenuItemSync(const CreateMenuCtx &ctx)
 {
-    QString menuStr;
-    QString hintStr;
-
-    if (m_config.menuSync() == ctx.menuType && ctx.isDir)
+    if (ctx.items & BCompareMenuTable::ITEM_SYNC)
     {
-        if (ctx.nbSelected == 1 && !m_pathLeftFile.isEmpty())
-        {
-            menuStr = i18nc("@bc sync with menu", "Sync with \"%1\"",
-                            QFileInfo(m_pathLeftFile).fileName());
+        QString menuStr;
+        QString hintStr;
 
-            hintStr = i18n("Sync to previously selected folder");
+        if (ctx.items & BCompareMenuTable::LABEL_TO_LEFT)
+        {
+            menuStr = m_strings.format(BCompareStrings::SYNC_WITH, ctx.nameLeft);
+            hintStr = m_strings.text(BCompareStrings::HINT_SYNC_TO_LEFT);
         }
-        else if (ctx.nbSelected == 2)
+        else
         {
-            menuStr = i18nc("@bc sync menu", "Sync");
-            hintStr = i18n("Sync two selected folders");
+            menuStr = m_strings.text(BCompareStrings::MENU_SYNC);
+            hintStr = m_strings.text(BCompareStrings::HINT_SYNC);
         }
-    }
 
-    if (!menuStr.isEmpty())
-    {
+        menuStr = withIndexedState(menuStr, m_pathLeftFile, m_pathRightFile);
         return createMenuItem(menuStr, hintStr, m_config.iconSync(), &BCompareKde::cbSync);
     }
     return nullptr;
 }
 
+QAction *BCompareKde::createMenuItemSyncBackground(const CreateMenuCtx &ctx)
+{
+    if (!(ctx.items & BCompareMenuTable::ITEM_SYNC_BACKGROUND))
+    {
+        return nullptr;
+    }
+
+    return createMenuItem(m_strings.text(BCompareStrings::MENU_SYNC_BACKGROUND),
+                          BCompareLowPriority::describe(BCompareLowPriority::availableLimits()),
+                          m_config.iconSync(), &BCompareKde::cbSyncBackground);
+}
+
 QAction *BCompareKde::createMenuItemMerge(const CreateMenuCtx &ctx)
 {
-    QString menuStr;
+    if (!(ctx.items & BCompareMenuTable::ITEM_MERGE))
+    {
+        return nullptr;
+    }
+
+    QString menuStr = m_strings.text(BCompareStrings::MENU_MERGE);
     QString hintStr;
 
-    if (m_config.menuMerge() == ctx.menuType)
+    switch (ctx.items & (BCompareMenuTable::LABEL_MERGE_LEFT | BCompareMenuTable::LABEL_MERGE_CENTER |
+                         BCompareMenuTable::LABEL_MERGE_THREE))
+    {
+    case BCompareMenuTable::LABEL_MERGE_LEFT | BCompareMenuTable::LABEL_MERGE_CENTER:
+        menuStr = m_strings.format(BCompareStrings::MERGE_WITH_LEFT_CENTER, ctx.nameLeft, ctx.nameCenter);
+        hintStr = m_strings.text(BCompareStrings::HINT_MERGE_TO_LEFT_CENTER);
+        break;
+    case BCompareMenuTable::LABEL_MERGE_LEFT:
+        menuStr = m_strings.format(BCompareStrings::MERGE_WITH_LEFT, ctx.nameLeft);
+        hintStr = m_strings.text(BCompareStrings::HINT_MERGE_TO_LEFT);
+        break;
+    case BCompareMenuTable::LABEL_MERGE_CENTER:
+        menuStr = m_strings.format(BCompareStrings::MERGE_WITH_CENTER, ctx.nameCenter);
+        hintStr = m_strings.text(BCompareStrings::HINT_MERGE_TO_CENTER);
+        break;
+    case BCompareMenuTable::LABEL_MERGE_THREE:
+        hintStr = m_strings.text(BCompareStrings::HINT_MERGE_THREE);
+        break;
+    default:
+        hintStr = m_strings.text(BCompareStrings::HINT_MERGE_TWO);
+        break;
+    }
+
+    return createMenuItem(menuStr, hintStr, m_config.iconMerge(), &BCompareKde::cbMerge);
+}
+
+void BCompareKde::addMenuItemsCompareSibling(QList<QAction*> &items, const CreateMenuCtx &ctx)
+{
+    if (!(ctx.items & BCompareMenuTable::ITEM_COMPARE_SIBLING))
+    {
+        return;
+    }
+
+    const QList<BCompareSiblings::Sibling> siblings =
+        BCompareSiblings::get().find(m_pathRightFile, m_config.listBackupSuffixes());
+
+    for (const BCompareSiblings::Sibling &sibling : siblings)
+    {
+        QAction *act = createMenuItem(
+            m_strings.format(BCompareStrings::COMPARE_WITH_SIBLING, QFileInfo(sibling.path).fileName()),
+            m_strings.text(sibling.isBackup ? BCompareStrings::HINT_COMPARE_BACKUP :
+                                              BCompareStrings::HINT_COMPARE_ORIGINAL),
+            m_config.iconFull(), &BCompareKde::cbComparePair);
+
+        /* The backup is the older version, on the left */
+        act->setData(sibling.isBackup ? QStringList{ sibling.path, m_pathRightFile } :
+                                        QStringList{ m_pathRightFile, sibling.path });
+        items.append(act);
+    }
+}
+
+QAction *BCompareKde::createMenuItemCompareHead(const CreateMenuCtx &ctx)
+{
+    if ((ctx.items & BCompareMenuTable::ITEM_COMPARE_HEAD) &&
+        !BCompareGit::get().findRepository(m_pathRightFile).isEmpty())
+    {
+        QAction *act = createMenuItem(m_strings.text(BCompareStrings::MENU_COMPARE_HEAD),
+                                      m_strings.text(BCompareStrings::HINT_COMPARE_HEAD),
+                                      m_config.iconFull(), &BCompareKde::cbCompareHead);
+        withGitState(act, BCompareGitCheck::CHECK_HEAD_VERSION, m_pathRightFile);
+        return act;
+    }
+    return nullptr;
+}
+
+QAction *BCompareKde::createMenuItemCompareSnapshot(const CreateMenuCtx &ctx)
+{
+    if (!(ctx.items & BCompareMenuTable::ITEM_COMPARE_SNAPSHOT) ||
+        !BCompareSnapshotFinder::hasSnapshots(m_pathRightFile))
     {
-        if (ctx.nbSelected == 1 && !m_pathLeftFile.isEmpty() && !m_pathCenterFile.isEmpty())
+        return nullptr;
+    }
+
+    QMenu *subMenu = new QMenu();
+    QAction *subMenuAction = new QAction(this);
+
+    subMenuAction->setMenu(subMenu);
+    subMenu->setTitle(i18nc("@bc compare with snapshot menu", "Compare with Snapshot"));
+    subMenu->setIcon(m_config.iconFull());
+    subMenu->addAction(i18n("Searching snapshots..."))->setEnabled(false);
+
+    /* The search runs while the menu is open, and stops with it */
+    BCompareSnapshotFinder *finder = new BCompareSnapshotFinder(m_pathRightFile, subMenuAction);
+
+    connect(finder, &BCompareSnapshotFinder::finished, subMenu,
+            [this, subMenu](const BCompareSnapshotFinder::Result &result) {
+        subMenu->clear();
+
+        for (const BCompareSnapshotFinder::Version &version : result.versions)
         {
-            menuStr = i18nc("@bc merge with left center menu", "Merge with \"%1\", \"%2\"",
-                            QFileInfo(m_pathLeftFile).fileName(),
-                            QFileInfo(m_pathCenterFile).fileName());
+            QAction *act = createMenuItem(
+                i18nc("@bc snapshot version", "%1, modified %2", version.snapshot,
+                      QLocale().toString(version.modified, QLocale::ShortFormat)),
+                i18n("Compare selected file with this earlier version"),
+                QIcon(), &BCompareKde::cbCompareSnapshot);
+            act->setData(QStringList{ version.path, version.snapshot });
+            subMenu->addAction(act);
+        }
 
-            hintStr = i18n("Merge file with previously selected left and center files using Beyond Compare");
+        if (result.versions.isEmpty())
+        {
+            subMenu->addAction(i18n("No earlier version"))->setEnabled(false);
         }
-        else if (ctx.nbSelected == 1 && !m_pathLeftFile.isEmpty())
+
+        if (!result.complete)
         {
-            menuStr = i18nc("@bc merge with left menu", "Merge with \"%1\"",
-                            QFileInfo(m_pathLeftFile).fileName());
+            subMenu->addSeparator();
+            subMenu->addAction(i18n("Older versions are not listed"))->setEnabled(false);
+        }
+    });
+
+    finder->start();
+
+    return subMenuAction;
+}
+
+QAction *BCompareKde::createMenuItemResolveConflict(const CreateMenuCtx &ctx)
+{
+    if ((ctx.items & BCompareMenuTable::ITEM_RESOLVE_CONFLICT) &&
+        !BCompareGit::get().findRepository(m_pathRightFile).isEmpty())
+    {
+        QAction *act = createMenuItem(m_strings.text(BCompareStrings::MENU_RESOLVE_CONFLICT),
+                                      m_strings.text(BCompareStrings::HINT_RESOLVE_CONFLICT),
+                                      m_config.iconMerge(), &BCompareKde::cbResolveConflict);
+        withGitState(act, BCompareGitCheck::CHECK_CONFLICT, m_pathRightFile);
+        return act;
+    }
+    return nullptr;
+}
 
-            hintStr = i18n("Merge file with previously selected left file using Beyond Compare");
+/** Bounds of the "Group Identical Files" menu content */
+static const int MAX_GROUP_ITEMS = 25;
+static const int MAX_GROUP_NAMES = 3;
+
+static QString groupDescription(const QStringList &group)
+{
+    QStringList names;
+
+    for (const QString &path : group.mid(0, MAX_GROUP_NAMES))
+    {
+        names.append(QFileInfo(path).fileName());
+    }
+    if (group.size() > MAX_GROUP_NAMES)
+    {
+        names.append(QStringLiteral("..."));
+    }
+
+    return i18ncp("@bc identical files group", "%1 identical: %2", "%1 identical: %2",
+                  group.size(), names.join(QLatin1String(", ")));
+}
+
+QAction *BCompareKde::createMenuItemGroupIdentical(const CreateMenuCtx &ctx)
+{
+    if (!(ctx.items & BCompareMenuTable::ITEM_GROUP_IDENTICAL))
+    {
+        return nullptr;
+    }
+
+    QMenu *subMenu = new QMenu();
+    QAction *subMenuAction = new QAction(this);
+
+    subMenuAction->setMenu(subMenu);
+    subMenu->setTitle(m_strings.text(BCompareStrings::MENU_GROUP_IDENTICAL));
+    subMenu->setIcon(m_config.iconFull());
+
+    QAction *scanning = subMenu->addAction(i18np("Scanning %1 file...", "Scanning %1 files...",
+                                                 m_listSelectedFiles.size()));
+    scanning->setEnabled(false);
+
+    /* The search starts when the submenu is opened, and stops with the menu */
+    BCompareDupFinder *finder = new BCompareDupFinder(m_listSelectedFiles, subMenuAction);
+
+    connect(finder, &BCompareDupFinder::finished, subMenu,
+            [this, subMenu](const BCompareDupFinder::Result &result) {
+        subMenu->clear();
+
+        int nbItems = 0;
+        for (const QStringList &group : result.identicalGroups)
+        {
+            if (nbItems++ >= MAX_GROUP_ITEMS)
+            {
+                break;
+            }
+            subMenu->addAction(groupDescription(group))->setEnabled(false);
         }
-        else if (ctx.nbSelected == 2 && !m_pathCenterFile.isEmpty())
+
+        if (result.identicalGroups.isEmpty())
         {
-            menuStr = i18nc("@bc merge with center menu", "Merge with \"%1\"",
-                            QFileInfo(m_pathCenterFile).fileName());
+            subMenu->addAction(i18n("No identical files"))->setEnabled(false);
+        }
 
-            hintStr = i18n("Merge selected files (left, right) with previously selected center file");
+        if (!result.differingPairs.isEmpty())
+        {
+            subMenu->addSeparator();
         }
-        else if (ctx.nbSelected == 2)
+
+        for (const auto &pair : result.differingPairs)
         {
-            menuStr = i18nc("@bc merge menu", "Merge");
-            hintStr = i18n("Merge selected files (left, right)");
+            QAction *act = createMenuItem(
+                i18nc("@bc compare pair menu", "Compare \"%1\" and \"%2\"",
+                      QFileInfo(pair.first).fileName(), QFileInfo(pair.second).fileName()),
+                i18n("Compare these files of the same size using Beyond Compare"),
+                QIcon(), &BCompareKde::cbComparePair);
+            act->setData(QStringList{ pair.first, pair.second });
+            subMenu->addAction(act);
         }
-        else if (ctx.nbSelected == 3)
+
+        if (!result.complete)
         {
-            menuStr = i18nc("@bc merge menu", "Merge");
-            hintStr = i18n("Merge selected files (left, right, center)");
+            subMenu->addSeparator();
+            subMenu->addAction(i18n("Some files were too large to be checked"))->setEnabled(false);
         }
+    });
+
+    connect(subMenu, &QMenu::aboutToShow, finder, &BCompareDupFinder::start);
+
+    return subMenuAction;
+}
+
+QAction *BCompareKde::createMenuItemQuickVerify(const CreateMenuCtx &ctx)
+{
+    if (!(ctx.items & BCompareMenuTable::ITEM_QUICK_VERIFY))
+    {
+        return nullptr;
     }
 
-    if (!menuStr.isEmpty())
+    /* Archives are considered folders but can not be walked */
+    if (!QFileInfo(m_pathLeftFile).isDir() || !QFileInfo(m_pathRightFile).isDir())
     {
-        return createMenuItem(menuStr, hintStr, m_config.iconMerge(), &BCompareKde::cbMerge);
+        return nullptr;
     }
-    return nullptr;
+
+    return createMenuItem(m_strings.text(BCompareStrings::MENU_QUICK_VERIFY),
+                          m_strings.text(BCompareStrings::HINT_QUICK_VERIFY),
+                          m_config.iconFull(), &BCompareKde::cbQuickVerify);
+}
+
+QAction *BCompareKde::createMenuItemDiffReport(const CreateMenuCtx &ctx)
+{
+    if (!(ctx.items & BCompareMenuTable::ITEM_DIFF_REPORT))
+    {
+        return nullptr;
+    }
+
+    /* Archives are considered folders but can not be walked */
+    if (!QFileInfo(m_pathLeftFile).isDir() || !QFileInfo(m_pathRightFile).isDir())
+    {
+        return nullptr;
+    }
+
+    return createMenuItem(m_strings.text(BCompareStrings::MENU_DIFF_REPORT),
+                          m_strings.text(BCompareStrings::HINT_DIFF_REPORT),
+                          QIcon(), &BCompareKde::cbDiffReport);
+}
+
+QAction *BCompareKde::createMenuItemShowUnchanged(const CreateMenuCtx &ctx)
+{
+    if (!(ctx.items & BCompareMenuTable::ITEM_SHOW_UNCHANGED))
+    {
+        return nullptr;
+    }
+
+    QAction *item = createMenuItem(m_strings.text(BCompareStrings::MENU_SHOW_UNCHANGED),
+                                   m_strings.text(BCompareStrings::HINT_SHOW_UNCHANGED),
+                                   QIcon(), &BCompareKde::cbShowUnchanged);
+    item->setCheckable(true);
+    item->setChecked(m_config.showUnchanged());
+
+    return item;
 }
 
 /*************************************************************
@@ -396,65 +1112,83 @@ QAction *BCompareKde::createMenuItemMerge(const CreateMenuCtx &ctx)
 
 void BCompareKde::createMenus(QList<QAction*> &items, const CreateMenuCtx &ctx)
 {
+    addItemToListIfNonNull(items, createMenuItemResolveConflict(ctx));
     addItemToListIfNonNull(items, createMenuItemMerge(ctx));
     addItemToListIfNonNull(items, createMenuItemCompare(ctx));
     addItemToListIfNonNull(items, createMenuItemCompareUsing(ctx));
+    addMenuItemsCompareSibling(items, ctx);
+    addItemToListIfNonNull(items, createMenuItemCompareHead(ctx));
+    addItemToListIfNonNull(items, createMenuItemCompareSnapshot(ctx));
     addItemToListIfNonNull(items, createMenuItemSync(ctx));
+    addItemToListIfNonNull(items, createMenuItemSyncBackground(ctx));
+    addItemToListIfNonNull(items, createMenuItemQuickVerify(ctx));
+    addItemToListIfNonNull(items, createMenuItemDiffReport(ctx));
+    addItemToListIfNonNull(items, createMenuItemShowUnchanged(ctx));
     addItemToListIfNonNull(items, createMenuItemSelectLeft(ctx));
     addItemToListIfNonNull(items, createMenuItemSelectCenter(ctx));
     addItemToListIfNonNull(items, createMenuItemEdit(ctx));
+    addItemToListIfNonNull(items, createMenuItemCompareClipboard(ctx));
+    addItemToListIfNonNull(items, createMenuItemGroupIdentical(ctx));
 }
 
 /*************************************************************
- * Entry point of this plugin
+ * Selection
  *************************************************************/
 
-BCompareKde::BCompareKde(QObject *pParent, const QVariantList &) :
-    KAbstractFileItemActionPlugin(pParent), m_config(BCompareConfig::get())
-{
-}
-
-BCompareKde::~BCompareKde()
-{
-}
-
-QList<QAction*> BCompareKde::actions(const KFileItemListProperties &fileItemInfos, QWidget *)
+/**
+ * Times the building of the menus when BCOMPARE_EXT_TRACE_LATENCY is set, to
+ * measure the worst popup latency, for instance on a slow network mount.
+ */
+class BCompareLatencyTrace
 {
-    QList<QAction*> listActions;
-    const KFileItemList selectedFiles = fileItemInfos.items();
-    int nbSelected = selectedFiles.size();
-
-    m_config.reloadMenuConfig();
+public:
+    BCompareLatencyTrace()
+    {
+        m_timer.start();
+    }
 
-    /* Do not handle more than 3 selected items */
-    if (nbSelected <= 0 || nbSelected > 3 || !m_config.menuEnabled())
+    ~BCompareLatencyTrace()
     {
-        return listActions;
+        static qint64 s_worstNs = 0;
+
+        if (qEnvironmentVariableIsSet("BCOMPARE_EXT_TRACE_LATENCY"))
+        {
+            qint64 elapsedNs = m_timer.nsecsElapsed();
+            s_worstNs = qMax(s_worstNs, elapsedNs);
+            qInfo("bcompare-ext-kde: menus built in %.1f ms, worst %.1f ms",
+                  elapsedNs / 1e6, s_worstNs / 1e6);
+        }
     }
 
+private:
+    QElapsedTimer m_timer;
+};
+
+bool BCompareKde::readSelection(const KFileItemList &selectedFiles, bool &firstIsDir)
+{
     /* All the selected items must be considered of the same type */
-    bool firstIsDir = isPathConsideredFolder(selectedFiles.at(0).url().path());
-    for (int i = 1; i < nbSelected; ++i)
+    firstIsDir = isItemConsideredFolder(selectedFiles.at(0));
+    for (int i = 1; i < selectedFiles.size(); ++i)
     {
-        if (firstIsDir != isPathConsideredFolder(selectedFiles.at(i).url().path()))
+        if (firstIsDir != isItemConsideredFolder(selectedFiles.at(i)))
         {
-            return listActions;
+            return false;
         }
     }
 
-    if (nbSelected == 3)
+    if (selectedFiles.size() == 3)
     {
         m_pathLeftFile = selectedFiles.at(0).url().path();
         m_pathRightFile = selectedFiles.at(1).url().path();
         m_pathCenterFile = selectedFiles.at(2).url().path();
     }
-    else if (nbSelected == 2)
+    else if (selectedFiles.size() == 2)
     {
         m_pathLeftFile = selectedFiles.at(0).url().path();
         m_pathRightFile = selectedFiles.at(1).url().path();
         m_pathCenterFile = m_config.readPathCenterFile();
 
-        if (firstIsDir != isPathConsideredFolder(m_pathCenterFile))
+        if (!isSavedPathUsable(m_pathCenterFile, firstIsDir))
         {
             m_pathCenterFile.clear();
         }
@@ -465,25 +1199,101 @@ QList<QAction*> BCompareKde::actions(const KFileItemListProperties &fileItemInfo
         m_pathLeftFile = m_config.readPathLeftFile();
         m_pathCenterFile = m_config.readPathCenterFile();
 
-        if (firstIsDir != isPathConsideredFolder(m_pathLeftFile))
+        if (!isSavedPathUsable(m_pathLeftFile, firstIsDir))
         {
             m_pathLeftFile.clear();
         }
 
-        if (firstIsDir != isPathConsideredFolder(m_pathCenterFile))
+        if (!isSavedPathUsable(m_pathCenterFile, firstIsDir))
         {
             m_pathCenterFile.clear();
         }
     }
 
+    return true;
+}
+
+bool BCompareKde::readLargeSelection(const KFileItemList &selectedFiles)
+{
+    m_listSelectedFiles.clear();
+    m_pathLeftFile.clear();
+    m_pathRightFile.clear();
+    m_pathCenterFile.clear();
+
+    /* Only files can be grouped, KFileItem already knows their type */
+    for (const KFileItem &item : selectedFiles)
+    {
+        if (item.isDir())
+        {
+            return false;
+        }
+        m_listSelectedFiles.append(item.url().path());
+    }
+
+    return true;
+}
+
+/*************************************************************
+ * Entry point of this plugin
+ *************************************************************/
+
+BCompareKde::BCompareKde(QObject *pParent, const QVariantList &) :
+    KAbstractFileItemActionPlugin(pParent), m_config(BCompareConfig::get()),
+    m_strings(BCompareStrings::get())
+{
+}
+
+BCompareKde::~BCompareKde()
+{
+}
+
+/** Delay of the memory trace after the first menu, once it has been painted */
+static const int TRACE_MEMORY_DELAY_MS = 5000;
+
+QList<QAction*> BCompareKde::actions(const KFileItemListProperties &fileItemInfos, QWidget *parentWidget)
+{
+    BCompareLatencyTrace trace;
+    QList<QAction*> listActions;
+    const KFileItemList selectedFiles = fileItemInfos.items();
+    int nbSelected = selectedFiles.size();
+
+    m_config.reloadMenuConfig();
+    m_parentWidget = parentWidget;
+
+    if (nbSelected <= 0 || !m_config.menuEnabled())
+    {
+        return listActions;
+    }
+
+    bool firstIsDir = false;
+
+    if (nbSelected > 3)
+    {
+        /* Too many items to be compared together, they can only be grouped by content */
+        if (!readLargeSelection(selectedFiles))
+        {
+            return listActions;
+        }
+    }
+    else if (!readSelection(selectedFiles, firstIsDir))
+    {
+        return listActions;
+    }
+
     CreateMenuCtx ctx;
     ctx.isDir = firstIsDir;
     ctx.menuType = BCompareConfig::MENU_MAIN;
     ctx.nbSelected = nbSelected;
+    ctx.nameLeft = QFileInfo(m_pathLeftFile).fileName();
+    ctx.nameCenter = QFileInfo(m_pathCenterFile).fileName();
+    ctx.items = BCompareMenuTable::lookup(m_config, ctx.menuType, ctx.isDir, nbSelected,
+                                          !m_pathLeftFile.isEmpty(), !m_pathCenterFile.isEmpty());
     createMenus(listActions, ctx);
 
     QList<QAction*> itemsSubMenu;
     ctx.menuType = BCompareConfig::MENU_SUBMENU;
+    ctx.items = BCompareMenuTable::lookup(m_config, ctx.menuType, ctx.isDir, nbSelected,
+                                          !m_pathLeftFile.isEmpty(), !m_pathCenterFile.isEmpty());
     createMenus(itemsSubMenu, ctx);
 
     if (itemsSubMenu.size() > 0)
@@ -492,13 +1302,22 @@ QList<QAction*> BCompareKde::actions(const KFileItemListProperties &fileItemInfo
         QAction *subMenuAction = new QAction(this);
 
         subMenuAction->setMenu(subMenu);
-        subMenu->setTitle(i18n("Beyond Compare"));
+        subMenu->setTitle(m_strings.text(BCompareStrings::MENU_BEYOND_COMPARE));
         subMenu->setIcon(m_config.iconFull());
         subMenu->addActions(itemsSubMenu);
 
         listActions.append(subMenuAction);
     }
 
+    BCompareWarmStart::warmAsync();
+
+    static bool s_traceScheduled = false;
+    if (!s_traceScheduled)
+    {
+        s_traceScheduled = true;
+        QTimer::singleShot(TRACE_MEMORY_DELAY_MS, &BCompareSharedIcons::traceMemory);
+    }
+
     return listActions;
 }
 
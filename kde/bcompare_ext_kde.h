@@ -24,8 +24,12 @@
 #define BCOMPARE_EXT_KDE_H
 
 #include <KAbstractFileItemActionPlugin>
+#include <KFileItem>
 #include <QList>
+#include <QPointer>
 #include "bcompare_config.h"
+#include "bcompare_menus.h"
+#include "bcompare_strings.h"
 
 class BCompareKde : public KAbstractFileItemActionPlugin
 {
@@ -42,13 +46,27 @@ protected:
     void cbSelectLeft();
     void cbSelectCenter();
     void cbEditFile();
+    void cbCompareClipboard();
     void cbCompare();
     void cbSync();
+    void cbSyncBackground();
     void cbMerge();
+    void cbCompareHead();
+    void cbCompareSnapshot();
+    void cbResolveConflict();
+    void cbComparePair();
+    void cbQuickVerify();
+    void cbDiffReport();
+    void cbShowUnchanged();
 
     /* Utilities */
-    bool isPathConsideredFolder(const QString &path) const;
+    bool isItemConsideredFolder(const KFileItem &item) const;
+    bool isSavedPathUsable(const QString &path, bool firstIsDir) const;
+    bool isArchivePair() const;
+    bool readSelection(const KFileItemList &selectedFiles, bool &firstIsDir);
+    bool readLargeSelection(const KFileItemList &selectedFiles);
     void clearSelections();
+    void launchFolderSession(const QStringList &args, bool lowPriority = false);
 
     /* Menu Items */
     QAction *createMenuItem(const QString &txt, const QString &hint,
@@ -58,16 +76,29 @@ protected:
         bool isDir;
         int nbSelected;
         BCompareConfig::MenuTypes menuType;
+        quint32 items;          /* BCompareMenuTable::Bits of the menu */
+        QString nameLeft;       /* File names of the saved paths */
+        QString nameCenter;
     };
 
     QAction *createMenuItemSelectLeft(const CreateMenuCtx &ctx);
     QAction *createMenuItemSelectCenter(const CreateMenuCtx &ctx);
     QAction *createMenuItemEdit(const CreateMenuCtx &ctx);
+    QAction *createMenuItemCompareClipboard(const CreateMenuCtx &ctx);
     QAction *createMenuItemCompare(const CreateMenuCtx &ctx);
     QAction *createSubMenuItemCompareUsing(const QString &fileViewer, const CreateMenuCtx &ctx);
     QAction *createMenuItemCompareUsing(const CreateMenuCtx &ctx);
+    void addMenuItemsCompareSibling(QList<QAction*> &items, const CreateMenuCtx &ctx);
     QAction *createMenuItemSync(const CreateMenuCtx &ctx);
+    QAction *createMenuItemSyncBackground(const CreateMenuCtx &ctx);
     QAction *createMenuItemMerge(const CreateMenuCtx &ctx);
+    QAction *createMenuItemCompareHead(const CreateMenuCtx &ctx);
+    QAction *createMenuItemCompareSnapshot(const CreateMenuCtx &ctx);
+    QAction *createMenuItemResolveConflict(const CreateMenuCtx &ctx);
+    QAction *createMenuItemGroupIdentical(const CreateMenuCtx &ctx);
+    QAction *createMenuItemQuickVerify(const CreateMenuCtx &ctx);
+    QAction *createMenuItemDiffReport(const CreateMenuCtx &ctx);
+    QAction *createMenuItemShowUnchanged(const CreateMenuCtx &ctx);
 
     void createMenus(QList<QAction*> &items, const CreateMenuCtx &ctx);
 
@@ -75,6 +106,9 @@ protected:
     /** A reference to the global configuration */
     BCompareConfig &m_config;
 
+    /** A reference to the translated menu texts */
+    BCompareStrings &m_strings;
+
     /** The path of the selected left file */
     QString m_pathLeftFile;
 
@@ -83,6 +117,12 @@ protected:
 
     /** The path of the selected right file */
     QString m_pathRightFile;
+
+    /** The selected files, when there are too many to be compared together */
+    QStringList m_listSelectedFiles;
+
+    /** The window the menu was opened from, parent of the reports */
+    QPointer<QWidget> m_parentWidget;
 };
 
 #endif // BCOMPARE_EXT_KDE_H
@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QStringList>
+
+#ifdef USE_LIBGIT2
+#include <git2.h>
+#endif
+
+#include "bcompare_git.h"
+#include "bcompare_memfile.h"
+
+/** A folder outside any work tree is looked up again after this delay */
+static const qint64 NO_REPOSITORY_CACHE_MS = 10 * 1000;
+
+
+#ifdef USE_LIBGIT2
+static QString blobVersion(git_repository *repo, const git_oid *id, const QString &name,
+                           QList<int> &memFds)
+{
+    QString r;
+    git_blob *blob = nullptr;
+
+    if (git_blob_lookup(&blob, repo, id) == 0)
+    {
+        r = BCompareMemFile::fromData(name, static_cast<const char *>(git_blob_rawcontent(blob)),
+                                      static_cast<qint64>(git_blob_rawsize(blob)), memFds);
+        git_blob_free(blob);
+    }
+
+    return r;
+}
+
+/*
+ * Returns the index of the repository, reloaded from disk only if it changed
+ * since the last popup. To be released with git_index_free().
+ */
+static git_index *openIndex(git_repository *repo)
+{
+    git_index *index = nullptr;
+
+    if (git_repository_index(&index, repo) != 0)
+    {
+        return nullptr;
+    }
+
+    if (git_index_read(index, 0) != 0)
+    {
+        git_index_free(index);
+        return nullptr;
+    }
+
+    return index;
+}
+#endif
+
+BCompareGit& BCompareGit::get()
+{
+    static BCompareGit m_git;
+    return m_git;
+}
+
+bool BCompareGit::isAvailable()
+{
+#ifdef USE_LIBGIT2
+    return true;
+#else
+    return false;
+#endif
+}
+
+BCompareGit::BCompareGit()
+{
+#ifdef USE_LIBGIT2
+    git_libgit2_init();
+#endif
+}
+
+BCompareGit::~BCompareGit()
+{
+#ifdef USE_LIBGIT2
+    for (git_repository *repo : m_repos)
+    {
+        git_repository_free(repo);
+    }
+    git_libgit2_shutdown();
+#endif
+}
+
+QString BCompareGit::findRepository(const QString &pathFile)
+{
+    if (!isAvailable() || pathFile.isEmpty())
+    {
+        return QString();
+    }
+
+    QMutexLocker lock(&m_mutex);
+    return findRepositoryLocked(pathFile);
+}
+
+/*
+ * A known work tree is still valid while its ".git" entry keeps the same
+ * modification time. Otherwise the repository is opened again, or forgotten
+ * if it was removed.
+ */
+bool BCompareGit::isRootValid(const QString &root, qint64 stamp)
+{
+    if (root.isEmpty())
+    {
+        return QDateTime::currentMSecsSinceEpoch() < stamp;
+    }
+
+    QFileInfo git(root + QLatin1String("/.git"));
+    if (git.exists() && git.lastModified().toMSecsSinceEpoch() == stamp)
+    {
+        return true;
+    }
+
+#ifdef USE_LIBGIT2
+    auto it = m_repos.find(root);
+    if (it != m_repos.end())
+    {
+        git_repository_free(it.value());
+        m_repos.erase(it);
+    }
+#endif
+
+    return false;
+}
+
+/*
+ * Walk up from the directory of the file until a ".git" entry (directory or
+ * gitfile for worktrees and submodules) is found. Every directory crossed is
+ * remembered, so that browsing inside a repository costs one hash lookup and
+ * one stat() of its ".git" entry.
+ */
+QString BCompareGit::findRepositoryLocked(const QString &pathFile)
+{
+    QString dir = QFileInfo(pathFile).absolutePath();
+    QStringList crossed;
+    QString root;
+    qint64 stamp = QDateTime::currentMSecsSinceEpoch() + NO_REPOSITORY_CACHE_MS;
+
+    for (;;)
+    {
+        auto it = m_repoRootCache.find(dir);
+        if (it != m_repoRootCache.end())
+        {
+            if (isRootValid(it->root, it->stamp))
+            {
+                root = it->root;
+                stamp = it->stamp;
+                break;
+            }
+            m_repoRootCache.erase(it);
+        }
+
+        crossed.append(dir);
+
+        QFileInfo git(dir + QLatin1String("/.git"));
+        if (git.exists())
+        {
+            root = dir;
+            stamp = git.lastModified().toMSecsSinceEpoch();
+            break;
+        }
+
+        QString parent = QFileInfo(dir).path();
+        if (parent == dir)
+        {
+            break;
+        }
+        dir = parent;
+    }
+
+    for (const QString &d : crossed)
+    {
+        m_repoRootCache.insert(d, RepoRoot{ root, stamp });
+    }
+
+    return root;
+}
+
+git_repository *BCompareGit::openRepository(const QString &pathFile, QString &relPath)
+{
+#ifdef USE_LIBGIT2
+    QString root = findRepositoryLocked(pathFile);
+    if (root.isEmpty())
+    {
+        return nullptr;
+    }
+
+    relPath = QDir(root).relativeFilePath(QFileInfo(pathFile).absoluteFilePath());
+
+    auto it = m_repos.constFind(root);
+    if (it != m_repos.constEnd())
+    {
+        return it.value();
+    }
+
+    git_repository *repo = nullptr;
+    if (git_repository_open(&repo, QFile::encodeName(root).constData()) != 0)
+    {
+        repo = nullptr;
+    }
+
+    /* Also remember failures, to not retry on each popup */
+    m_repos.insert(root, repo);
+    return repo;
+#else
+    Q_UNUSED(pathFile);
+    Q_UNUSED(relPath);
+    return nullptr;
+#endif
+}
+
+bool BCompareGit::hasHeadVersion(const QString &pathFile)
+{
+#ifdef USE_LIBGIT2
+    QMutexLocker lock(&m_mutex);
+
+    QString relPath;
+    git_repository *repo = openRepository(pathFile, relPath);
+    if (repo == nullptr)
+    {
+        return false;
+    }
+
+    git_object *tree = nullptr;
+    git_tree_entry *entry = nullptr;
+    bool found = false;
+
+    if (git_revparse_single(&tree, repo, "HEAD^{tree}") == 0)
+    {
+        if (git_tree_entry_bypath(&entry, reinterpret_cast<git_tree *>(tree),
+                                  QFile::encodeName(relPath).constData()) == 0)
+        {
+            found = (git_tree_entry_type(entry) == GIT_OBJECT_BLOB);
+            git_tree_entry_free(entry);
+        }
+        git_object_free(tree);
+    }
+
+    return found;
+#else
+    Q_UNUSED(pathFile);
+    return false;
+#endif
+}
+
+QString BCompareGit::headVersion(const QString &pathFile, QList<int> &memFds)
+{
+    QString r;
+
+#ifdef USE_LIBGIT2
+    QMutexLocker lock(&m_mutex);
+
+    QString relPath;
+    git_repository *repo = openRepository(pathFile, relPath);
+    if (repo == nullptr)
+    {
+        return r;
+    }
+
+    QByteArray spec = "HEAD:" + QFile::encodeName(relPath);
+    git_object *blob = nullptr;
+
+    if (git_revparse_single(&blob, repo, spec.constData()) == 0)
+    {
+        if (git_object_type(blob) == GIT_OBJECT_BLOB)
+        {
+            /* Written straight from the libgit2 buffer, no intermediate copy */
+            git_blob *b = reinterpret_cast<git_blob *>(blob);
+            r = BCompareMemFile::fromData(QLatin1String("HEAD:") + relPath,
+                                          static_cast<const char *>(git_blob_rawcontent(b)),
+                                          static_cast<qint64>(git_blob_rawsize(b)), memFds);
+        }
+        git_object_free(blob);
+    }
+#else
+    Q_UNUSED(pathFile);
+    Q_UNUSED(memFds);
+#endif
+
+    return r;
+}
+
+bool BCompareGit::hasConflict(const QString &pathFile)
+{
+#ifdef USE_LIBGIT2
+    QMutexLocker lock(&m_mutex);
+
+    QString relPath;
+    git_repository *repo = openRepository(pathFile, relPath);
+    if (repo == nullptr)
+    {
+        return false;
+    }
+
+    git_index *index = openIndex(repo);
+    bool found = false;
+
+    if (index != nullptr)
+    {
+        if (git_index_has_conflicts(index))
+        {
+            const git_index_entry *ancestor = nullptr;
+            const git_index_entry *ours = nullptr;
+            const git_index_entry *theirs = nullptr;
+
+            found = (git_index_conflict_get(&ancestor, &ours, &theirs, index,
+                                            QFile::encodeName(relPath).constData()) == 0 &&
+                     ours != nullptr && theirs != nullptr);
+        }
+        git_index_free(index);
+    }
+
+    return found;
+#else
+    Q_UNUSED(pathFile);
+    return false;
+#endif
+}
+
+bool BCompareGit::conflictVersions(const QString &pathFile, QString &base,
+                                   QString &ours, QString &theirs, QList<int> &memFds)
+{
+    base.clear();
+    ours.clear();
+    theirs.clear();
+
+#ifdef USE_LIBGIT2
+    QMutexLocker lock(&m_mutex);
+
+    QString relPath;
+    git_repository *repo = openRepository(pathFile, relPath);
+    if (repo == nullptr)
+    {
+        return false;
+    }
+
+    git_index *index = openIndex(repo);
+    if (index == nullptr)
+    {
+        return false;
+    }
+
+    const git_index_entry *ancestorEntry = nullptr;
+    const git_index_entry *oursEntry = nullptr;
+    const git_index_entry *theirsEntry = nullptr;
+
+    if (git_index_conflict_get(&ancestorEntry, &oursEntry, &theirsEntry, index,
+                               QFile::encodeName(relPath).constData()) == 0 &&
+        oursEntry != nullptr && theirsEntry != nullptr)
+    {
+        ours = blobVersion(repo, &oursEntry->id, QLatin1String("OURS:") + relPath, memFds);
+        theirs = blobVersion(repo, &theirsEntry->id, QLatin1String("THEIRS:") + relPath, memFds);
+
+        if (ancestorEntry != nullptr)
+        {
+            base = blobVersion(repo, &ancestorEntry->id, QLatin1String("BASE:") + relPath, memFds);
+        }
+    }
+
+    git_index_free(index);
+
+    return !ours.isEmpty() && !theirs.isEmpty();
+#else
+    Q_UNUSED(pathFile);
+    Q_UNUSED(memFds);
+    return false;
+#endif
+}
+
+/*************************************************************
+ * Background check
+ *************************************************************/
+
+struct BCompareGitCheckState
+{
+    /** Protects check, cleared when it is destroyed */
+    QMutex mutex;
+    BCompareGitCheck *check = nullptr;
+
+    BCompareGitCheck::Checks kind = BCompareGitCheck::CHECK_HEAD_VERSION;
+    QString pathFile;
+};
+
+class BCompareGitTask : public QRunnable
+{
+public:
+    explicit BCompareGitTask(const std::shared_ptr<BCompareGitCheckState> &state) :
+        m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        BCompareGit &git = BCompareGit::get();
+        bool found = (m_state->kind == BCompareGitCheck::CHECK_CONFLICT) ?
+                     git.hasConflict(m_state->pathFile) : git.hasHeadVersion(m_state->pathFile);
+
+        /* The result is queued to the check itself, dropped if it is destroyed meanwhile */
+        QMutexLocker lock(&m_state->mutex);
+        BCompareGitCheck *check = m_state->check;
+
+        if (check != nullptr)
+        {
+            QMetaObject::invokeMethod(check, [check, found]() {
+                Q_EMIT check->finished(found);
+            }, Qt::QueuedConnection);
+        }
+    }
+
+private:
+    std::shared_ptr<BCompareGitCheckState> m_state;
+};
+
+BCompareGitCheck::BCompareGitCheck(Checks check, const QString &pathFile, QObject *pParent) :
+    QObject(pParent), m_state(std::make_shared<BCompareGitCheckState>())
+{
+    m_state->check = this;
+    m_state->kind = check;
+    m_state->pathFile = pathFile;
+}
+
+BCompareGitCheck::~BCompareGitCheck()
+{
+    QMutexLocker lock(&m_state->mutex);
+    m_state->check = nullptr;
+}
+
+void BCompareGitCheck::start()
+{
+    QThreadPool::globalInstance()->start(new BCompareGitTask(m_state));
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_GIT_H
+#define BCOMPARE_GIT_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <memory>
+
+struct git_repository;
+struct BCompareGitCheckState;
+
+class BCompareGit
+{
+public:
+    /** Get a reference to the global Git repositories cache */
+    static BCompareGit& get();
+
+    /** Indicates if Git support was built in */
+    static bool isAvailable();
+
+    /** Work tree root of the repository containing pathFile, empty if none */
+    QString findRepository(const QString &pathFile);
+
+    /** Indicates if pathFile exists in the HEAD commit of its repository */
+    bool hasHeadVersion(const QString &pathFile);
+
+    /**
+     * Reads the HEAD version of pathFile from the object store into an
+     * in-memory file added to memFds, and returns a path Beyond Compare can open
+     */
+    QString headVersion(const QString &pathFile, QList<int> &memFds);
+
+    /** Indicates if pathFile is unmerged in the index of its repository */
+    bool hasConflict(const QString &pathFile);
+
+    /**
+     * Reads the conflict stages of pathFile from the index into in-memory files,
+     * added to memFds even if another stage fails.
+     * base is left empty when there is no common ancestor (both added).
+     * Returns false if ours or theirs are missing (modify/delete conflict).
+     */
+    bool conflictVersions(const QString &pathFile, QString &base, QString &ours, QString &theirs,
+                          QList<int> &memFds);
+
+private:
+    BCompareGit();
+    ~BCompareGit();
+
+    /** The methods below are called with m_mutex locked */
+    QString findRepositoryLocked(const QString &pathFile);
+    bool isRootValid(const QString &root, qint64 stamp);
+    git_repository *openRepository(const QString &pathFile, QString &relPath);
+
+    struct RepoRoot
+    {
+        /** Work tree root, empty if none */
+        QString root;
+
+        /**
+         * Modification time of the ".git" entry of root, in ms since the epoch,
+         * or expiry time of the entry if root is empty
+         */
+        qint64 stamp;
+    };
+
+    /** Mutex protecting the caches, libgit2 objects are not thread safe */
+    QMutex m_mutex;
+
+    /** Work tree root for each directory already looked up */
+    QHash<QString, RepoRoot> m_repoRootCache;
+
+    /** Opened repositories, indexed by work tree root */
+    QHash<QString, git_repository*> m_repos;
+};
+
+/**
+ * Looks a file up in its repository in the background, so that building
+ * the menu never waits for libgit2. The check is cancelled when this object
+ * is destroyed.
+ */
+class BCompareGitCheck : public QObject
+{
+    Q_OBJECT
+public:
+    typedef enum {
+        CHECK_HEAD_VERSION = 0,
+        CHECK_CONFLICT
+    } Checks;
+
+    BCompareGitCheck(Checks check, const QString &pathFile, QObject *pParent);
+    ~BCompareGitCheck() override;
+
+    void start();
+
+Q_SIGNALS:
+    void finished(bool found);
+
+private:
+    std::shared_ptr<BCompareGitCheckState> m_state;
+};
+
+#endif // BCOMPARE_GIT_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QFile>
+#include <sys/stat.h>
+
+#ifdef USE_XXHASH
+#include <xxhash.h>
+#else
+#include <QCryptographicHash>
+#endif
+
+#include "bcompare_hash.h"
+
+/** Size of the reads, cancellation is checked between each of them */
+static const int HASH_CHUNK_SIZE = 1024 * 1024;
+
+/** Bound of the cache, it is simply emptied when reached */
+static const int MAX_CACHED_HASHES = 200000;
+
+static QByteArray computeHash(const QString &pathFile, const std::atomic<bool> *cancel)
+{
+    QFile f(pathFile);
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        return QByteArray();
+    }
+
+    QByteArray buf(HASH_CHUNK_SIZE, Qt::Uninitialized);
+    bool ok = true;
+
+#ifdef USE_XXHASH
+    XXH3_state_t *state = XXH3_createState();
+    XXH3_128bits_reset(state);
+#else
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+#endif
+
+    for (;;)
+    {
+        if (cancel != nullptr && cancel->load(std::memory_order_relaxed))
+        {
+            ok = false;
+            break;
+        }
+
+        qint64 n = f.read(buf.data(), buf.size());
+        if (n <= 0)
+        {
+            ok = (n == 0);
+            break;
+        }
+
+#ifdef USE_XXHASH
+        XXH3_128bits_update(state, buf.constData(), static_cast<size_t>(n));
+#else
+        hash.addData(QByteArray::fromRawData(buf.constData(), static_cast<int>(n)));
+#endif
+    }
+
+    QByteArray r;
+
+#ifdef USE_XXHASH
+    if (ok)
+    {
+        XXH128_canonical_t digest;
+        XXH128_canonicalFromHash(&digest, XXH3_128bits_digest(state));
+        r = QByteArray(reinterpret_cast<const char *>(digest.digest), sizeof(digest.digest));
+    }
+    XXH3_freeState(state);
+#else
+    if (ok)
+    {
+        r = hash.result();
+    }
+#endif
+
+    return r;
+}
+
+BCompareHashCache& BCompareHashCache::get()
+{
+    static BCompareHashCache m_cache;
+    return m_cache;
+}
+
+bool BCompareHashCache::fileId(const QString &pathFile, FileId &id)
+{
+    struct stat st;
+
+    if (stat(QFile::encodeName(pathFile).constData(), &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        return false;
+    }
+
+    id.dev = static_cast<quint64>(st.st_dev);
+    id.ino = static_cast<quint64>(st.st_ino);
+    id.mtimeNs = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    id.size = static_cast<qint64>(st.st_size);
+    return true;
+}
+
+QByteArray BCompareHashCache::fileHash(const QString &pathFile, const std::atomic<bool> *cancel)
+{
+    FileId id;
+
+    if (!fileId(pathFile, id))
+    {
+        return QByteArray();
+    }
+
+    return fileHash(pathFile, id, cancel);
+}
+
+QByteArray BCompareHashCache::fileHash(const QString &pathFile, const FileId &id,
+                                       const std::atomic<bool> *cancel)
+{
+    QByteArray key(reinterpret_cast<const char *>(&id), sizeof(id));
+
+    {
+        QMutexLocker lock(&m_mutex);
+        auto it = m_hashes.constFind(key);
+        if (it != m_hashes.constEnd())
+        {
+            return it.value();
+        }
+    }
+
+    QByteArray hash = computeHash(pathFile, cancel);
+
+    if (!hash.isEmpty())
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_hashes.size() >= MAX_CACHED_HASHES)
+        {
+            m_hashes.clear();
+        }
+        m_hashes.insert(key, hash);
+    }
+
+    return hash;
+}
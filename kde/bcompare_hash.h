@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_HASH_H
+#define BCOMPARE_HASH_H
+
+#include <QByteArray>
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <atomic>
+
+class BCompareHashCache
+{
+public:
+    /** Get a reference to the global file content hash cache */
+    static BCompareHashCache& get();
+
+    /** Identity of a file content, a file is hashed again only if it changes */
+    struct FileId
+    {
+        quint64 dev;
+        quint64 ino;
+        qint64 mtimeNs;
+        qint64 size;
+    };
+
+    static bool fileId(const QString &pathFile, FileId &id);
+
+    /**
+     * Hash of the whole content of pathFile, computed once per identity.
+     * Returns an empty array if the file is unreadable or cancel was set.
+     */
+    QByteArray fileHash(const QString &pathFile, const std::atomic<bool> *cancel = nullptr);
+    QByteArray fileHash(const QString &pathFile, const FileId &id,
+                        const std::atomic<bool> *cancel = nullptr);
+
+private:
+    BCompareHashCache() = default;
+
+    /** Mutex protecting the cache, hashes are computed without holding it */
+    QMutex m_mutex;
+
+    /** Content hash for each file identity (raw FileId bytes) */
+    QHash<QByteArray, QByteArray> m_hashes;
+};
+
+#endif // BCOMPARE_HASH_H
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QRegularExpression>
+#include <QVector>
+#include <QFile>
+#include "bcompare_ignore.h"
+#include "bcompare_walk.h"
+
+/** Bound of the cache, it is simply dropped when full */
+static const int MAX_CACHED_RULE_SETS = 4096;
+
+static const char *s_ignoreFiles[] = { ".gitignore", ".bcignore" };
+
+struct BCompareIgnoreRule
+{
+    QRegularExpression regex;
+    bool negated;
+    bool folderOnly;
+};
+
+struct BCompareIgnoreRuleSet
+{
+    /** Modification times of the files the rules come from, -1 if missing */
+    qint64 mtimeNs[2];
+
+    /** In file order, the last matching rule wins */
+    QVector<BCompareIgnoreRule> rules;
+};
+
+struct BCompareIgnoreRules::ActiveRules
+{
+    std::shared_ptr<const BCompareIgnoreRuleSet> rules;
+
+    /** Path of the walked folder relative to the folder of the rules */
+    QString prefix;
+
+    /** Length of the relative path of the folder of the rules in the walk */
+    int strip;
+};
+
+static qint64 fileMtimeNs(const QByteArray &pathFile)
+{
+    struct stat st;
+    if (stat(pathFile.constData(), &st) != 0)
+    {
+        return -1;
+    }
+    return qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+/**
+ * Translates a Git wildcard pattern to a regular expression matching the
+ * paths relative to the folder of the rules
+ */
+static QString globToRegex(const QString &pattern, bool anchored)
+{
+    QString re = anchored ? QLatin1String("^") : QLatin1String("^(?:.*/)?");
+    int len = pattern.size();
+
+    for (int i = 0; i < len; ++i)
+    {
+        QChar c = pattern.at(i);
+
+        if (pattern.mid(i, 3) == QLatin1String("**/"))
+        {
+            re += QLatin1String("(?:.*/)?");
+            i += 2;
+        }
+        else if (pattern.mid(i) == QLatin1String("**"))
+        {
+            re += QLatin1String(".*");
+            break;
+        }
+        else if (c == QLatin1Char('*'))
+        {
+            re += QLatin1String("[^/]*");
+        }
+        else if (c == QLatin1Char('?'))
+        {
+            re += QLatin1String("[^/]");
+        }
+        else if (c == QLatin1Char('[') && pattern.indexOf(QLatin1Char(']'), i + 2) > 0)
+        {
+            int end = pattern.indexOf(QLatin1Char(']'), i + 2);
+            QString set = pattern.mid(i + 1, end - i - 1);
+
+            if (set.startsWith(QLatin1Char('!')))
+            {
+                set[0] = QLatin1Char('^');
+            }
+            re += QLatin1Char('[');
+            re += set.replace(QLatin1String("\\"), QLatin1String("\\\\"));
+            re += QLatin1Char(']');
+            i = end;
+        }
+        else if (c == QLatin1Char('\\') && i + 1 < len)
+        {
+            re += QRegularExpression::escape(pattern.mid(++i, 1));
+        }
+        else
+        {
+            re += QRegularExpression::escape(QString(c));
+        }
+    }
+
+    re += QLatin1Char('$');
+    return re;
+}
+
+static void parseRules(const QByteArray &pathFile, QVector<BCompareIgnoreRule> &rules)
+{
+    QFile f(QFile::decodeName(pathFile));
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return;
+    }
+
+    while (!f.atEnd())
+    {
+        QString line = QString::fromUtf8(f.readLine());
+        BCompareIgnoreRule rule;
+
+        /* Trailing spaces are ignored unless escaped */
+        while (line.endsWith(QLatin1Char('\n')) || line.endsWith(QLatin1Char('\r')) ||
+               (line.endsWith(QLatin1Char(' ')) && !line.endsWith(QLatin1String("\\ "))))
+        {
+            line.chop(1);
+        }
+
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+        {
+            continue;
+        }
+
+        rule.negated = line.startsWith(QLatin1Char('!'));
+        if (rule.negated)
+        {
+            line.remove(0, 1);
+        }
+
+        rule.folderOnly = line.endsWith(QLatin1Char('/'));
+        if (rule.folderOnly)
+        {
+            line.chop(1);
+        }
+
+        /* A slash anywhere but at the end anchors the pattern to its folder */
+        bool anchored = line.contains(QLatin1Char('/'));
+        if (line.startsWith(QLatin1Char('/')))
+        {
+            line.remove(0, 1);
+        }
+
+        if (!line.isEmpty())
+        {
+            rule.regex = QRegularExpression(globToRegex(line, anchored));
+            if (rule.regex.isValid())
+            {
+                rules.append(rule);
+            }
+        }
+    }
+
+    f.close();
+}
+
+/*************************************************************
+ * Rules cache
+ *************************************************************/
+
+BCompareIgnoreRules& BCompareIgnoreRules::get()
+{
+    static BCompareIgnoreRules m_rules;
+    return m_rules;
+}
+
+std::shared_ptr<const BCompareIgnoreRuleSet> BCompareIgnoreRules::rulesOf(const QByteArray &pathFolder)
+{
+    qint64 mtimeNs[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        mtimeNs[i] = fileMtimeNs(BCompareFolderWalk::joinPath(pathFolder, s_ignoreFiles[i]));
+    }
+
+    {
+        QMutexLocker lock(&m_mutex);
+        auto it = m_cache.constFind(pathFolder);
+        if (it != m_cache.constEnd() &&
+            it.value()->mtimeNs[0] == mtimeNs[0] && it.value()->mtimeNs[1] == mtimeNs[1])
+        {
+            return it.value();
+        }
+    }
+
+    auto ruleSet = std::make_shared<BCompareIgnoreRuleSet>();
+    for (int i = 0; i < 2; ++i)
+    {
+        ruleSet->mtimeNs[i] = mtimeNs[i];
+        if (mtimeNs[i] >= 0)
+        {
+            parseRules(BCompareFolderWalk::joinPath(pathFolder, s_ignoreFiles[i]), ruleSet->rules);
+        }
+    }
+
+    QMutexLocker lock(&m_mutex);
+    if (m_cache.size() >= MAX_CACHED_RULE_SETS)
+    {
+        m_cache.clear();
+    }
+    m_cache.insert(pathFolder, ruleSet);
+
+    return ruleSet;
+}
+
+bool BCompareIgnoreRules::isIgnored(const QList<ActiveRules> &active, const QString &relPath, bool isDir)
+{
+    /* The deepest rules take precedence, then the last ones of each file */
+    for (int i = active.size() - 1; i >= 0; --i)
+    {
+        const ActiveRules &a = active.at(i);
+        QString path = a.prefix + relPath.mid(a.strip);
+
+        const QVector<BCompareIgnoreRule> &rules = a.rules->rules;
+        for (int r = rules.size() - 1; r >= 0; --r)
+        {
+            if ((!rules.at(r).folderOnly || isDir) && rules.at(r).regex.match(path).hasMatch())
+            {
+                return !rules.at(r).negated;
+            }
+        }
+    }
+
+    return false;
+}
+
+void BCompareIgnoreRules::walkIgnored(const QByteArray &pathFolder, const QByteArray &relPath,
+                                      QList<ActiveRules> &active, QList<QByteArray> &folders,
+                                      QList<QByteArray> &files, int maxPaths)
+{
+    QByteArray path = BCompareFolderWalk::joinPath(pathFolder, relPath);
+    QMap<QByteArray, struct stat> entries;
+
+    if (folders.size() >= maxPaths || !BCompareFolderWalk::listEntries(path, entries))
+    {
+        return;
+    }
+
+    std::shared_ptr<const BCompareIgnoreRuleSet> rules = rulesOf(path);
+    bool hasRules = !rules->rules.isEmpty();
+    if (hasRules)
+    {
+        active.append(ActiveRules{ rules, QString(), relPath.isEmpty() ? 0 : relPath.size() + 1 });
+    }
+
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it)
+    {
+        bool isDir = S_ISDIR(it.value().st_mode);
+        QByteArray entryPath = relPath.isEmpty() ? it.key() : relPath + '/' + it.key();
+
+        /* Git never looks inside its own folder */
+        if ((isDir && it.key() == ".git") ||
+            isIgnored(active, QFile::decodeName(entryPath), isDir))
+        {
+            if (isDir)
+            {
+                folders.append(entryPath + '/');
+            }
+            else if (files.size() < maxPaths)
+            {
+                files.append(entryPath);
+            }
+        }
+        else if (isDir)
+        {
+            walkIgnored(pathFolder, entryPath, active, folders, files, maxPaths);
+        }
+    }
+
+    if (hasRules)
+    {
+        active.removeLast();
+    }
+}
+
+QList<QByteArray> BCompareIgnoreRules::ignoredPaths(const QByteArray &pathFolder, int maxPaths)
+{
+    QList<ActiveRules> active;
+    QList<QByteArray> folders, files;
+
+    QByteArray root = pathFolder;
+    if (root.size() > 1 && root.endsWith('/'))
+    {
+        root.chop(1);
+    }
+
+    /* The rules of the parent folders only apply inside a Git work tree */
+    QByteArray dir = root;
+    QString prefix;
+    while (!dir.isEmpty() && dir != "/")
+    {
+        int slash = dir.lastIndexOf('/');
+        prefix = QFile::decodeName(dir.mid(slash + 1)) + QLatin1Char('/') + prefix;
+        dir = (slash > 0) ? dir.left(slash) : QByteArray("/");
+
+        std::shared_ptr<const BCompareIgnoreRuleSet> rules = rulesOf(dir);
+        if (!rules->rules.isEmpty())
+        {
+            active.prepend(ActiveRules{ rules, prefix, 0 });
+        }
+
+        struct stat st;
+        if (stat(BCompareFolderWalk::joinPath(dir, ".git").constData(), &st) == 0)
+        {
+            break;
+        }
+        else if (dir == "/")
+        {
+            active.clear();
+        }
+    }
+
+    walkIgnored(root, QByteArray(), active, folders, files, maxPaths);
+
+    /* The folders are the most useful to skip */
+    folders.append(files);
+    return folders.mid(0, maxPaths);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_IGNORE_H
+#define BCOMPARE_IGNORE_H
+
+#include <QByteArray>
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <memory>
+
+struct BCompareIgnoreRuleSet;
+
+/**
+ * Compiles the .gitignore and .bcignore files found along the selected
+ * folders, with the Git semantics: negations, anchored and folder patterns.
+ * The rules of each folder are cached until one of its files changes.
+ */
+class BCompareIgnoreRules
+{
+public:
+    /** Get a reference to the global rules cache */
+    static BCompareIgnoreRules& get();
+
+    /**
+     * Relative paths ignored in the tree of pathFolder, folders ending with a
+     * slash, at most maxPaths of them with the folders first. The rules of the
+     * parent folders apply up to the root of a Git work tree. The ignored
+     * folders are not walked.
+     */
+    QList<QByteArray> ignoredPaths(const QByteArray &pathFolder, int maxPaths);
+
+private:
+    BCompareIgnoreRules() = default;
+
+    struct ActiveRules;
+
+    std::shared_ptr<const BCompareIgnoreRuleSet> rulesOf(const QByteArray &pathFolder);
+    static bool isIgnored(const QList<ActiveRules> &active, const QString &relPath, bool isDir);
+    void walkIgnored(const QByteArray &pathFolder, const QByteArray &relPath,
+                     QList<ActiveRules> &active, QList<QByteArray> &folders,
+                     QList<QByteArray> &files, int maxPaths);
+
+    /** Mutex protecting the cache */
+    QMutex m_mutex;
+
+    /** Compiled rules of each folder already looked at */
+    QHash<QByteArray, std::shared_ptr<const BCompareIgnoreRuleSet>> m_cache;
+};
+
+#endif // BCOMPARE_IGNORE_H
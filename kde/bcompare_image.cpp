@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QMimeDatabase>
+#include <QImageReader>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QPointer>
+#include <QImage>
+#include <QMutex>
+#include <QHash>
+#include <QtAlgorithms>
+#include <atomic>
+#include "bcompare_image.h"
+#include "bcompare_hash.h"
+
+/** Side of the downscaled decode the perceptual hash is computed from */
+static const int IMAGE_DECODE_SIZE = 64;
+
+/** Pictures are decoded whole only below this, to check their pixels */
+static const qint64 MAX_IMAGE_FULL_PIXELS = 16LL * 1000 * 1000;
+
+/** Number of the 64 bits of the hashes which may differ in similar pictures */
+static const int IMAGE_DHASH_THRESHOLD = 3;
+
+/** Bound of the cache, it is simply emptied when reached */
+static const int MAX_CACHED_IMAGES = 10000;
+
+struct ImageHash
+{
+    bool valid = false;
+    quint64 dHash = 0;
+    QSize size;
+
+    /** Hash of the decoded pixels, empty if the picture is too large */
+    QByteArray pixelHash;
+};
+
+struct BCompareImageState
+{
+    std::atomic<bool> cancelled{false};
+
+    QPointer<BCompareImageCheck> check;
+    QString pathLeft;
+    QString pathRight;
+};
+
+/** Hashes for each file identity (raw FileId bytes) */
+static QMutex s_cacheMutex;
+static QHash<QByteArray, ImageHash> s_cache;
+
+/*************************************************************
+ * Hashes
+ *************************************************************/
+
+/** One bit per pair of neighbour pixels of a 9x8 gray version of the picture */
+static quint64 differenceHash(const QImage &image)
+{
+    QImage gray = image.scaled(9, 8, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                       .convertToFormat(QImage::Format_Grayscale8);
+    quint64 hash = 0;
+
+    for (int y = 0; y < 8; ++y)
+    {
+        const uchar *line = gray.constScanLine(y);
+        for (int x = 0; x < 8; ++x)
+        {
+            hash = (hash << 1) | ((line[x] < line[x + 1]) ? 1 : 0);
+        }
+    }
+    return hash;
+}
+
+static QByteArray pixelHash(const QString &pathFile)
+{
+    QImageReader reader(pathFile);
+    reader.setAutoTransform(true);
+
+    QImage image = reader.read();
+    if (image.isNull())
+    {
+        return QByteArray();
+    }
+
+    image = image.convertToFormat(QImage::Format_ARGB32);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (int y = 0; y < image.height(); ++y)
+    {
+        hash.addData(reinterpret_cast<const char *>(image.constScanLine(y)), image.width() * 4);
+    }
+    return hash.result();
+}
+
+static ImageHash computeHash(const QString &pathFile, const std::atomic<bool> *cancelled)
+{
+    ImageHash h;
+    QImageReader reader(pathFile);
+    QSize size = reader.size();
+
+    if (!size.isValid())
+    {
+        return h;
+    }
+
+    /* Formats unable to decode at a lower resolution are decoded whole first */
+    qint64 pixels = static_cast<qint64>(size.width()) * size.height();
+    if (!reader.supportsOption(QImageIOHandler::ScaledSize) && pixels > MAX_IMAGE_FULL_PIXELS)
+    {
+        return h;
+    }
+
+    reader.setAutoTransform(true);
+    reader.setScaledSize(QSize(IMAGE_DECODE_SIZE, IMAGE_DECODE_SIZE));
+    QImage image = reader.read();
+    if (image.isNull() || cancelled->load())
+    {
+        return h;
+    }
+
+    h.dHash = differenceHash(image);
+    h.size = size;
+    if (pixels <= MAX_IMAGE_FULL_PIXELS)
+    {
+        h.pixelHash = pixelHash(pathFile);
+    }
+    h.valid = !cancelled->load();
+    return h;
+}
+
+static ImageHash imageHash(const QString &pathFile, const std::atomic<bool> *cancelled)
+{
+    BCompareHashCache::FileId id;
+    if (!BCompareHashCache::fileId(pathFile, id))
+    {
+        return ImageHash();
+    }
+
+    QByteArray key(reinterpret_cast<const char *>(&id), sizeof(id));
+    {
+        QMutexLocker lock(&s_cacheMutex);
+        auto it = s_cache.constFind(key);
+        if (it != s_cache.constEnd())
+        {
+            return it.value();
+        }
+    }
+
+    ImageHash h = computeHash(pathFile, cancelled);
+    if (h.valid)
+    {
+        QMutexLocker lock(&s_cacheMutex);
+        if (s_cache.size() >= MAX_CACHED_IMAGES)
+        {
+            s_cache.clear();
+        }
+        s_cache.insert(key, h);
+    }
+    return h;
+}
+
+static BCompareImageCheck::Similarity similarity(const ImageHash &left, const ImageHash &right)
+{
+    if (!left.valid || !right.valid)
+    {
+        return BCompareImageCheck::IMAGE_UNKNOWN;
+    }
+
+    if (!left.pixelHash.isEmpty() && left.size == right.size && left.pixelHash == right.pixelHash)
+    {
+        return BCompareImageCheck::IMAGE_PIXEL_IDENTICAL;
+    }
+
+    /* The hashes ignore the proportions of the pictures, which must match within 1% */
+    qint64 crossLeft = static_cast<qint64>(left.size.width()) * right.size.height();
+    qint64 crossRight = static_cast<qint64>(right.size.width()) * left.size.height();
+    bool sameAspect = qAbs(crossLeft - crossRight) * 100 <= crossLeft;
+
+    return (sameAspect && qPopulationCount(left.dHash ^ right.dHash) <= IMAGE_DHASH_THRESHOLD) ?
+           BCompareImageCheck::IMAGE_VISUALLY_IDENTICAL : BCompareImageCheck::IMAGE_DIFFERS;
+}
+
+/*************************************************************
+ * Background check
+ *************************************************************/
+
+class BCompareImageTask : public QRunnable
+{
+public:
+    explicit BCompareImageTask(const std::shared_ptr<BCompareImageState> &state) :
+        m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        ImageHash left = imageHash(m_state->pathLeft, &m_state->cancelled);
+        ImageHash right = imageHash(m_state->pathRight, &m_state->cancelled);
+        int result = similarity(left, right);
+
+        if (m_state->cancelled.load() || result == BCompareImageCheck::IMAGE_UNKNOWN)
+        {
+            return;
+        }
+
+        QPointer<BCompareImageCheck> check = m_state->check;
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [check, result]() {
+            if (!check.isNull())
+            {
+                Q_EMIT check->finished(result);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    std::shared_ptr<BCompareImageState> m_state;
+};
+
+/*************************************************************
+ * Check
+ *************************************************************/
+
+BCompareImageCheck::BCompareImageCheck(const QString &pathLeft, const QString &pathRight,
+                                       QObject *pParent) :
+    QObject(pParent), m_state(std::make_shared<BCompareImageState>())
+{
+    m_state->check = this;
+    m_state->pathLeft = pathLeft;
+    m_state->pathRight = pathRight;
+}
+
+BCompareImageCheck::~BCompareImageCheck()
+{
+    cancel();
+}
+
+void BCompareImageCheck::start()
+{
+    QThreadPool::globalInstance()->start(new BCompareImageTask(m_state));
+}
+
+void BCompareImageCheck::cancel()
+{
+    m_state->cancelled.store(true);
+}
+
+bool BCompareImageCheck::isPicture(const QString &pathFile)
+{
+    QMimeDatabase db;
+    return db.mimeTypeForFile(pathFile, QMimeDatabase::MatchExtension).name()
+             .startsWith(QLatin1String("image/"));
+}
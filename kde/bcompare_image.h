@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_IMAGE_H
+#define BCOMPARE_IMAGE_H
+
+#include <QObject>
+#include <QString>
+#include <memory>
+
+struct BCompareImageState;
+
+/**
+ * Compares two pictures from a perceptual hash (dHash) of a downscaled
+ * decode, and from their full pixels when they are small enough, so the
+ * compare menu can tell whether a Picture Compare is worth it. Hashes are
+ * cached for each file identity, and the check is cancelled when this
+ * object is destroyed.
+ */
+class BCompareImageCheck : public QObject
+{
+    Q_OBJECT
+public:
+    typedef enum {
+        IMAGE_UNKNOWN = 0,
+        IMAGE_DIFFERS,
+        IMAGE_VISUALLY_IDENTICAL,
+        IMAGE_PIXEL_IDENTICAL
+    } Similarity;
+
+    BCompareImageCheck(const QString &pathLeft, const QString &pathRight, QObject *pParent);
+    ~BCompareImageCheck() override;
+
+    void start();
+    void cancel();
+
+    /** True if the extension of pathFile is the one of a picture */
+    static bool isPicture(const QString &pathFile);
+
+Q_SIGNALS:
+    void finished(int similarity);
+
+private:
+    std::shared_ptr<BCompareImageState> m_state;
+};
+
+#endif // BCOMPARE_IMAGE_H
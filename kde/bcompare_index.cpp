@@ -0,0 +1,503 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QDateTime>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QVector>
+#include <QHash>
+#include <QFile>
+#include <QDir>
+#include <algorithm>
+#include <climits>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#ifdef USE_XXHASH
+#include <xxhash.h>
+#endif
+#include "bcompare_index.h"
+#include "bcompare_hash.h"
+
+static const char INDEX_MAGIC[8] = { 'B', 'C', 'M', 'R', 'K', 'L', '0', '1' };
+static const int INDEX_HASH_SIZE = 16;
+static const int MAX_INDEX_RECORDS = 1000000;
+static const qint64 REFRESH_INTERVAL_MS = 60 * 1000;
+
+/*
+ * An index file is a header, the records in breadth first order so that the
+ * entries of a folder are contiguous, then the names of the entries.
+ */
+struct IndexHeader
+{
+    char magic[8];
+    quint32 nbRecords;
+    quint32 namesSize;
+};
+
+enum IndexKinds : quint32
+{
+    INDEX_FILE = 'f',
+    INDEX_FOLDER = 'd',
+    INDEX_LINK = 'l'
+};
+
+struct IndexRecord
+{
+    quint64 ino;
+    qint64 size;
+    qint64 mtimeNs;
+    quint8 hash[INDEX_HASH_SIZE];
+    quint32 nameOffset;
+    quint32 nameLength;
+    quint32 firstChild;
+    quint32 nbChildren;
+    quint32 kind;
+    quint32 reserved;
+};
+
+/** Read only view of a mapped index file */
+class IndexView
+{
+public:
+    bool open(const QString &pathIndex)
+    {
+        m_file.setFileName(pathIndex);
+        if (!m_file.open(QIODevice::ReadOnly) || m_file.size() < qint64(sizeof(IndexHeader)))
+        {
+            return false;
+        }
+
+        m_data = m_file.map(0, m_file.size());
+        if (m_data == nullptr)
+        {
+            return false;
+        }
+
+        const IndexHeader *header = reinterpret_cast<const IndexHeader *>(m_data);
+        qint64 size = qint64(sizeof(IndexHeader)) + qint64(header->nbRecords) * sizeof(IndexRecord) +
+                      header->namesSize;
+
+        if (memcmp(header->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+            header->nbRecords == 0 || size != m_file.size())
+        {
+            m_data = nullptr;
+            return false;
+        }
+
+        m_records = reinterpret_cast<const IndexRecord *>(m_data + sizeof(IndexHeader));
+        m_names = reinterpret_cast<const char *>(m_records + header->nbRecords);
+        m_nbRecords = header->nbRecords;
+        m_namesSize = header->namesSize;
+        return true;
+    }
+
+    quint32 size() const
+    {
+        return m_nbRecords;
+    }
+
+    const IndexRecord &record(quint32 i) const
+    {
+        return m_records[i];
+    }
+
+    QByteArray name(const IndexRecord &rec) const
+    {
+        if (quint64(rec.nameOffset) + rec.nameLength > m_namesSize)
+        {
+            return QByteArray();
+        }
+        return QByteArray::fromRawData(m_names + rec.nameOffset, rec.nameLength);
+    }
+
+    bool hasValidChildren(const IndexRecord &rec) const
+    {
+        return quint64(rec.firstChild) + rec.nbChildren <= m_nbRecords;
+    }
+
+private:
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    const IndexRecord *m_records = nullptr;
+    const char *m_names = nullptr;
+    quint32 m_nbRecords = 0;
+    quint32 m_namesSize = 0;
+};
+
+static void hashData(const QByteArray &data, quint8 *hash)
+{
+#ifdef USE_XXHASH
+    XXH128_canonical_t canonical;
+    XXH128_canonicalFromHash(&canonical, XXH3_128bits(data.constData(), data.size()));
+    memcpy(hash, canonical.digest, INDEX_HASH_SIZE);
+#else
+    QByteArray digest = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    memcpy(hash, digest.constData(), INDEX_HASH_SIZE);
+#endif
+}
+
+static qint64 mtimeNs(const struct stat &st)
+{
+    return qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+/*************************************************************
+ * Background refresh
+ *************************************************************/
+
+class BCompareIndexTask : public QRunnable
+{
+public:
+    explicit BCompareIndexTask(const QString &pathFolder) :
+        m_pathFolder(pathFolder)
+    {
+    }
+
+    void run() override
+    {
+        BCompareMerkleIndex &index = BCompareMerkleIndex::get();
+
+        if (!index.isFresh(m_pathFolder))
+        {
+            index.refresh(m_pathFolder);
+        }
+        index.refreshFinished(m_pathFolder);
+    }
+
+private:
+    QString m_pathFolder;
+};
+
+/*************************************************************
+ * Index
+ *************************************************************/
+
+BCompareMerkleIndex& BCompareMerkleIndex::get()
+{
+    static BCompareMerkleIndex m_index;
+    return m_index;
+}
+
+QString BCompareMerkleIndex::indexPath(const QString &pathFolder)
+{
+    QString canonical = QFileInfo(pathFolder).canonicalFilePath();
+    if (canonical.isEmpty())
+    {
+        return QString();
+    }
+
+    QByteArray key = QCryptographicHash::hash(QFile::encodeName(canonical),
+                                              QCryptographicHash::Sha1).toHex();
+
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+           QLatin1String("/bcompare-ext/") + QLatin1String(key) + QLatin1String(".idx");
+}
+
+bool BCompareMerkleIndex::compareIndexed(const QString &pathLeft, const QString &pathRight,
+                                         int &nbDiffering)
+{
+    IndexView left, right;
+
+    if (!left.open(indexPath(pathLeft)) || !right.open(indexPath(pathRight)))
+    {
+        return false;
+    }
+
+    const IndexRecord &rootLeft = left.record(0);
+    const IndexRecord &rootRight = right.record(0);
+
+    nbDiffering = 0;
+    if (memcmp(rootLeft.hash, rootRight.hash, INDEX_HASH_SIZE) == 0)
+    {
+        return true;
+    }
+
+    if (!left.hasValidChildren(rootLeft) || !right.hasValidChildren(rootRight))
+    {
+        return false;
+    }
+
+    /* The entries of a folder are sorted by name, count the ones which differ */
+    quint32 l = 0, r = 0;
+    while (l < rootLeft.nbChildren || r < rootRight.nbChildren)
+    {
+        const IndexRecord *recLeft = (l < rootLeft.nbChildren) ?
+                                     &left.record(rootLeft.firstChild + l) : nullptr;
+        const IndexRecord *recRight = (r < rootRight.nbChildren) ?
+                                      &right.record(rootRight.firstChild + r) : nullptr;
+        int order = (recLeft == nullptr) ? 1 : (recRight == nullptr) ? -1 :
+                    left.name(*recLeft).compare(right.name(*recRight));
+
+        if (order < 0)
+        {
+            ++l;
+            ++nbDiffering;
+            continue;
+        }
+        if (order > 0)
+        {
+            ++r;
+            ++nbDiffering;
+            continue;
+        }
+
+        if (recLeft->kind != recRight->kind ||
+            memcmp(recLeft->hash, recRight->hash, INDEX_HASH_SIZE) != 0)
+        {
+            ++nbDiffering;
+        }
+        ++l;
+        ++r;
+    }
+
+    return true;
+}
+
+/*
+ * An index written after the last change of the folder entries is kept for
+ * a minute, in case files changed deeper in the tree
+ */
+bool BCompareMerkleIndex::isFresh(const QString &pathFolder)
+{
+    QFileInfo index(indexPath(pathFolder));
+    if (!index.exists())
+    {
+        return false;
+    }
+
+    QDateTime indexed = index.lastModified();
+    return indexed > QFileInfo(pathFolder).lastModified() &&
+           indexed.msecsTo(QDateTime::currentDateTime()) < REFRESH_INTERVAL_MS;
+}
+
+bool BCompareMerkleIndex::refresh(const QString &pathFolder)
+{
+    QString pathIndex = indexPath(pathFolder);
+    if (pathIndex.isEmpty() || !QFileInfo(pathFolder).isDir())
+    {
+        return false;
+    }
+
+    /* Hashes of the previous index, still valid for the files which did not change */
+    IndexView previous;
+    QHash<QByteArray, const IndexRecord *> previousFiles;
+
+    if (previous.open(pathIndex))
+    {
+        QVector<QByteArray> paths(previous.size());
+        for (quint32 i = 0; i < previous.size(); ++i)
+        {
+            const IndexRecord &rec = previous.record(i);
+            if (rec.kind == INDEX_FILE)
+            {
+                previousFiles.insert(paths.at(i), &rec);
+            }
+            else if (rec.kind == INDEX_FOLDER && previous.hasValidChildren(rec))
+            {
+                for (quint32 c = rec.firstChild; c < rec.firstChild + rec.nbChildren; ++c)
+                {
+                    if (c > i)
+                    {
+                        paths[c] = paths.at(i) + '/' + previous.name(previous.record(c));
+                    }
+                }
+            }
+        }
+    }
+
+    QByteArray root = QFile::encodeName(pathFolder);
+    QVector<IndexRecord> records;
+    QVector<QByteArray> paths;
+    QByteArray names;
+
+    IndexRecord rootRecord = {};
+    rootRecord.kind = INDEX_FOLDER;
+    records.append(rootRecord);
+    paths.append(QByteArray());
+
+    /* The records themselves are the queue of the breadth first walk */
+    for (int i = 0; i < records.size(); ++i)
+    {
+        if (records.at(i).kind != INDEX_FOLDER)
+        {
+            continue;
+        }
+
+        DIR *dir = opendir((root + paths.at(i)).constData());
+        if (dir == nullptr)
+        {
+            continue;
+        }
+
+        QVector<QByteArray> entries;
+        struct dirent *ent;
+        while ((ent = readdir(dir)) != nullptr)
+        {
+            if (strcmp(ent->d_name, ".") != 0 && strcmp(ent->d_name, "..") != 0)
+            {
+                entries.append(QByteArray(ent->d_name));
+            }
+        }
+        std::sort(entries.begin(), entries.end());
+
+        records[i].firstChild = records.size();
+        for (const QByteArray &name : entries)
+        {
+            struct stat st;
+            if (fstatat(dirfd(dir), name.constData(), &st, AT_SYMLINK_NOFOLLOW) != 0)
+            {
+                continue;
+            }
+
+            IndexRecord rec = {};
+            if (S_ISDIR(st.st_mode))
+            {
+                rec.kind = INDEX_FOLDER;
+            }
+            else if (S_ISREG(st.st_mode))
+            {
+                rec.kind = INDEX_FILE;
+            }
+            else if (S_ISLNK(st.st_mode))
+            {
+                rec.kind = INDEX_LINK;
+            }
+            else
+            {
+                continue;
+            }
+
+            rec.ino = st.st_ino;
+            rec.size = st.st_size;
+            rec.mtimeNs = mtimeNs(st);
+            rec.nameOffset = names.size();
+            rec.nameLength = name.size();
+            names.append(name);
+
+            records.append(rec);
+            paths.append(paths.at(i) + '/' + name);
+            records[i].nbChildren++;
+        }
+        closedir(dir);
+
+        if (records.size() > MAX_INDEX_RECORDS)
+        {
+            return false;
+        }
+    }
+
+    /* Children come after their folder, so hashing backwards sees them first */
+    for (int i = records.size() - 1; i >= 0; --i)
+    {
+        IndexRecord &rec = records[i];
+        QByteArray data;
+
+        if (rec.kind == INDEX_FILE)
+        {
+            const IndexRecord *old = previousFiles.value(paths.at(i), nullptr);
+            if (old != nullptr && old->ino == rec.ino && old->size == rec.size &&
+                old->mtimeNs == rec.mtimeNs)
+            {
+                memcpy(rec.hash, old->hash, INDEX_HASH_SIZE);
+                continue;
+            }
+
+            struct stat st;
+            if (stat((root + paths.at(i)).constData(), &st) != 0)
+            {
+                continue;
+            }
+
+            BCompareHashCache::FileId id{ quint64(st.st_dev), quint64(st.st_ino), mtimeNs(st),
+                                         qint64(st.st_size) };
+            QByteArray digest = BCompareHashCache::get().fileHash(
+                QFile::decodeName(root + paths.at(i)), id);
+            memcpy(rec.hash, digest.constData(), qMin(int(digest.size()), INDEX_HASH_SIZE));
+            continue;
+        }
+
+        if (rec.kind == INDEX_LINK)
+        {
+            char target[PATH_MAX];
+            ssize_t len = readlink((root + paths.at(i)).constData(), target, sizeof(target));
+            data = QByteArray(target, qMax<ssize_t>(len, 0));
+        }
+        else
+        {
+            for (quint32 c = rec.firstChild; c < rec.firstChild + rec.nbChildren; ++c)
+            {
+                const IndexRecord &child = records.at(c);
+                data.append(names.constData() + child.nameOffset, child.nameLength);
+                data.append('\0');
+                data.append(char(child.kind));
+                data.append(reinterpret_cast<const char *>(child.hash), INDEX_HASH_SIZE);
+            }
+        }
+        hashData(data, rec.hash);
+    }
+
+    QDir().mkpath(QFileInfo(pathIndex).absolutePath());
+
+    IndexHeader header;
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.nbRecords = records.size();
+    header.namesSize = names.size();
+
+    /* Readers map the index, it is replaced atomically */
+    QSaveFile file(pathIndex);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(records.constData()), records.size() * sizeof(IndexRecord));
+    file.write(names);
+
+    return file.commit();
+}
+
+void BCompareMerkleIndex::refreshAsync(const QString &pathFolder)
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_refreshing.contains(pathFolder))
+        {
+            return;
+        }
+        m_refreshing.insert(pathFolder);
+    }
+
+    QThreadPool::globalInstance()->start(new BCompareIndexTask(pathFolder));
+}
+
+void BCompareMerkleIndex::refreshFinished(const QString &pathFolder)
+{
+    QMutexLocker lock(&m_mutex);
+    m_refreshing.remove(pathFolder);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_INDEX_H
+#define BCOMPARE_INDEX_H
+
+#include <QString>
+#include <QSet>
+#include <QMutex>
+
+/**
+ * Persistent Merkle index of folders, stored under $XDG_CACHE_HOME/bcompare-ext.
+ * Each file is hashed once per (inode, size, mtime), each folder hash is built
+ * from the names, types and hashes of its entries, so comparing two indexed
+ * folders only reads a few records of the mapped index files.
+ */
+class BCompareMerkleIndex
+{
+public:
+    /** Get a reference to the global folder index */
+    static BCompareMerkleIndex& get();
+
+    /**
+     * Compares the indexes last built for both folders, without reading them.
+     * Returns false if one of them was never indexed, otherwise nbDiffering is
+     * the number of top level entries which differ, 0 if the folders are identical.
+     */
+    bool compareIndexed(const QString &pathLeft, const QString &pathRight, int &nbDiffering);
+
+    /** Rebuilds the index of pathFolder, hashing only the files which changed */
+    bool refresh(const QString &pathFolder);
+
+    /**
+     * True if the index of pathFolder was written after the last change of its
+     * entries, less than a minute ago
+     */
+    bool isFresh(const QString &pathFolder);
+
+    /** Calls refresh() in the background, unless the index is fresh or being refreshed */
+    void refreshAsync(const QString &pathFolder);
+
+private:
+    friend class BCompareIndexTask;
+
+    BCompareMerkleIndex() = default;
+
+    static QString indexPath(const QString &pathFolder);
+    void refreshFinished(const QString &pathFolder);
+
+    /** Mutex protecting the members below */
+    QMutex m_mutex;
+
+    /** Folders being indexed */
+    QSet<QString> m_refreshing;
+};
+
+#endif // BCOMPARE_INDEX_H
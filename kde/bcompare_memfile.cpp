@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QList>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include "bcompare_memfile.h"
+
+int BCompareMemFile::create(const QString &name)
+{
+    return memfd_create(name.toUtf8().constData(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+}
+
+bool BCompareMemFile::write(int fd, const char *data, qint64 size)
+{
+    while (size > 0)
+    {
+        ssize_t r = ::write(fd, data, size);
+        if (r < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += r;
+        size -= r;
+    }
+    return true;
+}
+
+QString BCompareMemFile::publish(int fd, QList<int> &fds)
+{
+    if (fd < 0)
+    {
+        return QString();
+    }
+
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0)
+    {
+        close(fd);
+        return QString();
+    }
+
+    fds.append(fd);
+
+    return QString(QLatin1String("/proc/%1/fd/%2")).arg(getpid()).arg(fd);
+}
+
+QString BCompareMemFile::fromData(const QString &name, const char *data, qint64 size,
+                                  QList<int> &fds)
+{
+    int fd = create(name);
+    if (fd < 0)
+    {
+        return QString();
+    }
+
+    if (!write(fd, data, size))
+    {
+        close(fd);
+        return QString();
+    }
+
+    return publish(fd, fds);
+}
+
+void BCompareMemFile::release(const QList<int> &fds)
+{
+    for (int fd : fds)
+    {
+        close(fd);
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_MEMFILE_H
+#define BCOMPARE_MEMFILE_H
+
+#include <QString>
+#include <QList>
+
+/**
+ * Anonymous, sealed, in-memory files that Beyond Compare can open through
+ * /proc/<pid>/fd/<fd>, so that generated content never touches the disk
+ */
+class BCompareMemFile
+{
+public:
+    /** Creates an empty in-memory file, returns -1 on failure */
+    static int create(const QString &name);
+
+    /** Appends data to a file returned by create() */
+    static bool write(int fd, const char *data, qint64 size);
+
+    /**
+     * Seals the file against any modification and returns the path another
+     * process can open. The descriptor is added to fds, the files of a single
+     * launch, which must stay open until the process given their paths exits,
+     * or fails to start, then be closed by release().
+     * On failure the descriptor is closed and an empty string is returned.
+     */
+    static QString publish(int fd, QList<int> &fds);
+
+    /** Closes the files published for a launch */
+    static void release(const QList<int> &fds);
+
+    /** Shortcut for create(), write() and publish() */
+    static QString fromData(const QString &name, const char *data, qint64 size, QList<int> &fds);
+};
+
+#endif // BCOMPARE_MEMFILE_H
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bcompare_menus.h"
+#include "bcompare_menus_baseline.h"
+
+typedef BCompareMenuTable T;
+
+/** Configured menus, by their digit in the base 3 index of the configuration */
+enum Config
+{
+    CFG_COMPARE = 0,
+    CFG_COMPARE_USING,
+    CFG_MERGE,
+    CFG_SYNC,
+    CFG_EDIT,
+    NB_CONFIGS
+};
+
+/** Classes of selections, the left and center paths being the saved ones */
+enum Selection
+{
+    SEL_ONE = 0,
+    SEL_ONE_CENTER,
+    SEL_ONE_LEFT,
+    SEL_ONE_LEFT_CENTER,
+    SEL_TWO,
+    SEL_TWO_CENTER,
+    SEL_THREE,
+    SEL_MANY,
+    NB_SELECTIONS
+};
+
+static const quint8 SELS_ONE = (1 << SEL_ONE) | (1 << SEL_ONE_CENTER) |
+                               (1 << SEL_ONE_LEFT) | (1 << SEL_ONE_LEFT_CENTER);
+static const quint8 SELS_ONE_LEFT = (1 << SEL_ONE_LEFT) | (1 << SEL_ONE_LEFT_CENTER);
+static const quint8 SELS_TWO = (1 << SEL_TWO) | (1 << SEL_TWO_CENTER);
+
+static const quint8 TYPE_FILE = 1;
+static const quint8 TYPE_FOLDER = 2;
+static const quint8 TYPE_ANY = TYPE_FILE | TYPE_FOLDER;
+
+/** Number of configurations, each menu being none, main or submenu */
+static const int NB_CONFIG_VALUES = 3 * 3 * 3 * 3 * 3;
+
+static const int NB_ROWS = NB_CONFIG_VALUES * 2 * 2 * NB_SELECTIONS;
+
+/** Items shown when the config menu is the one being built */
+struct Rule
+{
+    Config config;
+    quint8 selections;
+    quint8 types;
+    quint32 bits;
+};
+
+static constexpr Rule s_rules[] = {
+    { CFG_MERGE, SELS_ONE, TYPE_FILE, T::ITEM_RESOLVE_CONFLICT },
+    { CFG_MERGE, 1 << SEL_ONE_LEFT_CENTER, TYPE_ANY,
+      T::ITEM_MERGE | T::LABEL_MERGE_LEFT | T::LABEL_MERGE_CENTER },
+    { CFG_MERGE, 1 << SEL_ONE_LEFT, TYPE_ANY, T::ITEM_MERGE | T::LABEL_MERGE_LEFT },
+    { CFG_MERGE, 1 << SEL_TWO_CENTER, TYPE_ANY, T::ITEM_MERGE | T::LABEL_MERGE_CENTER },
+    { CFG_MERGE, 1 << SEL_TWO, TYPE_ANY, T::ITEM_MERGE },
+    { CFG_MERGE, 1 << SEL_THREE, TYPE_ANY, T::ITEM_MERGE | T::LABEL_MERGE_THREE },
+    { CFG_MERGE, SELS_ONE, TYPE_ANY, T::ITEM_SELECT_CENTER },
+    { CFG_COMPARE, SELS_ONE_LEFT, TYPE_ANY, T::ITEM_COMPARE | T::LABEL_TO_LEFT },
+    { CFG_COMPARE, SELS_TWO, TYPE_ANY, T::ITEM_COMPARE },
+    { CFG_COMPARE, SELS_ONE, TYPE_FILE,
+      T::ITEM_COMPARE_HEAD | T::ITEM_COMPARE_SNAPSHOT | T::ITEM_COMPARE_CLIPBOARD },
+    { CFG_COMPARE, (1 << SEL_ONE) | (1 << SEL_ONE_CENTER), TYPE_FILE, T::ITEM_COMPARE_SIBLING },
+    { CFG_COMPARE, 1 << SEL_MANY, TYPE_ANY, T::ITEM_GROUP_IDENTICAL },
+    { CFG_COMPARE_USING, SELS_ONE_LEFT, TYPE_FILE, T::ITEM_COMPARE_USING | T::LABEL_TO_LEFT },
+    { CFG_COMPARE_USING, SELS_TWO, TYPE_FILE, T::ITEM_COMPARE_USING },
+    { CFG_SYNC, SELS_ONE_LEFT, TYPE_FOLDER,
+      T::ITEM_SYNC | T::ITEM_SYNC_BACKGROUND | T::LABEL_TO_LEFT },
+    { CFG_SYNC, SELS_TWO, TYPE_FOLDER, T::ITEM_SYNC | T::ITEM_SYNC_BACKGROUND },
+    { CFG_SYNC, SELS_ONE_LEFT | SELS_TWO, TYPE_FOLDER,
+      T::ITEM_QUICK_VERIFY | T::ITEM_DIFF_REPORT | T::ITEM_SHOW_UNCHANGED },
+    { CFG_EDIT, SELS_ONE, TYPE_FILE, T::ITEM_EDIT },
+};
+
+static constexpr int configValue(int cfgIndex, int config)
+{
+    for (int i = 0; i < config; ++i)
+    {
+        cfgIndex /= 3;
+    }
+    return cfgIndex % 3;
+}
+
+static constexpr Selection selection(int nbSelected, bool hasLeft, bool hasCenter)
+{
+    return (nbSelected == 1) ? Selection(SEL_ONE + (hasLeft ? 2 : 0) + (hasCenter ? 1 : 0)) :
+           (nbSelected == 2) ? (hasCenter ? SEL_TWO_CENTER : SEL_TWO) :
+           (nbSelected == 3) ? SEL_THREE : SEL_MANY;
+}
+
+static constexpr int rowIndex(int cfgIndex, int menuType, bool isDir, int sel)
+{
+    return ((cfgIndex * 2 + (menuType - BCompareConfig::MENU_MAIN)) * 2 + (isDir ? 1 : 0)) *
+           NB_SELECTIONS + sel;
+}
+
+/** "Select Left" is in the main menu as soon as one of its next actions is */
+static constexpr quint32 selectLeftBits(int cfgIndex, int menuType, bool isDir)
+{
+    int compare = configValue(cfgIndex, CFG_COMPARE);
+    int compareUsing = configValue(cfgIndex, CFG_COMPARE_USING);
+    int merge = configValue(cfgIndex, CFG_MERGE);
+    int sync = configValue(cfgIndex, CFG_SYNC);
+    bool anyMain = compare == BCompareConfig::MENU_MAIN || compareUsing == BCompareConfig::MENU_MAIN ||
+                   merge == BCompareConfig::MENU_MAIN || sync == BCompareConfig::MENU_MAIN;
+    quint32 bits = 0;
+
+    if ((anyMain ? BCompareConfig::MENU_MAIN : BCompareConfig::MENU_SUBMENU) != menuType)
+    {
+        return 0;
+    }
+    if (compare != BCompareConfig::MENU_NONE || (compareUsing != BCompareConfig::MENU_NONE && !isDir))
+    {
+        bits |= T::LABEL_NEXT_COMPARE;
+    }
+    if (merge != BCompareConfig::MENU_NONE)
+    {
+        bits |= T::LABEL_NEXT_MERGE;
+    }
+    if (sync != BCompareConfig::MENU_NONE && isDir)
+    {
+        bits |= T::LABEL_NEXT_SYNC;
+    }
+    return (bits != 0) ? (bits | T::ITEM_SELECT_LEFT) : 0;
+}
+
+struct Rows
+{
+    quint32 row[NB_ROWS];
+};
+
+static constexpr Rows buildRows()
+{
+    Rows rows = {};
+
+    for (int menuType = BCompareConfig::MENU_MAIN; menuType <= BCompareConfig::MENU_SUBMENU; ++menuType)
+    {
+        for (int isDir = 0; isDir < 2; ++isDir)
+        {
+            for (int sel = 0; sel < NB_SELECTIONS; ++sel)
+            {
+                /* Items of each configured menu, when it is the one being built */
+                quint32 byConfig[NB_CONFIGS] = {};
+
+                for (const Rule &rule : s_rules)
+                {
+                    if ((rule.selections & (1 << sel)) && (rule.types & (isDir ? TYPE_FOLDER : TYPE_FILE)))
+                    {
+                        byConfig[rule.config] |= rule.bits;
+                    }
+                }
+
+                for (int cfgIndex = 0; cfgIndex < NB_CONFIG_VALUES; ++cfgIndex)
+                {
+                    quint32 bits = (sel <= SEL_ONE_LEFT_CENTER) ? selectLeftBits(cfgIndex, menuType, isDir) : 0;
+                    int digits = cfgIndex;
+
+                    for (int config = 0; config < NB_CONFIGS; ++config, digits /= 3)
+                    {
+                        if (digits % 3 == menuType)
+                        {
+                            bits |= byConfig[config];
+                        }
+                    }
+                    rows.row[rowIndex(cfgIndex, menuType, isDir, sel)] = bits;
+                }
+            }
+        }
+    }
+    return rows;
+}
+
+static constexpr Rows s_rows = buildRows();
+
+/*************************************************************
+ * Verification of the table
+ *************************************************************/
+
+/** Bits the menus had before the table, the items added since are not checked */
+static const quint32 BASELINE_BITS =
+    T::ITEM_MERGE | T::ITEM_COMPARE | T::ITEM_COMPARE_USING | T::ITEM_SYNC |
+    T::ITEM_SELECT_LEFT | T::ITEM_SELECT_CENTER | T::ITEM_EDIT |
+    T::LABEL_TO_LEFT | T::LABEL_NEXT_COMPARE | T::LABEL_NEXT_MERGE | T::LABEL_NEXT_SYNC |
+    T::LABEL_MERGE_LEFT | T::LABEL_MERGE_CENTER | T::LABEL_MERGE_THREE;
+
+static_assert(sizeof(s_baselineRows) / sizeof(s_baselineRows[0]) == NB_ROWS,
+              "Recorded menus do not cover the table");
+
+/** Checks every row against the menus recorded from the code the table replaced */
+static constexpr bool matchesBaseline(int first, int last)
+{
+    for (int index = first; index < last; ++index)
+    {
+        if ((s_rows.row[index] & BASELINE_BITS) != s_baselineRows[index])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(matchesBaseline(0, NB_ROWS / 2), "Menu table differs from the recorded menus");
+static_assert(matchesBaseline(NB_ROWS / 2, NB_ROWS), "Menu table differs from the recorded menus");
+
+/*************************************************************
+ * Lookup
+ *************************************************************/
+
+quint32 BCompareMenuTable::lookup(const BCompareConfig &config, BCompareConfig::MenuTypes menuType,
+                                  bool isDir, int nbSelected, bool hasLeft, bool hasCenter)
+{
+    int cfgIndex = config.menuCompare() + 3 * (config.menuCompareUsing() + 3 * (config.menuMerge() +
+                   3 * (config.menuSync() + 3 * config.menuEdit())));
+
+    return s_rows.row[rowIndex(cfgIndex, menuType, isDir, selection(nbSelected, hasLeft, hasCenter))];
+}
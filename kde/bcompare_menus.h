@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_MENUS_H
+#define BCOMPARE_MENUS_H
+
+#include <QtGlobal>
+#include "bcompare_config.h"
+
+/**
+ * Which menu items are shown, and which of their labels, only depends on the
+ * configured menus, on the number and type of the selected items, and on the
+ * saved left and center paths. All the answers are computed at compile time,
+ * so building a menu only reads one row of this table.
+ */
+class BCompareMenuTable
+{
+public:
+    typedef enum : quint32 {
+        ITEM_RESOLVE_CONFLICT   = 1 << 0,
+        ITEM_MERGE              = 1 << 1,
+        ITEM_COMPARE            = 1 << 2,
+        ITEM_COMPARE_USING      = 1 << 3,
+        ITEM_COMPARE_HEAD       = 1 << 4,
+        ITEM_SYNC               = 1 << 5,
+        ITEM_SYNC_BACKGROUND    = 1 << 6,
+        ITEM_QUICK_VERIFY       = 1 << 7,
+        ITEM_DIFF_REPORT        = 1 << 8,
+        ITEM_SHOW_UNCHANGED     = 1 << 9,
+        ITEM_SELECT_LEFT        = 1 << 10,
+        ITEM_SELECT_CENTER      = 1 << 11,
+        ITEM_EDIT               = 1 << 12,
+        ITEM_GROUP_IDENTICAL    = 1 << 13,
+        ITEM_COMPARE_SNAPSHOT   = 1 << 14,
+        ITEM_COMPARE_SIBLING    = 1 << 15,
+        ITEM_COMPARE_CLIPBOARD  = 1 << 16,
+
+        /* Compare and sync labels name the saved left item */
+        LABEL_TO_LEFT           = 1 << 17,
+
+        /* Actions listed by the "Select Left" label */
+        LABEL_NEXT_COMPARE      = 1 << 18,
+        LABEL_NEXT_MERGE        = 1 << 19,
+        LABEL_NEXT_SYNC         = 1 << 20,
+
+        /* Merge labels, none of them for two selected files */
+        LABEL_MERGE_LEFT        = 1 << 21,
+        LABEL_MERGE_CENTER      = 1 << 22,
+        LABEL_MERGE_THREE       = 1 << 23
+    } Bits;
+
+    /** Items and labels of the menuType menu, a combination of Bits */
+    static quint32 lookup(const BCompareConfig &config, BCompareConfig::MenuTypes menuType,
+                          bool isDir, int nbSelected, bool hasLeft, bool hasCenter);
+};
+
+#endif // BCOMPARE_MENUS_H
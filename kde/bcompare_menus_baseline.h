@@ -0,0 +1,1011 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Generated file, do not edit.
+ *
+ * Items and labels the actions() function of the first KDE plugin showed,
+ * before the menus were built from BCompareMenuTable. They were recorded by
+ * running that code unchanged for every configuration, menu type, item type
+ * and selection, in the order of the rows of the table. Only the bits of
+ * BASELINE_BITS are known here, the items added later were not in the menus.
+ */
+
+#ifndef BCOMPARE_MENUS_BASELINE_H
+#define BCOMPARE_MENUS_BASELINE_H
+
+static constexpr quint32 s_baselineRows[] = {
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x040400, 0x040400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x02000c, 0x02000c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x080400, 0x080400, 0x080400, 0x080400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e040c, 0x0e040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0c0400, 0x0c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080a, 0x62080a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x040400, 0x040400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160420, 0x160420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160420, 0x160420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x040400, 0x040400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x040400, 0x040400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160420, 0x160420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x02000c, 0x02000c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c22, 0x7e0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c22, 0x7e0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c22, 0x7e0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x02000c, 0x02000c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x080400, 0x080400, 0x080400, 0x080400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x1a0420, 0x1a0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0424, 0x1e0424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0c0400, 0x0c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0420, 0x1e0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x1a0420, 0x1a0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e040c, 0x0e040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0424, 0x1e0424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0420, 0x1e0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0c0400, 0x0c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x1a0420, 0x1a0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080a, 0x62080a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0424, 0x1e0424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080a, 0x62080a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0c0400, 0x0c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0420, 0x1e0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080e, 0x62080e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160404, 0x160404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x100400, 0x100400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160404, 0x160404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x140400, 0x140400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160404, 0x160404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x380c02, 0x780c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c06, 0x7e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3c0c02, 0x7c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x380c02, 0x780c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c06, 0x7e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3c0c02, 0x7c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x380c02, 0x780c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c06, 0x7e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3c0c02, 0x7c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x02000c, 0x02000c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0404, 0x1e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x180400, 0x180400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e040c, 0x0e040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0404, 0x1e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1c0400, 0x1c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220826, 0x620826, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0404, 0x1e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080a, 0x62080a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061404, 0x061404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061408, 0x061408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x06140c, 0x06140c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061408, 0x061408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x040400, 0x040400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061404, 0x061404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x081c00, 0x081c00, 0x281c02, 0x681c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c06, 0x6e1c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2c1c02, 0x6c1c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0a, 0x6e1c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0e, 0x6e1c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0a, 0x6e1c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2c1c02, 0x6c1c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c06, 0x6e1c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2c1c02, 0x6c1c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x02000c, 0x02000c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1404, 0x0e1404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1408, 0x0e1408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x080400, 0x080400, 0x080400, 0x080400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e140c, 0x0e140c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1408, 0x0e1408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0c0400, 0x0c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1404, 0x0e1404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080a, 0x62080a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061404, 0x061404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x041400, 0x041400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160420, 0x160420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061408, 0x061408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x06140c, 0x06140c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061408, 0x061408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160420, 0x160420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x041400, 0x041400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061404, 0x061404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x041400, 0x041400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160420, 0x160420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x02000c, 0x02000c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x081c00, 0x081c00, 0x281c02, 0x681c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c06, 0x6e1c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2c1c02, 0x6c1c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c22, 0x7e0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0a, 0x6e1c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0e, 0x6e1c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0a, 0x6e1c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c22, 0x7e0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2c1c02, 0x6c1c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c06, 0x6e1c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2c1c02, 0x6c1c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c22, 0x7e0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x02000c, 0x02000c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x081400, 0x081400, 0x081400, 0x081400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x1a0420, 0x1a0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1404, 0x0e1404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0424, 0x1e0424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0c1400, 0x0c1400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0420, 0x1e0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1408, 0x0e1408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x1a0420, 0x1a0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e140c, 0x0e140c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0424, 0x1e0424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1408, 0x0e1408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0420, 0x1e0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0c1400, 0x0c1400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x1a0420, 0x1a0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080a, 0x62080a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1404, 0x0e1404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0424, 0x1e0424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080a, 0x62080a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0c1400, 0x0c1400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0420, 0x1e0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080e, 0x62080e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061404, 0x061404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160404, 0x160404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061408, 0x061408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x100400, 0x100400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x06140c, 0x06140c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160404, 0x160404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061408, 0x061408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x140400, 0x140400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061404, 0x061404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160404, 0x160404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x081c00, 0x081c00, 0x281c02, 0x681c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x380c02, 0x780c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c06, 0x6e1c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c06, 0x7e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2c1c02, 0x6c1c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3c0c02, 0x7c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0a, 0x6e1c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x380c02, 0x780c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0e, 0x6e1c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c06, 0x7e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0a, 0x6e1c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3c0c02, 0x7c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2c1c02, 0x6c1c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x380c02, 0x780c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c06, 0x6e1c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c06, 0x7e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x020008, 0x020008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2c1c02, 0x6c1c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3c0c02, 0x7c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x02000c, 0x02000c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1404, 0x0e1404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0404, 0x1e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1408, 0x0e1408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x180400, 0x180400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e140c, 0x0e140c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0404, 0x1e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1408, 0x0e1408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1c0400, 0x1c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220826, 0x620826, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c1400, 0x0c1400, 0x0e1404, 0x0e1404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0404, 0x1e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000800, 0x000800, 0x22080a, 0x62080a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061404, 0x061404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x040400, 0x040400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061408, 0x061408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x06140c, 0x06140c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x02100c, 0x02100c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x081c00, 0x081c00, 0x281c02, 0x681c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c06, 0x6e1c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x080400, 0x080400, 0x080400, 0x080400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e040c, 0x0e040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0c0400, 0x0c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x221806, 0x621806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0a, 0x6e1c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x22180a, 0x62180a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0e, 0x6e1c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x040400, 0x040400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160420, 0x160420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160420, 0x160420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x040400, 0x040400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x040400, 0x040400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160420, 0x160420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x02100c, 0x02100c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c22, 0x7e0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c22, 0x7e0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c22, 0x7e0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x02100c, 0x02100c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020004, 0x020004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x080400, 0x080400, 0x080400, 0x080400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x1a0420, 0x1a0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0424, 0x1e0424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0c0400, 0x0c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0420, 0x1e0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x221806, 0x621806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x1a0420, 0x1a0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e040c, 0x0e040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0424, 0x1e0424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0420, 0x1e0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x221806, 0x621806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0c0400, 0x0c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x1a0420, 0x1a0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x22180a, 0x62180a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0424, 0x1e0424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x22180a, 0x62180a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x200802, 0x600802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0c0400, 0x0c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0420, 0x1e0420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x22180e, 0x62180e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220806, 0x620806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160404, 0x160404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061404, 0x061404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x100400, 0x100400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x06040c, 0x06040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160404, 0x160404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060408, 0x060408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x140400, 0x140400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x061408, 0x061408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x100400, 0x100400, 0x120420, 0x120420, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x040400, 0x040400, 0x060404, 0x060404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160404, 0x160404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x041400, 0x041400, 0x06140c, 0x06140c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x140400, 0x140400, 0x160424, 0x160424, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x080c00, 0x080c00, 0x280c02, 0x680c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x380c02, 0x780c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c06, 0x7e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3c0c02, 0x7c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x380c02, 0x780c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0e, 0x6e0c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c06, 0x7e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x001000, 0x001000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c0a, 0x6e0c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3c0c02, 0x7c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021004, 0x021004, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x380c02, 0x780c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2e0c06, 0x6e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c06, 0x7e0c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x021008, 0x021008, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020020, 0x020020, 0x000020, 0x000020, 0x000000, 0x000000,
+    0x0c0c00, 0x0c0c00, 0x2c0c02, 0x6c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3c0c02, 0x7c0c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x001000, 0x001000, 0x02100c, 0x02100c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x020024, 0x020024, 0x000024, 0x000024, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x081c00, 0x081c00, 0x281c02, 0x681c02, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0404, 0x1e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c06, 0x6e1c06, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x180400, 0x180400, 0x180400, 0x180400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e040c, 0x0e040c, 0x00000c, 0x00000c, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0404, 0x1e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x201802, 0x601802, 0x000002, 0x400002, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0408, 0x0e0408, 0x000008, 0x000008, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1c0400, 0x1c0400, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x221806, 0x621806, 0x000006, 0x400006, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220826, 0x620826, 0x000026, 0x400026, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0a, 0x6e1c0a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x180c00, 0x180c00, 0x3a0c22, 0x7a0c22, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x0c0400, 0x0c0400, 0x0e0404, 0x0e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x1c0400, 0x1c0400, 0x1e0404, 0x1e0404, 0x000004, 0x000004, 0x000000, 0x000000,
+    0x001800, 0x001800, 0x22180a, 0x62180a, 0x00000a, 0x40000a, 0x800002, 0x000000,
+    0x000800, 0x000800, 0x220822, 0x620822, 0x000022, 0x400022, 0x800002, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+    0x0c1c00, 0x0c1c00, 0x2e1c0e, 0x6e1c0e, 0x00000e, 0x40000e, 0x800002, 0x000000,
+    0x1c0c00, 0x1c0c00, 0x3e0c26, 0x7e0c26, 0x000026, 0x400026, 0x800002, 0x000000
+};
+
+#endif // BCOMPARE_MENUS_BASELINE_H
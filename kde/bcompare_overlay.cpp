@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QFileInfo>
+#include <QDir>
+#include <QPointer>
+#include <QMutex>
+#include <QFile>
+#include <KPluginFactory>
+#include <atomic>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "bcompare_overlay.h"
+#include "bcompare_config.h"
+#include "bcompare_hash.h"
+#include "bcompare_index.h"
+
+/** Items compared by each task, their emblems are published together */
+static const int OVERLAY_BATCH_SIZE = 64;
+
+/** Files larger than this are not hashed, a different modification time is enough */
+static const qint64 MAX_OVERLAY_HASH_SIZE = 64LL * 1024 * 1024;
+
+/** Bound of the browsed folders watched, they are all forgotten when reached */
+static const int MAX_WATCHED_FOLDERS = 64;
+
+/** Bound of the cache, it is simply emptied when reached */
+static const int MAX_CACHED_OVERLAYS = 100000;
+
+static const uint32_t WATCH_EVENTS = IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE |
+                                     IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+typedef enum {
+    OVERLAY_SAME = 0,
+    OVERLAY_MISSING,
+    OVERLAY_DIFFERS
+} OverlayState;
+
+struct BCompareOverlayBatch
+{
+    std::atomic<bool> cancelled{false};
+
+    QPointer<BCompareOverlay> overlay;
+    QString pathLeftFolder;
+    QList<QPair<QString, QString> > items;
+};
+
+/** State of each pair of files (raw FileId bytes of both) */
+static QMutex s_cacheMutex;
+static QHash<QByteArray, int> s_cache;
+
+/*************************************************************
+ * Comparison
+ *************************************************************/
+
+static OverlayState compareFiles(const QString &pathItem, const QString &pathLeftItem,
+                                 const std::atomic<bool> *cancelled)
+{
+    BCompareHashCache::FileId id, leftId;
+
+    if (!BCompareHashCache::fileId(pathItem, id) || !BCompareHashCache::fileId(pathLeftItem, leftId))
+    {
+        return OVERLAY_SAME;
+    }
+    if (id.size != leftId.size)
+    {
+        return OVERLAY_DIFFERS;
+    }
+    if (id.dev == leftId.dev && id.ino == leftId.ino)
+    {
+        return OVERLAY_SAME;
+    }
+
+    QByteArray key = QByteArray(reinterpret_cast<const char *>(&id), sizeof(id)) +
+                     QByteArray(reinterpret_cast<const char *>(&leftId), sizeof(leftId));
+    {
+        QMutexLocker lock(&s_cacheMutex);
+        auto it = s_cache.constFind(key);
+        if (it != s_cache.constEnd())
+        {
+            return static_cast<OverlayState>(it.value());
+        }
+    }
+
+    OverlayState state;
+    if (id.size > MAX_OVERLAY_HASH_SIZE)
+    {
+        state = (id.mtimeNs == leftId.mtimeNs) ? OVERLAY_SAME : OVERLAY_DIFFERS;
+    }
+    else
+    {
+        QByteArray hash = BCompareHashCache::get().fileHash(pathItem, id, cancelled);
+        QByteArray leftHash = BCompareHashCache::get().fileHash(pathLeftItem, leftId, cancelled);
+        if (hash.isEmpty() || leftHash.isEmpty())
+        {
+            return OVERLAY_SAME;
+        }
+        state = (hash == leftHash) ? OVERLAY_SAME : OVERLAY_DIFFERS;
+    }
+
+    QMutexLocker lock(&s_cacheMutex);
+    if (s_cache.size() >= MAX_CACHED_OVERLAYS)
+    {
+        s_cache.clear();
+    }
+    s_cache.insert(key, state);
+    return state;
+}
+
+static OverlayState compareItem(const QString &pathItem, const QString &pathLeftItem,
+                                const std::atomic<bool> *cancelled)
+{
+    struct stat st, leftSt;
+
+    if (stat(QFile::encodeName(pathItem).constData(), &st) != 0)
+    {
+        return OVERLAY_SAME;
+    }
+    if (stat(QFile::encodeName(pathLeftItem).constData(), &leftSt) != 0)
+    {
+        return OVERLAY_MISSING;
+    }
+    if (S_ISDIR(st.st_mode) != S_ISDIR(leftSt.st_mode))
+    {
+        return OVERLAY_DIFFERS;
+    }
+
+    /* Folders are only compared from their indexes, never walked here */
+    if (S_ISDIR(st.st_mode))
+    {
+        int nbDiffering = 0;
+        bool indexed = BCompareMerkleIndex::get().compareIndexed(pathItem, pathLeftItem, nbDiffering);
+        return (indexed && nbDiffering > 0) ? OVERLAY_DIFFERS : OVERLAY_SAME;
+    }
+
+    return compareFiles(pathItem, pathLeftItem, cancelled);
+}
+
+class BCompareOverlayTask : public QRunnable
+{
+public:
+    explicit BCompareOverlayTask(const std::shared_ptr<BCompareOverlayBatch> &batch) :
+        m_batch(batch)
+    {
+    }
+
+    void run() override
+    {
+        QVector<int> states;
+
+        for (const auto &item : m_batch->items)
+        {
+            if (m_batch->cancelled.load())
+            {
+                return;
+            }
+
+            QString pathItem = item.first + QLatin1Char('/') + item.second;
+            QString pathLeftItem = m_batch->pathLeftFolder + QLatin1Char('/') + item.second;
+            states.append(compareItem(pathItem, pathLeftItem, &m_batch->cancelled));
+        }
+
+        std::shared_ptr<BCompareOverlayBatch> batch = m_batch;
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [batch, states]() {
+            if (!batch->cancelled.load() && !batch->overlay.isNull())
+            {
+                batch->overlay->batchFinished(batch->items, states);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    std::shared_ptr<BCompareOverlayBatch> m_batch;
+};
+
+static QStringList overlaysOfState(int state)
+{
+    if (state == OVERLAY_MISSING)
+    {
+        return QStringList{ QLatin1String("vcs-added") };
+    }
+    if (state == OVERLAY_DIFFERS)
+    {
+        return QStringList{ QLatin1String("vcs-locally-modified") };
+    }
+    return QStringList();
+}
+
+/*************************************************************
+ * Plugin
+ *************************************************************/
+
+BCompareOverlay::BCompareOverlay(QObject *pParent, const QVariantList &args) :
+    KOverlayIconPlugin(pParent),
+    m_inotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)),
+    m_notifier(nullptr),
+    m_storageWatch(-1),
+    m_leftWatch(-1)
+{
+    Q_UNUSED(args);
+
+    if (m_inotifyFd >= 0)
+    {
+        m_notifier = new QSocketNotifier(m_inotifyFd, QSocketNotifier::Read, this);
+        connect(m_notifier, &QSocketNotifier::activated, this, &BCompareOverlay::readEvents);
+
+    }
+
+    /* The folder is watched even before a first selection is saved to it */
+    if (m_inotifyFd >= 0 && !BCompareConfig::get().leftFileSavePath().isEmpty())
+    {
+        QFileInfo storage(BCompareConfig::get().leftFileSavePath());
+        QDir().mkpath(storage.absolutePath());
+        m_storageWatch = watch(storage.absolutePath());
+    }
+
+    reloadLeftFolder();
+}
+
+BCompareOverlay::~BCompareOverlay()
+{
+    if (m_batch)
+    {
+        m_batch->cancelled.store(true);
+    }
+    if (m_inotifyFd >= 0)
+    {
+        close(m_inotifyFd);
+    }
+}
+
+QStringList BCompareOverlay::getOverlays(const QUrl &item)
+{
+    if (m_pathLeftFolder.isEmpty() || !item.isLocalFile())
+    {
+        return QStringList();
+    }
+
+    QString pathItem = item.adjusted(QUrl::StripTrailingSlash).toLocalFile();
+    if (pathItem == m_pathLeftFolder ||
+        pathItem.startsWith(m_pathLeftFolder + QLatin1Char('/')))
+    {
+        return QStringList();
+    }
+
+    QFileInfo info(pathItem);
+    QString pathFolder = info.absolutePath();
+    QString name = info.fileName();
+
+    auto folder = m_overlays.constFind(pathFolder);
+    if (folder != m_overlays.constEnd())
+    {
+        auto it = folder->constFind(name);
+        if (it != folder->constEnd())
+        {
+            return it.value();
+        }
+    }
+
+    watchFolder(pathFolder);
+    schedule(pathFolder, name);
+    return QStringList();
+}
+
+void BCompareOverlay::reloadLeftFolder()
+{
+    QString pathLeft = BCompareConfig::get().readPathLeftFile();
+
+    if (!QFileInfo(pathLeft).isDir())
+    {
+        pathLeft.clear();
+    }
+    else
+    {
+        pathLeft = QFileInfo(pathLeft).absoluteFilePath();
+    }
+
+    if (pathLeft == m_pathLeftFolder)
+    {
+        return;
+    }
+
+    m_pathLeftFolder = pathLeft;
+    if (m_leftWatch >= 0 && !m_folderWatches.contains(m_leftWatch) && m_leftWatch != m_storageWatch)
+    {
+        inotify_rm_watch(m_inotifyFd, m_leftWatch);
+    }
+    m_leftWatch = m_pathLeftFolder.isEmpty() ? -1 : watch(m_pathLeftFolder);
+
+    /* The items being compared go back to the queue, for the new Left folder */
+    if (m_batch)
+    {
+        m_batch->cancelled.store(true);
+        for (const auto &item : m_batch->items)
+        {
+            m_queued.insert(item.first + QLatin1Char('/') + item.second);
+            m_queue.enqueue(item);
+        }
+        m_batch.reset();
+    }
+
+    if (m_pathLeftFolder.isEmpty())
+    {
+        m_queue.clear();
+        m_queued.clear();
+
+        /* No more emblems, the shown ones are removed */
+        for (auto folder = m_overlays.constBegin(); folder != m_overlays.constEnd(); ++folder)
+        {
+            for (auto it = folder->constBegin(); it != folder->constEnd(); ++it)
+            {
+                if (!it.value().isEmpty())
+                {
+                    Q_EMIT overlaysChanged(QUrl::fromLocalFile(folder.key() + QLatin1Char('/') + it.key()),
+                                           QStringList());
+                }
+            }
+        }
+        forgetFolders();
+        return;
+    }
+
+    scheduleAll();
+    startBatch();
+}
+
+void BCompareOverlay::readEvents()
+{
+    alignas(struct inotify_event) char buf[16 * 1024];
+    ssize_t len;
+    bool leftChanged = false;
+
+    while ((len = read(m_inotifyFd, buf, sizeof(buf))) > 0)
+    {
+        const struct inotify_event *event;
+
+        for (char *p = buf; p < buf + len; p += sizeof(struct inotify_event) + event->len)
+        {
+            event = reinterpret_cast<const struct inotify_event *>(p);
+            QString name = (event->len > 0) ? QFile::decodeName(event->name) : QString();
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                leftChanged = true;
+                scheduleAll();
+                continue;
+            }
+
+            if (event->wd == m_storageWatch &&
+                name == QFileInfo(BCompareConfig::get().leftFileSavePath()).fileName())
+            {
+                leftChanged = true;
+            }
+
+            if (event->mask & IN_IGNORED)
+            {
+                if (event->wd == m_leftWatch)
+                {
+                    m_leftWatch = -1;
+                    leftChanged = true;
+                }
+                m_overlays.remove(m_folderWatches.take(event->wd));
+                continue;
+            }
+
+            if (name.isEmpty())
+            {
+                continue;
+            }
+
+            /* An item of the Left folder changed, its counterparts are compared again */
+            if (event->wd == m_leftWatch)
+            {
+                for (auto folder = m_overlays.constBegin(); folder != m_overlays.constEnd(); ++folder)
+                {
+                    if (folder->contains(name))
+                    {
+                        schedule(folder.key(), name);
+                    }
+                }
+            }
+
+            auto folder = m_folderWatches.constFind(event->wd);
+            if (folder != m_folderWatches.constEnd() && m_overlays.value(folder.value()).contains(name))
+            {
+                schedule(folder.value(), name);
+            }
+        }
+    }
+
+    if (leftChanged)
+    {
+        reloadLeftFolder();
+    }
+}
+
+int BCompareOverlay::watch(const QString &pathFolder)
+{
+    if (m_inotifyFd < 0)
+    {
+        return -1;
+    }
+    return inotify_add_watch(m_inotifyFd, QFile::encodeName(pathFolder).constData(), WATCH_EVENTS);
+}
+
+void BCompareOverlay::watchFolder(const QString &pathFolder)
+{
+    if (m_overlays.contains(pathFolder))
+    {
+        return;
+    }
+
+    if (m_folderWatches.size() >= MAX_WATCHED_FOLDERS)
+    {
+        forgetFolders();
+    }
+
+    int wd = watch(pathFolder);
+    if (wd >= 0)
+    {
+        m_folderWatches.insert(wd, pathFolder);
+    }
+    m_overlays.insert(pathFolder, QHash<QString, QStringList>());
+}
+
+void BCompareOverlay::forgetFolders()
+{
+    for (auto it = m_folderWatches.constBegin(); it != m_folderWatches.constEnd(); ++it)
+    {
+        if (it.key() != m_leftWatch && it.key() != m_storageWatch)
+        {
+            inotify_rm_watch(m_inotifyFd, it.key());
+        }
+    }
+    m_folderWatches.clear();
+    m_overlays.clear();
+}
+
+void BCompareOverlay::schedule(const QString &pathFolder, const QString &name)
+{
+    QString pathItem = pathFolder + QLatin1Char('/') + name;
+
+    if (!m_queued.contains(pathItem))
+    {
+        m_queued.insert(pathItem);
+        m_queue.enqueue(qMakePair(pathFolder, name));
+    }
+
+    startBatch();
+}
+
+void BCompareOverlay::scheduleAll()
+{
+    for (auto folder = m_overlays.constBegin(); folder != m_overlays.constEnd(); ++folder)
+    {
+        for (auto it = folder->constBegin(); it != folder->constEnd(); ++it)
+        {
+            schedule(folder.key(), it.key());
+        }
+    }
+}
+
+void BCompareOverlay::startBatch()
+{
+    if (m_batch || m_queue.isEmpty() || m_pathLeftFolder.isEmpty())
+    {
+        return;
+    }
+
+    m_batch = std::make_shared<BCompareOverlayBatch>();
+    m_batch->overlay = this;
+    m_batch->pathLeftFolder = m_pathLeftFolder;
+
+    while (!m_queue.isEmpty() && m_batch->items.size() < OVERLAY_BATCH_SIZE)
+    {
+        QPair<QString, QString> item = m_queue.dequeue();
+        m_queued.remove(item.first + QLatin1Char('/') + item.second);
+        m_batch->items.append(item);
+    }
+
+    QThreadPool::globalInstance()->start(new BCompareOverlayTask(m_batch));
+}
+
+void BCompareOverlay::batchFinished(const QList<QPair<QString, QString> > &items,
+                                    const QVector<int> &states)
+{
+    m_batch.reset();
+
+    for (int i = 0; i < items.size(); ++i)
+    {
+        auto folder = m_overlays.find(items[i].first);
+        if (folder == m_overlays.end())
+        {
+            continue;
+        }
+
+        QStringList overlays = overlaysOfState(states[i]);
+        auto it = folder->constFind(items[i].second);
+        bool changed = (it != folder->constEnd()) ? (it.value() != overlays) : !overlays.isEmpty();
+
+        folder->insert(items[i].second, overlays);
+        if (changed)
+        {
+            Q_EMIT overlaysChanged(QUrl::fromLocalFile(items[i].first + QLatin1Char('/') + items[i].second),
+                                   overlays);
+        }
+    }
+
+    startBatch();
+}
+
+K_PLUGIN_CLASS_WITH_JSON(BCompareOverlay, "bcompare_overlay_kde.json")
+
+#include "bcompare_overlay.moc"
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_OVERLAY_H
+#define BCOMPARE_OVERLAY_H
+
+#include <KOverlayIconPlugin>
+#include <QStringList>
+#include <QQueue>
+#include <QPair>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QUrl>
+#include <memory>
+
+class QSocketNotifier;
+struct BCompareOverlayBatch;
+
+/**
+ * Emblems on the items missing from, or differing from, their counterpart in
+ * the selected Left folder. Items are compared in small batches on the global
+ * thread pool and their emblems are published as soon as each batch is done.
+ * Comparisons are cached for the identities of both files, and an inotify
+ * watch on the Left folder and on the browsed folders compares the items
+ * again when they change.
+ */
+class BCompareOverlay : public KOverlayIconPlugin
+{
+    Q_OBJECT
+public:
+    BCompareOverlay(QObject *pParent, const QVariantList &args);
+    ~BCompareOverlay() override;
+
+    QStringList getOverlays(const QUrl &item) override;
+
+private:
+    friend class BCompareOverlayTask;
+
+    void reloadLeftFolder();
+    void readEvents();
+    int watch(const QString &pathFolder);
+    void watchFolder(const QString &pathFolder);
+    void forgetFolders();
+    void schedule(const QString &pathFolder, const QString &name);
+    void scheduleAll();
+    void startBatch();
+    void batchFinished(const QList<QPair<QString, QString> > &items, const QVector<int> &states);
+
+    /** The selected Left folder, empty if the Left selection is not a folder */
+    QString m_pathLeftFolder;
+
+    /** The inotify instance, -1 if it could not be created */
+    int m_inotifyFd;
+    QSocketNotifier *m_notifier;
+
+    /** Watch of the folder holding the saved Left selection */
+    int m_storageWatch;
+
+    /** Watch of the Left folder */
+    int m_leftWatch;
+
+    /** Browsed folders, by watch descriptor */
+    QHash<int, QString> m_folderWatches;
+
+    /** Emblems of the items already compared, by folder then by name */
+    QHash<QString, QHash<QString, QStringList> > m_overlays;
+
+    /** Items waiting to be compared, as folder and name */
+    QQueue<QPair<QString, QString> > m_queue;
+    QSet<QString> m_queued;
+
+    /** The batch being compared, null if none */
+    std::shared_ptr<BCompareOverlayBatch> m_batch;
+};
+
+#endif // BCOMPARE_OVERLAY_H
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QStandardPaths>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QStringList>
+#include <QFile>
+#include <QDir>
+#include <QSet>
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <link.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "bcompare_prefetch.h"
+
+/** Shortest time between two warm starts */
+static const qint64 WARM_INTERVAL_MS = 10 * 60 * 1000;
+
+/** Most files read ahead by a warm start, the library closure is usually far smaller */
+static const int MAX_WARMED_FILES = 128;
+
+/** Files with this part of their pages in the page cache are not read again */
+static const int RESIDENT_PERCENT = 90;
+
+/* Not exported by the C library, see ioprio_set(2) */
+static const int IOPRIO_WHO_PROCESS = 1;
+static const int IOPRIO_CLASS_IDLE = 3;
+static const int IOPRIO_CLASS_SHIFT = 13;
+
+static std::atomic<bool> s_running(false);
+static std::atomic<qint64> s_lastWarm(0);
+
+/** The bcompare launcher, usually a script, and the binary it runs */
+static QStringList programFiles()
+{
+    QStringList files;
+    QString launcher = QStandardPaths::findExecutable(QLatin1String("bcompare"));
+
+    if (launcher.isEmpty())
+    {
+        return files;
+    }
+
+    QFileInfo launcherInfo(QFileInfo(launcher).canonicalFilePath());
+    QDir prefix(launcherInfo.absolutePath() + QLatin1String("/.."));
+    QStringList candidates{ launcherInfo.absoluteFilePath(),
+                            launcherInfo.absoluteDir().absoluteFilePath(QLatin1String("BCompare")),
+                            prefix.absoluteFilePath(QLatin1String("lib/beyondcompare/BCompare")),
+                            prefix.absoluteFilePath(QLatin1String("lib64/beyondcompare/BCompare")) };
+
+    for (const QString &candidate : candidates)
+    {
+        QString path = QFileInfo(candidate).canonicalFilePath();
+        if (!path.isEmpty() && QFileInfo(path).isFile() && !files.contains(path))
+        {
+            files.append(path);
+        }
+    }
+    return files;
+}
+
+static int findLibc(struct dl_phdr_info *info, size_t, void *data)
+{
+    const char *name = (info->dlpi_name != nullptr) ? strrchr(info->dlpi_name, '/') : nullptr;
+
+    if (name != nullptr && strncmp(name, "/libc.so", 8) == 0)
+    {
+        *static_cast<QString*>(data) = QFile::decodeName(info->dlpi_name);
+        return 1;
+    }
+    return 0;
+}
+
+/** The folders searched by the dynamic loader after the run paths */
+static QStringList systemLibraryDirs()
+{
+    QStringList dirs;
+    QString libc;
+
+    /* The folder of the C library loaded here includes the multiarch triplet */
+    dl_iterate_phdr(findLibc, &libc);
+    if (!libc.isEmpty())
+    {
+        QString libcDir = QFileInfo(libc).absolutePath();
+
+        dirs.append(libcDir);
+        if (libcDir.startsWith(QLatin1String("/usr/")))
+        {
+            dirs.append(libcDir.mid(4));
+        }
+        else
+        {
+            dirs.append(QLatin1String("/usr") + libcDir);
+        }
+    }
+
+    for (const char *dir : { "/lib64", "/usr/lib64", "/lib", "/usr/lib" })
+    {
+        dirs.append(QLatin1String(dir));
+    }
+    return dirs;
+}
+
+/**
+ * Reads the libraries needed by an ELF file of the native class, and the
+ * folders of its run paths, false if data is not such a file.
+ */
+static bool readDynamicSection(const uchar *data, size_t size, const QString &origin,
+                               QStringList &needed, QStringList &runPaths)
+{
+    const ElfW(Ehdr) *ehdr = reinterpret_cast<const ElfW(Ehdr)*>(data);
+
+    if (size < sizeof(ElfW(Ehdr)) || memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 ||
+        ehdr->e_ident[EI_CLASS] != ((sizeof(void*) == 8) ? ELFCLASS64 : ELFCLASS32) ||
+        ehdr->e_phentsize != sizeof(ElfW(Phdr)) ||
+        ehdr->e_phoff + size_t(ehdr->e_phnum) * sizeof(ElfW(Phdr)) > size)
+    {
+        return false;
+    }
+
+    const ElfW(Phdr) *phdrs = reinterpret_cast<const ElfW(Phdr)*>(data + ehdr->e_phoff);
+    const ElfW(Phdr) *dynamic = nullptr;
+
+    for (int i = 0; i < ehdr->e_phnum; ++i)
+    {
+        if (phdrs[i].p_type == PT_DYNAMIC)
+        {
+            dynamic = &phdrs[i];
+        }
+    }
+    if (dynamic == nullptr || dynamic->p_offset + dynamic->p_filesz > size)
+    {
+        return false;
+    }
+
+    /* The string table is given by its address, found in a loaded segment */
+    auto toOffset = [&](ElfW(Addr) addr) -> size_t {
+        for (int i = 0; i < ehdr->e_phnum; ++i)
+        {
+            if (phdrs[i].p_type == PT_LOAD && addr >= phdrs[i].p_vaddr &&
+                addr < phdrs[i].p_vaddr + phdrs[i].p_filesz)
+            {
+                return phdrs[i].p_offset + (addr - phdrs[i].p_vaddr);
+            }
+        }
+        return size;
+    };
+
+    const ElfW(Dyn) *dyn = reinterpret_cast<const ElfW(Dyn)*>(data + dynamic->p_offset);
+    size_t nbDyn = dynamic->p_filesz / sizeof(ElfW(Dyn));
+    size_t strtab = size;
+    size_t strsz = 0;
+
+    for (size_t i = 0; i < nbDyn && dyn[i].d_tag != DT_NULL; ++i)
+    {
+        if (dyn[i].d_tag == DT_STRTAB)
+        {
+            strtab = toOffset(dyn[i].d_un.d_ptr);
+        }
+        else if (dyn[i].d_tag == DT_STRSZ)
+        {
+            strsz = dyn[i].d_un.d_val;
+        }
+    }
+    if (strtab >= size || strsz > size - strtab)
+    {
+        return false;
+    }
+
+    auto stringAt = [&](size_t offset) -> QString {
+        if (offset >= strsz)
+        {
+            return QString();
+        }
+        const char *str = reinterpret_cast<const char*>(data + strtab + offset);
+        return QFile::decodeName(QByteArray(str, int(qstrnlen(str, uint(strsz - offset)))));
+    };
+
+    for (size_t i = 0; i < nbDyn && dyn[i].d_tag != DT_NULL; ++i)
+    {
+        if (dyn[i].d_tag == DT_NEEDED)
+        {
+            needed.append(stringAt(dyn[i].d_un.d_val));
+        }
+        else if (dyn[i].d_tag == DT_RPATH || dyn[i].d_tag == DT_RUNPATH)
+        {
+            QString paths = stringAt(dyn[i].d_un.d_val);
+            paths.replace(QLatin1String("${ORIGIN}"), origin).replace(QLatin1String("$ORIGIN"), origin);
+            for (const QString &dir : paths.split(QLatin1Char(':')))
+            {
+                if (!dir.isEmpty())
+                {
+                    runPaths.append(dir);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Reads path ahead unless it is already in the page cache, and returns the
+ * libraries it needs, with the folders to search them first.
+ */
+static void warmFile(const QString &path, QStringList &needed, QStringList &runPaths)
+{
+    int fd = open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+    struct stat st;
+
+    if (fd < 0)
+    {
+        return;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return;
+    }
+
+    size_t size = size_t(st.st_size);
+    void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+    if (data != MAP_FAILED)
+    {
+        long pageSize = sysconf(_SC_PAGESIZE);
+        size_t nbPages = (size + size_t(pageSize) - 1) / size_t(pageSize);
+        QByteArray residency(int(nbPages), '\0');
+        size_t nbResident = 0;
+
+        /*
+         * Recent kernels only report the pages of files the user may write, the
+         * others look absent and are read ahead, which costs no I/O when cached
+         */
+        if (mincore(data, size, reinterpret_cast<unsigned char*>(residency.data())) == 0)
+        {
+            for (char page : residency)
+            {
+                nbResident += (page & 1);
+            }
+        }
+
+        readDynamicSection(static_cast<const uchar*>(data), size,
+                           QFileInfo(path).absolutePath(), needed, runPaths);
+        munmap(data, size);
+
+        if (nbResident * 100 < nbPages * RESIDENT_PERCENT)
+        {
+            readahead(fd, 0, size);
+        }
+    }
+    close(fd);
+}
+
+static void warmProgram()
+{
+    /* Only this thread, whose reads never delay the desktop */
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+
+    const QStringList systemDirs = systemLibraryDirs();
+    QStringList queue = programFiles();
+    QSet<QString> visited;
+
+    for (const QString &path : queue)
+    {
+        visited.insert(path);
+    }
+
+    for (int i = 0; i < queue.size() && i < MAX_WARMED_FILES; ++i)
+    {
+        QStringList needed;
+        QStringList runPaths;
+
+        warmFile(queue.at(i), needed, runPaths);
+
+        /* The binary is run from its own folder, where its private libraries are */
+        runPaths.append(QFileInfo(queue.at(i)).absolutePath());
+        runPaths.append(systemDirs);
+
+        for (const QString &name : needed)
+        {
+            for (const QString &dir : runPaths)
+            {
+                QString path = QFileInfo(QDir(dir).absoluteFilePath(name)).canonicalFilePath();
+
+                if (!path.isEmpty())
+                {
+                    if (!visited.contains(path))
+                    {
+                        visited.insert(path);
+                        queue.append(path);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    s_running = false;
+}
+
+void BCompareWarmStart::warmAsync()
+{
+    if (!qEnvironmentVariableIsSet("BCOMPARE_EXT_PREFETCH"))
+    {
+        return;
+    }
+
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (now - s_lastWarm < WARM_INTERVAL_MS || s_running.exchange(true))
+    {
+        return;
+    }
+    s_lastWarm = now;
+
+    std::thread(warmProgram).detach();
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QStandardPaths>
+#include <KLocalizedString>
+#include <QFileInfo>
+#include <QDir>
+#include "bcompare_priority.h"
+
+/** Limits of the transient cgroup, see systemd.resource-control(5) */
+static const char *CGROUP_CPU_QUOTA = "CPUQuota=50%";
+static const char *CGROUP_IO_BANDWIDTH = "50M";
+
+static bool hasProgram(const char *name)
+{
+    return !QStandardPaths::findExecutable(QLatin1String(name)).isEmpty();
+}
+
+/* The scope is created by the user manager, in the unified hierarchy */
+static bool hasCgroupScopes()
+{
+    QString runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+
+    return hasProgram("systemd-run") &&
+           QFileInfo(QDir(runtimeDir).absoluteFilePath(QLatin1String("systemd"))).isDir() &&
+           QFileInfo::exists(QLatin1String("/sys/fs/cgroup/cgroup.controllers"));
+}
+
+int BCompareLowPriority::availableLimits()
+{
+    int limits = LIMIT_NONE;
+
+    if (hasProgram("ionice"))
+    {
+        limits |= LIMIT_IDLE_IO;
+    }
+
+    if (hasProgram("chrt"))
+    {
+        limits |= LIMIT_IDLE_CPU;
+    }
+    else if (hasProgram("nice"))
+    {
+        limits |= LIMIT_NICE;
+    }
+
+    if (hasCgroupScopes())
+    {
+        limits |= LIMIT_CGROUP;
+    }
+
+    return limits;
+}
+
+QString BCompareLowPriority::describe(int limits)
+{
+    QStringList parts;
+
+    if (limits & LIMIT_IDLE_IO)
+    {
+        parts.append(i18nc("@bc low priority limit", "idle disk priority"));
+    }
+
+    if (limits & LIMIT_IDLE_CPU)
+    {
+        parts.append(i18nc("@bc low priority limit", "idle CPU priority"));
+    }
+    else if (limits & LIMIT_NICE)
+    {
+        parts.append(i18nc("@bc low priority limit", "lowest CPU priority"));
+    }
+
+    if (limits & LIMIT_CGROUP)
+    {
+        parts.append(i18nc("@bc low priority limit", "half a CPU and %1B/s of disk bandwidth",
+                           QLatin1String(CGROUP_IO_BANDWIDTH)));
+    }
+
+    if (parts.isEmpty())
+    {
+        return i18n("Runs at normal priority, no priority tool is installed");
+    }
+    return i18n("Runs with %1", parts.join(QLatin1String(", ")));
+}
+
+QStringList BCompareLowPriority::wrapCommand(const QString &program, const QStringList &args)
+{
+    int limits = availableLimits();
+    QStringList command;
+
+    /* Each tool execs the next one, the settings are inherited */
+    if (limits & LIMIT_IDLE_IO)
+    {
+        command << QLatin1String("ionice") << QLatin1String("-c") << QLatin1String("3");
+    }
+
+    if (limits & LIMIT_IDLE_CPU)
+    {
+        command << QLatin1String("chrt") << QLatin1String("--idle") << QLatin1String("0");
+    }
+    else if (limits & LIMIT_NICE)
+    {
+        command << QLatin1String("nice") << QLatin1String("-n") << QLatin1String("19");
+    }
+
+    if (limits & LIMIT_CGROUP)
+    {
+        command << QLatin1String("systemd-run") << QLatin1String("--user")
+                << QLatin1String("--scope") << QLatin1String("--quiet") << QLatin1String("--collect")
+                << QLatin1String("-p") << QLatin1String(CGROUP_CPU_QUOTA);
+
+        /* systemd finds the device of a path, which must not contain spaces */
+        for (const QString &arg : args)
+        {
+            if (QFileInfo(arg).isDir() && !arg.contains(QLatin1Char(' ')))
+            {
+                for (const char *property : { "IOReadBandwidthMax", "IOWriteBandwidthMax" })
+                {
+                    command << QLatin1String("-p")
+                            << QString(QLatin1String("%1=%2 %3")).arg(QLatin1String(property), arg,
+                                                                     QLatin1String(CGROUP_IO_BANDWIDTH));
+                }
+            }
+        }
+        command << QLatin1String("--");
+    }
+
+    command << program << args;
+    return command;
+}
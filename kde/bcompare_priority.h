@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_PRIORITY_H
+#define BCOMPARE_PRIORITY_H
+
+#include <QStringList>
+#include <QString>
+
+/**
+ * Runs Beyond Compare in the background without competing with the desktop:
+ * idle I/O class, idle CPU scheduling, and when the systemd user manager can
+ * create a transient cgroup, CPU and bandwidth limits. Each limit is only
+ * applied if the tool providing it is installed.
+ */
+class BCompareLowPriority
+{
+public:
+    typedef enum {
+        LIMIT_NONE = 0,
+        LIMIT_IDLE_IO = 1,
+        LIMIT_IDLE_CPU = 2,
+        LIMIT_NICE = 4,
+        LIMIT_CGROUP = 8
+    } Limits;
+
+    /** The limits which can be applied on this system */
+    static int availableLimits();
+
+    /** Sentence describing limits, shown in the menu hints */
+    static QString describe(int limits);
+
+    /**
+     * Program and arguments running program with args at low priority, the
+     * bandwidth limits apply to the devices of the folders found in args
+     */
+    static QStringList wrapCommand(const QString &program, const QStringList &args);
+};
+
+#endif // BCOMPARE_PRIORITY_H
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QHash>
+#include <QFile>
+#include <memory>
+#include <thread>
+#include <sys/stat.h>
+#include "bcompare_probe.h"
+
+/** Longest time a menu waits for the type of a path */
+static const qint64 PROBE_TIMEOUT_MS = 50;
+
+/** Probes still blocked, no more are started past this */
+static const int MAX_PENDING_PROBES = 8;
+
+struct ProbeState
+{
+    bool finished = false;
+    BCompareProbe::Type type = BCompareProbe::PROBE_UNKNOWN;
+};
+
+/** Mutex protecting the probes, and their condition */
+static QMutex s_mutex;
+static QWaitCondition s_finished;
+
+/** Probes whose stat() did not return yet, by path */
+static QHash<QString, std::shared_ptr<ProbeState> > s_pending;
+
+static BCompareProbe::Type statType(const QString &path)
+{
+    struct stat st;
+
+    if (stat(QFile::encodeName(path).constData(), &st) != 0)
+    {
+        return BCompareProbe::PROBE_MISSING;
+    }
+    return S_ISDIR(st.st_mode) ? BCompareProbe::PROBE_FOLDER : BCompareProbe::PROBE_FILE;
+}
+
+BCompareProbe::Type BCompareProbe::pathType(const QString &path)
+{
+    QMutexLocker lock(&s_mutex);
+
+    if (s_pending.contains(path) || s_pending.size() >= MAX_PENDING_PROBES)
+    {
+        return PROBE_UNKNOWN;
+    }
+
+    /* The thread is detached, it may stay blocked long after the menu is shown */
+    std::shared_ptr<ProbeState> probe = std::make_shared<ProbeState>();
+    s_pending.insert(path, probe);
+    std::thread([path, probe]() {
+        Type type = statType(path);
+
+        QMutexLocker lock(&s_mutex);
+        probe->type = type;
+        probe->finished = true;
+        s_pending.remove(path);
+        s_finished.wakeAll();
+    }).detach();
+
+    QElapsedTimer timer;
+    timer.start();
+    while (!probe->finished && timer.elapsed() < PROBE_TIMEOUT_MS)
+    {
+        s_finished.wait(&s_mutex, PROBE_TIMEOUT_MS - timer.elapsed());
+    }
+
+    return probe->finished ? probe->type : PROBE_UNKNOWN;
+}
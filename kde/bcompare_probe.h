@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_PROBE_H
+#define BCOMPARE_PROBE_H
+
+#include <QString>
+
+/**
+ * Type of a saved path, read by a helper thread which is waited for at most
+ * a few tens of milliseconds. A path whose previous probe is still blocked is
+ * answered as unknown right away. Only the saved paths go through here, the
+ * selected files are still looked at directly.
+ */
+class BCompareProbe
+{
+public:
+    typedef enum {
+        PROBE_UNKNOWN = 0,
+        PROBE_MISSING,
+        PROBE_FILE,
+        PROBE_FOLDER
+    } Type;
+
+    static Type pathType(const QString &path);
+};
+
+#endif // BCOMPARE_PROBE_H
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QTemporaryFile>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <QRunnable>
+#include <QFileInfo>
+#include <QProcess>
+#include <QThread>
+#include <QVector>
+#include <QFile>
+#include <KLocalizedString>
+#include "bcompare_report.h"
+#include "bcompare_hash.h"
+#include "bcompare_walk.h"
+
+/** Reports written at the same time, each one may read with several threads */
+static const int MAX_CONCURRENT_REPORTS = 2;
+
+static bool isHtmlReport(const QString &pathReport)
+{
+    return pathReport.endsWith(QLatin1String(".html"), Qt::CaseInsensitive) ||
+           pathReport.endsWith(QLatin1String(".htm"), Qt::CaseInsensitive);
+}
+
+static void notifyReport(const QString &summary, const QString &body, bool failed)
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(
+        QLatin1String("org.freedesktop.Notifications"), QLatin1String("/org/freedesktop/Notifications"),
+        QLatin1String("org.freedesktop.Notifications"), QLatin1String("Notify"));
+
+    msg << QLatin1String("Beyond Compare") << uint(0)
+        << (failed ? QLatin1String("dialog-warning") : QLatin1String("bcompare"))
+        << summary << body << QStringList() << QVariantMap() << int(-1);
+
+    QDBusConnection::sessionBus().asyncCall(msg);
+}
+
+/*************************************************************
+ * Built-in differ
+ *************************************************************/
+
+/* Compares the contents of one pair of files of the same size */
+class BCompareReportPairTask : public QRunnable
+{
+public:
+    BCompareReportPairTask(const QString &pathLeft, const QString &pathRight, char &result) :
+        m_pathLeft(pathLeft), m_pathRight(pathRight), m_result(result)
+    {
+    }
+
+    void run() override
+    {
+        BCompareHashCache &cache = BCompareHashCache::get();
+        QByteArray hashLeft = cache.fileHash(m_pathLeft);
+        QByteArray hashRight = cache.fileHash(m_pathRight);
+
+        m_result = (hashLeft.isEmpty() || hashRight.isEmpty()) ? 'u' :
+                   ((hashLeft == hashRight) ? '=' : 'c');
+    }
+
+private:
+    QString m_pathLeft;
+    QString m_pathRight;
+    char &m_result;
+};
+
+class BCompareBuiltinDiffer
+{
+public:
+    BCompareBuiltinDiffer(const QByteArray &pathLeft, const QByteArray &pathRight,
+                          QTextStream &out, bool html) :
+        m_pathLeft(pathLeft), m_pathRight(pathRight), m_out(out), m_html(html), m_nbDiffs(0)
+    {
+    }
+
+    /** Writes the differences, the structural ones as they are found */
+    int run()
+    {
+        walk(QByteArray());
+
+        /* Contents are compared in parallel, then reported in walk order */
+        QVector<char> results(m_pairs.size(), '=');
+        QThreadPool pool;
+        pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), 8));
+
+        for (int i = 0; i < m_pairs.size(); ++i)
+        {
+            pool.start(new BCompareReportPairTask(
+                QFile::decodeName(BCompareFolderWalk::joinPath(m_pathLeft, m_pairs.at(i))),
+                QFile::decodeName(BCompareFolderWalk::joinPath(m_pathRight, m_pairs.at(i))),
+                results[i]));
+        }
+        pool.waitForDone();
+
+        for (int i = 0; i < m_pairs.size(); ++i)
+        {
+            if (results.at(i) == 'c')
+            {
+                writeLine(i18nc("@bc report", "Content differs"), m_pairs.at(i));
+            }
+            else if (results.at(i) == 'u')
+            {
+                writeLine(i18nc("@bc report", "Unreadable"), m_pairs.at(i));
+            }
+        }
+
+        return m_nbDiffs;
+    }
+
+private:
+    void writeLine(const QString &kind, const QByteArray &relPath)
+    {
+        QString path = QFile::decodeName(relPath);
+
+        if (m_html)
+        {
+            m_out << "<tr><td>" << kind.toHtmlEscaped() << "</td><td>"
+                  << path.toHtmlEscaped() << "</td></tr>\n";
+        }
+        else
+        {
+            m_out << kind << '\t' << path << '\n';
+        }
+        m_nbDiffs++;
+    }
+
+    void walk(const QByteArray &relPath)
+    {
+        QMap<QByteArray, struct stat> entriesLeft, entriesRight;
+
+        if (!BCompareFolderWalk::listEntries(BCompareFolderWalk::joinPath(m_pathLeft, relPath), entriesLeft) ||
+            !BCompareFolderWalk::listEntries(BCompareFolderWalk::joinPath(m_pathRight, relPath), entriesRight))
+        {
+            writeLine(i18nc("@bc report", "Unreadable"), relPath);
+            return;
+        }
+
+        for (auto it = entriesRight.constBegin(); it != entriesRight.constEnd(); ++it)
+        {
+            if (!entriesLeft.contains(it.key()))
+            {
+                writeLine(i18nc("@bc report", "Right only"), BCompareFolderWalk::joinPath(relPath, it.key()));
+            }
+        }
+
+        for (auto it = entriesLeft.constBegin(); it != entriesLeft.constEnd(); ++it)
+        {
+            QByteArray entryPath = relPath.isEmpty() ? it.key() : relPath + '/' + it.key();
+            auto other = entriesRight.constFind(it.key());
+            mode_t type = it.value().st_mode & S_IFMT;
+
+            if (other == entriesRight.constEnd())
+            {
+                writeLine(i18nc("@bc report", "Left only"), entryPath);
+            }
+            else if (type != (other.value().st_mode & S_IFMT))
+            {
+                writeLine(i18nc("@bc report", "Type differs"), entryPath);
+            }
+            else if (S_ISDIR(it.value().st_mode))
+            {
+                walk(entryPath);
+            }
+            else if (S_ISLNK(it.value().st_mode))
+            {
+                if (QFile::symLinkTarget(QFile::decodeName(BCompareFolderWalk::joinPath(m_pathLeft, entryPath))) !=
+                    QFile::symLinkTarget(QFile::decodeName(BCompareFolderWalk::joinPath(m_pathRight, entryPath))))
+                {
+                    writeLine(i18nc("@bc report", "Link target differs"), entryPath);
+                }
+            }
+            else if (it.value().st_size != other.value().st_size)
+            {
+                writeLine(i18nc("@bc report", "Size differs"), entryPath);
+            }
+            else if (S_ISREG(it.value().st_mode))
+            {
+                m_pairs.append(entryPath);
+            }
+        }
+    }
+
+    QByteArray m_pathLeft;
+    QByteArray m_pathRight;
+    QTextStream &m_out;
+    bool m_html;
+    int m_nbDiffs;
+
+    /** Files of the same size on both sides, to be compared */
+    QList<QByteArray> m_pairs;
+};
+
+/*************************************************************
+ * Report tasks
+ *************************************************************/
+
+class BCompareReportTask : public QRunnable
+{
+public:
+    BCompareReportTask(const QString &pathLeft, const QString &pathRight, const QString &pathReport) :
+        m_pathLeft(pathLeft), m_pathRight(pathRight), m_pathReport(pathReport)
+    {
+    }
+
+    void run() override
+    {
+        QString summary, body;
+        int nbDiffs = -1;
+        bool ok = runScript() || runBuiltin(nbDiffs);
+
+        if (!ok)
+        {
+            summary = i18n("Diff report failed");
+            body = i18n("The report could not be written to %1", m_pathReport);
+        }
+        else if (nbDiffs < 0)
+        {
+            summary = i18n("Diff report ready");
+            body = i18n("The report of %1 and %2 was written to %3",
+                        m_pathLeft, m_pathRight, m_pathReport);
+        }
+        else
+        {
+            summary = i18n("Diff report ready");
+            body = i18np("%1 difference between %2 and %3, written to %4",
+                         "%1 differences between %2 and %3, written to %4",
+                         nbDiffs, m_pathLeft, m_pathRight, m_pathReport);
+        }
+
+        /* The session bus connection belongs to the GUI thread */
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [summary, body, ok]() {
+            notifyReport(summary, body, !ok);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    static QString quoted(const QString &path)
+    {
+        return QLatin1Char('"') + path + QLatin1Char('"');
+    }
+
+    /* Beyond Compare scripting, without any window */
+    bool runScript()
+    {
+        if (QStandardPaths::findExecutable(QLatin1String("bcompare")).isEmpty())
+        {
+            return false;
+        }
+
+        QTemporaryFile script;
+        if (!script.open())
+        {
+            return false;
+        }
+
+        QTextStream s(&script);
+        s << "load " << quoted(m_pathLeft) << ' ' << quoted(m_pathRight) << '\n'
+          << "expand all\n"
+          << "folder-report layout:summary options:display-mismatches output-to:"
+          << quoted(m_pathReport);
+        if (isHtmlReport(m_pathReport))
+        {
+            s << " output-options:html-color";
+        }
+        s << '\n';
+        s.flush();
+        script.close();
+
+        QFile::remove(m_pathReport);
+
+        QProcess process;
+        process.start(QLatin1String("bcompare"),
+                      QStringList{ QLatin1String("-silent"), QLatin1Char('@') + script.fileName() });
+
+        return process.waitForFinished(-1) && process.exitStatus() == QProcess::NormalExit &&
+               process.exitCode() == 0 && QFileInfo::exists(m_pathReport);
+    }
+
+    bool runBuiltin(int &nbDiffs)
+    {
+        QFile f(m_pathReport);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        {
+            return false;
+        }
+
+        bool html = isHtmlReport(m_pathReport);
+        QTextStream out(&f);
+
+        if (html)
+        {
+            out << "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>"
+                << i18n("Differences between %1 and %2", m_pathLeft, m_pathRight).toHtmlEscaped()
+                << "</title></head><body>\n<table>\n";
+        }
+        else
+        {
+            out << i18n("Differences between %1 and %2", m_pathLeft, m_pathRight) << "\n\n";
+        }
+
+        BCompareBuiltinDiffer differ(QFile::encodeName(m_pathLeft), QFile::encodeName(m_pathRight),
+                                     out, html);
+        nbDiffs = differ.run();
+
+        if (html)
+        {
+            out << "</table>\n</body></html>\n";
+        }
+
+        out.flush();
+        f.close();
+        return f.error() == QFileDevice::NoError;
+    }
+
+    QString m_pathLeft;
+    QString m_pathRight;
+    QString m_pathReport;
+};
+
+/*************************************************************
+ * Report queue
+ *************************************************************/
+
+BCompareReportQueue& BCompareReportQueue::get()
+{
+    static BCompareReportQueue m_queue;
+    return m_queue;
+}
+
+BCompareReportQueue::BCompareReportQueue()
+{
+    m_pool.setMaxThreadCount(MAX_CONCURRENT_REPORTS);
+}
+
+void BCompareReportQueue::enqueue(const QString &pathLeft, const QString &pathRight,
+                                  const QString &pathReport)
+{
+    m_pool.start(new BCompareReportTask(pathLeft, pathRight, pathReport));
+}
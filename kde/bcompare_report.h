@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_REPORT_H
+#define BCOMPARE_REPORT_H
+
+#include <QThreadPool>
+#include <QString>
+
+/**
+ * Writes reports of the differences between two folders without opening a
+ * window: Beyond Compare runs a folder-report script silently, or a built-in
+ * differ compares the trees when Beyond Compare can not be run. A desktop
+ * notification is posted when a report is written.
+ */
+class BCompareReportQueue
+{
+public:
+    /** Get a reference to the global report queue */
+    static BCompareReportQueue& get();
+
+    /**
+     * Queue a report, written to pathReport as HTML if its extension is .html
+     * or .htm, as text otherwise. A few reports run at the same time.
+     */
+    void enqueue(const QString &pathLeft, const QString &pathRight, const QString &pathReport);
+
+private:
+    BCompareReportQueue();
+
+    /** The reports being written, the others wait in its queue */
+    QThreadPool m_pool;
+};
+
+#endif // BCOMPARE_REPORT_H
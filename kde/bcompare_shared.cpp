@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QPixmap>
+#include <QImage>
+#include <cstring>
+#include <utility>
+#include "bcompare_shared.h"
+
+BCompareSharedIcons& BCompareSharedIcons::get()
+{
+    static BCompareSharedIcons s_icons;
+    return s_icons;
+}
+
+BCompareSharedIcons::BCompareSharedIcons() :
+    m_data(nullptr), m_size(0)
+{
+#ifdef BCOMPARE_SHARED_ICONS
+    m_file.setFileName(QLatin1String(BCOMPARE_SHARED_ICONS));
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    qint64 size = m_file.size();
+    if (size < qint64(sizeof(BCompareSharedBlob::Header)))
+    {
+        return;
+    }
+
+    /* A shared mapping, the pages of the file are the same for every process */
+    const uchar *data = m_file.map(0, size);
+    if (data == nullptr)
+    {
+        return;
+    }
+
+    const BCompareSharedBlob::Header *header = reinterpret_cast<const BCompareSharedBlob::Header*>(data);
+    if (header->magic != BCompareSharedBlob::MAGIC || header->version != BCompareSharedBlob::VERSION ||
+        quint64(header->nbIcons) * sizeof(BCompareSharedBlob::Icon) > quint64(size) - sizeof(*header))
+    {
+        m_file.unmap(const_cast<uchar*>(data));
+        return;
+    }
+
+    m_data = data;
+    m_size = size;
+#endif
+}
+
+QIcon BCompareSharedIcons::icon(const char *name) const
+{
+    QIcon icon;
+
+    if (m_data == nullptr)
+    {
+        return icon;
+    }
+
+    const BCompareSharedBlob::Header *header = reinterpret_cast<const BCompareSharedBlob::Header*>(m_data);
+    const BCompareSharedBlob::Icon *entries = reinterpret_cast<const BCompareSharedBlob::Icon*>(header + 1);
+
+    for (quint32 i = 0; i < header->nbIcons; ++i)
+    {
+        const BCompareSharedBlob::Icon &entry = entries[i];
+        quint64 bytes = quint64(entry.width) * entry.height * 4;
+
+        if (strncmp(entry.name, name, sizeof(entry.name)) != 0 ||
+            entry.width == 0 || entry.height == 0 || entry.offset % 16 != 0 ||
+            entry.offset + bytes > quint64(m_size))
+        {
+            continue;
+        }
+
+        /* The image does not own its pixels, and the pixmap keeps sharing them */
+        QImage image(m_data + entry.offset, int(entry.width), int(entry.height), int(entry.width) * 4,
+                     QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(entry.devicePixelRatio);
+        icon.addPixmap(QPixmap::fromImage(std::move(image), Qt::NoFormatConversion));
+    }
+
+    return icon;
+}
+
+static qint64 smapsValue(const QByteArray &smaps, const char *key)
+{
+    int pos = smaps.indexOf(key);
+    if (pos < 0)
+    {
+        return 0;
+    }
+
+    int end = smaps.indexOf('\n', pos);
+    return smaps.mid(pos + int(strlen(key)), end - pos - int(strlen(key)))
+                .replace("kB", "").trimmed().toLongLong();
+}
+
+void BCompareSharedIcons::traceMemory()
+{
+    static bool s_traced = !qEnvironmentVariableIsSet("BCOMPARE_EXT_TRACE_MEMORY");
+
+    if (s_traced)
+    {
+        return;
+    }
+    s_traced = true;
+
+    QFile f(QLatin1String("/proc/self/smaps_rollup"));
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    /* Comparing these between sessions gives the private cost of each instance */
+    const QByteArray smaps = f.readAll();
+    qInfo("bcompare-ext-kde: Pss %lld kB, private %lld kB, shared icons %s",
+          smapsValue(smaps, "\nPss:"),
+          smapsValue(smaps, "\nPrivate_Clean:") + smapsValue(smaps, "\nPrivate_Dirty:"),
+          (get().m_data != nullptr) ? "mapped" : "not installed");
+}
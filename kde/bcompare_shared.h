@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_SHARED_H
+#define BCOMPARE_SHARED_H
+
+#include <QIcon>
+#include <QFile>
+
+/**
+ * Layout of the blob of pre-decoded icons, written at build time by
+ * bcompare_blob_tool in the native byte order. Each icon is stored as
+ * premultiplied ARGB32 pixels, at an offset aligned on 16 bytes.
+ */
+struct BCompareSharedBlob
+{
+    static const quint32 MAGIC = 0x49584342;    /* "BCXI" */
+    static const quint32 VERSION = 1;
+
+    struct Header
+    {
+        quint32 magic;
+        quint32 version;
+        quint32 nbIcons;
+        quint32 reserved;
+    };
+
+    struct Icon
+    {
+        char name[24];
+        quint32 width;
+        quint32 height;
+        quint32 devicePixelRatio;
+        quint32 offset;
+    };
+};
+
+/**
+ * Footprint mode for hosts running many sessions: the menu icons are read from
+ * a read-only mapping of the installed blob, so their pixels are shared by all
+ * the processes of all the users instead of being decoded by each of them.
+ */
+class BCompareSharedIcons
+{
+public:
+    /** Get a reference to the shared icons */
+    static BCompareSharedIcons& get();
+
+    /** The icon named after its 1x picture, null if the blob is not installed */
+    QIcon icon(const char *name) const;
+
+    /** Logs the memory used by the process once, when BCOMPARE_EXT_TRACE_MEMORY is set */
+    static void traceMemory();
+
+private:
+    BCompareSharedIcons();
+
+    /** The installed blob, kept open as long as it is mapped */
+    QFile m_file;
+
+    /** The mapped blob, null if missing or invalid */
+    const uchar *m_data;
+    qint64 m_size;
+};
+
+#endif // BCOMPARE_SHARED_H
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <algorithm>
+#include <sys/stat.h>
+#include "bcompare_siblings.h"
+
+/** Bounds of the listings kept in memory, larger folders are not searched */
+static const int MAX_CACHED_LISTINGS = 16;
+static const int MAX_LISTED_NAMES = 100000;
+
+/** Most siblings offered for one file */
+static const int MAX_SIBLINGS = 3;
+
+/** A folder modified this close to its listing may change again with the same time */
+static const qint64 RACY_LISTING_NS = 1000000000;
+
+BCompareSiblings& BCompareSiblings::get()
+{
+    static BCompareSiblings siblings;
+    return siblings;
+}
+
+/** Builds the trie of the reversed suffixes, its accepting states end a suffix */
+void BCompareSiblings::compile(const QStringList &suffixes)
+{
+    m_suffixes = suffixes;
+    m_nodes.clear();
+    m_nodes.append(Node());
+
+    for (const QString &rule : suffixes)
+    {
+        QString suffix = rule.trimmed();
+        int state = 0;
+
+        if (suffix.isEmpty())
+        {
+            continue;
+        }
+
+        for (int i = suffix.size() - 1; i >= 0; --i)
+        {
+            int target = step(state, suffix[i]);
+            if (target < 0)
+            {
+                target = m_nodes.size();
+                m_nodes.append(Node());
+                m_nodes[state].next.append(qMakePair(suffix[i], target));
+            }
+            state = target;
+        }
+        m_nodes[state].accept = true;
+    }
+}
+
+int BCompareSiblings::step(int state, QChar c) const
+{
+    for (const auto &transition : m_nodes[state].next)
+    {
+        if (transition.first == c)
+        {
+            return transition.second;
+        }
+    }
+    return -1;
+}
+
+/** Indicates if name ends with one of the suffixes right after its first stemLength characters */
+bool BCompareSiblings::matchesSuffix(const QString &name, int stemLength) const
+{
+    int state = 0;
+
+    for (int i = name.size() - 1; i >= stemLength; --i)
+    {
+        state = step(state, name[i]);
+        if (state < 0)
+        {
+            return false;
+        }
+    }
+    return m_nodes[state].accept;
+}
+
+/** The sorted names of the files of pathFolder, listed again only when it was modified */
+const QStringList *BCompareSiblings::listing(const QString &pathFolder)
+{
+    struct stat st;
+
+    if (stat(QFile::encodeName(pathFolder).constData(), &st) != 0)
+    {
+        return nullptr;
+    }
+
+    qint64 modifiedNs = qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    auto it = m_listings.find(pathFolder);
+
+    if (it != m_listings.end() && it->modifiedNs == modifiedNs)
+    {
+        return &it->names;
+    }
+
+    qint64 listedNs = QDateTime::currentMSecsSinceEpoch() * 1000000;
+    QStringList names = QDir(pathFolder).entryList(QDir::Files | QDir::Hidden | QDir::System,
+                                                   QDir::Unsorted);
+
+    /* Huge folders are remembered empty, so they are not listed on every popup */
+    if (names.size() > MAX_LISTED_NAMES)
+    {
+        names.clear();
+    }
+    std::sort(names.begin(), names.end());
+
+    if (m_listings.size() >= MAX_CACHED_LISTINGS && it == m_listings.end())
+    {
+        m_listings.clear();
+    }
+
+    Listing &entry = m_listings[pathFolder];
+    entry.modifiedNs = (listedNs - modifiedNs < RACY_LISTING_NS) ? -1 : modifiedNs;
+    entry.names = names;
+    return &entry.names;
+}
+
+QList<BCompareSiblings::Sibling> BCompareSiblings::find(const QString &pathFile,
+                                                         const QStringList &suffixes)
+{
+    QList<Sibling> siblings;
+
+    if (m_nodes.isEmpty() || suffixes != m_suffixes)
+    {
+        compile(suffixes);
+    }
+
+    QFileInfo info(pathFile);
+    QString name = info.fileName();
+    QDir folder = info.absoluteDir();
+    const QStringList *names = listing(folder.absolutePath());
+
+    if (names == nullptr || name.isEmpty())
+    {
+        return siblings;
+    }
+
+    /* Backups of the file: the names starting with its name, followed by a suffix */
+    for (auto it = std::lower_bound(names->begin(), names->end(), name);
+         it != names->end() && it->startsWith(name) && siblings.size() < MAX_SIBLINGS; ++it)
+    {
+        if (it->size() > name.size() && matchesSuffix(*it, name.size()))
+        {
+            siblings.append(Sibling{ folder.absoluteFilePath(*it), true });
+        }
+    }
+
+    /* The file the selected backup was made from: its name without a suffix */
+    int state = 0;
+    for (int i = name.size() - 1; i > 0 && state >= 0 && siblings.size() < MAX_SIBLINGS; --i)
+    {
+        state = step(state, name[i]);
+        if (state >= 0 && m_nodes[state].accept)
+        {
+            QString stem = name.left(i);
+            if (std::binary_search(names->begin(), names->end(), stem))
+            {
+                siblings.append(Sibling{ folder.absoluteFilePath(stem), false });
+            }
+        }
+    }
+
+    return siblings;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_SIBLINGS_H
+#define BCOMPARE_SIBLINGS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+
+/**
+ * Finds the backup copies next to a file, such as foo.orig, foo.bak or foo~,
+ * and the file a selected backup was made from. The suffix rules are compiled
+ * into one automaton reading names backwards, which runs over a sorted listing
+ * of the folder kept until the folder is modified. Only used from the thread
+ * building the menus.
+ */
+class BCompareSiblings
+{
+public:
+    struct Sibling
+    {
+        QString path;
+
+        /** True if the sibling is the backup, false if the selected file is */
+        bool isBackup;
+    };
+
+    /** Get a reference to the global sibling matcher */
+    static BCompareSiblings& get();
+
+    /** The siblings of pathFile matching one of the suffixes, its backups first */
+    QList<Sibling> find(const QString &pathFile, const QStringList &suffixes);
+
+private:
+    BCompareSiblings() = default;
+
+    void compile(const QStringList &suffixes);
+    int step(int state, QChar c) const;
+    bool matchesSuffix(const QString &name, int stemLength) const;
+    const QStringList *listing(const QString &pathFolder);
+
+    struct Node
+    {
+        /** Transitions on the previous character of the name */
+        QVector<QPair<QChar, int>> next;
+        bool accept = false;
+    };
+
+    struct Listing
+    {
+        qint64 modifiedNs;
+        QStringList names;
+    };
+
+    /** The suffixes the automaton was compiled from */
+    QStringList m_suffixes;
+
+    /** States of the automaton, the first one is the initial state */
+    QVector<Node> m_nodes;
+
+    /** Sorted file names of the recently listed folders */
+    QHash<QString, Listing> m_listings;
+};
+
+#endif // BCOMPARE_SIBLINGS_H
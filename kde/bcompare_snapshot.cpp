@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QPointer>
+#include <QMutex>
+#include <QHash>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <algorithm>
+#include <cstring>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <linux/fs.h>
+#include <linux/fiemap.h>
+#include "bcompare_snapshot.h"
+
+/** Lifetime of the snapshots listed for a mount, new ones are usually taken every hour */
+static const qint64 SNAPSHOTS_LIFETIME_MS = 60 * 1000;
+
+/** Bounds of the work done for one file */
+static const int MAX_SNAPSHOTS = 1000;
+static const qint64 MAX_SEARCH_MS = 3000;
+static const int MAX_VERSIONS = 20;
+
+/** Most extents compared, files with more are recognized by inode, time and size */
+static const int MAX_EXTENTS = 64;
+
+struct BCompareSnapshot
+{
+    QString name;
+
+    /** The folder holding the content of the mount in this snapshot */
+    QString root;
+};
+
+struct BCompareMountSnapshots
+{
+    QString mountPath;
+    QList<BCompareSnapshot> snapshots;
+    qint64 listedMs = 0;
+};
+
+/** Mutex protecting the cache of the snapshots of each mount, by device */
+static QMutex s_mutex;
+static QHash<quint64, BCompareMountSnapshots> s_mounts;
+
+struct BCompareSnapshotState
+{
+    std::atomic<bool> cancelled{false};
+
+    QPointer<BCompareSnapshotFinder> finder;
+    QString pathFile;
+};
+
+/** Numbers in snapshot names are compared by value, the newest are usually the greatest */
+static bool isNewerName(const BCompareSnapshot &a, const BCompareSnapshot &b)
+{
+    bool aNumber = false;
+    bool bNumber = false;
+    qlonglong aValue = a.name.toLongLong(&aNumber);
+    qlonglong bValue = b.name.toLongLong(&bNumber);
+
+    if (aNumber && bNumber)
+    {
+        return aValue > bValue;
+    }
+    return a.name > b.name;
+}
+
+static QList<BCompareSnapshot> listSnapshots(const QString &mountPath)
+{
+    QList<BCompareSnapshot> snapshots;
+    QDir mount(mountPath);
+
+    /* snapper keeps each snapshot in a subvolume next to its description */
+    QDir snapper(mount.absoluteFilePath(QLatin1String(".snapshots")));
+    for (const QString &name : snapper.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+    {
+        snapshots.append(BCompareSnapshot{ name, snapper.absoluteFilePath(name + QLatin1String("/snapshot")) });
+    }
+
+    /* Hidden directories, listed without mounting the snapshots */
+    for (const char *dir : { ".zfs/snapshot", ".snapshot" })
+    {
+        QDir parent(mount.absoluteFilePath(QLatin1String(dir)));
+        for (const QString &name : parent.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+        {
+            snapshots.append(BCompareSnapshot{ name, parent.absoluteFilePath(name) });
+        }
+    }
+
+    std::sort(snapshots.begin(), snapshots.end(), isNewerName);
+    return snapshots;
+}
+
+/** The snapshots of the mount holding pathFile, and the path of the file in them */
+static QList<BCompareSnapshot> snapshotsOf(const QString &pathFile, QString &relativePath)
+{
+    QString dir = QFileInfo(pathFile).absolutePath();
+    struct stat st;
+
+    if (stat(QFile::encodeName(dir).constData(), &st) != 0)
+    {
+        return QList<BCompareSnapshot>();
+    }
+
+    quint64 dev = quint64(st.st_dev);
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QString mountPath;
+
+    {
+        QMutexLocker lock(&s_mutex);
+        auto it = s_mounts.constFind(dev);
+
+        if (it != s_mounts.constEnd() && now - it->listedMs < SNAPSHOTS_LIFETIME_MS &&
+            (dir == it->mountPath || dir.startsWith(it->mountPath + QLatin1Char('/')) ||
+             it->mountPath == QLatin1String("/")))
+        {
+            relativePath = QDir(it->mountPath).relativeFilePath(pathFile);
+            return it->snapshots;
+        }
+    }
+
+    /* The root of the mount is the last parent on the same device */
+    mountPath = dir;
+    while (mountPath != QLatin1String("/"))
+    {
+        QString parent = QFileInfo(mountPath).absolutePath();
+
+        if (stat(QFile::encodeName(parent).constData(), &st) != 0 || quint64(st.st_dev) != dev)
+        {
+            break;
+        }
+        mountPath = parent;
+    }
+
+    BCompareMountSnapshots mount;
+    mount.mountPath = mountPath;
+    mount.snapshots = listSnapshots(mountPath);
+    mount.listedMs = now;
+
+    {
+        QMutexLocker lock(&s_mutex);
+        s_mounts.insert(dev, mount);
+    }
+
+    relativePath = QDir(mountPath).relativeFilePath(pathFile);
+    return mount.snapshots;
+}
+
+/**
+ * Identifies the content of a file: the list of its extents when the file
+ * system reports them all, otherwise its inode, modification time and size,
+ * which snapshots keep for the files they did not copy.
+ */
+static QByteArray contentKey(const QString &path, const struct stat &st)
+{
+    QByteArray key;
+    int fd = open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+
+    if (fd >= 0)
+    {
+        alignas(struct fiemap) char buffer[sizeof(struct fiemap) + MAX_EXTENTS * sizeof(struct fiemap_extent)];
+        struct fiemap *map = reinterpret_cast<struct fiemap*>(buffer);
+
+        memset(buffer, 0, sizeof(buffer));
+        map->fm_length = FIEMAP_MAX_OFFSET;
+        map->fm_extent_count = MAX_EXTENTS;
+
+        if (ioctl(fd, FS_IOC_FIEMAP, map) == 0 && map->fm_mapped_extents > 0 &&
+            (map->fm_extents[map->fm_mapped_extents - 1].fe_flags & FIEMAP_EXTENT_LAST))
+        {
+            key = "x:" + QByteArray::number(qlonglong(st.st_size));
+
+            for (quint32 i = 0; i < map->fm_mapped_extents; ++i)
+            {
+                const struct fiemap_extent &extent = map->fm_extents[i];
+
+                /* Extents without a stable address can not be shared */
+                if (extent.fe_flags & (FIEMAP_EXTENT_UNKNOWN | FIEMAP_EXTENT_DELALLOC |
+                                       FIEMAP_EXTENT_DATA_INLINE))
+                {
+                    key.clear();
+                    break;
+                }
+                key += ':' + QByteArray::number(qulonglong(extent.fe_physical)) +
+                       '+' + QByteArray::number(qulonglong(extent.fe_length));
+            }
+        }
+        close(fd);
+    }
+
+    if (key.isEmpty())
+    {
+        key = "i:" + QByteArray::number(qulonglong(st.st_ino)) + ':' +
+              QByteArray::number(qlonglong(st.st_mtim.tv_sec)) + '.' +
+              QByteArray::number(qlonglong(st.st_mtim.tv_nsec)) + ':' +
+              QByteArray::number(qlonglong(st.st_size));
+    }
+    return key;
+}
+
+class BCompareSnapshotTask : public QRunnable
+{
+public:
+    explicit BCompareSnapshotTask(const std::shared_ptr<BCompareSnapshotState> &state) :
+        m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        BCompareSnapshotFinder::Result result;
+        QString relativePath;
+        QList<BCompareSnapshot> snapshots = snapshotsOf(m_state->pathFile, relativePath);
+        QHash<QByteArray, int> seen;
+        QElapsedTimer timer;
+        struct stat st;
+
+        timer.start();
+        result.complete = (snapshots.size() <= MAX_SNAPSHOTS);
+
+        /* The current content is not an earlier version */
+        if (stat(QFile::encodeName(m_state->pathFile).constData(), &st) == 0)
+        {
+            seen.insert(contentKey(m_state->pathFile, st), -1);
+        }
+
+        for (const BCompareSnapshot &snapshot : snapshots.mid(0, MAX_SNAPSHOTS))
+        {
+            if (m_state->cancelled.load())
+            {
+                return;
+            }
+            if (timer.elapsed() > MAX_SEARCH_MS)
+            {
+                result.complete = false;
+                break;
+            }
+
+            QString path = QDir(snapshot.root).absoluteFilePath(relativePath);
+            if (stat(QFile::encodeName(path).constData(), &st) != 0 || !S_ISREG(st.st_mode))
+            {
+                continue;
+            }
+
+            QByteArray key = contentKey(path, st);
+            if (seen.contains(key))
+            {
+                continue;
+            }
+            seen.insert(key, result.versions.size());
+
+            BCompareSnapshotFinder::Version version;
+            version.path = path;
+            version.snapshot = snapshot.name;
+            version.modified = QDateTime::fromMSecsSinceEpoch(qint64(st.st_mtim.tv_sec) * 1000 +
+                                                              st.st_mtim.tv_nsec / 1000000);
+            result.versions.append(version);
+        }
+
+        std::sort(result.versions.begin(), result.versions.end(),
+                  [](const BCompareSnapshotFinder::Version &a, const BCompareSnapshotFinder::Version &b) {
+            return a.modified > b.modified;
+        });
+        if (result.versions.size() > MAX_VERSIONS)
+        {
+            result.versions = result.versions.mid(0, MAX_VERSIONS);
+            result.complete = false;
+        }
+
+        QPointer<BCompareSnapshotFinder> finder = m_state->finder;
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [finder, result]() {
+            if (!finder.isNull())
+            {
+                Q_EMIT finder->finished(result);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    std::shared_ptr<BCompareSnapshotState> m_state;
+};
+
+/*************************************************************
+ * Finder
+ *************************************************************/
+
+bool BCompareSnapshotFinder::hasSnapshots(const QString &pathFile)
+{
+    QString relativePath;
+    return !snapshotsOf(pathFile, relativePath).isEmpty();
+}
+
+BCompareSnapshotFinder::BCompareSnapshotFinder(const QString &pathFile, QObject *pParent) :
+    QObject(pParent), m_state(std::make_shared<BCompareSnapshotState>())
+{
+    m_state->finder = this;
+    m_state->pathFile = pathFile;
+}
+
+BCompareSnapshotFinder::~BCompareSnapshotFinder()
+{
+    cancel();
+}
+
+void BCompareSnapshotFinder::start()
+{
+    QThreadPool::globalInstance()->start(new BCompareSnapshotTask(m_state));
+}
+
+void BCompareSnapshotFinder::cancel()
+{
+    m_state->cancelled.store(true);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_SNAPSHOT_H
+#define BCOMPARE_SNAPSHOT_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QString>
+#include <QList>
+#include <memory>
+
+struct BCompareSnapshotState;
+
+/**
+ * Finds the earlier versions of a file kept by filesystem snapshots: snapper
+ * on btrfs (.snapshots/N/snapshot), ZFS (.zfs/snapshot/NAME) and NetApp
+ * (.snapshot/NAME), at the root of the mount holding the file. Versions
+ * sharing their extents, or their inode, time and size, are the same content
+ * and are listed once. The search is cancelled when this object is destroyed.
+ */
+class BCompareSnapshotFinder : public QObject
+{
+    Q_OBJECT
+public:
+    struct Version
+    {
+        /** The file in the snapshot */
+        QString path;
+
+        /** Name of the newest snapshot holding this version */
+        QString snapshot;
+
+        QDateTime modified;
+    };
+
+    struct Result
+    {
+        /** Distinct versions, newest first, without the current content */
+        QList<Version> versions;
+
+        /** False if older versions were skipped because of the work bounds */
+        bool complete;
+    };
+
+    /** Indicates if the mount holding pathFile has snapshots, from a cache */
+    static bool hasSnapshots(const QString &pathFile);
+
+    BCompareSnapshotFinder(const QString &pathFile, QObject *pParent);
+    ~BCompareSnapshotFinder() override;
+
+    void start();
+    void cancel();
+
+Q_SIGNALS:
+    void finished(const BCompareSnapshotFinder::Result &result);
+
+private:
+    std::shared_ptr<BCompareSnapshotState> m_state;
+};
+
+#endif // BCOMPARE_SNAPSHOT_H
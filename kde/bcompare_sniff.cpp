@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QPointer>
+#include <QAction>
+#include <QFile>
+#include <string.h>
+#include "bcompare_sniff.h"
+
+/** Only the beginning of the file is looked at */
+static const qint64 SNIFF_READ_SIZE = 64 * 1024;
+
+struct ExtensionKind
+{
+    const char *ext;
+    BCompareSniffer::FileKinds kind;
+};
+
+static const ExtensionKind s_extensionTable[] = {
+    { "png",  BCompareSniffer::KIND_PICTURE },
+    { "jpg",  BCompareSniffer::KIND_PICTURE },
+    { "jpeg", BCompareSniffer::KIND_PICTURE },
+    { "gif",  BCompareSniffer::KIND_PICTURE },
+    { "bmp",  BCompareSniffer::KIND_PICTURE },
+    { "tif",  BCompareSniffer::KIND_PICTURE },
+    { "tiff", BCompareSniffer::KIND_PICTURE },
+    { "webp", BCompareSniffer::KIND_PICTURE },
+    { "ico",  BCompareSniffer::KIND_PICTURE },
+    { "csv",  BCompareSniffer::KIND_TABLE },
+    { "tsv",  BCompareSniffer::KIND_TABLE },
+    { "exe",  BCompareSniffer::KIND_BINARY },
+    { "dll",  BCompareSniffer::KIND_BINARY },
+    { "so",   BCompareSniffer::KIND_BINARY },
+    { "o",    BCompareSniffer::KIND_BINARY },
+    { "a",    BCompareSniffer::KIND_BINARY },
+    { "bin",  BCompareSniffer::KIND_BINARY },
+    { "iso",  BCompareSniffer::KIND_BINARY },
+    { "img",  BCompareSniffer::KIND_BINARY },
+    { "class", BCompareSniffer::KIND_BINARY },
+    { "pyc",  BCompareSniffer::KIND_BINARY },
+    { "txt",  BCompareSniffer::KIND_TEXT },
+    { "log",  BCompareSniffer::KIND_TEXT },
+    { "md",   BCompareSniffer::KIND_TEXT },
+    { "c",    BCompareSniffer::KIND_TEXT },
+    { "h",    BCompareSniffer::KIND_TEXT },
+    { "cc",   BCompareSniffer::KIND_TEXT },
+    { "cpp",  BCompareSniffer::KIND_TEXT },
+    { "hpp",  BCompareSniffer::KIND_TEXT },
+    { "py",   BCompareSniffer::KIND_TEXT },
+    { "java", BCompareSniffer::KIND_TEXT },
+    { "js",   BCompareSniffer::KIND_TEXT },
+    { "rs",   BCompareSniffer::KIND_TEXT },
+    { "go",   BCompareSniffer::KIND_TEXT },
+    { "sh",   BCompareSniffer::KIND_TEXT },
+    { "json", BCompareSniffer::KIND_TEXT },
+    { "xml",  BCompareSniffer::KIND_TEXT },
+    { "html", BCompareSniffer::KIND_TEXT },
+    { "htm",  BCompareSniffer::KIND_TEXT },
+    { "css",  BCompareSniffer::KIND_TEXT },
+    { "ini",  BCompareSniffer::KIND_TEXT },
+    { "conf", BCompareSniffer::KIND_TEXT },
+    { "yml",  BCompareSniffer::KIND_TEXT },
+    { "yaml", BCompareSniffer::KIND_TEXT },
+};
+
+struct MagicKind
+{
+    const char *magic;
+    int offset;
+    int len;
+    BCompareSniffer::FileKinds kind;
+};
+
+/*
+ * Only magic numbers which cannot start a text file are listed, besides the
+ * byte order marks. PDF and the other formats Beyond Compare converts to text
+ * are left to its own file format rules.
+ */
+static const MagicKind s_magicTable[] = {
+    { "\x89PNG\r\n\x1a\n", 0, 8, BCompareSniffer::KIND_PICTURE },
+    { "\xff\xd8\xff",      0, 3, BCompareSniffer::KIND_PICTURE },
+    { "GIF8",              0, 4, BCompareSniffer::KIND_PICTURE },
+    { "II*\0",             0, 4, BCompareSniffer::KIND_PICTURE },
+    { "MM\0*",             0, 4, BCompareSniffer::KIND_PICTURE },
+    { "WEBP",              8, 4, BCompareSniffer::KIND_PICTURE },
+    { "\x7f" "ELF",        0, 4, BCompareSniffer::KIND_BINARY },
+    { "\xef\xbb\xbf",      0, 3, BCompareSniffer::KIND_TEXT },
+    { "\xff\xfe",          0, 2, BCompareSniffer::KIND_TEXT },
+    { "\xfe\xff",          0, 2, BCompareSniffer::KIND_TEXT },
+};
+
+/** Name prefix of the viewer used for each kind, see menu.ini "Viewers" */
+static const char *viewerPrefix(BCompareSniffer::FileKinds kind)
+{
+    switch (kind)
+    {
+        case BCompareSniffer::KIND_TEXT:
+            return "Text";
+        case BCompareSniffer::KIND_TABLE:
+            return "Table";
+        case BCompareSniffer::KIND_PICTURE:
+            return "Picture";
+        case BCompareSniffer::KIND_BINARY:
+            return "Hex";
+        default:
+            return nullptr;
+    }
+}
+
+static QString findViewer(const QStringList &listViewer, BCompareSniffer::FileKinds kind)
+{
+    const char *prefix = viewerPrefix(kind);
+
+    if (prefix != nullptr)
+    {
+        QString name = QLatin1String(prefix) + QLatin1String(" Compare");
+
+        for (const QString &viewer : listViewer)
+        {
+            if (viewer.trimmed().compare(name, Qt::CaseInsensitive) == 0)
+            {
+                return viewer.trimmed();
+            }
+        }
+    }
+
+    return QString();
+}
+
+/*************************************************************
+ * Background classification
+ *************************************************************/
+
+class BCompareSniffTask : public QRunnable
+{
+public:
+    BCompareSniffTask(QAction *action, const QStringList &listViewer,
+                      const QString &pathLeft, const QString &pathRight) :
+        m_action(action), m_listViewer(listViewer),
+        m_pathLeft(pathLeft), m_pathRight(pathRight)
+    {
+    }
+
+    void run() override
+    {
+        QString viewer = BCompareSniffer::get().preselectViewer(m_listViewer,
+                                                                m_pathLeft, m_pathRight);
+        if (viewer.isEmpty())
+        {
+            return;
+        }
+
+        /* The action lives in the GUI thread and may be gone with the menu */
+        QPointer<QAction> action = m_action;
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [action, viewer]() {
+            if (!action.isNull() && action->data().toString().isEmpty())
+            {
+                action->setData(viewer);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    QPointer<QAction> m_action;
+    QStringList m_listViewer;
+    QString m_pathLeft;
+    QString m_pathRight;
+};
+
+/*************************************************************
+ * Classifier
+ *************************************************************/
+
+BCompareSniffer& BCompareSniffer::get()
+{
+    static BCompareSniffer m_sniffer;
+    return m_sniffer;
+}
+
+BCompareSniffer::FileKinds BCompareSniffer::kindFromExtension(const QString &pathFile)
+{
+    int slash = pathFile.lastIndexOf(QLatin1Char('/'));
+    int dot = pathFile.lastIndexOf(QLatin1Char('.'));
+    if (dot <= slash + 1)
+    {
+        return KIND_UNKNOWN;
+    }
+
+    QString ext = pathFile.mid(dot + 1).toLower();
+    QMutexLocker lock(&m_mutex);
+
+    auto it = m_extCache.constFind(ext);
+    if (it != m_extCache.constEnd())
+    {
+        return it.value();
+    }
+
+    FileKinds kind = KIND_UNKNOWN;
+    for (const ExtensionKind &e : s_extensionTable)
+    {
+        if (ext == QLatin1String(e.ext))
+        {
+            kind = e.kind;
+            break;
+        }
+    }
+
+    m_extCache.insert(ext, kind);
+    return kind;
+}
+
+BCompareSniffer::FileKinds BCompareSniffer::kindFromContent(const QString &pathFile)
+{
+    QFile f(pathFile);
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        return KIND_UNKNOWN;
+    }
+
+    QByteArray head = f.read(SNIFF_READ_SIZE);
+    f.close();
+
+    if (head.isEmpty())
+    {
+        return KIND_UNKNOWN;
+    }
+
+    for (const MagicKind &m : s_magicTable)
+    {
+        if (head.size() >= m.offset + m.len &&
+            memcmp(head.constData() + m.offset, m.magic, m.len) == 0)
+        {
+            return m.kind;
+        }
+    }
+
+    /* memchr() is vectorized by the C library, this is the hot loop */
+    if (memchr(head.constData(), '\0', head.size()) != nullptr)
+    {
+        return KIND_BINARY;
+    }
+
+    /* Text without a byte order mark is left to Beyond Compare */
+    return KIND_UNKNOWN;
+}
+
+BCompareSniffer::FileKinds BCompareSniffer::classify(const QString &pathFile)
+{
+    FileKinds kind = kindFromExtension(pathFile);
+    if (kind == KIND_UNKNOWN)
+    {
+        kind = kindFromContent(pathFile);
+    }
+    return kind;
+}
+
+QString BCompareSniffer::preselectViewer(const QStringList &listViewer,
+                                         const QString &pathLeft, const QString &pathRight)
+{
+    if (listViewer.isEmpty() || pathLeft.isEmpty() || pathRight.isEmpty())
+    {
+        return QString();
+    }
+
+    FileKinds kind = classify(pathLeft);
+    if (kind == KIND_UNKNOWN || kind != classify(pathRight))
+    {
+        return QString();
+    }
+
+    return findViewer(listViewer, kind);
+}
+
+void BCompareSniffer::preselectViewerAsync(QAction *action, const QStringList &listViewer,
+                                           const QString &pathLeft, const QString &pathRight)
+{
+    QThreadPool::globalInstance()->start(
+        new BCompareSniffTask(action, listViewer, pathLeft, pathRight));
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_SNIFF_H
+#define BCOMPARE_SNIFF_H
+
+#include <QStringList>
+#include <QString>
+#include <QHash>
+#include <QMutex>
+
+class QAction;
+
+class BCompareSniffer
+{
+public:
+    /** Get a reference to the global content classifier */
+    static BCompareSniffer& get();
+
+    typedef enum {
+        KIND_UNKNOWN = 0,
+        KIND_TEXT,
+        KIND_TABLE,
+        KIND_PICTURE,
+        KIND_BINARY
+    } FileKinds;
+
+    FileKinds classify(const QString &pathFile);
+
+    /**
+     * Returns the entry of listViewer matching both files, or an empty string
+     * if Beyond Compare should do its own detection
+     */
+    QString preselectViewer(const QStringList &listViewer,
+                            const QString &pathLeft, const QString &pathRight);
+
+    /**
+     * Classify the pair in the background and store the selected viewer as the
+     * data of action, so that it is passed with -fv when the action is triggered
+     */
+    void preselectViewerAsync(QAction *action, const QStringList &listViewer,
+                              const QString &pathLeft, const QString &pathRight);
+
+private:
+    BCompareSniffer() = default;
+
+    FileKinds kindFromExtension(const QString &pathFile);
+    static FileKinds kindFromContent(const QString &pathFile);
+
+    /** Mutex protecting the extension cache */
+    QMutex m_mutex;
+
+    /** Kind associated to each lower case extension already looked up */
+    QHash<QString, FileKinds> m_extCache;
+};
+
+#endif // BCOMPARE_SNIFF_H
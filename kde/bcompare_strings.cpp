@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <KLocalizedString>
+#include <QCoreApplication>
+#include <QEvent>
+#include "bcompare_strings.h"
+
+BCompareStrings& BCompareStrings::get()
+{
+    static BCompareStrings strings;
+    return strings;
+}
+
+BCompareStrings::BCompareStrings() :
+    m_loaded(false)
+{
+    /* The application receives the event when the translators change */
+    if (QCoreApplication::instance() != nullptr)
+    {
+        QCoreApplication::instance()->installEventFilter(this);
+    }
+}
+
+bool BCompareStrings::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::LanguageChange)
+    {
+        m_loaded = false;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+const QString& BCompareStrings::text(Text id)
+{
+    if (!m_loaded)
+    {
+        load();
+    }
+    return m_texts[id];
+}
+
+QString BCompareStrings::format(Format id, const QString &arg1, const QString &arg2)
+{
+    if (!m_loaded)
+    {
+        load();
+    }
+
+    const Template &t = m_formats[id];
+    QString r = t.pieces[0];
+
+    for (int i = 0; i < t.args.size(); ++i)
+    {
+        r += (t.args[i] == 1) ? arg1 : arg2;
+        r += t.pieces[i + 1];
+    }
+    return r;
+}
+
+BCompareStrings::Template BCompareStrings::parse(const QString &translated)
+{
+    Template t;
+    int start = 0;
+
+    for (int i = 0; i + 1 < translated.size(); ++i)
+    {
+        if (translated[i] == QLatin1Char('%') &&
+            (translated[i + 1] == QLatin1Char('1') || translated[i + 1] == QLatin1Char('2')))
+        {
+            t.pieces.append(translated.mid(start, i - start));
+            t.args.append(translated[i + 1].digitValue());
+            start = i + 2;
+            ++i;
+        }
+    }
+    t.pieces.append(translated.mid(start));
+    return t;
+}
+
+void BCompareStrings::load()
+{
+    /* The arguments are substituted with their own markers, so they stay in the templates */
+    const QString a1 = QStringLiteral("%1");
+    const QString a2 = QStringLiteral("%2");
+
+    m_texts.resize(TEXT_COUNT);
+    m_texts[ACTION_COMPARE] = i18nc("@bc compare action", "Compare");
+    m_texts[ACTION_MERGE] = i18nc("@bc merge action", "Merge");
+    m_texts[ACTION_SYNC] = i18nc("@bc sync action", "Sync");
+    m_texts[TYPE_FOLDER] = i18nc("@bc selected folder type", "Folder");
+    m_texts[TYPE_FILE] = i18nc("@bc selected file type", "File");
+    m_texts[HINT_SELECT] = i18n("Remembers selected item for later comparison using Beyond Compare. "
+                                "Right-click another item to start the comparison");
+    m_texts[MENU_EDIT] = i18nc("@bc edit menu", "Edit");
+    m_texts[MENU_EDIT_WITH] = i18n("Edit with Beyond Compare");
+    m_texts[HINT_EDIT] = i18n("Edit the file using Beyond Compare");
+    m_texts[MENU_COMPARE_CLIPBOARD] = i18nc("@bc compare with clipboard menu", "Compare with Clipboard");
+    m_texts[HINT_COMPARE_CLIPBOARD] = i18n("Compare selected file with the text in the clipboard, "
+                                           "using Beyond Compare");
+    m_texts[MENU_COMPARE] = i18nc("@bc compare menu", "Compare");
+    m_texts[HINT_COMPARE] = i18n("Compare selected items using Beyond Compare");
+    m_texts[HINT_COMPARE_TO_LEFT] = i18n("Compare selected item with previously selected left item, "
+                                         "using Beyond Compare");
+    m_texts[MENU_COMPARE_USING] = i18n("Compare Using");
+    m_texts[MENU_SYNC] = i18nc("@bc sync menu", "Sync");
+    m_texts[HINT_SYNC] = i18n("Sync two selected folders");
+    m_texts[HINT_SYNC_TO_LEFT] = i18n("Sync to previously selected folder");
+    m_texts[MENU_SYNC_BACKGROUND] = i18nc("@bc sync menu", "Sync in Background (Low Priority)");
+    m_texts[MENU_MERGE] = i18nc("@bc merge menu", "Merge");
+    m_texts[HINT_MERGE_TWO] = i18n("Merge selected files (left, right)");
+    m_texts[HINT_MERGE_THREE] = i18n("Merge selected files (left, right, center)");
+    m_texts[HINT_MERGE_TO_LEFT] = i18n("Merge file with previously selected left file using Beyond Compare");
+    m_texts[HINT_MERGE_TO_CENTER] = i18n("Merge selected files (left, right) with previously selected center file");
+    m_texts[HINT_MERGE_TO_LEFT_CENTER] = i18n("Merge file with previously selected left and center files "
+                                              "using Beyond Compare");
+    m_texts[MENU_COMPARE_HEAD] = i18nc("@bc compare with git menu", "Compare with Git HEAD");
+    m_texts[HINT_COMPARE_HEAD] = i18n("Compare selected file with its last committed version, "
+                                      "using Beyond Compare");
+    m_texts[HINT_COMPARE_BACKUP] = i18n("Compare selected file with its backup copy, "
+                                        "using Beyond Compare");
+    m_texts[HINT_COMPARE_ORIGINAL] = i18n("Compare the selected backup copy with the file it was made from, "
+                                          "using Beyond Compare");
+    m_texts[MENU_RESOLVE_CONFLICT] = i18nc("@bc resolve conflict menu", "Resolve Conflict with Beyond Compare");
+    m_texts[HINT_RESOLVE_CONFLICT] = i18n("Merge the conflicting Git versions of the selected file "
+                                          "into it, using Beyond Compare");
+    m_texts[MENU_GROUP_IDENTICAL] = i18n("Group Identical Files");
+    m_texts[MENU_QUICK_VERIFY] = i18n("Quick Verify");
+    m_texts[HINT_QUICK_VERIFY] = i18n("Checks that both folders have exactly the same content, "
+                                      "without starting Beyond Compare");
+    m_texts[MENU_DIFF_REPORT] = i18n("Generate Diff Report...");
+    m_texts[HINT_DIFF_REPORT] = i18n("Writes the list of differing files to a report in the background, "
+                                     "without opening Beyond Compare");
+    m_texts[MENU_SHOW_UNCHANGED] = i18n("Show Unchanged Too");
+    m_texts[HINT_SHOW_UNCHANGED] = i18n("Also scans the subfolders whose files did not change "
+                                        "when comparing or syncing folders");
+    m_texts[MENU_BEYOND_COMPARE] = i18n("Beyond Compare");
+
+    m_formats.resize(FORMAT_COUNT);
+    m_formats[SELECT_LEFT] = parse(i18n("Select Left %1 for %2", a1, a2));
+    m_formats[SELECT_CENTER] = parse(i18n("Select Center %1", a1));
+    m_formats[COMPARE_TO] = parse(i18nc("@bc compare to menu", "Compare to \"%1\"", a1));
+    m_formats[COMPARE_TO_USING] = parse(i18n("Compare to \"%1\" Using", a1));
+    m_formats[COMPARE_WITH_SIBLING] = parse(i18nc("@bc compare with backup menu", "Compare with \"%1\"", a1));
+    m_formats[SYNC_WITH] = parse(i18nc("@bc sync with menu", "Sync with \"%1\"", a1));
+    m_formats[MERGE_WITH_LEFT] = parse(i18nc("@bc merge with left menu", "Merge with \"%1\"", a1));
+    m_formats[MERGE_WITH_CENTER] = parse(i18nc("@bc merge with center menu", "Merge with \"%1\"", a1));
+    m_formats[MERGE_WITH_LEFT_CENTER] = parse(i18nc("@bc merge with left center menu",
+                                                    "Merge with \"%1\", \"%2\"", a1, a2));
+
+    m_loaded = true;
+}
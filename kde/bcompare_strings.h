@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_STRINGS_H
+#define BCOMPARE_STRINGS_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * Translated texts of the menus, looked up in the catalog once per language.
+ * Labels with arguments are kept as preparsed templates, so building them only
+ * concatenates strings. Everything is loaded again on QEvent::LanguageChange.
+ */
+class BCompareStrings : public QObject
+{
+    Q_OBJECT
+public:
+    typedef enum {
+        ACTION_COMPARE = 0,
+        ACTION_MERGE,
+        ACTION_SYNC,
+        TYPE_FOLDER,
+        TYPE_FILE,
+        HINT_SELECT,
+        MENU_EDIT,
+        MENU_EDIT_WITH,
+        HINT_EDIT,
+        MENU_COMPARE_CLIPBOARD,
+        HINT_COMPARE_CLIPBOARD,
+        MENU_COMPARE,
+        HINT_COMPARE,
+        HINT_COMPARE_TO_LEFT,
+        MENU_COMPARE_USING,
+        MENU_SYNC,
+        HINT_SYNC,
+        HINT_SYNC_TO_LEFT,
+        MENU_SYNC_BACKGROUND,
+        MENU_MERGE,
+        HINT_MERGE_TWO,
+        HINT_MERGE_THREE,
+        HINT_MERGE_TO_LEFT,
+        HINT_MERGE_TO_CENTER,
+        HINT_MERGE_TO_LEFT_CENTER,
+        MENU_COMPARE_HEAD,
+        HINT_COMPARE_HEAD,
+        HINT_COMPARE_BACKUP,
+        HINT_COMPARE_ORIGINAL,
+        MENU_RESOLVE_CONFLICT,
+        HINT_RESOLVE_CONFLICT,
+        MENU_GROUP_IDENTICAL,
+        MENU_QUICK_VERIFY,
+        HINT_QUICK_VERIFY,
+        MENU_DIFF_REPORT,
+        HINT_DIFF_REPORT,
+        MENU_SHOW_UNCHANGED,
+        HINT_SHOW_UNCHANGED,
+        MENU_BEYOND_COMPARE,
+        TEXT_COUNT
+    } Text;
+
+    typedef enum {
+        SELECT_LEFT = 0,
+        SELECT_CENTER,
+        COMPARE_TO,
+        COMPARE_TO_USING,
+        COMPARE_WITH_SIBLING,
+        SYNC_WITH,
+        MERGE_WITH_LEFT,
+        MERGE_WITH_CENTER,
+        MERGE_WITH_LEFT_CENTER,
+        FORMAT_COUNT
+    } Format;
+
+    /** Get a reference to the global translations */
+    static BCompareStrings& get();
+
+    const QString& text(Text id);
+    QString format(Format id, const QString &arg1, const QString &arg2 = QString());
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    BCompareStrings();
+    void load();
+
+    /** Literal pieces of a format, with the argument inserted after each of them */
+    struct Template
+    {
+        QStringList pieces;
+        QVector<int> args;
+    };
+
+    static Template parse(const QString &translated);
+
+    /** Indicates if the translations below match the current language */
+    bool m_loaded;
+
+    QVector<QString> m_texts;
+    QVector<Template> m_formats;
+};
+
+#endif // BCOMPARE_STRINGS_H
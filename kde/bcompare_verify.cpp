@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QThread>
+#include <QRunnable>
+#include <QPointer>
+#include <QVector>
+#include <QMutex>
+#include <QMap>
+#include <QFile>
+#include <atomic>
+#include <climits>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#ifdef USE_LIBURING
+#include <liburing.h>
+#endif
+#include "bcompare_verify.h"
+#include "bcompare_walk.h"
+
+/** Size of the reads done on each side */
+static const int VERIFY_CHUNK_SIZE = 1024 * 1024;
+
+#ifdef USE_LIBURING
+/** Number of chunk pairs in flight, each slot owns one buffer per side */
+static const unsigned URING_SLOTS = 16;
+static const unsigned URING_CHUNK_SIZE = 256 * 1024;
+#endif
+
+struct BCompareFilePair
+{
+    QByteArray relPath;
+    qint64 size;
+};
+
+struct BCompareVerifyState
+{
+    std::atomic<bool> cancelled{false};
+    std::atomic<int> nextPair{0};
+    std::atomic<qint64> nbBytes{0};
+
+    QPointer<BCompareFolderVerifier> verifier;
+    QByteArray pathLeft;
+    QByteArray pathRight;
+    QVector<BCompareFilePair> pairs;
+
+    /** First difference found by the walk, after all the pairs listed so far */
+    BCompareFolderVerifier::DiffKinds walkDiff = BCompareFolderVerifier::DIFF_NONE;
+    QByteArray walkDiffPath;
+
+    /** Mutex protecting the members below */
+    QMutex mutex;
+    int firstDiffPair = INT_MAX;
+    BCompareFolderVerifier::DiffKinds firstDiffKind = BCompareFolderVerifier::DIFF_NONE;
+
+    void pairDiffers(int index, BCompareFolderVerifier::DiffKinds kind)
+    {
+        QMutexLocker lock(&mutex);
+        if (index < firstDiffPair)
+        {
+            firstDiffPair = index;
+            firstDiffKind = kind;
+        }
+    }
+
+    /** Pairs after a known difference do not need to be read */
+    bool isNeeded(int index)
+    {
+        QMutexLocker lock(&mutex);
+        return !cancelled.load() && index < firstDiffPair;
+    }
+};
+
+/*************************************************************
+ * Tree walk
+ *************************************************************/
+
+static bool sameLinkTarget(const QByteArray &pathLeft, const QByteArray &pathRight)
+{
+    char targetLeft[PATH_MAX], targetRight[PATH_MAX];
+    ssize_t lenLeft = readlink(pathLeft.constData(), targetLeft, sizeof(targetLeft));
+    ssize_t lenRight = readlink(pathRight.constData(), targetRight, sizeof(targetRight));
+
+    return lenLeft >= 0 && lenLeft == lenRight && memcmp(targetLeft, targetRight, lenLeft) == 0;
+}
+
+/**
+ * Pairs the entries of both trees in name order, depth first. Stops at the
+ * first difference which does not need the contents to be read.
+ */
+static bool walkFolders(BCompareVerifyState &state, const QByteArray &relPath)
+{
+    QMap<QByteArray, struct stat> entriesLeft, entriesRight;
+    QByteArray pathLeft = BCompareFolderWalk::joinPath(state.pathLeft, relPath);
+    QByteArray pathRight = BCompareFolderWalk::joinPath(state.pathRight, relPath);
+
+    if (!BCompareFolderWalk::listEntries(pathLeft, entriesLeft) ||
+        !BCompareFolderWalk::listEntries(pathRight, entriesRight))
+    {
+        state.walkDiff = BCompareFolderVerifier::DIFF_UNREADABLE;
+        state.walkDiffPath = relPath;
+        return false;
+    }
+
+    auto itLeft = entriesLeft.constBegin();
+    auto itRight = entriesRight.constBegin();
+
+    while (itLeft != entriesLeft.constEnd() || itRight != entriesRight.constEnd())
+    {
+        if (state.cancelled.load())
+        {
+            return false;
+        }
+
+        /* Names present on one side only */
+        if (itRight == entriesRight.constEnd() ||
+            (itLeft != entriesLeft.constEnd() && itLeft.key() < itRight.key()))
+        {
+            state.walkDiff = BCompareFolderVerifier::DIFF_MISSING;
+            state.walkDiffPath = BCompareFolderWalk::joinPath(relPath, itLeft.key());
+            return false;
+        }
+        if (itLeft == entriesLeft.constEnd() || itRight.key() < itLeft.key())
+        {
+            state.walkDiff = BCompareFolderVerifier::DIFF_MISSING;
+            state.walkDiffPath = BCompareFolderWalk::joinPath(relPath, itRight.key());
+            return false;
+        }
+
+        QByteArray entryPath = relPath.isEmpty() ? itLeft.key() : relPath + '/' + itLeft.key();
+        const struct stat &stLeft = itLeft.value();
+        const struct stat &stRight = itRight.value();
+
+        if ((stLeft.st_mode & S_IFMT) != (stRight.st_mode & S_IFMT))
+        {
+            state.walkDiff = BCompareFolderVerifier::DIFF_TYPE;
+            state.walkDiffPath = entryPath;
+            return false;
+        }
+
+        if (S_ISDIR(stLeft.st_mode))
+        {
+            if (!walkFolders(state, entryPath))
+            {
+                return false;
+            }
+        }
+        else if (S_ISREG(stLeft.st_mode))
+        {
+            if (stLeft.st_size != stRight.st_size)
+            {
+                state.walkDiff = BCompareFolderVerifier::DIFF_SIZE;
+                state.walkDiffPath = entryPath;
+                return false;
+            }
+            state.pairs.append(BCompareFilePair{ entryPath, stLeft.st_size });
+        }
+        else if (S_ISLNK(stLeft.st_mode))
+        {
+            if (!sameLinkTarget(BCompareFolderWalk::joinPath(state.pathLeft, entryPath),
+                                BCompareFolderWalk::joinPath(state.pathRight, entryPath)))
+            {
+                state.walkDiff = BCompareFolderVerifier::DIFF_CONTENT;
+                state.walkDiffPath = entryPath;
+                return false;
+            }
+        }
+
+        ++itLeft;
+        ++itRight;
+    }
+
+    return true;
+}
+
+/*************************************************************
+ * Content comparison
+ *************************************************************/
+
+/* Reads both files of a pair with pread(), one thread per pair */
+class BCompareVerifyTask : public QRunnable
+{
+public:
+    explicit BCompareVerifyTask(BCompareVerifyState &state) :
+        m_state(state), m_bufLeft(VERIFY_CHUNK_SIZE, Qt::Uninitialized),
+        m_bufRight(VERIFY_CHUNK_SIZE, Qt::Uninitialized)
+    {
+    }
+
+    void run() override
+    {
+        int index;
+        while ((index = m_state.nextPair.fetch_add(1)) < m_state.pairs.size() &&
+               m_state.isNeeded(index))
+        {
+            BCompareFolderVerifier::DiffKinds kind = comparePair(m_state.pairs.at(index));
+            if (kind != BCompareFolderVerifier::DIFF_NONE)
+            {
+                m_state.pairDiffers(index, kind);
+            }
+        }
+    }
+
+private:
+    BCompareFolderVerifier::DiffKinds comparePair(const BCompareFilePair &pair)
+    {
+        QByteArray pathLeft = BCompareFolderWalk::joinPath(m_state.pathLeft, pair.relPath);
+        QByteArray pathRight = BCompareFolderWalk::joinPath(m_state.pathRight, pair.relPath);
+        int fdLeft = open(pathLeft.constData(), O_RDONLY | O_CLOEXEC);
+        int fdRight = open(pathRight.constData(), O_RDONLY | O_CLOEXEC);
+        BCompareFolderVerifier::DiffKinds kind = BCompareFolderVerifier::DIFF_NONE;
+
+        if (fdLeft < 0 || fdRight < 0)
+        {
+            kind = BCompareFolderVerifier::DIFF_UNREADABLE;
+        }
+        else
+        {
+            posix_fadvise(fdLeft, 0, 0, POSIX_FADV_SEQUENTIAL);
+            posix_fadvise(fdRight, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+            for (qint64 offset = 0; offset < pair.size && !m_state.cancelled.load(); )
+            {
+                size_t len = qMin<qint64>(VERIFY_CHUNK_SIZE, pair.size - offset);
+                if (pread(fdLeft, m_bufLeft.data(), len, offset) != ssize_t(len) ||
+                    pread(fdRight, m_bufRight.data(), len, offset) != ssize_t(len))
+                {
+                    kind = BCompareFolderVerifier::DIFF_UNREADABLE;
+                    break;
+                }
+
+                /* memcmp() is vectorized by the C library */
+                if (memcmp(m_bufLeft.constData(), m_bufRight.constData(), len) != 0)
+                {
+                    kind = BCompareFolderVerifier::DIFF_CONTENT;
+                    break;
+                }
+
+                offset += len;
+                m_state.nbBytes += len;
+            }
+        }
+
+        if (fdLeft >= 0)
+        {
+            close(fdLeft);
+        }
+        if (fdRight >= 0)
+        {
+            close(fdRight);
+        }
+
+        return kind;
+    }
+
+    BCompareVerifyState &m_state;
+    QByteArray m_bufLeft;
+    QByteArray m_bufRight;
+};
+
+static void compareWithThreads(BCompareVerifyState &state)
+{
+    /* A private pool, the global one runs the caller */
+    QThreadPool pool;
+    int nbThreads = qBound(1, QThread::idealThreadCount(), 8);
+
+    pool.setMaxThreadCount(nbThreads);
+    for (int i = 0; i < nbThreads; ++i)
+    {
+        pool.start(new BCompareVerifyTask(state));
+    }
+    pool.waitForDone();
+}
+
+#ifdef USE_LIBURING
+struct UringSlot
+{
+    int pair;
+    unsigned len;
+    int pendingReads;
+    bool failed;
+};
+
+struct UringFiles
+{
+    int fdLeft = -1;
+    int fdRight = -1;
+    int inFlight = 0;
+};
+
+static void closeFiles(UringFiles &files)
+{
+    if (files.fdLeft >= 0)
+    {
+        close(files.fdLeft);
+    }
+    if (files.fdRight >= 0)
+    {
+        close(files.fdRight);
+    }
+    files.fdLeft = files.fdRight = -1;
+}
+
+/**
+ * Reads chunks of the pairs in order, several in flight at once, into buffers
+ * registered with the kernel. Returns false if io_uring can not be used.
+ */
+static bool compareWithUring(BCompareVerifyState &state)
+{
+    struct io_uring ring;
+    if (io_uring_queue_init(URING_SLOTS * 2, &ring, 0) < 0)
+    {
+        return false;
+    }
+
+    std::unique_ptr<char[]> buffers(new char[URING_SLOTS * 2 * URING_CHUNK_SIZE]);
+    struct iovec iov[URING_SLOTS * 2];
+    for (unsigned i = 0; i < URING_SLOTS * 2; ++i)
+    {
+        iov[i].iov_base = buffers.get() + i * URING_CHUNK_SIZE;
+        iov[i].iov_len = URING_CHUNK_SIZE;
+    }
+    bool fixedBuffers = (io_uring_register_buffers(&ring, iov, URING_SLOTS * 2) == 0);
+
+    QVector<UringSlot> slots(URING_SLOTS);
+    QVector<int> freeSlots;
+    for (unsigned i = 0; i < URING_SLOTS; ++i)
+    {
+        freeSlots.append(i);
+    }
+
+    QVector<UringFiles> files(state.pairs.size());
+    int nextPair = 0;
+    qint64 nextOffset = 0;
+
+    for (;;)
+    {
+        /* Queue the next chunks while there are free buffers */
+        while (!freeSlots.isEmpty() && nextPair < state.pairs.size() && state.isNeeded(nextPair))
+        {
+            const BCompareFilePair &pair = state.pairs.at(nextPair);
+            UringFiles &f = files[nextPair];
+
+            if (nextOffset == 0)
+            {
+                QByteArray pathLeft = BCompareFolderWalk::joinPath(state.pathLeft, pair.relPath);
+                QByteArray pathRight = BCompareFolderWalk::joinPath(state.pathRight, pair.relPath);
+                f.fdLeft = open(pathLeft.constData(), O_RDONLY | O_CLOEXEC);
+                f.fdRight = open(pathRight.constData(), O_RDONLY | O_CLOEXEC);
+                if (f.fdLeft < 0 || f.fdRight < 0)
+                {
+                    closeFiles(f);
+                    state.pairDiffers(nextPair++, BCompareFolderVerifier::DIFF_UNREADABLE);
+                    continue;
+                }
+            }
+
+            int slot = freeSlots.takeLast();
+            unsigned len = qMin<qint64>(URING_CHUNK_SIZE, pair.size - nextOffset);
+            slots[slot] = UringSlot{ nextPair, len, 2, false };
+
+            for (int side = 0; side < 2; ++side)
+            {
+                struct io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+                int fd = (side == 0) ? f.fdLeft : f.fdRight;
+                void *buf = iov[slot * 2 + side].iov_base;
+
+                if (fixedBuffers)
+                {
+                    io_uring_prep_read_fixed(sqe, fd, buf, len, nextOffset, slot * 2 + side);
+                }
+                else
+                {
+                    io_uring_prep_read(sqe, fd, buf, len, nextOffset);
+                }
+                io_uring_sqe_set_data64(sqe, slot * 2 + side);
+            }
+            f.inFlight++;
+
+            nextOffset += len;
+            if (nextOffset >= pair.size)
+            {
+                nextPair++;
+                nextOffset = 0;
+            }
+        }
+
+        if (freeSlots.size() == int(URING_SLOTS))
+        {
+            break;
+        }
+
+        io_uring_submit_and_wait(&ring, 1);
+
+        struct io_uring_cqe *cqe;
+        while (io_uring_peek_cqe(&ring, &cqe) == 0)
+        {
+            unsigned index = unsigned(io_uring_cqe_get_data64(cqe));
+            UringSlot &s = slots[index / 2];
+
+            if (cqe->res != int(s.len))
+            {
+                s.failed = true;
+            }
+            io_uring_cqe_seen(&ring, cqe);
+
+            if (--s.pendingReads > 0)
+            {
+                continue;
+            }
+
+            const char *bufLeft = static_cast<const char*>(iov[(index & ~1u)].iov_base);
+            const char *bufRight = static_cast<const char*>(iov[(index | 1u)].iov_base);
+
+            if (s.failed)
+            {
+                state.pairDiffers(s.pair, BCompareFolderVerifier::DIFF_UNREADABLE);
+            }
+            else if (memcmp(bufLeft, bufRight, s.len) != 0)
+            {
+                state.pairDiffers(s.pair, BCompareFolderVerifier::DIFF_CONTENT);
+            }
+            else
+            {
+                state.nbBytes += s.len;
+            }
+
+            /* The files are closed with their last chunk */
+            UringFiles &f = files[s.pair];
+            if (--f.inFlight == 0 && (s.pair < nextPair || !state.isNeeded(s.pair)))
+            {
+                closeFiles(f);
+            }
+            freeSlots.append(index / 2);
+        }
+    }
+
+    for (UringFiles &f : files)
+    {
+        closeFiles(f);
+    }
+
+    if (fixedBuffers)
+    {
+        io_uring_unregister_buffers(&ring);
+    }
+    io_uring_queue_exit(&ring);
+
+    return true;
+}
+#endif
+
+/*************************************************************
+ * Background check
+ *************************************************************/
+
+class BCompareVerifyFoldersTask : public QRunnable
+{
+public:
+    explicit BCompareVerifyFoldersTask(const std::shared_ptr<BCompareVerifyState> &state) :
+        m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        bool walkComplete = walkFolders(*m_state, QByteArray());
+        if (m_state->cancelled.load())
+        {
+            return;
+        }
+
+        qint64 startRead = timer.nsecsElapsed();
+        bool compared = false;
+#ifdef USE_LIBURING
+        compared = compareWithUring(*m_state);
+#endif
+        if (!compared)
+        {
+            compareWithThreads(*m_state);
+        }
+        qint64 readTime = timer.nsecsElapsed() - startRead;
+
+        if (m_state->cancelled.load())
+        {
+            return;
+        }
+
+        BCompareFolderVerifier::Result result;
+        result.diffKind = BCompareFolderVerifier::DIFF_NONE;
+        result.nbFiles = m_state->pairs.size();
+        result.nbBytes = m_state->nbBytes.load();
+        result.throughput = (readTime > 0) ? (2.0 * result.nbBytes) / readTime : 0.0;
+
+        {
+            QMutexLocker lock(&m_state->mutex);
+            if (m_state->firstDiffPair < m_state->pairs.size())
+            {
+                result.diffKind = m_state->firstDiffKind;
+                result.diffPath = QFile::decodeName(m_state->pairs.at(m_state->firstDiffPair).relPath);
+            }
+            else if (!walkComplete)
+            {
+                result.diffKind = m_state->walkDiff;
+                result.diffPath = QFile::decodeName(m_state->walkDiffPath);
+            }
+        }
+
+        QPointer<BCompareFolderVerifier> verifier = m_state->verifier;
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [verifier, result]() {
+            if (!verifier.isNull())
+            {
+                Q_EMIT verifier->finished(result);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    std::shared_ptr<BCompareVerifyState> m_state;
+};
+
+/*************************************************************
+ * Verifier
+ *************************************************************/
+
+BCompareFolderVerifier::BCompareFolderVerifier(const QString &pathLeft, const QString &pathRight,
+                                               QObject *pParent) :
+    QObject(pParent), m_state(std::make_shared<BCompareVerifyState>())
+{
+    m_state->verifier = this;
+    m_state->pathLeft = QFile::encodeName(pathLeft);
+    m_state->pathRight = QFile::encodeName(pathRight);
+}
+
+BCompareFolderVerifier::~BCompareFolderVerifier()
+{
+    cancel();
+}
+
+void BCompareFolderVerifier::start()
+{
+    QThreadPool::globalInstance()->start(new BCompareVerifyFoldersTask(m_state));
+}
+
+void BCompareFolderVerifier::cancel()
+{
+    m_state->cancelled.store(true);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BCOMPARE_VERIFY_H
+#define BCOMPARE_VERIFY_H
+
+#include <QObject>
+#include <QString>
+#include <memory>
+
+struct BCompareVerifyState;
+
+/**
+ * Checks that two folders are byte-identical without starting Beyond Compare.
+ * Both trees are walked together to pair their entries, then the contents of
+ * the pairs are read in batches, through io_uring when available, and compared.
+ * The check is cancelled when this object is destroyed.
+ */
+class BCompareFolderVerifier : public QObject
+{
+    Q_OBJECT
+public:
+    typedef enum {
+        DIFF_NONE = 0,
+        DIFF_MISSING,
+        DIFF_TYPE,
+        DIFF_SIZE,
+        DIFF_CONTENT,
+        DIFF_UNREADABLE
+    } DiffKinds;
+
+    struct Result
+    {
+        /** Kind of the first difference, DIFF_NONE if the folders are identical */
+        DiffKinds diffKind;
+
+        /** Path of the first difference, relative to the compared folders */
+        QString diffPath;
+
+        /** Number of file pairs and bytes per side compared */
+        qint64 nbFiles;
+        qint64 nbBytes;
+
+        /** Read throughput of both sides, in GB/s */
+        double throughput;
+    };
+
+    BCompareFolderVerifier(const QString &pathLeft, const QString &pathRight, QObject *pParent);
+    ~BCompareFolderVerifier() override;
+
+    void start();
+    void cancel();
+
+Q_SIGNALS:
+    void finished(const BCompareFolderVerifier::Result &result);
+
+private:
+    std::shared_ptr<BCompareVerifyState> m_state;
+};
+
+#endif // BCOMPARE_VERIFY_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Scooter Software, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <string.h>
+#include "bcompare_walk.h"
+
+bool BCompareFolderWalk::listEntries(const QByteArray &pathFolder,
+                                     QMap<QByteArray, struct stat> &entries)
+{
+    DIR *dir = opendir(pathFolder.constData());
+    if (dir == nullptr)
+    {
+        return false;
+    }
+
+    /* readdir() is backed by getdents64, the attributes are read relative to the open directory */
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != nullptr)
+    {
+        if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0)
+        {
+            continue;
+        }
+
+        struct stat st;
+        if (fstatat(dirfd(dir), ent->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0)
+        {
+            entries.insert(QByteArray(ent->d_name), st);
+        }
+    }
+
+    closedir(dir);
+    return true;
+}
+
+QByteArray BCompareFolderWalk::joinPath(const QByteArray &dir, const QByteArray &name)
+{
+    return name.isEmpty() ? dir : dir + '/' + name;
+}
@@ -8,11 +8,37 @@
 #include <string.h>
 #include <curses.h>
 #include <glib/gstdio.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <dirent.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <link.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#include <linux/fiemap.h>
 
 #include <libnemo-extension/nemo-file-info.h>
+#include <libnemo-extension/nemo-info-provider.h>
 #include <libnemo-extension/nemo-menu-provider.h>
 #include <libnemo-extension/nemo-menu.h>
 
+#ifdef USE_LIBURING
+#include <liburing.h>
+#endif
+#ifdef USE_XXHASH
+#include <xxhash.h>
+#endif
+
+#ifdef USE_LIBGIT2
+#include <git2.h>
+#endif
+
 #define DIR_PERM (S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH)
 #define GBOOLEAN_TO_POINTER(i) (GINT_TO_POINTER ((i) ? 2 : 1))
 #define GPOINTER_TO_BOOLEAN(i) ((gboolean) ((GPOINTER_TO_INT(i) == 2) ? TRUE : FALSE))
@@ -38,6 +64,7 @@ typedef struct {
 	int MaskCnt;
 	gchar **Viewers;
 	int ViewerCnt;
+	gchar **BackupSuffixes;
 	gboolean LeftIsDir;
 	GString *LeftFile;
 	GString *RightFile;
@@ -45,6 +72,14 @@ typedef struct {
 	GString *StorageDir;
 	GString *LeftFileStorage;
 	GString *CenterFileStorage;
+	GString *ShowUnchangedStorage;
+	GString *GenerationStorage;
+	gchar *Generation;
+	guint UpdateSource;
+	GFileMonitor *GenerationMonitor;
+	struct _DupJob *DupJob;
+	GHashTable *PathTypes;
+	GQueue *PathTypeOrder;
 } BCompareExt;
 
 typedef struct BCompareExtClass {
@@ -76,11 +111,38 @@ static void setup_display(gpointer data)
 		g_setenv("DISPLAY", pDisplayName, TRUE);
 }
 
-static void spawn_bc(GtkWidget *window, char **argv)
+/* Closes the in-memory files published for a launch, see memfd_publish */
+static void memfd_close_all(GList *fds)
+{
+	GList *l;
+
+	for (l = fds; l != NULL; l = l->next)
+		close(GPOINTER_TO_INT(l->data));
+	g_list_free(fds);
+}
+
+/* Closes the in-memory files read by a process which exited */
+static void memfd_release(GPid pid, gint status, gpointer data)
+{
+	memfd_close_all((GList *)data);
+	g_spawn_close_pid(pid);
+}
+
+/*
+ * fds are the in-memory files published for this launch only. They are
+ * closed once the process exits, or right away if it cannot be started.
+ */
+static void spawn_bc_setup(
+		GtkWidget *window,
+		char **argv,
+		GSpawnChildSetupFunc child_setup,
+		GList *fds)
 {
 	GdkDisplay *gDisplay = gtk_widget_get_display(window);
 	GError *error = NULL;
 	char *display = NULL;
+	GSpawnFlags flags = G_SPAWN_FILE_AND_ARGV_ZERO | G_SPAWN_SEARCH_PATH;
+	GPid pid;
 
 	if (gDisplay != NULL) {
 		display = (char *)gdk_display_get_name(gDisplay);
@@ -88,9 +150,14 @@ static void spawn_bc(GtkWidget *window, char **argv)
 		display = NULL;
 	}
 
-	if (g_spawn_async(NULL, argv, NULL,
-			G_SPAWN_FILE_AND_ARGV_ZERO | G_SPAWN_SEARCH_PATH, 
-			setup_display, display, NULL, &error) != TRUE) {
+	/*
+	 * Beyond Compare opens the in-memory files through this process, so they
+	 * stay open until it exits, and their descriptors are not reused meanwhile
+	 */
+	if (fds != NULL) flags |= G_SPAWN_DO_NOT_REAP_CHILD;
+
+	if (g_spawn_async(NULL, argv, NULL, flags,
+			child_setup, display, &pid, &error) != TRUE) {
 		GtkWindow *parent;
 		GtkMessageDialog *dialog;
 		gchar *cmd_line = g_strjoinv(" ", &argv[1]);
@@ -109,36 +176,203 @@ static void spawn_bc(GtkWidget *window, char **argv)
 				G_CALLBACK(gtk_widget_destroy), dialog);
 		gtk_widget_show_all(GTK_WIDGET(dialog));
 		g_error_free(error);
+		memfd_close_all(fds);
+	}
+	else if (flags & G_SPAWN_DO_NOT_REAP_CHILD) {
+		g_child_watch_add(pid, memfd_release, fds);
 	}
 }
 
-static void clear_selections(BCompareExt *bcobj)
+static void spawn_bc(GtkWidget *window, char **argv)
 {
-	g_unlink(bcobj->LeftFileStorage->str);
-	g_unlink(bcobj->CenterFileStorage->str);
+	spawn_bc_setup(window, argv, setup_display, NULL);
 }
 
-static void alert_updated(BCompareExt *bcobj)
+/* Gives Beyond Compare the in-memory files fds published for it */
+static void spawn_bc_memfds(GtkWidget *window, char **argv, GList *fds)
+{
+	spawn_bc_setup(window, argv, setup_display, fds);
+}
+
+/* Not exported by the C library, see ioprio_set(2) */
+#define IOPRIO_WHO_PROCESS 1
+#define IOPRIO_CLASS_IDLE 3
+#define IOPRIO_CLASS_SHIFT 13
+
+/* Limits of the transient cgroup, see systemd.resource-control(5) */
+#define CGROUP_CPU_QUOTA "CPUQuota=50%"
+#define CGROUP_IO_BANDWIDTH "50M"
+
+static void setup_low_priority(gpointer data)
+{
+	struct sched_param param;
+
+	if (data != NULL) setup_display(data);
+
+	/* Idle classes only, the desktop never waits for this process */
+	syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0,
+		IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+	memset(&param, 0, sizeof(param));
+	if (sched_setscheduler(0, SCHED_IDLE, &param) != 0)
+		setpriority(PRIO_PROCESS, 0, 19);
+}
+
+/* The scope is created by the user manager, in the unified hierarchy */
+static gboolean has_cgroup_scopes(void)
+{
+	gchar *program = g_find_program_in_path("systemd-run");
+	gchar *manager = g_build_filename(g_get_user_runtime_dir(), "systemd", NULL);
+	gboolean available = (program != NULL) &&
+		g_file_test(manager, G_FILE_TEST_IS_DIR) &&
+		g_file_test("/sys/fs/cgroup/cgroup.controllers", G_FILE_TEST_EXISTS);
+
+	g_free(manager);
+	g_free(program);
+	return available;
+}
+
+/*
+ * Runs Beyond Compare at idle I/O and CPU priority, inside a transient
+ * cgroup limiting its CPU and disk bandwidth when systemd can create one.
+ */
+static void spawn_bc_low_priority(GtkWidget *window, char **argv)
+{
+	static const char *scope_args[] = {
+		"systemd-run", "systemd-run", "--user", "--scope", "--quiet", "--collect",
+		"-p", CGROUP_CPU_QUOTA
+	};
+	GPtrArray *command = g_ptr_array_new_with_free_func(g_free);
+	guint i;
+
+	if (has_cgroup_scopes()) {
+		for (i = 0; i < G_N_ELEMENTS(scope_args); i++)
+			g_ptr_array_add(command, g_strdup(scope_args[i]));
+
+		/* systemd finds the device of a path, which must not contain spaces */
+		for (i = 2; argv[i] != NULL; i++) {
+			if (g_file_test(argv[i], G_FILE_TEST_IS_DIR) && (strchr(argv[i], ' ') == NULL)) {
+				g_ptr_array_add(command, g_strdup("-p"));
+				g_ptr_array_add(command, g_strdup_printf(
+					"IOReadBandwidthMax=%s %s", argv[i], CGROUP_IO_BANDWIDTH));
+				g_ptr_array_add(command, g_strdup("-p"));
+				g_ptr_array_add(command, g_strdup_printf(
+					"IOWriteBandwidthMax=%s %s", argv[i], CGROUP_IO_BANDWIDTH));
+			}
+		}
+		g_ptr_array_add(command, g_strdup("--"));
+
+		for (i = 1; argv[i] != NULL; i++)
+			g_ptr_array_add(command, g_strdup(argv[i]));
+	}
+	else {
+		for (i = 0; argv[i] != NULL; i++)
+			g_ptr_array_add(command, g_strdup(argv[i]));
+	}
+	g_ptr_array_add(command, NULL);
+
+	spawn_bc_setup(window, (char **)command->pdata, setup_low_priority, NULL);
+	g_ptr_array_unref(command);
+}
+
+/*
+ * The saved selections are shared by every window and file manager process.
+ * Each change of them rewrites atomically a token, made of the process id, a
+ * count of its own changes and the time, which the processes watch to build
+ * their menus again, once for a burst of changes.
+ */
+#define UPDATE_COALESCE_MS 100
+
+static gchar * generation_read(BCompareExt *bcobj)
 {
+	gchar *contents = NULL;
+
+	g_file_get_contents(bcobj->GenerationStorage->str, &contents, NULL, NULL);
+	return contents;
+}
+
+static gboolean alert_updated_now(gpointer data)
+{
+	BCompareExt *bcobj = (BCompareExt *)data;
+
+	bcobj->UpdateSource = 0;
 	g_signal_emit_by_name((NemoMenuProvider *)bcobj, "items_updated");
+	return G_SOURCE_REMOVE;
 }
 
-static gboolean file_is_dir(BCompareExt *bcobj, char *filepath)
+static void alert_updated(BCompareExt *bcobj)
 {
-	gboolean isdir;
+	if (bcobj->UpdateSource == 0)
+		bcobj->UpdateSource = g_timeout_add(UPDATE_COALESCE_MS, alert_updated_now, bcobj);
+}
+
+static void generation_changed(GFileMonitor *monitor, GFile *file,
+		GFile *other, GFileMonitorEvent event, gpointer data)
+{
+	BCompareExt *bcobj = (BCompareExt *)data;
+	gchar *generation = generation_read(bcobj);
+
+	/* The last change saved by this process was already shown */
+	if (g_strcmp0(generation, bcobj->Generation) != 0) {
+		g_free(bcobj->Generation);
+		bcobj->Generation = generation;
+		alert_updated(bcobj);
+	}
+	else g_free(generation);
+}
+
+/* Tells every process about a change of the saved selections */
+static void selection_changed(BCompareExt *bcobj)
+{
+	static guint changes = 0;
+
+	/* Unique to this change, nothing is read back so no concurrent change is lost */
+	g_free(bcobj->Generation);
+	bcobj->Generation = g_strdup_printf("%d:%u:%" G_GINT64_FORMAT "\n",
+		(int)getpid(), ++changes, g_get_real_time());
+	g_mkdir_with_parents(bcobj->StorageDir->str, DIR_PERM);
+	g_file_set_contents(bcobj->GenerationStorage->str, bcobj->Generation, -1, NULL);
+
+	alert_updated(bcobj);
+}
+
+/* Saves path to storage, nothing changes if it was already saved */
+static void selection_save(BCompareExt *bcobj, const char *storage, const char *path)
+{
+	gchar *saved = NULL;
+
+	if (g_file_get_contents(storage, &saved, NULL, NULL) &&
+			(strcmp(g_strstrip(saved), path) == 0)) {
+		g_free(saved);
+		return;
+	}
+	g_free(saved);
+
+	g_mkdir_with_parents(bcobj->StorageDir->str, DIR_PERM);
+	g_file_set_contents(storage, path, -1, NULL);
+	selection_changed(bcobj);
+}
+
+static void clear_selections(BCompareExt *bcobj)
+{
+	gboolean cleared = (g_unlink(bcobj->LeftFileStorage->str) == 0);
+
+	if (g_unlink(bcobj->CenterFileStorage->str) == 0) cleared = TRUE;
+	if (cleared) selection_changed(bcobj);
+}
+
+static gboolean file_is_archive(BCompareExt *bcobj, const char *filepath)
+{
+	gboolean isarchive = FALSE;
 	int mcnt;
 	gchar *basename = g_path_get_basename(filepath);
 
-	isdir = g_file_test(filepath, G_FILE_TEST_IS_DIR);
-	if (!isdir) {
-		for (mcnt = 0; mcnt < bcobj->MaskCnt; mcnt++) {
-			isdir = isdir |
-				g_str_has_suffix(basename, bcobj->Masks[mcnt]);
-		}
+	for (mcnt = 0; mcnt < bcobj->MaskCnt; mcnt++) {
+		isarchive = isarchive |
+			g_str_has_suffix(basename, bcobj->Masks[mcnt]);
 	}
 
 	g_free(basename);
-	return isdir;
+	return isarchive;
 }
 
 static gchar * nemo_to_path(NemoFileInfo* file)
@@ -148,418 +382,6348 @@ static gchar * nemo_to_path(NemoFileInfo* file)
 
 /*************************************************************
  *
- * Action callbacks
+ * Warm start of Beyond Compare
  *
  *************************************************************/
-static void select_left_action(BcMenuItem *item, BCompareExt *bcobj)
+
+/* Shortest time between two warm starts */
+#define WARM_INTERVAL_USEC (10 * 60 * G_USEC_PER_SEC)
+
+/* Most files read ahead by a warm start, the library closure is usually far smaller */
+#define MAX_WARMED_FILES 128
+
+/* Files with this part of their pages in the page cache are not read again */
+#define RESIDENT_PERCENT 90
+
+static gint warm_running = 0;
+static gint64 warm_last = 0;
+G_LOCK_DEFINE_STATIC(warm);
+
+/* Adds the real path of a regular file to files, once */
+static void warm_add_file(GPtrArray *files, GHashTable *visited, const gchar *path)
 {
-	GString *left_file;
-	FILE *fileptr;
+	char *real = realpath(path, NULL);
 
-	left_file =
-		(GString *)g_object_get_data((GObject *)item, "bcext::left_path");
-	g_mkdir_with_parents(bcobj->StorageDir->str, DIR_PERM);
-	fileptr = g_fopen(bcobj->LeftFileStorage->str, "w");
-	if (fileptr != NULL) {
-		if (left_file != NULL)
-			fputs(left_file->str, fileptr);
-		else fputs("", fileptr);
-		fclose(fileptr);
+	if (real == NULL) return;
+	if (g_file_test(real, G_FILE_TEST_IS_REGULAR) &&
+	    !g_hash_table_contains(visited, real)) {
+		g_hash_table_add(visited, g_strdup(real));
+		g_ptr_array_add(files, g_strdup(real));
 	}
-	if (left_file != NULL) g_string_free(left_file, TRUE);
+	free(real);
+}
 
-	alert_updated(bcobj);
+/* The bcompare launcher, usually a script, and the binary it runs */
+static void warm_program_files(GPtrArray *files, GHashTable *visited)
+{
+	static const char *binaries[] = {
+		"BCompare", "../lib/beyondcompare/BCompare", "../lib64/beyondcompare/BCompare"
+	};
+	gchar *launcher = g_find_program_in_path("bcompare");
+	char *real;
+	gchar *dir, *path;
+	guint i;
+
+	if (launcher == NULL) return;
+	real = realpath(launcher, NULL);
+	if (real != NULL) {
+		warm_add_file(files, visited, real);
+		dir = g_path_get_dirname(real);
+		for (i = 0; i < G_N_ELEMENTS(binaries); i++) {
+			path = g_build_filename(dir, binaries[i], NULL);
+			warm_add_file(files, visited, path);
+			g_free(path);
+		}
+		g_free(dir);
+		free(real);
+	}
+	g_free(launcher);
 }
 
-static void select_center_action(BcMenuItem *item, BCompareExt *bcobj)
+static int warm_find_libc(struct dl_phdr_info *info, size_t size, void *data)
 {
-	GString *center_file;
-	FILE *fileptr;
+	const char *name = (info->dlpi_name != NULL) ? strrchr(info->dlpi_name, '/') : NULL;
 
-	center_file =
-		(GString *)g_object_get_data((GObject *)item, "bcext::center_file");
-	g_mkdir_with_parents(bcobj->StorageDir->str, DIR_PERM);
-	fileptr = g_fopen(bcobj->CenterFileStorage->str, "w");
-	if (fileptr != NULL) {
-		if (center_file != NULL)
-			fputs(center_file->str, fileptr);
-		else fputs("", fileptr);
-		fclose(fileptr);
+	if (name != NULL && strncmp(name, "/libc.so", 8) == 0) {
+		*(gchar **)data = g_path_get_dirname(info->dlpi_name);
+		return 1;
 	}
-	if (center_file != NULL) g_string_free(center_file, TRUE);
-
-	alert_updated(bcobj);
+	return 0;
 }
 
-static void edit_file_action(BcMenuItem *item, BCompareExt *bcobj)
+/* The folders searched by the dynamic loader after the run paths */
+static void warm_system_dirs(GPtrArray *dirs)
 {
-	GString *edit_file;
-	char *argv[5];
-
-	edit_file =
-		(GString *)g_object_get_data((GObject *)item, "bcext::edit_file");
-	argv[0] = "bcompare";
-	argv[1] = "bcompare";
-	argv[2] = "-edit";
-	if (edit_file != NULL)
-		argv[3] = edit_file->str;
-	else argv[3] = "";
-	argv[4] = 0;
+	static const char *defaults[] = { "/lib64", "/usr/lib64", "/lib", "/usr/lib" };
+	gchar *libc_dir = NULL;
+	guint i;
+
+	/* The folder of the C library loaded here includes the multiarch triplet */
+	dl_iterate_phdr(warm_find_libc, &libc_dir);
+	if (libc_dir != NULL) {
+		g_ptr_array_add(dirs, g_strdup(libc_dir));
+		if (g_str_has_prefix(libc_dir, "/usr/"))
+			g_ptr_array_add(dirs, g_strdup(libc_dir + 4));
+		else g_ptr_array_add(dirs, g_strconcat("/usr", libc_dir, NULL));
+		g_free(libc_dir);
+	}
+	for (i = 0; i < G_N_ELEMENTS(defaults); i++)
+		g_ptr_array_add(dirs, g_strdup(defaults[i]));
+}
 
-	spawn_bc(bcobj->Winder, argv);
-	clear_selections(bcobj);
+/* Offset in the file of an address of a loaded segment, size if there is none */
+static gsize elf_offset(const ElfW(Ehdr) *ehdr, const ElfW(Phdr) *phdrs,
+			ElfW(Addr) addr, gsize size)
+{
+	int i;
 
-	if (edit_file != NULL) g_string_free(edit_file, TRUE);
+	for (i = 0; i < ehdr->e_phnum; i++) {
+		if (phdrs[i].p_type == PT_LOAD && addr >= phdrs[i].p_vaddr &&
+		    addr < phdrs[i].p_vaddr + phdrs[i].p_filesz)
+			return phdrs[i].p_offset + (addr - phdrs[i].p_vaddr);
+	}
+	return size;
 }
 
-static void compare_action(BcMenuItem *item, BCompareExt *bcobj)
+static gchar * elf_expand_origin(const gchar *dir, const gchar *origin)
 {
-	GString *left_file, *right_file;
-	GString *msg = g_string_new("");
-	char *fileviewer;
-	char *argv[6];
-	int cnt = 0;
-
-	left_file =
-		(GString *)g_object_get_data((GObject *)item, "bcext::left_file");
-	right_file =
-		(GString *)g_object_get_data((GObject *)item, "bcext::right_file");
-	fileviewer =
-		(char *)g_object_get_data((GObject *)item, "bcext::fileviewer");
+	GString *expanded = g_string_new(NULL);
 
-	argv[cnt++] = "bcompare";
-	argv[cnt++] = "bcompare";
-	if (strcmp(fileviewer, "") != 0) {
-		g_string_printf(msg, "-fv=\"%s\"", fileviewer);
-		argv[cnt++] = msg->str;
+	while (*dir != '\0') {
+		if (g_str_has_prefix(dir, "${ORIGIN}")) {
+			g_string_append(expanded, origin);
+			dir += 9;
+		}
+		else if (g_str_has_prefix(dir, "$ORIGIN")) {
+			g_string_append(expanded, origin);
+			dir += 7;
+		}
+		else g_string_append_c(expanded, *dir++);
 	}
-	if (left_file != NULL)
-		argv[cnt++] = left_file->str;
-	else argv[cnt++] = "";
-	if (right_file != NULL)
-		argv[cnt++] = right_file->str;
-	else argv[cnt++] = "";
-	argv[cnt++] = 0;
+	return g_string_free(expanded, FALSE);
+}
 
-	spawn_bc(bcobj->Winder, argv);
-	clear_selections(bcobj);
+/*
+ * Reads the libraries needed by an ELF file of the native class, and the
+ * folders of its run paths. Returns FALSE if data is not such a file.
+ */
+static gboolean elf_dynamic(const guchar *data, gsize size, const gchar *origin,
+			    GPtrArray *needed, GPtrArray *run_paths)
+{
+	const ElfW(Ehdr) *ehdr = (const ElfW(Ehdr) *)data;
+	const ElfW(Phdr) *phdrs, *dynamic = NULL;
+	const ElfW(Dyn) *dyn;
+	gsize nb_dyn, strtab = size, strsz = 0, i;
+	const char *str;
+	gchar **dirs;
+	gchar *paths;
+	int p, d;
+
+	if (size < sizeof(ElfW(Ehdr)) || memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 ||
+	    ehdr->e_ident[EI_CLASS] != ((sizeof(void *) == 8) ? ELFCLASS64 : ELFCLASS32) ||
+	    ehdr->e_phentsize != sizeof(ElfW(Phdr)) ||
+	    ehdr->e_phoff + (gsize)ehdr->e_phnum * sizeof(ElfW(Phdr)) > size)
+		return FALSE;
+
+	phdrs = (const ElfW(Phdr) *)(data + ehdr->e_phoff);
+	for (p = 0; p < ehdr->e_phnum; p++) {
+		if (phdrs[p].p_type == PT_DYNAMIC) dynamic = &phdrs[p];
+	}
+	if (dynamic == NULL || dynamic->p_offset + dynamic->p_filesz > size)
+		return FALSE;
+
+	/* The string table is given by its address */
+	dyn = (const ElfW(Dyn) *)(data + dynamic->p_offset);
+	nb_dyn = dynamic->p_filesz / sizeof(ElfW(Dyn));
+	for (i = 0; i < nb_dyn && dyn[i].d_tag != DT_NULL; i++) {
+		if (dyn[i].d_tag == DT_STRTAB)
+			strtab = elf_offset(ehdr, phdrs, dyn[i].d_un.d_ptr, size);
+		else if (dyn[i].d_tag == DT_STRSZ)
+			strsz = dyn[i].d_un.d_val;
+	}
+	if (strtab >= size || strsz > size - strtab) return FALSE;
+
+	for (i = 0; i < nb_dyn && dyn[i].d_tag != DT_NULL; i++) {
+		if ((dyn[i].d_tag != DT_NEEDED && dyn[i].d_tag != DT_RPATH &&
+		     dyn[i].d_tag != DT_RUNPATH) || dyn[i].d_un.d_val >= strsz)
+			continue;
+
+		str = (const char *)(data + strtab + dyn[i].d_un.d_val);
+		paths = g_strndup(str, strnlen(str, strsz - dyn[i].d_un.d_val));
+		if (dyn[i].d_tag == DT_NEEDED) {
+			g_ptr_array_add(needed, paths);
+			continue;
+		}
 
-	g_string_free(msg, TRUE);
-	if (left_file != NULL) g_string_free(left_file, TRUE);
-	if (right_file != NULL) g_string_free(right_file, TRUE);
+		dirs = g_strsplit(paths, ":", -1);
+		for (d = 0; dirs[d] != NULL; d++) {
+			if (*dirs[d] != '\0')
+				g_ptr_array_add(run_paths, elf_expand_origin(dirs[d], origin));
+		}
+		g_strfreev(dirs);
+		g_free(paths);
+	}
+	return TRUE;
 }
 
-static void sync_action(BcMenuItem *item, BCompareExt *bcobj)
+/*
+ * Reads path ahead unless it is already in the page cache, and adds the
+ * libraries it needs, with the folders to search them first.
+ */
+static void warm_file(const gchar *path, GPtrArray *needed, GPtrArray *run_paths)
 {
-	GString *left_folder, *right_folder;
-	char *argv[6];
-
-	left_folder =
-		(GString *)g_object_get_data((GObject *)item, "bcext::left_folder");
-	right_folder =
-		(GString *)g_object_get_data((GObject *)item, "bcext::right_folder");
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	struct stat st;
+	unsigned char *residency;
+	gsize size, nb_pages, nb_resident = 0, i;
+	long page_size;
+	gchar *origin;
+	void *data;
+
+	if (fd < 0) return;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		close(fd);
+		return;
+	}
 
-	argv[0] = "bcompare";
-	argv[1] = "bcompare";
-	argv[2] = "-sync";
-	if (left_folder != NULL)
-		argv[3] = left_folder->str;
-	else argv[3] = "";
-	if (right_folder != NULL)
-		argv[4] = right_folder->str;
-	else argv[4] = "";
-	argv[5] = 0;
+	size = st.st_size;
+	data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	if (data != MAP_FAILED) {
+		page_size = sysconf(_SC_PAGESIZE);
+		nb_pages = (size + page_size - 1) / page_size;
+		residency = g_malloc0(nb_pages);
+
+		/*
+		 * Recent kernels only report the pages of files the user may write, the
+		 * others look absent and are read ahead, which costs no I/O when cached
+		 */
+		if (mincore(data, size, residency) == 0) {
+			for (i = 0; i < nb_pages; i++)
+				nb_resident += residency[i] & 1;
+		}
+		g_free(residency);
 
-	spawn_bc(bcobj->Winder, argv);
-	clear_selections(bcobj);
+		origin = g_path_get_dirname(path);
+		elf_dynamic(data, size, origin, needed, run_paths);
+		g_free(origin);
+		munmap(data, size);
 
-	if (left_folder != NULL) g_string_free(left_folder, TRUE);
-	if (right_folder != NULL) g_string_free(right_folder, TRUE);
+		if (nb_resident * 100 < nb_pages * RESIDENT_PERCENT)
+			readahead(fd, 0, size);
+	}
+	close(fd);
 }
 
-static void merge_action(BcMenuItem *item, BCompareExt *bcobj)
+static gpointer warm_thread(gpointer data)
 {
-	GString *left_file, *right_file, *center_file;
-	char *argv[7];
+	GHashTable *visited = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	GPtrArray *files = g_ptr_array_new_with_free_func(g_free);
+	GPtrArray *system_dirs = g_ptr_array_new_with_free_func(g_free);
+	GPtrArray *needed, *run_paths;
+	gchar *path;
+	gboolean found;
+	guint i, n, d;
+
+	/* Only this thread, whose reads never delay the desktop */
+	syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0,
+		IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+
+	warm_system_dirs(system_dirs);
+	warm_program_files(files, visited);
+
+	for (i = 0; i < files->len && i < MAX_WARMED_FILES; i++) {
+		needed = g_ptr_array_new_with_free_func(g_free);
+		run_paths = g_ptr_array_new_with_free_func(g_free);
+
+		warm_file(g_ptr_array_index(files, i), needed, run_paths);
+
+		/* The binary is run from its own folder, where its private libraries are */
+		g_ptr_array_add(run_paths, g_path_get_dirname(g_ptr_array_index(files, i)));
+		for (d = 0; d < system_dirs->len; d++)
+			g_ptr_array_add(run_paths, g_strdup(g_ptr_array_index(system_dirs, d)));
+
+		for (n = 0; n < needed->len; n++) {
+			for (d = 0; d < run_paths->len; d++) {
+				path = g_build_filename(g_ptr_array_index(run_paths, d),
+							g_ptr_array_index(needed, n), NULL);
+				found = g_file_test(path, G_FILE_TEST_EXISTS);
+				if (found) warm_add_file(files, visited, path);
+				g_free(path);
+				if (found) break;
+			}
+		}
+		g_ptr_array_unref(run_paths);
+		g_ptr_array_unref(needed);
+	}
 
-	left_file =
-		(GString *)g_object_get_data((GObject *)item, "bcext::left_file");
-	right_file =
-		(GString *)g_object_get_data((GObject *)item, "bcext::right_file");
-	center_file =
-		(GString *)g_object_get_data((GObject *)item, "bcext::center_file");
+	g_ptr_array_unref(system_dirs);
+	g_ptr_array_unref(files);
+	g_hash_table_unref(visited);
+	g_atomic_int_set(&warm_running, 0);
+	return NULL;
+}
 
-	argv[0] = "bcompare";
-	argv[1] = "bcompare";
-	argv[2] = "-fv=\"\"Text Merge\"\"";
-	if (left_file != NULL)
-		argv[3] = left_file->str;
-	else argv[3] = "";
-	if (right_file != NULL)
-		argv[4] = right_file->str;
-	else argv[4] = "";
-	if (center_file != NULL)
-		argv[5] = center_file->str;
-	else argv[5] = "";
-	argv[6] = 0;
+/*
+ * Opt-in warm start, enabled by BCOMPARE_EXT_PREFETCH: when a menu is shown,
+ * Beyond Compare and the libraries it loads are read ahead at idle I/O
+ * priority, so that the first comparison on a cold machine does not wait for
+ * the disk. The work is done at most once every ten minutes.
+ */
+static void warm_start(void)
+{
+	gint64 now = g_get_monotonic_time();
+	gboolean start;
 
-	spawn_bc(bcobj->Winder, argv);
-	clear_selections(bcobj);
+	if (g_getenv("BCOMPARE_EXT_PREFETCH") == NULL) return;
 
-	if (left_file != NULL) g_string_free(left_file, TRUE);
-	if (right_file != NULL) g_string_free(right_file, TRUE);
-	if (center_file != NULL) g_string_free(center_file, TRUE);
+	G_LOCK(warm);
+	start = ((warm_last == 0) || (now - warm_last >= WARM_INTERVAL_USEC)) &&
+		g_atomic_int_compare_and_exchange(&warm_running, 0, 1);
+	if (start) warm_last = now;
+	G_UNLOCK(warm);
+
+	if (start) g_thread_unref(g_thread_new("bcompare-warm", warm_thread, NULL));
 }
 
 /*************************************************************
  *
- * Menu Items
+ * Probes of saved paths
  *
  *************************************************************/
 
-static BcMenuItem * select_left_mitem(
-		BCompareExt *bcobj,
-		gboolean IsDir)
-{
-	BcMenuItem *item;
-	GString *MenuStr = g_string_new("");
-	GString *HintStr = g_string_new("");
-	GString *ItemStr = g_string_new("");
+/* Longest time a menu waits for the type of a path */
+#define PROBE_TIMEOUT_USEC (50 * 1000)
 
-	if (IsDir) g_string_assign(ItemStr, "Folder");
-	else g_string_assign(ItemStr, "File");
+/* Probes still blocked, no more are started past this */
+#define MAX_PENDING_PROBES 8
 
-	if ((bcobj->CompareMenuType == MENU_SUBMENU) ||
-		((bcobj->LeftFile != NULL) && (bcobj->LeftIsDir == IsDir))) {
-		g_string_printf(MenuStr, "Select Left %s", ItemStr->str);
-	}
-	else if ((bcobj->MergeMenuType != MENU_NONE) && (!IsDir)) {
-		g_string_printf(MenuStr, "Select Left %s for Compare/Merge", ItemStr->str);
+typedef enum {
+	PROBE_UNKNOWN = 0,
+	PROBE_MISSING,
+	PROBE_FILE,
+	PROBE_FOLDER
+} ProbeType;
+
+typedef struct {
+	gint RefCount;
+	gchar *Path;
+	gboolean Finished;
+	ProbeType Type;
+} PathProbe;
+
+static GMutex probe_mutex;
+static GCond probe_finished;
+static GHashTable *probes_pending = NULL;	/* path -> PathProbe, while stat() runs */
+
+static void probe_unref(PathProbe *probe)
+{
+	if (g_atomic_int_dec_and_test(&probe->RefCount)) {
+		g_free(probe->Path);
+		g_free(probe);
 	}
-	else {
-		g_string_printf(MenuStr, "Select Left %s for Compare", ItemStr->str);
+}
+
+static gpointer probe_thread(gpointer data)
+{
+	PathProbe *probe = (PathProbe *)data;
+	struct stat st;
+	ProbeType type;
+
+	if (stat(probe->Path, &st) != 0) type = PROBE_MISSING;
+	else type = S_ISDIR(st.st_mode) ? PROBE_FOLDER : PROBE_FILE;
+
+	g_mutex_lock(&probe_mutex);
+	probe->Type = type;
+	probe->Finished = TRUE;
+	g_hash_table_remove(probes_pending, probe->Path);
+	g_cond_broadcast(&probe_finished);
+	g_mutex_unlock(&probe_mutex);
+
+	probe_unref(probe);
+	return NULL;
+}
+
+/*
+ * Type of a saved path, read by a helper thread which is waited for at most
+ * PROBE_TIMEOUT_USEC. A path whose previous probe is still blocked is answered
+ * as unknown right away. Only the saved paths go through here, the selected
+ * files are still looked at directly.
+ */
+static ProbeType path_probe(const char *path)
+{
+	PathProbe *probe;
+	ProbeType type;
+	gint64 deadline;
+
+	g_mutex_lock(&probe_mutex);
+	if (probes_pending == NULL)
+		probes_pending = g_hash_table_new(g_str_hash, g_str_equal);
+
+	if (g_hash_table_contains(probes_pending, path) ||
+			(g_hash_table_size(probes_pending) >= MAX_PENDING_PROBES)) {
+		g_mutex_unlock(&probe_mutex);
+		return PROBE_UNKNOWN;
 	}
 
-	g_string_assign(HintStr, "Remembers selected item for later comparison using Beyond Compare. Right-click another item to start the comparison");
+	/* The thread may stay blocked long after the menu is shown */
+	probe = g_new0(PathProbe, 1);
+	probe->RefCount = 2;
+	probe->Path = g_strdup(path);
+	g_hash_table_insert(probes_pending, probe->Path, probe);
+	g_thread_unref(g_thread_new("bcompare-probe", probe_thread, probe));
 
-	item = nemo_menu_item_new("BCompareExt::select_left",
-							   MenuStr->str,
-							   HintStr->str,
-							   "bcomparehalf32");
+	deadline = g_get_monotonic_time() + PROBE_TIMEOUT_USEC;
+	while (!probe->Finished &&
+			g_cond_wait_until(&probe_finished, &probe_mutex, deadline));
 
+	type = probe->Finished ? probe->Type : PROBE_UNKNOWN;
+	g_mutex_unlock(&probe_mutex);
+
+	probe_unref(probe);
+	return type;
+}
+
+/*************************************************************
+ *
+ * Types of saved paths
+ *
+ *************************************************************/
+
+/* Paths remembered, the least recently used is forgotten first */
+#define MAX_CACHED_PATH_TYPES 32
+
+/* A type is looked at again after this, in case the path was replaced */
+#define PATH_TYPE_LIFETIME_USEC (30 * G_USEC_PER_SEC)
+
+typedef struct {
+	ProbeType Type;
+	gint64 Known;	/* when the type was read */
+} PathType;
+
+static void path_type_touch(BCompareExt *bcobj, const char *path)
+{
+	GList *link = g_queue_find_custom(bcobj->PathTypeOrder, path, (GCompareFunc)strcmp);
+
+	if (link != NULL) {
+		g_queue_unlink(bcobj->PathTypeOrder, link);
+		g_queue_push_head_link(bcobj->PathTypeOrder, link);
+	}
+}
+
+static void path_type_remember(BCompareExt *bcobj, const char *path, ProbeType type)
+{
+	PathType *cached = g_hash_table_lookup(bcobj->PathTypes, path);
+	gchar *key;
+
+	if (cached == NULL) {
+		if (g_hash_table_size(bcobj->PathTypes) >= MAX_CACHED_PATH_TYPES) {
+			key = g_queue_pop_tail(bcobj->PathTypeOrder);
+			g_hash_table_remove(bcobj->PathTypes, key);
+		}
+		cached = g_new0(PathType, 1);
+		key = g_strdup(path);
+		g_hash_table_insert(bcobj->PathTypes, key, cached);
+		g_queue_push_head(bcobj->PathTypeOrder, key);
+	} else {
+		path_type_touch(bcobj, path);
+	}
+
+	cached->Type = type;
+	cached->Known = g_get_monotonic_time();
+}
+
+/*
+ * Type of a saved Left or Center path. Selected items are remembered from the
+ * file manager, so repeated menus in the same folders make no stat() calls.
+ */
+static ProbeType path_type(BCompareExt *bcobj, const char *path)
+{
+	PathType *cached = g_hash_table_lookup(bcobj->PathTypes, path);
+	ProbeType type;
+
+	if ((cached != NULL) &&
+			(g_get_monotonic_time() - cached->Known < PATH_TYPE_LIFETIME_USEC)) {
+		path_type_touch(bcobj, path);
+		return cached->Type;
+	}
+
+	type = path_probe(path);
+	if (type != PROBE_UNKNOWN) path_type_remember(bcobj, path, type);
+	return type;
+}
+
+/* The file manager already knows the type of the selected items */
+static gboolean file_info_is_dir(BCompareExt *bcobj, NemoFileInfo *file)
+{
+	gchar *path = nemo_to_path(file);
+	gboolean isdir = nemo_file_info_is_directory(file);
+
+	if (path == NULL) return isdir;
+
+	/* In case it is selected as Left or Center, for the next menus */
+	path_type_remember(bcobj, path, isdir ? PROBE_FOLDER : PROBE_FILE);
+
+	isdir = isdir || file_is_archive(bcobj, path);
+	g_free(path);
+	return isdir;
+}
+
+/*
+ * Anonymous in-memory files, opened by Beyond Compare through /proc/<pid>/fd.
+ * They stay open until the process they are given to exits, see spawn_bc_setup.
+ * Each launch collects the files published for it in its own list fds.
+ */
+static gchar * memfd_publish(int fd, GList **fds)
+{
+	if (fcntl(fd, F_ADD_SEALS,
+			F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+		close(fd);
+		return NULL;
+	}
+
+	*fds = g_list_prepend(*fds, GINT_TO_POINTER(fd));
+
+	return g_strdup_printf("/proc/%d/fd/%d", (int)getpid(), fd);
+}
+
+static gboolean memfd_write(int fd, const void *data, gsize size)
+{
+	const char *ptr = data;
+	ssize_t written;
+
+	while (size > 0) {
+		written = write(fd, ptr, size);
+		if (written < 0) {
+			if (errno == EINTR) continue;
+			return FALSE;
+		}
+		ptr += written;
+		size -= written;
+	}
+	return TRUE;
+}
+
+static gchar * memfd_from_data(
+		const char *name,
+		const void *data,
+		gsize size,
+		GList **fds)
+{
+	int fd;
+
+	fd = memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if (fd < 0) return NULL;
+
+	if (!memfd_write(fd, data, size)) {
+		close(fd);
+		return NULL;
+	}
+	return memfd_publish(fd, fds);
+}
+
+#ifdef USE_LIBGIT2
+/* A folder outside any work tree is looked up again after this delay */
+#define NO_REPOSITORY_CACHE_USEC (10 * G_USEC_PER_SEC)
+#define MAX_CACHED_REPO_ROOTS 4096
+
+typedef struct {
+	const gchar *Root;	/* interned work tree root, or NULL outside any */
+	gint64 Stamp;		/* modification time of its ".git", or expiry without root */
+} RepoRoot;
+
+typedef struct {
+	git_repository *Repo;	/* NULL if it failed to open */
+	gint64 Stamp;		/* modification time of ".git" when it was opened */
+} RepoEntry;
+
+/*
+ * The repositories are used by the background checks of the menus and by the
+ * actions, one at a time since libgit2 objects are not thread safe.
+ */
+G_LOCK_DEFINE_STATIC(git_repos);
+static GHashTable *repo_roots = NULL;	/* folder -> RepoRoot */
+static GHashTable *repos = NULL;	/* interned root -> RepoEntry */
+
+static void repo_entry_free(gpointer data)
+{
+	RepoEntry *entry = (RepoEntry *)data;
+
+	if (entry->Repo != NULL) git_repository_free(entry->Repo);
+	g_free(entry);
+}
+
+/* Returns the modification time of the ".git" entry of dir, or -1 if none */
+static gint64 git_dir_stamp(const char *dir)
+{
+	gchar *gitpath = g_build_filename(dir, ".git", NULL);
+	struct stat st;
+	gint64 stamp = -1;
+
+	if (stat(gitpath, &st) == 0)
+		stamp = (gint64)st.st_mtim.tv_sec * G_USEC_PER_SEC + st.st_mtim.tv_nsec / 1000;
+	g_free(gitpath);
+
+	return stamp;
+}
+
+/*
+ * A known work tree is still valid while its ".git" entry keeps the same
+ * modification time, and a folder outside any until its entry expires.
+ */
+static gboolean git_root_valid(const RepoRoot *known)
+{
+	if (known->Root == NULL)
+		return g_get_monotonic_time() < known->Stamp;
+
+	return git_dir_stamp(known->Root) == known->Stamp;
+}
+
+/*
+ * Returns the work tree root containing filepath, or NULL. Every directory
+ * crossed is remembered, so browsing inside a repository costs one lookup
+ * and one stat() of its ".git" entry. Called with git_repos locked.
+ */
+static const gchar * git_find_repository(const char *filepath, gint64 *stamp)
+{
+	GSList *crossed = NULL, *l;
+	RepoRoot *known, found = { NULL, 0 };
+	gchar *dir, *parent;
+
+	dir = g_path_get_dirname(filepath);
+	for (;;) {
+		known = g_hash_table_lookup(repo_roots, dir);
+		if ((known != NULL) && git_root_valid(known)) {
+			found = *known;
+			g_free(dir);
+			break;
+		}
+
+		crossed = g_slist_prepend(crossed, dir);
+
+		found.Stamp = git_dir_stamp(dir);
+		if (found.Stamp >= 0) {
+			found.Root = g_intern_string(dir);
+			break;
+		}
+
+		parent = g_path_get_dirname(dir);
+		if (strcmp(parent, dir) == 0) {
+			g_free(parent);
+			found.Stamp = g_get_monotonic_time() + NO_REPOSITORY_CACHE_USEC;
+			break;
+		}
+		dir = parent;
+	}
+
+	if (g_hash_table_size(repo_roots) >= MAX_CACHED_REPO_ROOTS)
+		g_hash_table_remove_all(repo_roots);
+	for (l = crossed; l != NULL; l = l->next) {
+		known = g_new(RepoRoot, 1);
+		*known = found;
+		g_hash_table_replace(repo_roots, l->data, known);
+	}
+	g_slist_free(crossed);
+
+	*stamp = found.Stamp;
+	return found.Root;
+}
+
+/*
+ * Returns the repository of the work tree containing filepath, opened again
+ * when its ".git" entry changed. Called with git_repos locked.
+ */
+static git_repository * git_open_repository(
+		const char *filepath,
+		const char **relpath)
+{
+	const gchar *root;
+	RepoEntry *entry;
+	gint64 stamp;
+
+	if (repo_roots == NULL) {
+		repo_roots = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+		repos = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, repo_entry_free);
+	}
+
+	root = git_find_repository(filepath, &stamp);
+	if (root == NULL) return NULL;
+
+	*relpath = filepath + strlen(root);
+	while (**relpath == G_DIR_SEPARATOR) (*relpath)++;
+
+	entry = g_hash_table_lookup(repos, root);
+	if ((entry != NULL) && (entry->Stamp == stamp)) return entry->Repo;
+
+	entry = g_new0(RepoEntry, 1);
+	entry->Stamp = stamp;
+	if (git_repository_open(&entry->Repo, root) != 0) entry->Repo = NULL;
+
+	/* Also remember failures, to not retry on each popup */
+	g_hash_table_replace(repos, (gpointer)root, entry);
+	return entry->Repo;
+}
+
+static gboolean git_has_head_version(const char *filepath)
+{
+	const char *relpath;
+	git_repository *repo;
+	git_object *tree = NULL;
+	git_tree_entry *entry = NULL;
+	gboolean found = FALSE;
+
+	G_LOCK(git_repos);
+	repo = git_open_repository(filepath, &relpath);
+	if ((repo != NULL) && (git_revparse_single(&tree, repo, "HEAD^{tree}") == 0)) {
+		if (git_tree_entry_bypath(&entry, (git_tree *)tree, relpath) == 0) {
+			found = (git_tree_entry_type(entry) == GIT_OBJECT_BLOB);
+			git_tree_entry_free(entry);
+		}
+		git_object_free(tree);
+	}
+	G_UNLOCK(git_repos);
+
+	return found;
+}
+
+static gchar * git_head_version(const char *filepath, GList **fds)
+{
+	const char *relpath;
+	git_repository *repo;
+	git_object *blob = NULL;
+	gchar *spec, *path = NULL;
+
+	G_LOCK(git_repos);
+	repo = git_open_repository(filepath, &relpath);
+	if (repo != NULL) {
+		spec = g_strconcat("HEAD:", relpath, NULL);
+		if (git_revparse_single(&blob, repo, spec) == 0) {
+			/* Written straight from the libgit2 buffer, no temporary file */
+			if (git_object_type(blob) == GIT_OBJECT_BLOB) {
+				path = memfd_from_data(spec,
+					git_blob_rawcontent((git_blob *)blob),
+					git_blob_rawsize((git_blob *)blob), fds);
+			}
+			git_object_free(blob);
+		}
+		g_free(spec);
+	}
+	G_UNLOCK(git_repos);
+
+	return path;
+}
+
+static gchar * git_blob_version(
+		git_repository *repo,
+		const git_oid *id,
+		const char *stage,
+		const char *relpath,
+		GList **fds)
+{
+	git_blob *blob = NULL;
+	gchar *name, *path = NULL;
+
+	if (git_blob_lookup(&blob, repo, id) == 0) {
+		name = g_strconcat(stage, ":", relpath, NULL);
+		path = memfd_from_data(name,
+			git_blob_rawcontent(blob), git_blob_rawsize(blob), fds);
+		g_free(name);
+		git_blob_free(blob);
+	}
+
+	return path;
+}
+
+/*
+ * Returns the index of the repository, reloaded from disk only if it changed
+ * since the last popup. To be released with git_index_free().
+ */
+static git_index * git_open_index(git_repository *repo)
+{
+	git_index *index = NULL;
+
+	if (git_repository_index(&index, repo) != 0) return NULL;
+
+	if (git_index_read(index, 0) != 0) {
+		git_index_free(index);
+		return NULL;
+	}
+
+	return index;
+}
+
+static gboolean git_has_conflict(const char *filepath)
+{
+	const char *relpath;
+	git_repository *repo;
+	const git_index_entry *ancestor, *ours, *theirs;
+	git_index *index = NULL;
+	gboolean found = FALSE;
+
+	G_LOCK(git_repos);
+	repo = git_open_repository(filepath, &relpath);
+	if (repo != NULL) index = git_open_index(repo);
+	if ((index != NULL) && git_index_has_conflicts(index)) {
+		ancestor = ours = theirs = NULL;
+		found = (git_index_conflict_get(
+					&ancestor, &ours, &theirs, index, relpath) == 0) &&
+			(ours != NULL) && (theirs != NULL);
+	}
+	if (index != NULL) git_index_free(index);
+	G_UNLOCK(git_repos);
+
+	return found;
+}
+
+/*
+ * Reads the conflict stages of filepath from the index into in-memory files,
+ * added to fds even if another stage fails. base is NULL when there is no
+ * common ancestor (both added).
+ */
+static gboolean git_conflict_versions(
+		const char *filepath,
+		gchar **base,
+		gchar **ours,
+		gchar **theirs,
+		GList **fds)
+{
+	const char *relpath;
+	git_repository *repo;
+	const git_index_entry *ancestor_entry, *ours_entry, *theirs_entry;
+	git_index *index = NULL;
+
+	*base = *ours = *theirs = NULL;
+
+	G_LOCK(git_repos);
+	repo = git_open_repository(filepath, &relpath);
+	if (repo != NULL) index = git_open_index(repo);
+	if (index != NULL) {
+		ancestor_entry = ours_entry = theirs_entry = NULL;
+		if ((git_index_conflict_get(&ancestor_entry, &ours_entry, &theirs_entry,
+					index, relpath) == 0) &&
+				(ours_entry != NULL) && (theirs_entry != NULL)) {
+			*ours = git_blob_version(repo, &ours_entry->id, "OURS", relpath, fds);
+			*theirs = git_blob_version(repo, &theirs_entry->id, "THEIRS", relpath, fds);
+			if (ancestor_entry != NULL)
+				*base = git_blob_version(repo, &ancestor_entry->id, "BASE", relpath, fds);
+		}
+		git_index_free(index);
+	}
+	G_UNLOCK(git_repos);
+
+	return (*ours != NULL) && (*theirs != NULL);
+}
+#endif
+
+/*************************************************************
+ *
+ * Action callbacks
+ *
+ *************************************************************/
+static void select_left_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	GString *left_file;
+
+	left_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::left_path");
+	selection_save(bcobj, bcobj->LeftFileStorage->str,
+		(left_file != NULL) ? left_file->str : "");
+	if (left_file != NULL) g_string_free(left_file, TRUE);
+
+	/* A comparison is likely to follow */
+	warm_start();
+}
+
+static void select_center_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	GString *center_file;
+
+	center_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::center_file");
+	selection_save(bcobj, bcobj->CenterFileStorage->str,
+		(center_file != NULL) ? center_file->str : "");
+	if (center_file != NULL) g_string_free(center_file, TRUE);
+}
+
+static void edit_file_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	GString *edit_file;
+	char *argv[5];
+
+	edit_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::edit_file");
+	argv[0] = "bcompare";
+	argv[1] = "bcompare";
+	argv[2] = "-edit";
+	if (edit_file != NULL)
+		argv[3] = edit_file->str;
+	else argv[3] = "";
+	argv[4] = 0;
+
+	spawn_bc(bcobj->Winder, argv);
+	clear_selections(bcobj);
+
+	if (edit_file != NULL) g_string_free(edit_file, TRUE);
+}
+
+/*
+ * The clipboard is read when the item is activated, and written straight
+ * from the buffer received into an in-memory file, without another copy.
+ */
+typedef struct {
+	BCompareExt *Ext;
+	gchar *RightFile;
+} ClipboardJob;
+
+static void clipboard_received(GtkClipboard *clipboard, const gchar *text, gpointer data)
+{
+	ClipboardJob *job = (ClipboardJob *)data;
+	BCompareExt *bcobj = job->Ext;
+	gchar *path = NULL;
+	GList *fds = NULL;
+	char *argv[7];
+
+	if (text != NULL) path = memfd_from_data("Clipboard", text, strlen(text), &fds);
+
+	if (path != NULL) {
+		argv[0] = "bcompare";
+		argv[1] = "bcompare";
+		argv[2] = "-ro1";
+		argv[3] = "-title1=Clipboard";
+		argv[4] = path;
+		argv[5] = job->RightFile;
+		argv[6] = 0;
+
+		spawn_bc_memfds(bcobj->Winder, argv, fds);
+		g_free(path);
+	}
+
+	g_free(job->RightFile);
+	g_free(job);
+}
+
+static void compare_clipboard_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	ClipboardJob *job = g_new0(ClipboardJob, 1);
+
+	job->Ext = bcobj;
+	job->RightFile = g_strdup(g_object_get_data((GObject *)item, "bcext::right_file"));
+
+	gtk_clipboard_request_text(gtk_clipboard_get(GDK_SELECTION_CLIPBOARD),
+		clipboard_received, job);
+}
+
+/* Defined with the walk of folders below */
+static void spawn_folder_session(
+		BCompareExt *bcobj,
+		char **argv,
+		const char *left_folder,
+		const char *right_folder,
+		gboolean low_priority);
+
+static void compare_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	GString *left_file, *right_file;
+	GString *msg = g_string_new("");
+	char *fileviewer;
+	char *argv[6];
+	int cnt = 0;
+
+	left_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::left_file");
+	right_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::right_file");
+	fileviewer =
+		(char *)g_object_get_data((GObject *)item, "bcext::fileviewer");
+
+	argv[cnt++] = "bcompare";
+	argv[cnt++] = "bcompare";
+	if (strcmp(fileviewer, "") != 0) {
+		g_string_printf(msg, "-fv=\"%s\"", fileviewer);
+		argv[cnt++] = msg->str;
+	}
+	if (left_file != NULL)
+		argv[cnt++] = left_file->str;
+	else argv[cnt++] = "";
+	if (right_file != NULL)
+		argv[cnt++] = right_file->str;
+	else argv[cnt++] = "";
+	argv[cnt++] = 0;
+
+	spawn_folder_session(bcobj, argv,
+		(left_file != NULL) ? left_file->str : NULL,
+		(right_file != NULL) ? right_file->str : NULL, FALSE);
+	clear_selections(bcobj);
+
+	g_string_free(msg, TRUE);
+	if (left_file != NULL) g_string_free(left_file, TRUE);
+	if (right_file != NULL) g_string_free(right_file, TRUE);
+}
+
+static void sync_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	GString *left_folder, *right_folder;
+	char *argv[6];
+
+	left_folder =
+		(GString *)g_object_get_data((GObject *)item, "bcext::left_folder");
+	right_folder =
+		(GString *)g_object_get_data((GObject *)item, "bcext::right_folder");
+
+	argv[0] = "bcompare";
+	argv[1] = "bcompare";
+	argv[2] = "-sync";
+	if (left_folder != NULL)
+		argv[3] = left_folder->str;
+	else argv[3] = "";
+	if (right_folder != NULL)
+		argv[4] = right_folder->str;
+	else argv[4] = "";
+	argv[5] = 0;
+
+	spawn_folder_session(bcobj, argv,
+		(left_folder != NULL) ? left_folder->str : NULL,
+		(right_folder != NULL) ? right_folder->str : NULL, FALSE);
+	clear_selections(bcobj);
+
+	if (left_folder != NULL) g_string_free(left_folder, TRUE);
+	if (right_folder != NULL) g_string_free(right_folder, TRUE);
+}
+
+static void sync_background_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	char *argv[6];
+
+	argv[0] = "bcompare";
+	argv[1] = "bcompare";
+	argv[2] = "-sync";
+	argv[3] = g_object_get_data((GObject *)item, "bcext::left_folder");
+	argv[4] = g_object_get_data((GObject *)item, "bcext::right_folder");
+	argv[5] = 0;
+
+	spawn_folder_session(bcobj, argv, argv[3], argv[4], TRUE);
+	clear_selections(bcobj);
+}
+
+static void merge_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	GString *left_file, *right_file, *center_file;
+	char *argv[7];
+
+	left_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::left_file");
+	right_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::right_file");
+	center_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::center_file");
+
+	argv[0] = "bcompare";
+	argv[1] = "bcompare";
+	argv[2] = "-fv=\"\"Text Merge\"\"";
+	if (left_file != NULL)
+		argv[3] = left_file->str;
+	else argv[3] = "";
+	if (right_file != NULL)
+		argv[4] = right_file->str;
+	else argv[4] = "";
+	if (center_file != NULL)
+		argv[5] = center_file->str;
+	else argv[5] = "";
+	argv[6] = 0;
+
+	spawn_bc(bcobj->Winder, argv);
+	clear_selections(bcobj);
+
+	if (left_file != NULL) g_string_free(left_file, TRUE);
+	if (right_file != NULL) g_string_free(right_file, TRUE);
+	if (center_file != NULL) g_string_free(center_file, TRUE);
+}
+
+#ifdef USE_LIBGIT2
+static void compare_head_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	GString *right_file;
+	gchar *head_path = NULL;
+	gchar *basename, *title;
+	GList *fds = NULL;
+	char *argv[7];
+
+	right_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::right_file");
+	if (right_file != NULL)
+		head_path = git_head_version(right_file->str, &fds);
+
+	if (head_path != NULL) {
+		basename = g_path_get_basename(right_file->str);
+		title = g_strdup_printf("-title1=%s (HEAD)", basename);
+
+		argv[0] = "bcompare";
+		argv[1] = "bcompare";
+		argv[2] = "-ro1";
+		argv[3] = title;
+		argv[4] = head_path;
+		argv[5] = right_file->str;
+		argv[6] = 0;
+
+		spawn_bc_memfds(bcobj->Winder, argv, fds);
+
+		g_free(basename);
+		g_free(title);
+		g_free(head_path);
+	}
+
+	if (right_file != NULL) g_string_free(right_file, TRUE);
+}
+
+static void resolve_conflict_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	GString *merge_file;
+	gchar *base = NULL, *ours = NULL, *theirs = NULL, *output;
+	GList *fds = NULL;
+	char *argv[11];
+	int cnt = 0;
+
+	merge_file =
+		(GString *)g_object_get_data((GObject *)item, "bcext::merge_file");
+
+	if ((merge_file != NULL) && git_conflict_versions(
+				merge_file->str, &base, &ours, &theirs, &fds)) {
+		output = g_strdup_printf("-mergeoutput=%s", merge_file->str);
+
+		argv[cnt++] = "bcompare";
+		argv[cnt++] = "bcompare";
+		argv[cnt++] = "-fv=\"\"Text Merge\"\"";
+		argv[cnt++] = "-title1=Ours";
+		argv[cnt++] = "-title2=Theirs";
+		argv[cnt++] = ours;
+		argv[cnt++] = theirs;
+		if (base != NULL) {
+			argv[cnt++] = "-title3=Base";
+			argv[cnt++] = base;
+		}
+		argv[cnt++] = output;
+		argv[cnt++] = 0;
+
+		spawn_bc_memfds(bcobj->Winder, argv, fds);
+
+		g_free(output);
+	}
+	else {
+		/* Nothing is launched, the stages read so far are released */
+		memfd_close_all(fds);
+	}
+
+	g_free(base);
+	g_free(ours);
+	g_free(theirs);
+
+	if (merge_file != NULL) g_string_free(merge_file, TRUE);
+}
+#endif
+
+/*************************************************************
+ *
+ * Menu Items
+ *
+ *************************************************************/
+
+static BcMenuItem * select_left_mitem(
+		BCompareExt *bcobj,
+		gboolean IsDir)
+{
+	BcMenuItem *item;
+	GString *MenuStr = g_string_new("");
+	GString *HintStr = g_string_new("");
+	GString *ItemStr = g_string_new("");
+
+	if (IsDir) g_string_assign(ItemStr, "Folder");
+	else g_string_assign(ItemStr, "File");
+
+	if ((bcobj->CompareMenuType == MENU_SUBMENU) ||
+		((bcobj->LeftFile != NULL) && (bcobj->LeftIsDir == IsDir))) {
+		g_string_printf(MenuStr, "Select Left %s", ItemStr->str);
+	}
+	else if ((bcobj->MergeMenuType != MENU_NONE) && (!IsDir)) {
+		g_string_printf(MenuStr, "Select Left %s for Compare/Merge", ItemStr->str);
+	}
+	else {
+		g_string_printf(MenuStr, "Select Left %s for Compare", ItemStr->str);
+	}
+
+	g_string_assign(HintStr, "Remembers selected item for later comparison using Beyond Compare. Right-click another item to start the comparison");
+
+	item = nemo_menu_item_new("BCompareExt::select_left",
+							   MenuStr->str,
+							   HintStr->str,
+							   "bcomparehalf32");
+
+	g_signal_connect(item, "activate",
+		G_CALLBACK (select_left_action), bcobj);
+	g_object_set_data(
+	(GObject*)item, "bcext::left_path", g_string_new(bcobj->RightFile->str));
+	g_object_set_data((GObject*)item, "bcext::is_dir", GBOOLEAN_TO_POINTER(IsDir));
+
+	g_string_free(MenuStr, TRUE);
+	g_string_free(HintStr, TRUE);
+	g_string_free(ItemStr, TRUE);
+
+	return item;
+}
+
+static BcMenuItem * select_center_mitem(BCompareExt *bcobj)
+{
+	BcMenuItem *item;
+
+	item = nemo_menu_item_new("BCompareExt::select_center",
+								  "Select Center File",
+								  "Remembers selected item for later comparison using Beyond Compare. Right-click another item to start the comparison",
+								  "bcomparehalf32" /* icon name */);
+
+	g_signal_connect(item, "activate",
+			G_CALLBACK (select_center_action), bcobj);
+	g_object_set_data(
+	(GObject*)item, "bcext::center_file", g_string_new(bcobj->RightFile->str));
+	return item;
+}
+
+static BcMenuItem * edit_file_mitem(BCompareExt *bcobj)
+{
+	BcMenuItem *item;
+	GString *MenuStr = g_string_new("");
+
+	if (bcobj->EditMenuType == MENU_SUBMENU)
+		g_string_printf(MenuStr, "Edit");
+	else
+		g_string_printf(MenuStr, "Edit with Beyond Compare");
+
+	item = nemo_menu_item_new("BCompareExt::edit_file",
+								  MenuStr->str,
+				  "Edit the file using Beyond Compare",
+								  "bcomparefull32" /* icon name */);
+
+	g_signal_connect(item, "activate",
+			G_CALLBACK (edit_file_action), bcobj);
+	g_object_set_data(
+	(GObject*) item, "bcext::edit_file", g_string_new(bcobj->RightFile->str));
+	g_string_free(MenuStr, TRUE);
+	return item;
+}
+
+static BcMenuItem * compare_clipboard_mitem(BCompareExt *bcobj)
+{
+	BcMenuItem *item;
+
+	item = nemo_menu_item_new("BCompareExt::compare_clipboard",
+				"Compare with Clipboard",
+				"Compare selected file with the text in the clipboard, using Beyond Compare",
+				"bcomparefull32" /* icon name */);
+
+	g_signal_connect(item, "activate",
+			G_CALLBACK (compare_clipboard_action), bcobj);
+	g_object_set_data_full((GObject *)item, "bcext::right_file",
+		g_strdup(bcobj->RightFile->str), g_free);
+	return item;
+}
+
+static BcMenuItem * compare_mitem(
+		BCompareExt *bcobj,
+		gchar *fileviewer,
+		int SelectedCnt)
+{
+	BcMenuItem *item;
+	GString *MenuStr = g_string_new("");
+	GString *HintStr = g_string_new("");
+	GString *NameStr = g_string_new("");
+	gchar *LeftFileName;
+
+	if (strcmp(fileviewer, "") == 0) {
+		if (SelectedCnt == 1) {
+			LeftFileName = g_path_get_basename(bcobj->LeftFile->str);
+			g_string_printf(MenuStr, "Compare to '%s'", LeftFileName);
+			g_string_assign(HintStr,
+					"Compare selected items using Beyond Compare");
+			g_free(LeftFileName);
+		}
+		else {
+			g_string_assign(MenuStr, "Compare");
+			g_string_assign(HintStr,
+					"Compare selected item with previously selected left item, using Beyond Compare");
+		}
+	}
+	else {
+		g_string_assign(MenuStr, fileviewer);
+		g_string_printf(HintStr, "Compare files using the '%s' viewer",
+				fileviewer);
+	}
+
+	g_string_printf(NameStr, "BCompareExt::compare_using %s", fileviewer);
+
+	item = nemo_menu_item_new(NameStr->str,
+								  MenuStr->str,
+								  HintStr->str,
+								  "bcomparefull32" /* icon name */);
+	g_signal_connect(item, "activate",
+			G_CALLBACK (compare_action), bcobj);
+	g_object_set_data(
+	(GObject*)item, "bcext::left_file", g_string_new(bcobj->LeftFile->str));
+	g_object_set_data(
+	(GObject*)item, "bcext::right_file", g_string_new(bcobj->RightFile->str));
+	g_object_set_data((GObject*)item, "bcext::fileviewer", fileviewer);
+
+	g_string_free(MenuStr, TRUE);
+	g_string_free(HintStr, TRUE);
+	g_string_free(NameStr, TRUE);
+	return item;
+}
+
+static BcMenuItem * sync_mitem(
+		BCompareExt *bcobj,
+		int SelectedCnt)
+{
+	BcMenuItem *item;
+	GString *MenuStr = g_string_new("");
+	GString *HintStr = g_string_new("");
+	gchar *LeftFolderName;
+
+
+	if (SelectedCnt == 1) {
+		LeftFolderName = g_path_get_basename(bcobj->LeftFile->str);
+		g_string_printf(MenuStr, "Sync with '%s'", LeftFolderName);
+		g_string_assign(HintStr,
+				"Sync to previously selected folder");
+		g_free(LeftFolderName);
+	}
+	else {
+		g_string_assign(MenuStr, "Sync");
+		g_string_assign(HintStr,
+				"Sync two selected folders");
+	}
+
+	item = nemo_menu_item_new("BCompareExt::sync",
+								  MenuStr->str,
+								  HintStr->str,
+								  "bcomparefull32" /* icon name */);
+	g_signal_connect(item, "activate",
+			G_CALLBACK (sync_action), bcobj);
+	g_object_set_data(
+			(GObject*)item, "bcext::left_folder", g_string_new(bcobj->LeftFile->str));
+	g_object_set_data(
+		(GObject*)item, "bcext::right_folder", g_string_new(bcobj->RightFile->str));
+
+	g_string_free(MenuStr, TRUE);
+	g_string_free(HintStr, TRUE);
+	return item;
+
+}
+
+static BcMenuItem * sync_background_mitem(BCompareExt *bcobj)
+{
+	BcMenuItem *item;
+	GString *HintStr = g_string_new("Runs with idle disk and CPU priority");
+
+	if (has_cgroup_scopes())
+		g_string_append(HintStr,
+			", half a CPU and " CGROUP_IO_BANDWIDTH "B/s of disk bandwidth");
+
+	item = nemo_menu_item_new("BCompareExt::sync_background",
+							"Sync in Background (Low Priority)",
+							HintStr->str,
+							"bcomparefull32");
+	g_signal_connect(item, "activate",
+			G_CALLBACK(sync_background_action), bcobj);
+	g_object_set_data_full((GObject *)item, "bcext::left_folder",
+			g_strdup(bcobj->LeftFile->str), g_free);
+	g_object_set_data_full((GObject *)item, "bcext::right_folder",
+			g_strdup(bcobj->RightFile->str), g_free);
+
+	g_string_free(HintStr, TRUE);
+	return item;
+}
+
+static BcMenuItem * merge_mitem(
+		BCompareExt *bcobj,
+		int SelectedCnt)
+{
+	BcMenuItem *item;
+	GString *MenuStr = g_string_new("");
+	GString *HintStr = g_string_new("");
+	gchar *File1, *File2;
+
+	if (SelectedCnt == 1){
+		if (bcobj->CenterFile == NULL) {
+			File1 = g_path_get_basename(bcobj->LeftFile->str);
+			g_string_printf(MenuStr, "Merge with '%s'", File1);
+			g_string_assign(HintStr,
+				"Merge file with previously selected left file using Beyond Compare");
+			g_free(File1);
+		}
+		else {
+			File1 = g_path_get_basename(bcobj->LeftFile->str);
+			File2 = g_path_get_basename(bcobj->CenterFile->str);
+			g_string_printf(MenuStr, "Merge with '%s', '%s'", File1, File2);
+			g_string_assign(HintStr,
+				"Merge file with previously selected left and center files using Beyond Compare");
+			g_free(File1);
+			g_free(File2);
+		}
+	}
+	else if (SelectedCnt == 2){
+		if (bcobj->CenterFile == NULL) {
+			g_string_assign(MenuStr, "Merge");
+			g_string_assign(HintStr,
+				"Merge selected files (left, right)");
+		}
+		else {
+			File1 = g_path_get_basename(bcobj->CenterFile->str);
+			g_string_printf(MenuStr, "Merge with '%s'", File1);
+			g_string_assign(HintStr,
+				"Merge selected files (left, right) with previously selected center file");
+			g_free(File1);
+		}
+	}
+	else if (SelectedCnt == 3) {
+		g_string_assign(MenuStr, "Merge");
+		g_string_assign(HintStr,
+				"Merge selected files (left, right, center)");
+	}
+	else return NULL;
+
+
+	item = nemo_menu_item_new("BCompareExt::merge",
+								  MenuStr->str,
+								  HintStr->str,
+								  "bcomparefull32" /* icon name */);
+	g_signal_connect(item, "activate",
+			G_CALLBACK(merge_action), bcobj);
+	g_object_set_data(
+			(GObject*)item, "bcext::left_file", g_string_new(bcobj->LeftFile->str));
+	g_object_set_data(
+			(GObject*)item, "bcext::right_file", g_string_new(bcobj->RightFile->str));
+	if (bcobj->CenterFile != NULL) {
+	g_object_set_data(
+			(GObject*)item, "bcext::center_file", g_string_new(bcobj->CenterFile->str));
+	}
+
+	g_string_free(MenuStr, TRUE);
+	g_string_free(HintStr, TRUE);
+
+	return item;
+}
+
+
+#ifdef USE_LIBGIT2
+static BcMenuItem * compare_head_mitem(BCompareExt *bcobj)
+{
+	BcMenuItem *item;
+
+	item = nemo_menu_item_new("BCompareExt::compare_head",
+				"Compare with Git HEAD",
+				"Compare selected file with its last committed version, using Beyond Compare",
+				"bcomparefull32" /* icon name */);
+
+	g_signal_connect(item, "activate",
+			G_CALLBACK (compare_head_action), bcobj);
+	g_object_set_data(
+	(GObject*)item, "bcext::right_file", g_string_new(bcobj->RightFile->str));
+	return item;
+}
+
+static BcMenuItem * resolve_conflict_mitem(BCompareExt *bcobj)
+{
+	BcMenuItem *item;
+
+	item = nemo_menu_item_new("BCompareExt::resolve_conflict",
+				"Resolve Conflict with Beyond Compare",
+				"Merge the conflicting Git versions of the selected file into it, using Beyond Compare",
+				"bcomparefull32" /* icon name */);
+
+	g_signal_connect(item, "activate",
+			G_CALLBACK (resolve_conflict_action), bcobj);
+	g_object_set_data(
+	(GObject*)item, "bcext::merge_file", g_string_new(bcobj->RightFile->str));
+	return item;
+}
+#endif
+
+/*************************************************************
+ *
+ * Content hashes
+ *
+ *************************************************************/
+
+#define MAX_CACHED_HASHES 200000
+#define HASH_CHUNK_SIZE (1024 * 1024)
+
+/* Digest of every file already hashed, keyed by its identity */
+G_LOCK_DEFINE_STATIC(hash_cache);
+static GHashTable *hash_cache = NULL;
+
+/*
+ * Returns "dev:ino:mtime:size", which changes whenever the content may have
+ * changed, or NULL if filepath is not a regular file.
+ */
+static gchar * file_identity(const char *filepath, gint64 *size)
+{
+	struct stat st;
+
+	if ((stat(filepath, &st) != 0) || !S_ISREG(st.st_mode)) return NULL;
+
+	*size = st.st_size;
+	return g_strdup_printf("%lu:%lu:%ld.%09ld:%lld",
+		(unsigned long)st.st_dev, (unsigned long)st.st_ino,
+		(long)st.st_mtim.tv_sec, (long)st.st_mtim.tv_nsec,
+		(long long)st.st_size);
+}
+
+static gchar * file_content_hash(
+		const char *filepath,
+		const char *identity,
+		gint *cancelled)
+{
+	FILE *fileptr;
+	guchar *buf;
+	size_t len;
+	gchar *digest = NULL;
+#ifdef USE_XXHASH
+	XXH3_state_t *state;
+	XXH128_hash_t hash;
+#else
+	GChecksum *checksum;
+#endif
+
+	G_LOCK(hash_cache);
+	if (hash_cache != NULL)
+		digest = g_strdup(g_hash_table_lookup(hash_cache, identity));
+	G_UNLOCK(hash_cache);
+	if (digest != NULL) return digest;
+
+	fileptr = fopen(filepath, "rb");
+	if (fileptr == NULL) return NULL;
+
+	buf = g_malloc(HASH_CHUNK_SIZE);
+#ifdef USE_XXHASH
+	state = XXH3_createState();
+	XXH3_128bits_reset(state);
+#else
+	checksum = g_checksum_new(G_CHECKSUM_SHA1);
+#endif
+
+	while (!g_atomic_int_get(cancelled) &&
+			((len = fread(buf, 1, HASH_CHUNK_SIZE, fileptr)) > 0)) {
+#ifdef USE_XXHASH
+		XXH3_128bits_update(state, buf, len);
+#else
+		g_checksum_update(checksum, buf, len);
+#endif
+	}
+
+	if (!ferror(fileptr) && !g_atomic_int_get(cancelled)) {
+#ifdef USE_XXHASH
+		hash = XXH3_128bits_digest(state);
+		digest = g_strdup_printf("%016llx%016llx",
+			(unsigned long long)hash.high64, (unsigned long long)hash.low64);
+#else
+		digest = g_strdup(g_checksum_get_string(checksum));
+#endif
+	}
+
+#ifdef USE_XXHASH
+	XXH3_freeState(state);
+#else
+	g_checksum_free(checksum);
+#endif
+	g_free(buf);
+	fclose(fileptr);
+
+	if (digest != NULL) {
+		G_LOCK(hash_cache);
+		if ((hash_cache != NULL) &&
+				(g_hash_table_size(hash_cache) >= MAX_CACHED_HASHES)) {
+			g_hash_table_destroy(hash_cache);
+			hash_cache = NULL;
+		}
+		if (hash_cache == NULL)
+			hash_cache = g_hash_table_new_full(
+					g_str_hash, g_str_equal, g_free, g_free);
+		g_hash_table_insert(hash_cache, g_strdup(identity), g_strdup(digest));
+		G_UNLOCK(hash_cache);
+	}
+
+	return digest;
+}
+
+/*************************************************************
+ *
+ * Quick verification of folders
+ *
+ *************************************************************/
+
+#define VERIFY_CHUNK_SIZE (1024 * 1024)
+#define MAX_VERIFY_THREADS 8
+#ifdef USE_LIBURING
+/* Number of chunk pairs in flight, each slot owns one buffer per side */
+#define URING_SLOTS 16
+#define URING_CHUNK_SIZE (256 * 1024)
+#endif
+
+typedef enum {
+	DIFF_NONE = 0,
+	DIFF_MISSING,
+	DIFF_TYPE,
+	DIFF_SIZE,
+	DIFF_CONTENT,
+	DIFF_UNREADABLE
+} DiffKinds;
+
+typedef struct {
+	gchar *RelPath;
+	gint64 Size;
+} FilePair;
+
+typedef struct {
+	gchar *Name;
+	struct stat St;
+} DirEntry;
+
+typedef struct {
+	BCompareExt *Ext;
+	gchar *LeftFolder;
+	gchar *RightFolder;
+	GArray *Pairs;		/* FilePair, in walk order */
+	DiffKinds WalkDiff;	/* first difference found after all the pairs */
+	gchar *WalkDiffPath;
+	gint NextPair;
+	GMutex Lock;		/* protects the members below */
+	gint64 Bytes;
+	guint FirstDiffPair;
+	DiffKinds FirstDiffKind;
+	gdouble Throughput;
+} VerifyJob;
+
+static void verify_job_free(VerifyJob *job)
+{
+	guint i;
+
+	for (i = 0; i < job->Pairs->len; i++)
+		g_free(g_array_index(job->Pairs, FilePair, i).RelPath);
+	g_array_free(job->Pairs, TRUE);
+	g_mutex_clear(&job->Lock);
+	g_free(job->WalkDiffPath);
+	g_free(job->RightFolder);
+	g_free(job->LeftFolder);
+	g_free(job);
+}
+
+static void verify_pair_differs(VerifyJob *job, guint index, DiffKinds kind)
+{
+	g_mutex_lock(&job->Lock);
+	if (index < job->FirstDiffPair) {
+		job->FirstDiffPair = index;
+		job->FirstDiffKind = kind;
+	}
+	g_mutex_unlock(&job->Lock);
+}
+
+/* Pairs after a known difference do not need to be read */
+static gboolean verify_is_needed(VerifyJob *job, guint index)
+{
+	gboolean needed;
+
+	g_mutex_lock(&job->Lock);
+	needed = (index < job->FirstDiffPair);
+	g_mutex_unlock(&job->Lock);
+
+	return needed;
+}
+
+static void verify_add_bytes(VerifyJob *job, gint64 bytes)
+{
+	g_mutex_lock(&job->Lock);
+	job->Bytes += bytes;
+	g_mutex_unlock(&job->Lock);
+}
+
+static gint dir_entry_compare(gconstpointer a, gconstpointer b)
+{
+	return strcmp(((const DirEntry *)a)->Name, ((const DirEntry *)b)->Name);
+}
+
+static void dir_entries_free(GArray *entries)
+{
+	guint i;
+
+	for (i = 0; i < entries->len; i++)
+		g_free(g_array_index(entries, DirEntry, i).Name);
+	g_array_free(entries, TRUE);
+}
+
+/* Returns the entries of dirpath sorted by name, NULL if it can not be read */
+static GArray * list_directory(const char *dirpath)
+{
+	DIR *dir = opendir(dirpath);
+	struct dirent *ent;
+	GArray *entries;
+	DirEntry entry;
+
+	if (dir == NULL) return NULL;
+
+	/* readdir() is backed by getdents64, the attributes are read relative to it */
+	entries = g_array_new(FALSE, FALSE, sizeof(DirEntry));
+	while ((ent = readdir(dir)) != NULL) {
+		if ((strcmp(ent->d_name, ".") == 0) || (strcmp(ent->d_name, "..") == 0))
+			continue;
+		if (fstatat(dirfd(dir), ent->d_name, &entry.St, AT_SYMLINK_NOFOLLOW) == 0) {
+			entry.Name = g_strdup(ent->d_name);
+			g_array_append_val(entries, entry);
+		}
+	}
+	closedir(dir);
+
+	g_array_sort(entries, dir_entry_compare);
+	return entries;
+}
+
+static gboolean same_link_target(const char *leftpath, const char *rightpath)
+{
+	gchar *left_target = g_file_read_link(leftpath, NULL);
+	gchar *right_target = g_file_read_link(rightpath, NULL);
+	gboolean same = (left_target != NULL) && (right_target != NULL) &&
+		(strcmp(left_target, right_target) == 0);
+
+	g_free(right_target);
+	g_free(left_target);
+	return same;
+}
+
+static gboolean walk_difference(
+		VerifyJob *job,
+		DiffKinds kind,
+		const char *relpath,
+		const char *name)
+{
+	job->WalkDiff = kind;
+	job->WalkDiffPath = (name == NULL) ? g_strdup(relpath) :
+		((relpath[0] == '\0') ? g_strdup(name) :
+			g_build_filename(relpath, name, NULL));
+	return FALSE;
+}
+
+/*
+ * Pairs the entries of both trees in name order, depth first. Stops at the
+ * first difference which does not need the contents to be read.
+ */
+static gboolean walk_folders(VerifyJob *job, const char *relpath)
+{
+	GArray *left_entries, *right_entries;
+	DirEntry *left, *right;
+	gchar *leftpath, *rightpath, *entrypath;
+	gboolean same = TRUE;
+	FilePair pair;
+	guint l = 0, r = 0;
+	int order;
+
+	leftpath = g_build_filename(job->LeftFolder, relpath, NULL);
+	rightpath = g_build_filename(job->RightFolder, relpath, NULL);
+	left_entries = list_directory(leftpath);
+	right_entries = list_directory(rightpath);
+	g_free(rightpath);
+	g_free(leftpath);
+
+	if ((left_entries == NULL) || (right_entries == NULL)) {
+		same = walk_difference(job, DIFF_UNREADABLE, relpath, NULL);
+	}
+
+	while (same && ((l < left_entries->len) || (r < right_entries->len))) {
+		left = (l < left_entries->len) ?
+			&g_array_index(left_entries, DirEntry, l) : NULL;
+		right = (r < right_entries->len) ?
+			&g_array_index(right_entries, DirEntry, r) : NULL;
+
+		/* Names present on one side only */
+		order = (left == NULL) ? 1 :
+			((right == NULL) ? -1 : strcmp(left->Name, right->Name));
+		if (order != 0) {
+			same = walk_difference(job, DIFF_MISSING, relpath,
+					(order < 0) ? left->Name : right->Name);
+			break;
+		}
+
+		entrypath = (relpath[0] == '\0') ? g_strdup(left->Name) :
+			g_build_filename(relpath, left->Name, NULL);
+
+		if ((left->St.st_mode & S_IFMT) != (right->St.st_mode & S_IFMT)) {
+			same = walk_difference(job, DIFF_TYPE, entrypath, NULL);
+		} else if (S_ISDIR(left->St.st_mode)) {
+			same = walk_folders(job, entrypath);
+		} else if (S_ISREG(left->St.st_mode)) {
+			if (left->St.st_size != right->St.st_size) {
+				same = walk_difference(job, DIFF_SIZE, entrypath, NULL);
+			} else {
+				pair.RelPath = g_strdup(entrypath);
+				pair.Size = left->St.st_size;
+				g_array_append_val(job->Pairs, pair);
+			}
+		} else if (S_ISLNK(left->St.st_mode)) {
+			leftpath = g_build_filename(job->LeftFolder, entrypath, NULL);
+			rightpath = g_build_filename(job->RightFolder, entrypath, NULL);
+			if (!same_link_target(leftpath, rightpath))
+				same = walk_difference(job, DIFF_CONTENT, entrypath, NULL);
+			g_free(rightpath);
+			g_free(leftpath);
+		}
+
+		g_free(entrypath);
+		l++;
+		r++;
+	}
+
+	if (left_entries != NULL) dir_entries_free(left_entries);
+	if (right_entries != NULL) dir_entries_free(right_entries);
+
+	return same;
+}
+
+static void open_pair(VerifyJob *job, FilePair *pair, int *leftfd, int *rightfd)
+{
+	gchar *path;
+
+	path = g_build_filename(job->LeftFolder, pair->RelPath, NULL);
+	*leftfd = open(path, O_RDONLY | O_CLOEXEC);
+	g_free(path);
+
+	path = g_build_filename(job->RightFolder, pair->RelPath, NULL);
+	*rightfd = open(path, O_RDONLY | O_CLOEXEC);
+	g_free(path);
+}
+
+static void close_pair(int *leftfd, int *rightfd)
+{
+	if (*leftfd >= 0) close(*leftfd);
+	if (*rightfd >= 0) close(*rightfd);
+	*leftfd = *rightfd = -1;
+}
+
+static DiffKinds compare_pair_content(
+		VerifyJob *job,
+		FilePair *pair,
+		char *leftbuf,
+		char *rightbuf)
+{
+	DiffKinds kind = DIFF_NONE;
+	gint64 offset;
+	size_t len;
+	int leftfd, rightfd;
+
+	open_pair(job, pair, &leftfd, &rightfd);
+	if ((leftfd < 0) || (rightfd < 0)) {
+		close_pair(&leftfd, &rightfd);
+		return DIFF_UNREADABLE;
+	}
+
+	posix_fadvise(leftfd, 0, 0, POSIX_FADV_SEQUENTIAL);
+	posix_fadvise(rightfd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+	for (offset = 0; offset < pair->Size; offset += len) {
+		len = MIN(VERIFY_CHUNK_SIZE, pair->Size - offset);
+		if ((pread(leftfd, leftbuf, len, offset) != (ssize_t)len) ||
+				(pread(rightfd, rightbuf, len, offset) != (ssize_t)len)) {
+			kind = DIFF_UNREADABLE;
+			break;
+		}
+
+		/* memcmp() is vectorized by the C library */
+		if (memcmp(leftbuf, rightbuf, len) != 0) {
+			kind = DIFF_CONTENT;
+			break;
+		}
+		verify_add_bytes(job, len);
+	}
+
+	close_pair(&leftfd, &rightfd);
+	return kind;
+}
+
+static void verify_worker(gpointer data, gpointer user_data)
+{
+	VerifyJob *job = (VerifyJob *)data;
+	char *leftbuf = g_malloc(VERIFY_CHUNK_SIZE);
+	char *rightbuf = g_malloc(VERIFY_CHUNK_SIZE);
+	DiffKinds kind;
+	guint index;
+
+	while (((index = g_atomic_int_add(&job->NextPair, 1)) < job->Pairs->len) &&
+			verify_is_needed(job, index)) {
+		kind = compare_pair_content(job,
+				&g_array_index(job->Pairs, FilePair, index), leftbuf, rightbuf);
+		if (kind != DIFF_NONE) verify_pair_differs(job, index, kind);
+	}
+
+	g_free(rightbuf);
+	g_free(leftbuf);
+}
+
+static void verify_with_threads(VerifyJob *job)
+{
+	int threads = CLAMP(g_get_num_processors(), 1, MAX_VERIFY_THREADS);
+	GThreadPool *pool;
+	int i;
+
+	pool = g_thread_pool_new(verify_worker, NULL, threads, TRUE, NULL);
+	for (i = 0; i < threads; i++)
+		g_thread_pool_push(pool, job, NULL);
+	g_thread_pool_free(pool, FALSE, TRUE);
+}
+
+#ifdef USE_LIBURING
+typedef struct {
+	guint Pair;
+	unsigned Len;
+	int PendingReads;
+	gboolean Failed;
+} UringSlot;
+
+typedef struct {
+	int LeftFd;
+	int RightFd;
+	int InFlight;
+} UringFiles;
+
+/*
+ * Reads chunks of the pairs in order, several in flight at once, into buffers
+ * registered with the kernel. Returns FALSE if io_uring can not be used.
+ */
+static gboolean verify_with_uring(VerifyJob *job)
+{
+	struct io_uring ring;
+	struct io_uring_sqe *sqe;
+	struct io_uring_cqe *cqe;
+	struct iovec iov[URING_SLOTS * 2];
+	UringSlot slots[URING_SLOTS];
+	int free_slots[URING_SLOTS];
+	int free_cnt = URING_SLOTS;
+	UringFiles *files, *f;
+	FilePair *pair;
+	char *buffers;
+	gboolean fixed;
+	guint next_pair = 0;
+	gint64 next_offset = 0;
+	unsigned index, len;
+	int i, side, slot;
+
+	if (io_uring_queue_init(URING_SLOTS * 2, &ring, 0) < 0) return FALSE;
+
+	buffers = g_malloc((gsize)URING_SLOTS * 2 * URING_CHUNK_SIZE);
+	for (i = 0; i < URING_SLOTS * 2; i++) {
+		iov[i].iov_base = buffers + (gsize)i * URING_CHUNK_SIZE;
+		iov[i].iov_len = URING_CHUNK_SIZE;
+	}
+	for (i = 0; i < URING_SLOTS; i++) free_slots[i] = i;
+	fixed = (io_uring_register_buffers(&ring, iov, URING_SLOTS * 2) == 0);
+
+	files = g_new(UringFiles, MAX(job->Pairs->len, 1));
+	for (index = 0; index < job->Pairs->len; index++) {
+		files[index].LeftFd = files[index].RightFd = -1;
+		files[index].InFlight = 0;
+	}
+
+	for (;;) {
+		/* Queue the next chunks while there are free buffers */
+		while ((free_cnt > 0) && (next_pair < job->Pairs->len) &&
+				verify_is_needed(job, next_pair)) {
+			pair = &g_array_index(job->Pairs, FilePair, next_pair);
+			f = &files[next_pair];
+
+			if (next_offset == 0) {
+				open_pair(job, pair, &f->LeftFd, &f->RightFd);
+				if ((f->LeftFd < 0) || (f->RightFd < 0)) {
+					close_pair(&f->LeftFd, &f->RightFd);
+					verify_pair_differs(job, next_pair++, DIFF_UNREADABLE);
+					continue;
+				}
+			}
+
+			slot = free_slots[--free_cnt];
+			len = MIN(URING_CHUNK_SIZE, pair->Size - next_offset);
+			slots[slot].Pair = next_pair;
+			slots[slot].Len = len;
+			slots[slot].PendingReads = 2;
+			slots[slot].Failed = FALSE;
+
+			for (side = 0; side < 2; side++) {
+				sqe = io_uring_get_sqe(&ring);
+				if (fixed)
+					io_uring_prep_read_fixed(sqe, side ? f->RightFd : f->LeftFd,
+						iov[slot * 2 + side].iov_base, len, next_offset,
+						slot * 2 + side);
+				else
+					io_uring_prep_read(sqe, side ? f->RightFd : f->LeftFd,
+						iov[slot * 2 + side].iov_base, len, next_offset);
+				io_uring_sqe_set_data64(sqe, slot * 2 + side);
+			}
+			f->InFlight++;
+
+			next_offset += len;
+			if (next_offset >= pair->Size) {
+				next_pair++;
+				next_offset = 0;
+			}
+		}
+
+		if (free_cnt == URING_SLOTS) break;
+
+		io_uring_submit_and_wait(&ring, 1);
+
+		while (io_uring_peek_cqe(&ring, &cqe) == 0) {
+			index = (unsigned)io_uring_cqe_get_data64(cqe);
+			slot = index / 2;
+			if (cqe->res != (int)slots[slot].Len) slots[slot].Failed = TRUE;
+			io_uring_cqe_seen(&ring, cqe);
+
+			if (--slots[slot].PendingReads > 0) continue;
+
+			if (slots[slot].Failed)
+				verify_pair_differs(job, slots[slot].Pair, DIFF_UNREADABLE);
+			else if (memcmp(iov[slot * 2].iov_base, iov[slot * 2 + 1].iov_base,
+						slots[slot].Len) != 0)
+				verify_pair_differs(job, slots[slot].Pair, DIFF_CONTENT);
+			else
+				verify_add_bytes(job, slots[slot].Len);
+
+			/* The files are closed with their last chunk */
+			f = &files[slots[slot].Pair];
+			if ((--f->InFlight == 0) && ((slots[slot].Pair < next_pair) ||
+					!verify_is_needed(job, slots[slot].Pair)))
+				close_pair(&f->LeftFd, &f->RightFd);
+			free_slots[free_cnt++] = slot;
+		}
+	}
+
+	for (index = 0; index < job->Pairs->len; index++)
+		close_pair(&files[index].LeftFd, &files[index].RightFd);
+	g_free(files);
+
+	if (fixed) io_uring_unregister_buffers(&ring);
+	io_uring_queue_exit(&ring);
+	g_free(buffers);
+
+	return TRUE;
+}
+#endif
+
+static gchar * verify_report(VerifyJob *job)
+{
+	const gchar *path;
+	gchar *size, *report;
+	DiffKinds kind = job->WalkDiff;
+
+	path = job->WalkDiffPath;
+	if (job->FirstDiffPair < job->Pairs->len) {
+		kind = job->FirstDiffKind;
+		path = g_array_index(job->Pairs, FilePair, job->FirstDiffPair).RelPath;
+	}
+
+	switch (kind) {
+	case DIFF_NONE:
+		size = g_format_size(2 * job->Bytes);
+		report = g_strdup_printf("The folders are identical: %u files compared, "
+				"%s read at %.2f GB/s.", job->Pairs->len, size, job->Throughput);
+		g_free(size);
+		return report;
+	case DIFF_MISSING:
+		return g_strdup_printf(
+			"The folders differ: \"%s\" exists on one side only.", path);
+	case DIFF_TYPE:
+		return g_strdup_printf(
+			"The folders differ: \"%s\" is not of the same type on both sides.", path);
+	case DIFF_SIZE:
+		return g_strdup_printf(
+			"The folders differ: \"%s\" does not have the same size on both sides.", path);
+	case DIFF_CONTENT:
+		return g_strdup_printf(
+			"The folders differ: \"%s\" does not have the same content on both sides.", path);
+	default:
+		return g_strdup_printf(
+			"The folders could not be verified: \"%s\" could not be read.", path);
+	}
+}
+
+static void verify_response(GtkDialog *dialog, gint response, VerifyJob *job)
+{
+	BCompareExt *bcobj = job->Ext;
+	char *argv[5];
+
+	/* Differences are shown by a full folder comparison */
+	if (response == GTK_RESPONSE_ACCEPT) {
+		argv[0] = "bcompare";
+		argv[1] = "bcompare";
+		argv[2] = job->LeftFolder;
+		argv[3] = job->RightFolder;
+		argv[4] = 0;
+		spawn_bc(bcobj->Winder, argv);
+	}
+
+	gtk_widget_destroy(GTK_WIDGET(dialog));
+	verify_job_free(job);
+}
+
+static gboolean verify_finished(gpointer data)
+{
+	VerifyJob *job = (VerifyJob *)data;
+	gboolean identical = (job->WalkDiff == DIFF_NONE) &&
+		(job->FirstDiffPair >= job->Pairs->len);
+	GtkWindow *parent = NULL;
+	GtkWidget *dialog;
+	gchar *report = verify_report(job);
+
+	if (job->Ext->Winder != NULL)
+		parent = GTK_WINDOW(gtk_widget_get_ancestor(job->Ext->Winder, GTK_TYPE_WINDOW));
+
+	dialog = gtk_message_dialog_new(parent,
+				GTK_DIALOG_DESTROY_WITH_PARENT,
+				identical ? GTK_MESSAGE_INFO : GTK_MESSAGE_WARNING,
+				GTK_BUTTONS_CLOSE,
+				"%s", report);
+	if (!identical)
+		gtk_dialog_add_button(GTK_DIALOG(dialog), "Compare", GTK_RESPONSE_ACCEPT);
+	g_signal_connect(dialog, "response", G_CALLBACK(verify_response), job);
+	gtk_widget_show_all(dialog);
+	g_free(report);
+
+	return G_SOURCE_REMOVE;
+}
+
+static gpointer verify_thread(gpointer data)
+{
+	VerifyJob *job = (VerifyJob *)data;
+	gint64 start;
+	gboolean done = FALSE;
+
+	walk_folders(job, "");
+
+	start = g_get_monotonic_time();
+#ifdef USE_LIBURING
+	done = verify_with_uring(job);
+#endif
+	if (!done) verify_with_threads(job);
+
+	/* Both sides were read, bytes per microsecond / 1000 is GB/s */
+	g_mutex_lock(&job->Lock);
+	job->Throughput = (2.0 * job->Bytes) /
+		(MAX(g_get_monotonic_time() - start, 1) * 1000.0);
+	g_mutex_unlock(&job->Lock);
+
+	g_idle_add(verify_finished, job);
+	return NULL;
+}
+
+static void verify_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	VerifyJob *job = g_new0(VerifyJob, 1);
+
+	job->Ext = bcobj;
+	job->LeftFolder = g_strdup(
+		g_object_get_data((GObject *)item, "bcext::left_folder"));
+	job->RightFolder = g_strdup(
+		g_object_get_data((GObject *)item, "bcext::right_folder"));
+	job->Pairs = g_array_new(FALSE, FALSE, sizeof(FilePair));
+	job->FirstDiffPair = G_MAXUINT;
+	g_mutex_init(&job->Lock);
+
+	g_thread_unref(g_thread_new("bcompare-verify", verify_thread, job));
+	clear_selections(bcobj);
+}
+
+static BcMenuItem * verify_mitem(BCompareExt *bcobj)
+{
+	BcMenuItem *item;
+
+	/* Archives are considered folders but can not be walked */
+	if (!g_file_test(bcobj->LeftFile->str, G_FILE_TEST_IS_DIR) ||
+			!g_file_test(bcobj->RightFile->str, G_FILE_TEST_IS_DIR))
+		return NULL;
+
+	item = nemo_menu_item_new("BCompareExt::verify",
+							"Quick Verify",
+							"Checks that both folders have exactly the same content, "
+							"without starting Beyond Compare",
+							"bcomparefull32");
+	g_signal_connect(item, "activate",
+			G_CALLBACK(verify_action), bcobj);
+	g_object_set_data_full((GObject *)item, "bcext::left_folder",
+			g_strdup(bcobj->LeftFile->str), g_free);
+	g_object_set_data_full((GObject *)item, "bcext::right_folder",
+			g_strdup(bcobj->RightFile->str), g_free);
+
+	return item;
+}
+
+/*************************************************************
+ *
+ * Listings of archives
+ *
+ *************************************************************/
+
+/* Bounds of the listings, beyond them archives are left to Beyond Compare */
+#define MAX_ARCHIVE_ENTRIES 500000
+#define MAX_ARCHIVE_FILTERS 256
+#define MAX_TAR_EXTENDED_HEADER (64 * 1024)
+#define MAX_ZIP_DIRECTORY_SIZE (128 * 1024 * 1024)
+
+/* Bound of the cache, it is simply emptied when reached */
+#define MAX_CACHED_ARCHIVES 256
+
+/* ZIP records, see APPNOTE.TXT */
+#define ZIP_LOCAL_SIGNATURE 0x04034b50
+#define ZIP_EOCD_SIGNATURE 0x06054b50
+#define ZIP_CENTRAL_SIGNATURE 0x02014b50
+#define ZIP64_LOCATOR_SIGNATURE 0x07064b50
+#define ZIP64_EOCD_SIGNATURE 0x06064b50
+#define ZIP_EOCD_SIZE 22
+#define ZIP_MAX_COMMENT 0xFFFF
+#define ZIP64_LOCATOR_SIZE 20
+#define ZIP64_EOCD_SIZE 56
+#define ZIP_CENTRAL_SIZE 46
+
+#define TAR_BLOCK_SIZE 512
+
+typedef enum {
+	ARCHIVE_UNKNOWN = 0,
+	ARCHIVE_IDENTICAL,
+	ARCHIVE_METADATA_DIFFERS,
+	ARCHIVE_ENTRIES_DIFFER
+} ArchiveStates;
+
+typedef struct {
+	gboolean HasCrc;
+	guint32 Crc;
+	gint64 Size;
+	gint64 Mtime;
+	guint32 Mode;
+} ArchiveEntry;
+
+typedef struct {
+	ArchiveStates State;
+	GPtrArray *Differing;	/* entries only in one archive or with a different content */
+} ArchiveResult;
+
+typedef struct {
+	BCompareExt *Ext;
+	gchar *LeftFile;
+	gchar *RightFile;
+	gchar *Key;
+} ArchiveJob;
+
+G_LOCK_DEFINE_STATIC(archive_results);
+static GHashTable *archive_results = NULL;	/* pair of identities -> ArchiveResult */
+static GHashTable *archive_pending = NULL;	/* pairs of identities being listed */
+
+static guint16 le16(const guchar *p)
+{
+	return (guint16)(p[0] | (p[1] << 8));
+}
+
+static guint32 le32(const guchar *p)
+{
+	return (guint32)le16(p) | ((guint32)le16(p + 2) << 16);
+}
+
+static guint64 le64(const guchar *p)
+{
+	return (guint64)le32(p) | ((guint64)le32(p + 4) << 32);
+}
+
+static void archive_entry_add(GHashTable *listing, const char *name, gsize len,
+		gboolean has_crc, guint32 crc, gint64 size, gint64 mtime, guint32 mode)
+{
+	ArchiveEntry *entry = g_new(ArchiveEntry, 1);
+
+	entry->HasCrc = has_crc;
+	entry->Crc = crc;
+	entry->Size = size;
+	entry->Mtime = mtime;
+	entry->Mode = mode;
+	g_hash_table_insert(listing, g_strndup(name, len), entry);
+}
+
+/*
+ * Reads the central directory of a ZIP archive, nothing else is touched.
+ * The archive is read rather than mapped, a file truncated meanwhile only
+ * makes the listing fail.
+ */
+static gboolean read_zip(int fd, guint64 size, GHashTable *listing)
+{
+	guchar locator[ZIP64_LOCATOR_SIZE], record[ZIP64_EOCD_SIZE];
+	guchar *data = NULL;
+	const guchar *eocd = NULL, *p, *end, *extra, *extra_end;
+	guint64 nb_entries, cd_size, cd_offset, locator_offset, eocd_offset, i;
+	gsize tail;
+	gint64 entry_size;
+	int name_len, extra_len, comment_len, len;
+	gboolean ok = FALSE;
+
+	if (size < ZIP_EOCD_SIZE) return FALSE;
+
+	/* The end of central directory record is in the last 64 KB, before the comment */
+	tail = MIN(size, ZIP_EOCD_SIZE + ZIP_MAX_COMMENT);
+	data = g_malloc(tail);
+	if (pread(fd, data, tail, size - tail) != (ssize_t)tail) goto done;
+	for (p = data + tail - ZIP_EOCD_SIZE; p >= data; p--) {
+		if (le32(p) == ZIP_EOCD_SIGNATURE) {
+			eocd = p;
+			break;
+		}
+	}
+	if (eocd == NULL) goto done;
+
+	nb_entries = le16(eocd + 10);
+	cd_size = le32(eocd + 12);
+	cd_offset = le32(eocd + 16);
+
+	/* ZIP64 archives keep the real values in another record, found with its locator */
+	if ((nb_entries == 0xFFFF) || (cd_size == 0xFFFFFFFF) || (cd_offset == 0xFFFFFFFF)) {
+		eocd_offset = size - tail + (eocd - data);
+		if ((eocd_offset < ZIP64_LOCATOR_SIZE) ||
+				(pread(fd, locator, ZIP64_LOCATOR_SIZE, eocd_offset - ZIP64_LOCATOR_SIZE) !=
+				 ZIP64_LOCATOR_SIZE) ||
+				(le32(locator) != ZIP64_LOCATOR_SIGNATURE))
+			goto done;
+		locator_offset = le64(locator + 8);
+		if ((locator_offset > size) || (ZIP64_EOCD_SIZE > size - locator_offset)) goto done;
+		if ((pread(fd, record, ZIP64_EOCD_SIZE, locator_offset) != ZIP64_EOCD_SIZE) ||
+				(le32(record) != ZIP64_EOCD_SIGNATURE))
+			goto done;
+
+		nb_entries = le64(record + 32);
+		cd_size = le64(record + 40);
+		cd_offset = le64(record + 48);
+	}
+
+	if ((nb_entries > MAX_ARCHIVE_ENTRIES) || (cd_size > MAX_ZIP_DIRECTORY_SIZE) ||
+			(cd_offset > size) || (cd_size > size - cd_offset))
+		goto done;
+
+	g_free(data);
+	data = g_malloc(MAX(cd_size, 1));
+	if (pread(fd, data, cd_size, cd_offset) != (ssize_t)cd_size) goto done;
+
+	p = data;
+	end = p + cd_size;
+	for (i = 0; i < nb_entries; i++) {
+		if ((end - p < ZIP_CENTRAL_SIZE) || (le32(p) != ZIP_CENTRAL_SIGNATURE))
+			goto done;
+
+		name_len = le16(p + 28);
+		extra_len = le16(p + 30);
+		comment_len = le16(p + 32);
+		if (end - p < ZIP_CENTRAL_SIZE + name_len + extra_len + comment_len)
+			goto done;
+
+		/* The 64 bit uncompressed size comes first in the ZIP64 extra field */
+		entry_size = le32(p + 24);
+		if (entry_size == 0xFFFFFFFF) {
+			extra = p + ZIP_CENTRAL_SIZE + name_len;
+			extra_end = extra + extra_len;
+			while (extra_end - extra >= 4) {
+				len = le16(extra + 2);
+				if ((le16(extra) == 0x0001) && (len >= 8) && (extra_end - extra >= 4 + len)) {
+					entry_size = (gint64)le64(extra + 4);
+					break;
+				}
+				extra += 4 + len;
+			}
+		}
+
+		if ((name_len > 0) && (p[ZIP_CENTRAL_SIZE + name_len - 1] != '/'))
+			archive_entry_add(listing, (const char *)p + ZIP_CENTRAL_SIZE, name_len,
+				TRUE, le32(p + 16), entry_size,
+				((gint64)le16(p + 14) << 16) | le16(p + 12), le32(p + 38) >> 16);
+
+		p += ZIP_CENTRAL_SIZE + name_len + extra_len + comment_len;
+	}
+	ok = TRUE;
+
+done:
+	g_free(data);
+	return ok;
+}
+
+/* Octal number of a TAR header field, or base-256 when the high bit is set */
+static gint64 tar_number(const guchar *field, int len)
+{
+	gint64 value = 0;
+	int i;
+
+	if (field[0] & 0x80) {
+		value = field[0] & 0x7F;
+		for (i = 1; i < len; i++)
+			value = (value << 8) | field[i];
+		return value;
+	}
+
+	for (i = 0; (i < len) && (field[i] != '\0'); i++) {
+		if ((field[i] >= '0') && (field[i] <= '7'))
+			value = (value << 3) | (field[i] - '0');
+		else if (field[i] != ' ')
+			return -1;
+	}
+	return value;
+}
+
+static gboolean tar_checksum_valid(const guchar *header)
+{
+	gint64 sum = 0;
+	int i;
+
+	for (i = 0; i < TAR_BLOCK_SIZE; i++)
+		sum += ((i >= 148) && (i < 156)) ? ' ' : header[i];
+	return (sum == tar_number(header + 148, 8));
+}
+
+/* Applies the "path" and "size" records of a PAX extended header */
+static void parse_pax_records(const char *data, gsize size, gchar **path, gint64 *entry_size)
+{
+	gsize pos = 0, len;
+	const char *record, *record_end, *space;
+
+	while (pos < size) {
+		space = memchr(data + pos, ' ', size - pos);
+		len = (space != NULL) ? strtoul(data + pos, NULL, 10) : 0;
+		if ((len == 0) || (len > size - pos) || (space >= data + pos + len)) return;
+
+		/* "<len> <key>=<value>\n", the key and its '=' must fit before the newline */
+		record = space + 1;
+		record_end = data + pos + len - 1;
+		if (len > (gsize)((record + 5) - (data + pos))) {
+			if (memcmp(record, "path=", 5) == 0) {
+				g_free(*path);
+				*path = g_strndup(record + 5, record_end - (record + 5));
+			}
+			else if (memcmp(record, "size=", 5) == 0) {
+				*entry_size = g_ascii_strtoll(record + 5, NULL, 10);
+			}
+		}
+		pos += len;
+	}
+}
+
+/* Reads the headers of an uncompressed TAR archive, the contents are skipped */
+static gboolean read_tar(int fd, GHashTable *listing)
+{
+	guchar header[TAR_BLOCK_SIZE];
+	gchar *next_path = NULL, *name, *data;
+	gint64 next_size = -1, size;
+	off_t pos = 0, data_pos;
+	gboolean ok = FALSE;
+	char type;
+
+	while (pread(fd, header, TAR_BLOCK_SIZE, pos) == TAR_BLOCK_SIZE) {
+		if (header[0] == '\0') {
+			ok = (pos > 0);
+			break;
+		}
+		if (!tar_checksum_valid(header)) break;
+
+		type = (char)header[156];
+		size = (next_size >= 0) ? next_size : tar_number(header + 124, 12);
+		if (size < 0) break;
+
+		data_pos = pos + TAR_BLOCK_SIZE;
+		pos = data_pos + ((size + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE) * TAR_BLOCK_SIZE;
+
+		/* GNU long names and PAX extended headers describe the next entry */
+		if ((type == 'L') || (type == 'x')) {
+			if (size > MAX_TAR_EXTENDED_HEADER) break;
+			data = g_malloc0(size + 1);
+			if (pread(fd, data, size, data_pos) != (ssize_t)size) {
+				g_free(data);
+				break;
+			}
+			if (type == 'L') {
+				g_free(next_path);
+				next_path = g_strdup(data);
+			}
+			else parse_pax_records(data, size, &next_path, &next_size);
+			g_free(data);
+			continue;
+		}
+		if (type == 'g') continue;
+
+		if (next_path != NULL)
+			name = next_path;
+		else if ((memcmp(header + 257, "ustar", 5) == 0) && (header[345] != '\0'))
+			name = g_strdup_printf("%.155s/%.100s", header + 345, header);
+		else
+			name = g_strndup((const char *)header, 100);
+		next_path = NULL;
+		next_size = -1;
+
+		if ((type != '5') && !g_str_has_suffix(name, "/")) {
+			if (g_hash_table_size(listing) >= MAX_ARCHIVE_ENTRIES) {
+				g_free(name);
+				break;
+			}
+			archive_entry_add(listing, name, strlen(name), FALSE, 0, size,
+				tar_number(header + 136, 12), (guint32)tar_number(header + 100, 8));
+		}
+		g_free(name);
+	}
+
+	/* Archives ending without their two zero blocks are still fine */
+	if (!ok) ok = (pos > 0) && (g_hash_table_size(listing) > 0) &&
+		(pread(fd, header, 1, pos) == 0);
+
+	g_free(next_path);
+	return ok;
+}
+
+/* Compressed TAR files have no readable header, they are not listed */
+static GHashTable * archive_listing(const char *path)
+{
+	GHashTable *listing = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	guchar magic[4];
+	struct stat st;
+	gboolean ok = FALSE;
+	int fd;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if ((fd >= 0) && (fstat(fd, &st) == 0) && (pread(fd, magic, 4, 0) == 4)) {
+		if ((le32(magic) == ZIP_LOCAL_SIGNATURE) || (le32(magic) == ZIP_EOCD_SIGNATURE))
+			ok = read_zip(fd, st.st_size, listing);
+		else ok = read_tar(fd, listing);
+	}
+	if (fd >= 0) close(fd);
+
+	if (!ok) {
+		g_hash_table_unref(listing);
+		listing = NULL;
+	}
+	return listing;
+}
+
+/* Without a CRC, TAR entries of the same size and time are taken as identical */
+static gboolean archive_same_content(const ArchiveEntry *a, const ArchiveEntry *b)
+{
+	if (a->Size != b->Size) return FALSE;
+	if (a->HasCrc && b->HasCrc) return (a->Crc == b->Crc);
+	return (a->Mtime == b->Mtime);
+}
+
+static void archive_result_free(gpointer data)
+{
+	ArchiveResult *result = (ArchiveResult *)data;
+
+	g_ptr_array_unref(result->Differing);
+	g_free(result);
+}
+
+static gint archive_entry_compare(gconstpointer a, gconstpointer b)
+{
+	return strcmp(*(const char **)a, *(const char **)b);
+}
+
+/*
+ * Compares two archives from their listings only, so the answer takes
+ * milliseconds even for archives of several GB. Runs in the background.
+ */
+static ArchiveResult * archive_compare(const char *left_path, const char *right_path)
+{
+	ArchiveResult *result;
+	GHashTable *left, *right;
+	GHashTableIter iter;
+	gpointer name, entry, other;
+	gboolean metadata_differs = FALSE;
+
+	result = g_new0(ArchiveResult, 1);
+	result->Differing = g_ptr_array_new_with_free_func(g_free);
+	left = archive_listing(left_path);
+	right = (left != NULL) ? archive_listing(right_path) : NULL;
+
+	if ((left != NULL) && (right != NULL)) {
+		g_hash_table_iter_init(&iter, left);
+		while (g_hash_table_iter_next(&iter, &name, &entry)) {
+			other = g_hash_table_lookup(right, name);
+			if ((other == NULL) || !archive_same_content(entry, other))
+				g_ptr_array_add(result->Differing, g_strdup(name));
+			else if ((((ArchiveEntry *)entry)->Mtime != ((ArchiveEntry *)other)->Mtime) ||
+					(((ArchiveEntry *)entry)->Mode != ((ArchiveEntry *)other)->Mode))
+				metadata_differs = TRUE;
+		}
+		g_hash_table_iter_init(&iter, right);
+		while (g_hash_table_iter_next(&iter, &name, NULL)) {
+			if (!g_hash_table_contains(left, name))
+				g_ptr_array_add(result->Differing, g_strdup(name));
+		}
+
+		g_ptr_array_sort(result->Differing, archive_entry_compare);
+		result->State = (result->Differing->len > 0) ? ARCHIVE_ENTRIES_DIFFER :
+			(metadata_differs ? ARCHIVE_METADATA_DIFFERS : ARCHIVE_IDENTICAL);
+	}
+
+	if (left != NULL) g_hash_table_unref(left);
+	if (right != NULL) g_hash_table_unref(right);
+	return result;
+}
+
+/* Key of the results, from the identities of both archives */
+static gchar * archive_key(const char *left_path, const char *right_path)
+{
+	gchar *left_id, *right_id, *key = NULL;
+	gint64 size;
+
+	left_id = file_identity(left_path, &size);
+	right_id = file_identity(right_path, &size);
+	if ((left_id != NULL) && (right_id != NULL))
+		key = g_strconcat(left_id, "|", right_id, NULL);
+	g_free(left_id);
+	g_free(right_id);
+	return key;
+}
+
+static void archive_job_free(ArchiveJob *job)
+{
+	g_free(job->Key);
+	g_free(job->RightFile);
+	g_free(job->LeftFile);
+	g_free(job);
+}
+
+static gboolean archive_job_finished(gpointer data)
+{
+	ArchiveJob *job = (ArchiveJob *)data;
+
+	G_LOCK(archive_results);
+	g_hash_table_remove(archive_pending, job->Key);
+	G_UNLOCK(archive_results);
+
+	/* The menus are built again, with the result in the cache */
+	alert_updated(job->Ext);
+	archive_job_free(job);
+	return G_SOURCE_REMOVE;
+}
+
+static gpointer archive_thread(gpointer data)
+{
+	ArchiveJob *job = (ArchiveJob *)data;
+	ArchiveResult *result = archive_compare(job->LeftFile, job->RightFile);
+
+	G_LOCK(archive_results);
+	if (g_hash_table_size(archive_results) >= MAX_CACHED_ARCHIVES)
+		g_hash_table_remove_all(archive_results);
+	g_hash_table_replace(archive_results, g_strdup(job->Key), result);
+	G_UNLOCK(archive_results);
+
+	g_idle_add(archive_job_finished, job);
+	return NULL;
+}
+
+/*
+ * Filter argument narrowing a session of both archives to their differing
+ * entries, NULL if they are not known yet or too many. Only the result
+ * found while the menu was shown is used, the session is never delayed.
+ */
+static gchar * archive_narrowing_filter(const char *left_path, const char *right_path)
+{
+	const ArchiveResult *result;
+	GString *filters = NULL;
+	const char *entry;
+	gchar *key;
+	guint i;
+
+	key = archive_key(left_path, right_path);
+	if (key == NULL) return NULL;
+
+	G_LOCK(archive_results);
+	result = (archive_results != NULL) ? g_hash_table_lookup(archive_results, key) : NULL;
+	if ((result != NULL) && (result->State == ARCHIVE_ENTRIES_DIFFER) &&
+			(result->Differing->len <= MAX_ARCHIVE_FILTERS)) {
+		filters = g_string_new("-filters=");
+		for (i = 0; i < result->Differing->len; i++) {
+			entry = g_ptr_array_index(result->Differing, i);
+
+			/* The separator of the filters can not be escaped */
+			if (strchr(entry, ';') != NULL) {
+				g_string_free(filters, TRUE);
+				filters = NULL;
+				break;
+			}
+			g_string_append_printf(filters, "%s/%s", (i > 0) ? ";" : "", entry);
+		}
+	}
+	G_UNLOCK(archive_results);
+
+	g_free(key);
+	return (filters != NULL) ? g_string_free(filters, FALSE) : NULL;
+}
+
+/*
+ * Adds the state of the archives known from their listings to the label.
+ * The listings are read in the background, and the menus are built again
+ * when the result is known.
+ */
+static void archive_state_mitem(BCompareExt *bcobj, BcMenuItem *item)
+{
+	const ArchiveResult *result;
+	ArchiveStates found = ARCHIVE_UNKNOWN;
+	ArchiveJob *job = NULL;
+	guint differing = 0;
+	gchar *key, *label, *state = NULL;
+
+	key = archive_key(bcobj->LeftFile->str, bcobj->RightFile->str);
+	if (key == NULL) return;
+
+	G_LOCK(archive_results);
+	if (archive_results == NULL) {
+		archive_results = g_hash_table_new_full(g_str_hash, g_str_equal,
+			g_free, archive_result_free);
+		archive_pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	}
+
+	result = g_hash_table_lookup(archive_results, key);
+	if (result != NULL) {
+		found = result->State;
+		differing = result->Differing->len;
+	}
+	else if (!g_hash_table_contains(archive_pending, key)) {
+		g_hash_table_add(archive_pending, g_strdup(key));
+		job = g_new0(ArchiveJob, 1);
+		job->Ext = bcobj;
+		job->LeftFile = g_strdup(bcobj->LeftFile->str);
+		job->RightFile = g_strdup(bcobj->RightFile->str);
+		job->Key = key;
+		key = NULL;
+	}
+	G_UNLOCK(archive_results);
+
+	g_free(key);
+	if (job != NULL)
+		g_thread_unref(g_thread_new("bcompare-archive", archive_thread, job));
+	if (found == ARCHIVE_UNKNOWN) return;
+
+	g_object_get(item, "label", &label, NULL);
+	if (found == ARCHIVE_IDENTICAL)
+		state = g_strdup_printf("%s (identical contents)", label);
+	else if (found == ARCHIVE_METADATA_DIFFERS)
+		state = g_strdup_printf("%s (only metadata differs)", label);
+	else
+		state = g_strdup_printf((differing == 1) ?
+			"%s (%u entry differs)" : "%s (%u entries differ)",
+			label, differing);
+
+	g_object_set(item, "label", state, NULL);
+	g_free(state);
+	g_free(label);
+}
+
+/*************************************************************
+ *
+ * Ignore rules of folders
+ *
+ *************************************************************/
+
+/* Bound of the cache, it is simply dropped when full */
+#define MAX_CACHED_RULE_SETS 4096
+
+static const char *ignore_files[] = { ".gitignore", ".bcignore" };
+
+typedef struct {
+	GRegex *Regex;
+	gboolean Negated;
+	gboolean FolderOnly;
+} IgnoreRule;
+
+typedef struct {
+	gint64 MtimeNs[2];	/* of the files the rules come from, -1 if missing */
+	GPtrArray *Rules;	/* IgnoreRule in file order, the last match wins */
+} IgnoreRuleSet;
+
+typedef struct {
+	GPtrArray *Rules;
+	gchar *Prefix;		/* walked folder relative to the folder of the rules */
+	gsize Strip;		/* length of the folder of the rules in the walk */
+} ActiveRules;
+
+G_LOCK_DEFINE_STATIC(ignore_cache);
+static GHashTable *ignore_cache = NULL;
+
+static void ignore_rule_free(gpointer data)
+{
+	IgnoreRule *rule = (IgnoreRule *)data;
+
+	g_regex_unref(rule->Regex);
+	g_free(rule);
+}
+
+static void ignore_rule_set_free(gpointer data)
+{
+	IgnoreRuleSet *set = (IgnoreRuleSet *)data;
+
+	g_ptr_array_unref(set->Rules);
+	g_free(set);
+}
+
+static gint64 file_mtime_ns(const char *filepath)
+{
+	struct stat st;
+
+	if (stat(filepath, &st) != 0) return -1;
+	return (gint64)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+/*
+ * Translates a Git wildcard pattern to a regular expression matching the
+ * paths relative to the folder of the rules.
+ */
+static gchar * glob_to_regex(const char *pattern, gboolean anchored)
+{
+	GString *re = g_string_new(anchored ? "^" : "^(?:.*/)?");
+	const char *end;
+	gchar *escaped;
+
+	while (*pattern != '\0') {
+		if (strncmp(pattern, "**/", 3) == 0) {
+			g_string_append(re, "(?:.*/)?");
+			pattern += 3;
+			continue;
+		}
+		if (strcmp(pattern, "**") == 0) {
+			g_string_append(re, ".*");
+			break;
+		}
+
+		if (*pattern == '*') {
+			g_string_append(re, "[^/]*");
+		}
+		else if (*pattern == '?') {
+			g_string_append(re, "[^/]");
+		}
+		else if ((*pattern == '[') && (pattern[1] != '\0') &&
+				((end = strchr(pattern + 2, ']')) != NULL)) {
+			g_string_append_c(re, '[');
+			if (*(++pattern) == '!') {
+				g_string_append_c(re, '^');
+				pattern++;
+			}
+			for (; pattern < end; pattern++) {
+				if (*pattern == '\\') g_string_append_c(re, '\\');
+				g_string_append_c(re, *pattern);
+			}
+			g_string_append_c(re, ']');
+		}
+		else {
+			if ((*pattern == '\\') && (pattern[1] != '\0')) pattern++;
+			escaped = g_regex_escape_string(pattern, 1);
+			g_string_append(re, escaped);
+			g_free(escaped);
+		}
+		pattern++;
+	}
+
+	g_string_append_c(re, '$');
+	return g_string_free(re, FALSE);
+}
+
+static void parse_ignore_file(const char *filepath, GPtrArray *rules)
+{
+	gchar *contents, *line, *re;
+	gchar **lines;
+	IgnoreRule *rule;
+	gboolean negated, folder_only, anchored;
+	gsize len;
+	int i;
+
+	if (!g_file_get_contents(filepath, &contents, NULL, NULL)) return;
+
+	lines = g_strsplit(contents, "\n", -1);
+	for (i = 0; lines[i] != NULL; i++) {
+		line = lines[i];
+		len = strlen(line);
+
+		/* Trailing spaces are ignored unless escaped */
+		while ((len > 0) && ((line[len - 1] == '\r') ||
+				((line[len - 1] == ' ') && ((len < 2) || (line[len - 2] != '\\')))))
+			line[--len] = '\0';
+		if ((len == 0) || (line[0] == '#')) continue;
+
+		negated = (line[0] == '!');
+		if (negated) {
+			line++;
+			len--;
+		}
+
+		folder_only = (len > 0) && (line[len - 1] == '/');
+		if (folder_only) line[--len] = '\0';
+
+		/* A slash anywhere but at the end anchors the pattern to its folder */
+		anchored = (strchr(line, '/') != NULL);
+		if (line[0] == '/') line++;
+		if (line[0] == '\0') continue;
+
+		re = glob_to_regex(line, anchored);
+		rule = g_new0(IgnoreRule, 1);
+		rule->Regex = g_regex_new(re, G_REGEX_OPTIMIZE, 0, NULL);
+		rule->Negated = negated;
+		rule->FolderOnly = folder_only;
+		if (rule->Regex != NULL) g_ptr_array_add(rules, rule);
+		else g_free(rule);
+		g_free(re);
+	}
+
+	g_strfreev(lines);
+	g_free(contents);
+}
+
+/*
+ * Returns the compiled rules of folder, cached until one of its files
+ * changes. To be released with g_ptr_array_unref().
+ */
+static GPtrArray * ignore_rules_of(const char *folder)
+{
+	IgnoreRuleSet *set;
+	GPtrArray *rules = NULL;
+	gchar *filepath;
+	gint64 mtime_ns[2];
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		filepath = g_build_filename(folder, ignore_files[i], NULL);
+		mtime_ns[i] = file_mtime_ns(filepath);
+		g_free(filepath);
+	}
+
+	G_LOCK(ignore_cache);
+	set = (ignore_cache != NULL) ? g_hash_table_lookup(ignore_cache, folder) : NULL;
+	if ((set != NULL) && (set->MtimeNs[0] == mtime_ns[0]) && (set->MtimeNs[1] == mtime_ns[1]))
+		rules = g_ptr_array_ref(set->Rules);
+	G_UNLOCK(ignore_cache);
+	if (rules != NULL) return rules;
+
+	set = g_new0(IgnoreRuleSet, 1);
+	set->Rules = g_ptr_array_new_with_free_func(ignore_rule_free);
+	for (i = 0; i < 2; i++) {
+		set->MtimeNs[i] = mtime_ns[i];
+		if (mtime_ns[i] >= 0) {
+			filepath = g_build_filename(folder, ignore_files[i], NULL);
+			parse_ignore_file(filepath, set->Rules);
+			g_free(filepath);
+		}
+	}
+	rules = g_ptr_array_ref(set->Rules);
+
+	G_LOCK(ignore_cache);
+	if ((ignore_cache != NULL) &&
+			(g_hash_table_size(ignore_cache) >= MAX_CACHED_RULE_SETS)) {
+		g_hash_table_destroy(ignore_cache);
+		ignore_cache = NULL;
+	}
+	if (ignore_cache == NULL)
+		ignore_cache = g_hash_table_new_full(
+				g_str_hash, g_str_equal, g_free, ignore_rule_set_free);
+	g_hash_table_insert(ignore_cache, g_strdup(folder), set);
+	G_UNLOCK(ignore_cache);
+
+	return rules;
+}
+
+static void active_rules_truncate(GArray *active, guint len)
+{
+	guint i;
+
+	for (i = len; i < active->len; i++) {
+		g_ptr_array_unref(g_array_index(active, ActiveRules, i).Rules);
+		g_free(g_array_index(active, ActiveRules, i).Prefix);
+	}
+	g_array_set_size(active, len);
+}
+
+static gboolean is_ignored(GArray *active, const char *relpath, gboolean isdir)
+{
+	ActiveRules *a;
+	IgnoreRule *rule;
+	gchar *path;
+	gint i, r;
+
+	/* The deepest rules take precedence, then the last ones of each file */
+	for (i = (gint)active->len - 1; i >= 0; i--) {
+		a = &g_array_index(active, ActiveRules, i);
+		path = g_strconcat(a->Prefix, relpath + a->Strip, NULL);
+
+		for (r = (gint)a->Rules->len - 1; r >= 0; r--) {
+			rule = (IgnoreRule *)g_ptr_array_index(a->Rules, r);
+			if ((!rule->FolderOnly || isdir) &&
+					g_regex_match(rule->Regex, path, 0, NULL)) {
+				g_free(path);
+				return !rule->Negated;
+			}
+		}
+		g_free(path);
+	}
+
+	return FALSE;
+}
+
+static void walk_ignored(
+		const char *root,
+		const char *relpath,
+		GArray *active,
+		GPtrArray *folders,
+		GPtrArray *files,
+		guint max)
+{
+	gchar *dirpath, *entrypath;
+	GArray *entries;
+	ActiveRules rules;
+	DirEntry *entry;
+	guint depth = active->len;
+	gboolean isdir;
+	guint i;
+
+	if (folders->len >= max) return;
+
+	dirpath = (relpath[0] == '\0') ? g_strdup(root) :
+		g_build_filename(root, relpath, NULL);
+	entries = list_directory(dirpath);
+	if (entries == NULL) {
+		g_free(dirpath);
+		return;
+	}
+
+	rules.Rules = ignore_rules_of(dirpath);
+	rules.Prefix = g_strdup("");
+	rules.Strip = (relpath[0] == '\0') ? 0 : strlen(relpath) + 1;
+	g_array_append_val(active, rules);
+	if (rules.Rules->len == 0) active_rules_truncate(active, depth);
+
+	for (i = 0; i < entries->len; i++) {
+		entry = &g_array_index(entries, DirEntry, i);
+		isdir = S_ISDIR(entry->St.st_mode);
+		entrypath = (relpath[0] == '\0') ? g_strdup(entry->Name) :
+			g_build_filename(relpath, entry->Name, NULL);
+
+		/* Git never looks inside its own folder */
+		if ((isdir && (strcmp(entry->Name, ".git") == 0)) ||
+				is_ignored(active, entrypath, isdir)) {
+			if (isdir)
+				g_ptr_array_add(folders, g_strconcat(entrypath, "/", NULL));
+			else if (files->len < max)
+				g_ptr_array_add(files, g_strdup(entrypath));
+		}
+		else if (isdir) {
+			walk_ignored(root, entrypath, active, folders, files, max);
+		}
+		g_free(entrypath);
+	}
+
+	active_rules_truncate(active, depth);
+	dir_entries_free(entries);
+	g_free(dirpath);
+}
+
+/*
+ * Returns the relative paths ignored in the tree of folder by the .gitignore
+ * and .bcignore files, folders first and ending with a slash, at most max of
+ * them. The rules of the parent folders apply up to the root of a Git work
+ * tree. The ignored folders are not walked.
+ */
+static GPtrArray * ignored_paths(const char *folder, guint max)
+{
+	GArray *active = g_array_new(FALSE, FALSE, sizeof(ActiveRules));
+	GPtrArray *folders = g_ptr_array_new_with_free_func(g_free);
+	GPtrArray *files = g_ptr_array_new();
+	ActiveRules rules;
+	gchar *root = g_strdup(folder);
+	gchar *dir, *name, *prefix, *gitpath;
+	gboolean in_git = FALSE;
+	gsize len = strlen(root);
+	guint i;
+
+	if ((len > 1) && (root[len - 1] == '/')) root[len - 1] = '\0';
+
+	/* The rules of the parent folders only apply inside a Git work tree */
+	dir = g_strdup(root);
+	prefix = g_strdup("");
+	while (!in_git && (strcmp(dir, "/") != 0) && (dir[0] != '\0')) {
+		name = g_path_get_basename(dir);
+		gitpath = g_strconcat(name, "/", prefix, NULL);
+		g_free(prefix);
+		g_free(name);
+		prefix = gitpath;
+
+		name = g_path_get_dirname(dir);
+		g_free(dir);
+		dir = name;
+
+		rules.Rules = ignore_rules_of(dir);
+		rules.Prefix = g_strdup(prefix);
+		rules.Strip = 0;
+		g_array_prepend_val(active, rules);
+
+		gitpath = g_build_filename(dir, ".git", NULL);
+		in_git = g_file_test(gitpath, G_FILE_TEST_EXISTS);
+		g_free(gitpath);
+	}
+	if (!in_git) active_rules_truncate(active, 0);
+	g_free(prefix);
+	g_free(dir);
+
+	walk_ignored(root, "", active, folders, files, max);
+
+	/* The folders are the most useful to skip */
+	for (i = 0; i < files->len; i++)
+		g_ptr_array_add(folders, g_ptr_array_index(files, i));
+	if (folders->len > max) g_ptr_array_set_size(folders, max);
+
+	g_ptr_array_free(files, TRUE);
+	active_rules_truncate(active, 0);
+	g_array_free(active, TRUE);
+	g_free(root);
+	return folders;
+}
+
+/*************************************************************
+ *
+ * Changed subtrees of folders
+ *
+ *************************************************************/
+
+/* Bounds of the walk, past them the unchanged subtrees are not skipped */
+#define MAX_DELTA_WALK_USEC (15 * G_USEC_PER_SEC)
+#define MAX_DELTA_FILTERS 256
+/* Ignored paths kept for each side, the folders first */
+#define MAX_IGNORE_FILTERS 256
+
+typedef struct {
+	BCompareExt *Ext;
+	gchar **Argv;
+	gboolean LowPriority;
+	gchar *LeftFolder;
+	gchar *RightFolder;
+	gint64 Deadline;
+	gboolean SkipUnchanged;
+	GHashTable *Ignored;	/* relative paths, folders ending with a slash */
+	GMutex Lock;		/* protects the members below */
+	GPtrArray *Unchanged;	/* relative paths of the unchanged subtrees */
+	gboolean Changed;
+} DeltaJob;
+
+static void delta_job_free(DeltaJob *job)
+{
+	g_ptr_array_unref(job->Unchanged);
+	g_mutex_clear(&job->Lock);
+	if (job->Ignored != NULL) g_hash_table_destroy(job->Ignored);
+	g_free(job->RightFolder);
+	g_free(job->LeftFolder);
+	g_strfreev(job->Argv);
+	g_free(job);
+}
+
+static gboolean same_entry(const struct stat *left, const struct stat *right)
+{
+	return ((left->st_mode & S_IFMT) == (right->st_mode & S_IFMT)) &&
+		(S_ISDIR(left->st_mode) ||
+			((left->st_size == right->st_size) &&
+			(left->st_mtim.tv_sec == right->st_mtim.tv_sec) &&
+			(left->st_mtim.tv_nsec == right->st_mtim.tv_nsec)));
+}
+
+static gboolean delta_is_ignored(DeltaJob *job, const char *relpath, DirEntry *entry)
+{
+	gchar *key = S_ISDIR(entry->St.st_mode) ? g_strconcat(relpath, "/", NULL) :
+		g_strdup(relpath);
+	gboolean ignored = g_hash_table_contains(job->Ignored, key);
+
+	g_free(key);
+	return ignored;
+}
+
+/*
+ * Returns TRUE if the subtree relpath changed, looking only at the sizes and
+ * modification times of the entries which are not ignored. In that case its unchanged subfolders, at any depth,
+ * are added to unchanged. With a pool, the subfolders are walked by it.
+ */
+static gboolean walk_delta(
+		DeltaJob *job,
+		const char *relpath,
+		GPtrArray *unchanged,
+		GThreadPool *pool)
+{
+	gchar *leftpath, *rightpath, *subpath;
+	GArray *left_entries, *right_entries;
+	GPtrArray *below;
+	DirEntry *left, *right, *entry;
+	gboolean changed = FALSE;
+	guint i = 0, j = 0;
+	int cmp;
+
+	if (g_get_monotonic_time() > job->Deadline) return TRUE;
+
+	leftpath = g_build_filename(job->LeftFolder, relpath, NULL);
+	rightpath = g_build_filename(job->RightFolder, relpath, NULL);
+	left_entries = list_directory(leftpath);
+	right_entries = list_directory(rightpath);
+	g_free(rightpath);
+	g_free(leftpath);
+
+	if ((left_entries == NULL) || (right_entries == NULL)) {
+		if (left_entries != NULL) dir_entries_free(left_entries);
+		if (right_entries != NULL) dir_entries_free(right_entries);
+		return TRUE;
+	}
+
+	below = g_ptr_array_new();
+
+	while ((i < left_entries->len) || (j < right_entries->len)) {
+		left = (i < left_entries->len) ? &g_array_index(left_entries, DirEntry, i) : NULL;
+		right = (j < right_entries->len) ? &g_array_index(right_entries, DirEntry, j) : NULL;
+		cmp = (left == NULL) ? 1 : ((right == NULL) ? -1 : strcmp(left->Name, right->Name));
+		entry = (cmp <= 0) ? left : right;
+		if (cmp <= 0) i++;
+		if (cmp >= 0) j++;
+
+		subpath = (relpath[0] == '\0') ? g_strdup(entry->Name) :
+			g_build_filename(relpath, entry->Name, NULL);
+
+		if (delta_is_ignored(job, subpath, entry)) {
+			/* Filtered out of the session */
+		}
+		else if ((cmp != 0) || !same_entry(&left->St, &right->St)) {
+			changed = TRUE;
+		}
+		else if (S_ISDIR(left->St.st_mode)) {
+			if (pool != NULL) {
+				g_thread_pool_push(pool, subpath, NULL);
+				subpath = NULL;
+			}
+			else if (walk_delta(job, subpath, below, NULL)) {
+				changed = TRUE;
+			}
+			else {
+				g_ptr_array_add(below, subpath);
+				subpath = NULL;
+			}
+		}
+		g_free(subpath);
+	}
+
+	/* An unchanged subtree is reported by its closest changed parent */
+	for (i = 0; i < below->len; i++) {
+		if (changed) g_ptr_array_add(unchanged, g_ptr_array_index(below, i));
+		else g_free(g_ptr_array_index(below, i));
+	}
+	g_ptr_array_free(below, TRUE);
+
+	dir_entries_free(right_entries);
+	dir_entries_free(left_entries);
+	return changed;
+}
+
+/* Walks one top level folder present on both sides */
+static void delta_worker(gpointer data, gpointer user_data)
+{
+	DeltaJob *job = (DeltaJob *)user_data;
+	gchar *relpath = (gchar *)data;
+	GPtrArray *unchanged = g_ptr_array_new();
+	gboolean changed = walk_delta(job, relpath, unchanged, NULL);
+	guint i;
+
+	g_mutex_lock(&job->Lock);
+	if (changed) {
+		job->Changed = TRUE;
+		for (i = 0; i < unchanged->len; i++)
+			g_ptr_array_add(job->Unchanged, g_ptr_array_index(unchanged, i));
+		g_free(relpath);
+	}
+	else g_ptr_array_add(job->Unchanged, relpath);
+	g_mutex_unlock(&job->Lock);
+
+	g_ptr_array_free(unchanged, TRUE);
+}
+
+static gint skipped_path_compare(gconstpointer a, gconstpointer b)
+{
+	return strcmp(*(const char **)a, *(const char **)b);
+}
+
+static gboolean delta_finished(gpointer data)
+{
+	DeltaJob *job = (DeltaJob *)data;
+	BCompareExt *bcobj = job->Ext;
+	GPtrArray *argv = g_ptr_array_new();
+	GPtrArray *skipped = g_ptr_array_new_with_free_func(g_free);
+	GString *filters = g_string_new("-filters=");
+	GHashTableIter iter;
+	gpointer path;
+	guint i;
+
+	g_ptr_array_add(argv, job->Argv[0]);
+	g_ptr_array_add(argv, job->Argv[1]);
+
+	g_hash_table_iter_init(&iter, job->Ignored);
+	while (g_hash_table_iter_next(&iter, &path, NULL))
+		g_ptr_array_add(skipped, g_strdup(path));
+
+	if (job->SkipUnchanged && job->Changed &&
+			(job->Unchanged->len <= MAX_DELTA_FILTERS) &&
+			(g_get_monotonic_time() <= job->Deadline)) {
+		for (i = 0; i < job->Unchanged->len; i++) {
+			g_ptr_array_add(skipped, g_strconcat(
+				(char *)g_ptr_array_index(job->Unchanged, i), "/", NULL));
+		}
+	}
+	g_ptr_array_sort(skipped, skipped_path_compare);
+
+	/* Relative exclusions, the skipped folders are not even scanned */
+	if (skipped->len > 0) {
+		for (i = 0; i < skipped->len; i++) {
+			g_string_append_printf(filters, "%s-/%s", (i > 0) ? ";" : "",
+				(char *)g_ptr_array_index(skipped, i));
+		}
+		g_ptr_array_add(argv, filters->str);
+	}
+
+	for (i = 2; job->Argv[i] != NULL; i++)
+		g_ptr_array_add(argv, job->Argv[i]);
+	g_ptr_array_add(argv, NULL);
+
+	if (job->LowPriority) spawn_bc_low_priority(bcobj->Winder, (char **)argv->pdata);
+	else spawn_bc(bcobj->Winder, (char **)argv->pdata);
+
+	g_string_free(filters, TRUE);
+	g_ptr_array_unref(skipped);
+	g_ptr_array_free(argv, TRUE);
+	delta_job_free(job);
+	return G_SOURCE_REMOVE;
+}
+
+static gpointer delta_thread(gpointer data)
+{
+	DeltaJob *job = (DeltaJob *)data;
+	const char *folders[2] = { job->LeftFolder, job->RightFolder };
+	GPtrArray *unchanged, *ignored;
+	GThreadPool *pool;
+	gboolean changed;
+	guint i, side;
+
+	job->Ignored = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	for (side = 0; side < 2; side++) {
+		ignored = ignored_paths(folders[side], MAX_IGNORE_FILTERS);
+		for (i = 0; i < ignored->len; i++)
+			g_hash_table_add(job->Ignored, g_strdup(g_ptr_array_index(ignored, i)));
+		g_ptr_array_unref(ignored);
+	}
+
+	if (job->SkipUnchanged) {
+		unchanged = g_ptr_array_new();
+		pool = g_thread_pool_new(delta_worker, job, MAX_VERIFY_THREADS, FALSE, NULL);
+		changed = walk_delta(job, "", unchanged, pool);
+		g_thread_pool_free(pool, FALSE, TRUE);
+		g_ptr_array_free(unchanged, TRUE);
+
+		if (changed) job->Changed = TRUE;
+	}
+
+	g_idle_add(delta_finished, job);
+	return NULL;
+}
+
+/* See Persistent index of folders */
+static void index_refresh_async(const char *folder);
+
+/*
+ * Launches a session of both folders without their ignored paths, limited
+ * to their changed subtrees unless the user asked to see the unchanged ones
+ * too.
+ */
+static void spawn_folder_session(
+		BCompareExt *bcobj,
+		char **argv,
+		const char *left_folder,
+		const char *right_folder,
+		gboolean low_priority)
+{
+	DeltaJob *job;
+	GPtrArray *narrowed;
+	gchar *filter = NULL;
+	guint i;
+
+	/* Archives are considered folders but can not be walked */
+	if ((left_folder == NULL) || (right_folder == NULL) ||
+			!g_file_test(left_folder, G_FILE_TEST_IS_DIR) ||
+			!g_file_test(right_folder, G_FILE_TEST_IS_DIR)) {
+		if ((left_folder != NULL) && (right_folder != NULL) &&
+				g_file_test(left_folder, G_FILE_TEST_IS_REGULAR) &&
+				g_file_test(right_folder, G_FILE_TEST_IS_REGULAR))
+			filter = archive_narrowing_filter(left_folder, right_folder);
+
+		/* Only the differing entries of the archives are shown */
+		narrowed = g_ptr_array_new();
+		g_ptr_array_add(narrowed, argv[0]);
+		g_ptr_array_add(narrowed, argv[1]);
+		if (filter != NULL) g_ptr_array_add(narrowed, filter);
+		for (i = 2; argv[i] != NULL; i++)
+			g_ptr_array_add(narrowed, argv[i]);
+		g_ptr_array_add(narrowed, NULL);
+
+		if (low_priority) spawn_bc_low_priority(bcobj->Winder, (char **)narrowed->pdata);
+		else spawn_bc(bcobj->Winder, (char **)narrowed->pdata);
+
+		g_ptr_array_free(narrowed, TRUE);
+		g_free(filter);
+		return;
+	}
+
+	/* For the state shown by the next menus of these folders */
+	index_refresh_async(left_folder);
+	index_refresh_async(right_folder);
+
+	job = g_new0(DeltaJob, 1);
+	job->Ext = bcobj;
+	job->Argv = g_strdupv(argv);
+	job->LowPriority = low_priority;
+	job->LeftFolder = g_strdup(left_folder);
+	job->RightFolder = g_strdup(right_folder);
+	job->Deadline = g_get_monotonic_time() + MAX_DELTA_WALK_USEC;
+	job->SkipUnchanged =
+		!g_file_test(bcobj->ShowUnchangedStorage->str, G_FILE_TEST_EXISTS);
+	job->Unchanged = g_ptr_array_new_with_free_func(g_free);
+	g_mutex_init(&job->Lock);
+
+	g_thread_unref(g_thread_new("bcompare-delta", delta_thread, job));
+}
+
+static void show_unchanged_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	if (g_file_test(bcobj->ShowUnchangedStorage->str, G_FILE_TEST_EXISTS))
+		g_unlink(bcobj->ShowUnchangedStorage->str);
+	else
+		g_file_set_contents(bcobj->ShowUnchangedStorage->str, "", 0, NULL);
+	selection_changed(bcobj);
+}
+
+static BcMenuItem * show_unchanged_mitem(BCompareExt *bcobj)
+{
+	BcMenuItem *item;
+	gboolean show = g_file_test(bcobj->ShowUnchangedStorage->str, G_FILE_TEST_EXISTS);
+
+	item = nemo_menu_item_new("BCompareExt::show_unchanged",
+							show ? "Show Changed Only" : "Show Unchanged Too",
+							show ? "Skips the subfolders whose files did not change "
+								"when comparing or syncing folders" :
+								"Also scans the subfolders whose files did not change "
+								"when comparing or syncing folders",
+							NULL);
 	g_signal_connect(item, "activate",
-		G_CALLBACK (select_left_action), bcobj);
-	g_object_set_data(
-	(GObject*)item, "bcext::left_path", g_string_new(bcobj->RightFile->str));
-	g_object_set_data((GObject*)item, "bcext::is_dir", GBOOLEAN_TO_POINTER(IsDir));
+			G_CALLBACK(show_unchanged_action), bcobj);
+
+	return item;
+}
+
+/*************************************************************
+ *
+ * Diff reports of folders
+ *
+ *************************************************************/
+
+/* Reports written at the same time, each one may read with several threads */
+#define MAX_CONCURRENT_REPORTS 2
+
+typedef struct {
+	gchar *LeftFolder;
+	gchar *RightFolder;
+	gchar *Output;
+	gboolean Html;
+	gboolean Ok;
+	gint NbDiffs;		/* -1 when Beyond Compare wrote the report */
+	FILE *Out;
+	GPtrArray *Pairs;	/* relative paths of the files of the same size */
+	gchar *Results;		/* for each pair '=', 'c' if it differs, 'u' if unreadable */
+} ReportJob;
+
+static GThreadPool *report_pool = NULL;
+
+static void report_job_free(ReportJob *job)
+{
+	if (job->Pairs != NULL) g_ptr_array_unref(job->Pairs);
+	g_free(job->Results);
+	g_free(job->Output);
+	g_free(job->RightFolder);
+	g_free(job->LeftFolder);
+	g_free(job);
+}
+
+static void report_line(ReportJob *job, const char *kind, const char *relpath)
+{
+	gchar *escaped;
+
+	if (job->Html) {
+		escaped = g_markup_escape_text(relpath, -1);
+		fprintf(job->Out, "<tr><td>%s</td><td>%s</td></tr>\n", kind, escaped);
+		g_free(escaped);
+	}
+	else fprintf(job->Out, "%s\t%s\n", kind, relpath);
+	job->NbDiffs++;
+}
+
+/* Writes the structural differences as they are found */
+static void report_walk(ReportJob *job, const char *relpath)
+{
+	gchar *leftpath, *rightpath, *subpath;
+	GArray *left_entries, *right_entries;
+	DirEntry *left, *right, *entry;
+	guint i = 0, j = 0;
+	int cmp;
+
+	leftpath = g_build_filename(job->LeftFolder, relpath, NULL);
+	rightpath = g_build_filename(job->RightFolder, relpath, NULL);
+	left_entries = list_directory(leftpath);
+	right_entries = list_directory(rightpath);
+
+	if ((left_entries == NULL) || (right_entries == NULL)) {
+		report_line(job, "Unreadable", relpath);
+	}
+	else while ((i < left_entries->len) || (j < right_entries->len)) {
+		left = (i < left_entries->len) ? &g_array_index(left_entries, DirEntry, i) : NULL;
+		right = (j < right_entries->len) ? &g_array_index(right_entries, DirEntry, j) : NULL;
+		cmp = (left == NULL) ? 1 : ((right == NULL) ? -1 : strcmp(left->Name, right->Name));
+		entry = (cmp <= 0) ? left : right;
+		if (cmp <= 0) i++;
+		if (cmp >= 0) j++;
+
+		subpath = (relpath[0] == '\0') ? g_strdup(entry->Name) :
+			g_build_filename(relpath, entry->Name, NULL);
+
+		if (cmp < 0) {
+			report_line(job, "Left only", subpath);
+		}
+		else if (cmp > 0) {
+			report_line(job, "Right only", subpath);
+		}
+		else if ((left->St.st_mode & S_IFMT) != (right->St.st_mode & S_IFMT)) {
+			report_line(job, "Type differs", subpath);
+		}
+		else if (S_ISDIR(left->St.st_mode)) {
+			report_walk(job, subpath);
+		}
+		else if (S_ISLNK(left->St.st_mode)) {
+			g_free(leftpath);
+			g_free(rightpath);
+			leftpath = g_build_filename(job->LeftFolder, subpath, NULL);
+			rightpath = g_build_filename(job->RightFolder, subpath, NULL);
+			if (!same_link_target(leftpath, rightpath))
+				report_line(job, "Link target differs", subpath);
+		}
+		else if (left->St.st_size != right->St.st_size) {
+			report_line(job, "Size differs", subpath);
+		}
+		else if (S_ISREG(left->St.st_mode)) {
+			g_ptr_array_add(job->Pairs, subpath);
+			subpath = NULL;
+		}
+		g_free(subpath);
+	}
+
+	if (left_entries != NULL) dir_entries_free(left_entries);
+	if (right_entries != NULL) dir_entries_free(right_entries);
+	g_free(rightpath);
+	g_free(leftpath);
+}
+
+static gchar * report_file_hash(const char *folder, const char *relpath)
+{
+	gchar *filepath = g_build_filename(folder, relpath, NULL);
+	gchar *identity;
+	gchar *digest = NULL;
+	gint64 size;
+	gint cancelled = 0;
+
+	identity = file_identity(filepath, &size);
+	if (identity != NULL)
+		digest = file_content_hash(filepath, identity, &cancelled);
+
+	g_free(identity);
+	g_free(filepath);
+	return digest;
+}
+
+static void report_pair_worker(gpointer data, gpointer user_data)
+{
+	ReportJob *job = (ReportJob *)user_data;
+	guint index = GPOINTER_TO_UINT(data) - 1;
+	const char *relpath = g_ptr_array_index(job->Pairs, index);
+	gchar *left_hash = report_file_hash(job->LeftFolder, relpath);
+	gchar *right_hash = report_file_hash(job->RightFolder, relpath);
+
+	if ((left_hash == NULL) || (right_hash == NULL))
+		job->Results[index] = 'u';
+	else if (strcmp(left_hash, right_hash) != 0)
+		job->Results[index] = 'c';
+
+	g_free(right_hash);
+	g_free(left_hash);
+}
+
+static gboolean report_builtin(ReportJob *job)
+{
+	GThreadPool *pool;
+	gchar *escaped;
+	guint i;
+
+	job->Out = fopen(job->Output, "w");
+	if (job->Out == NULL) return FALSE;
+
+	if (job->Html) {
+		escaped = g_markup_printf_escaped("Differences between %s and %s",
+				job->LeftFolder, job->RightFolder);
+		fprintf(job->Out, "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\">"
+				"<title>%s</title></head><body>\n<table>\n", escaped);
+		g_free(escaped);
+	}
+	else {
+		fprintf(job->Out, "Differences between %s and %s\n\n",
+				job->LeftFolder, job->RightFolder);
+	}
+
+	job->Pairs = g_ptr_array_new_with_free_func(g_free);
+	report_walk(job, "");
+
+	/* Contents are compared in parallel, then reported in walk order */
+	job->Results = g_malloc(job->Pairs->len + 1);
+	memset(job->Results, '=', job->Pairs->len);
+	pool = g_thread_pool_new(report_pair_worker, job, MAX_VERIFY_THREADS, FALSE, NULL);
+	for (i = 0; i < job->Pairs->len; i++)
+		g_thread_pool_push(pool, GUINT_TO_POINTER(i + 1), NULL);
+	g_thread_pool_free(pool, FALSE, TRUE);
+
+	for (i = 0; i < job->Pairs->len; i++) {
+		if (job->Results[i] == 'c')
+			report_line(job, "Content differs", g_ptr_array_index(job->Pairs, i));
+		else if (job->Results[i] == 'u')
+			report_line(job, "Unreadable", g_ptr_array_index(job->Pairs, i));
+	}
+
+	if (job->Html) fprintf(job->Out, "</table>\n</body></html>\n");
+	return (fclose(job->Out) == 0);
+}
+
+/* Beyond Compare scripting, without any window */
+static gboolean report_script(ReportJob *job)
+{
+	gchar *program = g_find_program_in_path("bcompare");
+	gchar *script_path = NULL;
+	gchar *script, *arg;
+	char *argv[4];
+	gint status = -1;
+	int fd;
+
+	if (program == NULL) return FALSE;
+	g_free(program);
+
+	fd = g_file_open_tmp("bcompare-report-XXXXXX.txt", &script_path, NULL);
+	if (fd < 0) return FALSE;
+	close(fd);
+
+	script = g_strdup_printf("load \"%s\" \"%s\"\n"
+			"expand all\n"
+			"folder-report layout:summary options:display-mismatches "
+			"output-to:\"%s\"%s\n",
+			job->LeftFolder, job->RightFolder, job->Output,
+			job->Html ? " output-options:html-color" : "");
+	arg = g_strconcat("@", script_path, NULL);
+
+	g_unlink(job->Output);
+	if (g_file_set_contents(script_path, script, -1, NULL)) {
+		argv[0] = "bcompare";
+		argv[1] = "-silent";
+		argv[2] = arg;
+		argv[3] = 0;
+		g_spawn_sync(NULL, argv, NULL, G_SPAWN_SEARCH_PATH |
+				G_SPAWN_STDOUT_TO_DEV_NULL | G_SPAWN_STDERR_TO_DEV_NULL,
+				NULL, NULL, NULL, NULL, &status, NULL);
+	}
+
+	g_unlink(script_path);
+	g_free(arg);
+	g_free(script);
+	g_free(script_path);
+
+	return WIFEXITED(status) && (WEXITSTATUS(status) == 0) &&
+		g_file_test(job->Output, G_FILE_TEST_EXISTS);
+}
+
+static gboolean report_finished(gpointer data)
+{
+	ReportJob *job = (ReportJob *)data;
+	GApplication *app = g_application_get_default();
+	GNotification *notification;
+	gchar *body;
+
+	if (!job->Ok)
+		body = g_strdup_printf("The report could not be written to %s", job->Output);
+	else if (job->NbDiffs < 0)
+		body = g_strdup_printf("The report of %s and %s was written to %s",
+				job->LeftFolder, job->RightFolder, job->Output);
+	else
+		body = g_strdup_printf("%d difference(s) between %s and %s, written to %s",
+				job->NbDiffs, job->LeftFolder, job->RightFolder, job->Output);
+
+	if (app != NULL) {
+		notification = g_notification_new(job->Ok ? "Diff report ready" : "Diff report failed");
+		g_notification_set_body(notification, body);
+		g_application_send_notification(app, NULL, notification);
+		g_object_unref(notification);
+	}
+
+	g_free(body);
+	report_job_free(job);
+	return G_SOURCE_REMOVE;
+}
+
+static void report_worker(gpointer data, gpointer user_data)
+{
+	ReportJob *job = (ReportJob *)data;
+
+	job->NbDiffs = -1;
+	job->Ok = report_script(job);
+	if (!job->Ok) {
+		job->NbDiffs = 0;
+		job->Ok = report_builtin(job);
+	}
+
+	g_idle_add(report_finished, job);
+}
+
+static void report_chooser_response(GtkNativeDialog *dialog, gint response, ReportJob *job)
+{
+	GFile *file;
+	gchar *lower;
+
+	if (response == GTK_RESPONSE_ACCEPT) {
+		file = gtk_file_chooser_get_file(GTK_FILE_CHOOSER(dialog));
+		if (file != NULL) {
+			job->Output = g_file_get_path(file);
+			g_object_unref(file);
+		}
+	}
+	g_object_unref(dialog);
+
+	if (job->Output == NULL) {
+		report_job_free(job);
+		return;
+	}
+
+	lower = g_ascii_strdown(job->Output, -1);
+	job->Html = g_str_has_suffix(lower, ".html") || g_str_has_suffix(lower, ".htm");
+	g_free(lower);
+
+	/* The reports beyond the limit wait in the queue of the pool */
+	if (report_pool == NULL)
+		report_pool = g_thread_pool_new(report_worker, NULL,
+				MAX_CONCURRENT_REPORTS, FALSE, NULL);
+	g_thread_pool_push(report_pool, job, NULL);
+}
+
+static void report_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	ReportJob *job = g_new0(ReportJob, 1);
+	GtkFileChooserNative *chooser;
+
+	job->LeftFolder = g_strdup(
+		g_object_get_data((GObject *)item, "bcext::left_folder"));
+	job->RightFolder = g_strdup(
+		g_object_get_data((GObject *)item, "bcext::right_folder"));
+
+	chooser = gtk_file_chooser_native_new("Save Diff Report", NULL,
+			GTK_FILE_CHOOSER_ACTION_SAVE, "_Save", "_Cancel");
+	gtk_file_chooser_set_current_name(GTK_FILE_CHOOSER(chooser), "bcompare-report.html");
+	gtk_file_chooser_set_do_overwrite_confirmation(GTK_FILE_CHOOSER(chooser), TRUE);
+	g_signal_connect(chooser, "response",
+			G_CALLBACK(report_chooser_response), job);
+	gtk_native_dialog_show(GTK_NATIVE_DIALOG(chooser));
+
+	clear_selections(bcobj);
+}
+
+static BcMenuItem * report_mitem(BCompareExt *bcobj)
+{
+	BcMenuItem *item;
+
+	/* Archives are considered folders but can not be walked */
+	if (!g_file_test(bcobj->LeftFile->str, G_FILE_TEST_IS_DIR) ||
+			!g_file_test(bcobj->RightFile->str, G_FILE_TEST_IS_DIR))
+		return NULL;
+
+	item = nemo_menu_item_new("BCompareExt::report",
+							"Generate Diff Report...",
+							"Writes the list of differing files to a report in the "
+							"background, without opening Beyond Compare",
+							NULL);
+	g_signal_connect(item, "activate",
+			G_CALLBACK(report_action), bcobj);
+	g_object_set_data_full((GObject *)item, "bcext::left_folder",
+			g_strdup(bcobj->LeftFile->str), g_free);
+	g_object_set_data_full((GObject *)item, "bcext::right_folder",
+			g_strdup(bcobj->RightFile->str), g_free);
+
+	return item;
+}
+
+/*************************************************************
+ *
+ * Persistent index of folders
+ *
+ *************************************************************/
+
+/*
+ * Merkle index of a folder, under $XDG_CACHE_HOME/bcompare-ext: a header, the
+ * records in breadth first order so that the entries of a folder are
+ * contiguous, then their names. Each folder hash is built from the names,
+ * types and hashes of its entries.
+ */
+#define INDEX_MAGIC "BCMRKL01"
+#define INDEX_HASH_SIZE 16
+#define MAX_INDEX_RECORDS 1000000
+#define INDEX_REFRESH_INTERVAL (60 * G_USEC_PER_SEC)
+
+typedef struct {
+	char Magic[8];
+	guint32 NbRecords;
+	guint32 NamesSize;
+} IndexHeader;
+
+typedef enum {
+	INDEX_FILE = 'f',
+	INDEX_FOLDER = 'd',
+	INDEX_LINK = 'l'
+} IndexKinds;
+
+typedef struct {
+	guint64 Ino;
+	gint64 Size;
+	gint64 MtimeNs;
+	guint8 Hash[INDEX_HASH_SIZE];
+	guint32 NameOffset;
+	guint32 NameLength;
+	guint32 FirstChild;
+	guint32 NbChildren;
+	guint32 Kind;
+	guint32 Reserved;
+} IndexRecord;
+
+typedef struct {
+	GMappedFile *Mapped;
+	const IndexRecord *Records;
+	const char *Names;
+	guint32 NbRecords;
+	guint32 NamesSize;
+} IndexView;
+
+/* Folders being indexed */
+G_LOCK_DEFINE_STATIC(index_refresh);
+static GHashTable *index_refreshes = NULL;
+
+static gchar * index_path(const char *folder)
+{
+	char *canonical = realpath(folder, NULL);
+	gchar *key, *name, *path;
+
+	if (canonical == NULL) return NULL;
+
+	key = g_compute_checksum_for_string(G_CHECKSUM_SHA1, canonical, -1);
+	name = g_strconcat(key, ".idx", NULL);
+	path = g_build_filename(g_get_user_cache_dir(), "bcompare-ext", name, NULL);
+
+	g_free(name);
+	g_free(key);
+	free(canonical);
+	return path;
+}
+
+/* Maps the index of folder, FALSE if it was never built */
+static gboolean index_open(const char *folder, IndexView *view)
+{
+	gchar *path = index_path(folder);
+	const IndexHeader *header;
+	const char *contents;
+	gsize len;
+
+	view->Mapped = (path != NULL) ? g_mapped_file_new(path, FALSE, NULL) : NULL;
+	g_free(path);
+	if (view->Mapped == NULL) return FALSE;
+
+	contents = g_mapped_file_get_contents(view->Mapped);
+	len = g_mapped_file_get_length(view->Mapped);
+	header = (const IndexHeader *)contents;
+
+	if ((len < sizeof(IndexHeader)) ||
+			(memcmp(header->Magic, INDEX_MAGIC, sizeof(header->Magic)) != 0) ||
+			(header->NbRecords == 0) ||
+			(len != sizeof(IndexHeader) +
+				(gsize)header->NbRecords * sizeof(IndexRecord) + header->NamesSize)) {
+		g_mapped_file_unref(view->Mapped);
+		view->Mapped = NULL;
+		return FALSE;
+	}
+
+	view->Records = (const IndexRecord *)(contents + sizeof(IndexHeader));
+	view->Names = (const char *)(view->Records + header->NbRecords);
+	view->NbRecords = header->NbRecords;
+	view->NamesSize = header->NamesSize;
+	return TRUE;
+}
+
+static void index_close(IndexView *view)
+{
+	if (view->Mapped != NULL) g_mapped_file_unref(view->Mapped);
+	view->Mapped = NULL;
+}
+
+static gboolean index_valid_children(IndexView *view, const IndexRecord *rec)
+{
+	return (guint64)rec->FirstChild + rec->NbChildren <= view->NbRecords;
+}
+
+static int index_name_compare(
+		IndexView *left,
+		const IndexRecord *left_rec,
+		IndexView *right,
+		const IndexRecord *right_rec)
+{
+	int order = memcmp(left->Names + left_rec->NameOffset,
+			right->Names + right_rec->NameOffset,
+			MIN(left_rec->NameLength, right_rec->NameLength));
+
+	if (order != 0) return order;
+	return (int)left_rec->NameLength - (int)right_rec->NameLength;
+}
+
+static gboolean index_names_valid(IndexView *view, const IndexRecord *rec)
+{
+	guint32 c;
+
+	for (c = rec->FirstChild; c < rec->FirstChild + rec->NbChildren; c++) {
+		if ((guint64)view->Records[c].NameOffset +
+				view->Records[c].NameLength > view->NamesSize)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+/*
+ * Compares the indexes last built for both folders, without reading them.
+ * Returns FALSE if one of them was never indexed, otherwise differing is the
+ * number of top level entries which differ, 0 if the folders are identical.
+ */
+static gboolean index_compare(const char *left, const char *right, int *differing)
+{
+	IndexView left_view, right_view;
+	const IndexRecord *left_root, *right_root, *left_rec, *right_rec;
+	gboolean valid = FALSE;
+	guint32 l = 0, r = 0;
+	int order;
+
+	if (!index_open(left, &left_view)) return FALSE;
+	if (!index_open(right, &right_view)) {
+		index_close(&left_view);
+		return FALSE;
+	}
+
+	left_root = &left_view.Records[0];
+	right_root = &right_view.Records[0];
+	*differing = 0;
+
+	if (memcmp(left_root->Hash, right_root->Hash, INDEX_HASH_SIZE) == 0) {
+		valid = TRUE;
+	} else if (index_valid_children(&left_view, left_root) &&
+			index_valid_children(&right_view, right_root) &&
+			index_names_valid(&left_view, left_root) &&
+			index_names_valid(&right_view, right_root)) {
+		/* The entries of a folder are sorted by name */
+		while ((l < left_root->NbChildren) || (r < right_root->NbChildren)) {
+			left_rec = (l < left_root->NbChildren) ?
+				&left_view.Records[left_root->FirstChild + l] : NULL;
+			right_rec = (r < right_root->NbChildren) ?
+				&right_view.Records[right_root->FirstChild + r] : NULL;
+			order = (left_rec == NULL) ? 1 : ((right_rec == NULL) ? -1 :
+				index_name_compare(&left_view, left_rec, &right_view, right_rec));
+
+			if (order < 0) {
+				l++;
+				(*differing)++;
+			} else if (order > 0) {
+				r++;
+				(*differing)++;
+			} else {
+				if ((left_rec->Kind != right_rec->Kind) ||
+						(memcmp(left_rec->Hash, right_rec->Hash, INDEX_HASH_SIZE) != 0))
+					(*differing)++;
+				l++;
+				r++;
+			}
+		}
+		valid = TRUE;
+	}
+
+	index_close(&right_view);
+	index_close(&left_view);
+	return valid;
+}
+
+static void index_hash_data(const guint8 *data, gsize len, guint8 *hash)
+{
+#ifdef USE_XXHASH
+	XXH128_canonical_t canonical;
+
+	XXH128_canonicalFromHash(&canonical, XXH3_128bits(data, len));
+	memcpy(hash, canonical.digest, INDEX_HASH_SIZE);
+#else
+	GChecksum *checksum = g_checksum_new(G_CHECKSUM_SHA1);
+	guint8 digest[20];
+	gsize digest_len = sizeof(digest);
+
+	g_checksum_update(checksum, data, len);
+	g_checksum_get_digest(checksum, digest, &digest_len);
+	g_checksum_free(checksum);
+	memcpy(hash, digest, INDEX_HASH_SIZE);
+#endif
+}
+
+static void index_hash_file(const char *filepath, guint8 *hash)
+{
+	gint64 size;
+	gint cancelled = 0;
+	gchar *identity = file_identity(filepath, &size);
+	gchar *digest = NULL;
+	int i;
+
+	if (identity != NULL)
+		digest = file_content_hash(filepath, identity, &cancelled);
+
+	/* Raw bytes of the beginning of the hexadecimal digest */
+	for (i = 0; (digest != NULL) && (i < INDEX_HASH_SIZE) && (digest[2 * i] != '\0'); i++)
+		hash[i] = (g_ascii_xdigit_value(digest[2 * i]) << 4) |
+			g_ascii_xdigit_value(digest[2 * i + 1]);
+
+	g_free(digest);
+	g_free(identity);
+}
+
+static gint index_entry_compare(gconstpointer a, gconstpointer b)
+{
+	return strcmp(*(const gchar **)a, *(const gchar **)b);
+}
+
+/* Rebuilds the index of folder, hashing only the files which changed */
+static gboolean index_refresh(const char *folder)
+{
+	gchar *path = index_path(folder);
+	GHashTable *previous_files;
+	GPtrArray *previous_paths, *paths;
+	GArray *records;
+	GByteArray *names, *data, *contents;
+	IndexView previous;
+	IndexRecord rec, *cur, *child;
+	const IndexRecord *old;
+	IndexHeader header;
+	DIR *dir;
+	struct dirent *ent;
+	struct stat st;
+	GPtrArray *entries;
+	gchar *fullpath, target[PATH_MAX];
+	ssize_t target_len;
+	gboolean saved = FALSE;
+	guint i, c;
+
+	if (path == NULL) return FALSE;
+
+	/* Hashes of the previous index, still valid for the files which did not change */
+	previous_files = g_hash_table_new(g_str_hash, g_str_equal);
+	previous_paths = g_ptr_array_new_with_free_func(g_free);
+	if (index_open(folder, &previous)) {
+		g_ptr_array_add(previous_paths, g_strdup(""));
+		for (i = 1; i < previous.NbRecords; i++)
+			g_ptr_array_add(previous_paths, NULL);
+
+		for (i = 0; i < previous.NbRecords; i++) {
+			old = &previous.Records[i];
+			if (g_ptr_array_index(previous_paths, i) == NULL) continue;
+
+			if (old->Kind == INDEX_FILE) {
+				g_hash_table_insert(previous_files,
+					g_ptr_array_index(previous_paths, i), (gpointer)old);
+			} else if ((old->Kind == INDEX_FOLDER) &&
+					index_valid_children(&previous, old) &&
+					index_names_valid(&previous, old)) {
+				for (c = old->FirstChild; c < old->FirstChild + old->NbChildren; c++) {
+					if ((c <= i) || (g_ptr_array_index(previous_paths, c) != NULL))
+						continue;
+					g_ptr_array_index(previous_paths, c) = g_strdup_printf("%s/%.*s",
+						(gchar *)g_ptr_array_index(previous_paths, i),
+						(int)previous.Records[c].NameLength,
+						previous.Names + previous.Records[c].NameOffset);
+				}
+			}
+		}
+	}
+
+	records = g_array_new(FALSE, TRUE, sizeof(IndexRecord));
+	paths = g_ptr_array_new_with_free_func(g_free);
+	names = g_byte_array_new();
+
+	memset(&rec, 0, sizeof(rec));
+	rec.Kind = INDEX_FOLDER;
+	g_array_append_val(records, rec);
+	g_ptr_array_add(paths, g_strdup(""));
+
+	/* The records themselves are the queue of the breadth first walk */
+	for (i = 0; (i < records->len) && (records->len <= MAX_INDEX_RECORDS); i++) {
+		if (g_array_index(records, IndexRecord, i).Kind != INDEX_FOLDER) continue;
+
+		fullpath = g_strconcat(folder, g_ptr_array_index(paths, i), NULL);
+		dir = opendir(fullpath);
+		g_free(fullpath);
+		if (dir == NULL) continue;
+
+		entries = g_ptr_array_new_with_free_func(g_free);
+		while ((ent = readdir(dir)) != NULL) {
+			if ((strcmp(ent->d_name, ".") != 0) && (strcmp(ent->d_name, "..") != 0))
+				g_ptr_array_add(entries, g_strdup(ent->d_name));
+		}
+		g_ptr_array_sort(entries, index_entry_compare);
+
+		g_array_index(records, IndexRecord, i).FirstChild = records->len;
+		for (c = 0; c < entries->len; c++) {
+			if (fstatat(dirfd(dir), g_ptr_array_index(entries, c),
+					&st, AT_SYMLINK_NOFOLLOW) != 0)
+				continue;
+
+			memset(&rec, 0, sizeof(rec));
+			if (S_ISDIR(st.st_mode)) rec.Kind = INDEX_FOLDER;
+			else if (S_ISREG(st.st_mode)) rec.Kind = INDEX_FILE;
+			else if (S_ISLNK(st.st_mode)) rec.Kind = INDEX_LINK;
+			else continue;
+
+			rec.Ino = st.st_ino;
+			rec.Size = st.st_size;
+			rec.MtimeNs = (gint64)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+			rec.NameOffset = names->len;
+			rec.NameLength = strlen(g_ptr_array_index(entries, c));
+			g_byte_array_append(names,
+				g_ptr_array_index(entries, c), rec.NameLength);
+
+			g_array_append_val(records, rec);
+			g_ptr_array_add(paths, g_strconcat(g_ptr_array_index(paths, i),
+				"/", g_ptr_array_index(entries, c), NULL));
+			g_array_index(records, IndexRecord, i).NbChildren++;
+		}
+
+		closedir(dir);
+		g_ptr_array_unref(entries);
+	}
+
+	/* Children come after their folder, so hashing backwards sees them first */
+	for (i = records->len; (records->len <= MAX_INDEX_RECORDS) && (i-- > 0); ) {
+		cur = &g_array_index(records, IndexRecord, i);
+		fullpath = g_strconcat(folder, g_ptr_array_index(paths, i), NULL);
+
+		if (cur->Kind == INDEX_FILE) {
+			old = g_hash_table_lookup(previous_files, g_ptr_array_index(paths, i));
+			if ((old != NULL) && (old->Ino == cur->Ino) &&
+					(old->Size == cur->Size) && (old->MtimeNs == cur->MtimeNs))
+				memcpy(cur->Hash, old->Hash, INDEX_HASH_SIZE);
+			else
+				index_hash_file(fullpath, cur->Hash);
+		} else if (cur->Kind == INDEX_LINK) {
+			target_len = readlink(fullpath, target, sizeof(target));
+			index_hash_data((guint8 *)target, MAX(target_len, 0), cur->Hash);
+		} else {
+			data = g_byte_array_new();
+			for (c = cur->FirstChild; c < cur->FirstChild + cur->NbChildren; c++) {
+				child = &g_array_index(records, IndexRecord, c);
+				g_byte_array_append(data,
+					names->data + child->NameOffset, child->NameLength);
+				g_byte_array_append(data, (const guint8 *)"", 1);
+				g_byte_array_append(data, (const guint8 *)&child->Kind, 1);
+				g_byte_array_append(data, child->Hash, INDEX_HASH_SIZE);
+			}
+			index_hash_data(data->data, data->len, cur->Hash);
+			g_byte_array_unref(data);
+		}
+
+		g_free(fullpath);
+	}
+
+	if (records->len <= MAX_INDEX_RECORDS) {
+		memcpy(header.Magic, INDEX_MAGIC, sizeof(header.Magic));
+		header.NbRecords = records->len;
+		header.NamesSize = names->len;
+
+		contents = g_byte_array_sized_new(sizeof(header) +
+			records->len * sizeof(IndexRecord) + names->len);
+		g_byte_array_append(contents, (const guint8 *)&header, sizeof(header));
+		g_byte_array_append(contents, (const guint8 *)records->data,
+			records->len * sizeof(IndexRecord));
+		g_byte_array_append(contents, names->data, names->len);
+
+		/* Readers map the index, it is replaced atomically */
+		fullpath = g_path_get_dirname(path);
+		g_mkdir_with_parents(fullpath, DIR_PERM);
+		g_free(fullpath);
+		saved = g_file_set_contents(path,
+			(const gchar *)contents->data, contents->len, NULL);
+		g_byte_array_unref(contents);
+	}
+
+	g_byte_array_unref(names);
+	g_ptr_array_unref(paths);
+	g_array_free(records, TRUE);
+	index_close(&previous);
+	g_hash_table_destroy(previous_files);
+	g_ptr_array_unref(previous_paths);
+	g_free(path);
+
+	return saved;
+}
+
+/*
+ * An index written after the last change of the folder entries is kept for
+ * a minute, in case files changed deeper in the tree
+ */
+static gboolean index_fresh(const char *folder)
+{
+	gchar *path = index_path(folder);
+	gint64 indexed = (path != NULL) ? file_mtime_ns(path) : -1;
+
+	g_free(path);
+	return (indexed > file_mtime_ns(folder)) &&
+		(g_get_real_time() - indexed / 1000 < INDEX_REFRESH_INTERVAL);
+}
+
+static gpointer index_refresh_thread(gpointer data)
+{
+	gchar *folder = (gchar *)data;
+
+	if (!index_fresh(folder)) index_refresh(folder);
+
+	G_LOCK(index_refresh);
+	g_hash_table_remove(index_refreshes, folder);
+	G_UNLOCK(index_refresh);
+
+	g_free(folder);
+	return NULL;
+}
+
+/* Refreshes the index of folder in the background, unless it is fresh */
+static void index_refresh_async(const char *folder)
+{
+	gboolean start;
+
+	G_LOCK(index_refresh);
+	if (index_refreshes == NULL)
+		index_refreshes = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+	start = !g_hash_table_contains(index_refreshes, folder);
+	if (start) g_hash_table_add(index_refreshes, g_strdup(folder));
+	G_UNLOCK(index_refresh);
+
+	if (start)
+		g_thread_unref(g_thread_new("bcompare-index", index_refresh_thread,
+			g_strdup(folder)));
+}
+
+/*
+ * Adds the state of the folders known from their last index to the label,
+ * the indexes are refreshed when a session of the folders is launched.
+ */
+static void index_state_mitem(BCompareExt *bcobj, BcMenuItem *item)
+{
+	gchar *label, *state;
+	int differing;
+
+	/* Archives are considered folders, their listings are compared instead */
+	if (g_file_test(bcobj->LeftFile->str, G_FILE_TEST_IS_REGULAR) &&
+			g_file_test(bcobj->RightFile->str, G_FILE_TEST_IS_REGULAR)) {
+		archive_state_mitem(bcobj, item);
+		return;
+	}
+
+	if (index_compare(bcobj->LeftFile->str, bcobj->RightFile->str, &differing)) {
+		g_object_get(item, "label", &label, NULL);
+		if (differing == 0)
+			state = g_strdup_printf("%s (identical)", label);
+		else
+			state = g_strdup_printf((differing == 1) ?
+				"%s (%d subtree differs)" : "%s (%d subtrees differ)",
+				label, differing);
+		g_object_set(item, "label", state, NULL);
+		g_free(state);
+		g_free(label);
+	}
+}
+
+/*************************************************************
+ *
+ * Whitespace equivalence of files
+ *
+ *************************************************************/
+
+/* The check runs in the background, it gives up past these bounds */
+#define MAX_EQUIV_FILE_SIZE (256 * 1024 * 1024)
+#define MAX_EQUIV_CHECK_USEC (G_USEC_PER_SEC / 10)
+
+/* Bytes compared between two looks at the clock */
+#define EQUIV_SPAN_SIZE (1024 * 1024)
+
+/* Size of the blocks given to memcmp() while skipping identical bytes */
+#define EQUIV_STRIDE 64
+
+/* Files holding a NUL byte in their beginning are not text */
+#define EQUIV_SNIFF_SIZE (64 * 1024)
+
+typedef enum {
+	EQUIV_UNKNOWN = 0,
+	EQUIV_DIFFERENT,
+	EQUIV_SAME_BYTES,
+	EQUIV_SAME_TEXT
+} Equivalence;
+
+typedef enum {
+	SEP_NONE = 0,
+	SEP_SPACE,
+	SEP_EOL
+} Separator;
+
+typedef struct {
+	const char *P;
+	const char *End;
+	const char *Text;	/* first byte at or after P which is not whitespace */
+} TextCursor;
+
+#define IS_BLANK(c) (((c) == ' ') || ((c) == '\t'))
+#define IS_SPACE(c) (IS_BLANK(c) || ((c) == '\r') || ((c) == '\n'))
+
+/* Length of the identical beginning of a and b */
+static gsize common_prefix(const char *a, const char *b, gsize len)
+{
+	gsize n = 0;
+
+	/* memcmp() is vectorized by the C library, this is the hot loop */
+	while ((n + EQUIV_STRIDE <= len) && (memcmp(a + n, b + n, EQUIV_STRIDE) == 0))
+		n += EQUIV_STRIDE;
+	while ((n < len) && (a[n] == b[n]))
+		n++;
+	return n;
+}
+
+/* TRUE if only whitespace and line ends are left, each byte is looked at once */
+static gboolean at_blank_tail(TextCursor *c)
+{
+	if ((c->Text == NULL) || (c->Text < c->P)) {
+		c->Text = c->P;
+		while ((c->Text < c->End) && IS_SPACE(*c->Text))
+			c->Text++;
+	}
+	return (c->Text == c->End);
+}
+
+/* Consumes a run of blanks and the line end following it */
+static Separator skip_separator(TextCursor *c)
+{
+	const char *start = c->P;
+
+	while ((c->P < c->End) && IS_BLANK(*c->P))
+		c->P++;
+
+	if ((c->P < c->End) && ((*c->P == '\r') || (*c->P == '\n'))) {
+		if ((*c->P == '\r') && (c->P + 1 < c->End) && (c->P[1] == '\n'))
+			c->P++;
+		c->P++;
+		return SEP_EOL;
+	}
+
+	return (c->P != start) ? SEP_SPACE : SEP_NONE;
+}
+
+/*
+ * Compares two buffers ignoring CR/LF differences, trailing whitespace, the
+ * length and kind of whitespace runs, and blank lines at the end. Nothing is
+ * copied: identical spans are skipped and only the differences are looked at.
+ */
+static Equivalence compare_text(const char *left, gsize left_size,
+		const char *right, gsize right_size, gint64 deadline)
+{
+	TextCursor l = { left, left + left_size, NULL };
+	TextCursor r = { right, right + right_size, NULL };
+	gboolean same_bytes = TRUE;
+	gsize run = 0;		/* bytes skipped since the last separator */
+	gsize avail, span, n;
+	Separator sep_left, sep_right;
+
+	for (;;) {
+		if (g_get_monotonic_time() > deadline) return EQUIV_UNKNOWN;
+
+		avail = MIN(l.End - l.P, r.End - r.P);
+		span = MIN(avail, EQUIV_SPAN_SIZE);
+		n = common_prefix(l.P, r.P, span);
+		l.P += n;
+		r.P += n;
+		run += n;
+		if ((n == span) && (span < avail)) continue;
+
+		if ((l.P == l.End) && (r.P == r.End))
+			return same_bytes ? EQUIV_SAME_BYTES : EQUIV_SAME_TEXT;
+		same_bytes = FALSE;
+
+		/* The whitespace run holding the difference starts the same way on both sides */
+		while ((run > 0) && IS_BLANK(l.P[-1])) {
+			l.P--;
+			r.P--;
+			run--;
+		}
+
+		if (at_blank_tail(&l) && at_blank_tail(&r)) return EQUIV_SAME_TEXT;
+
+		sep_left = skip_separator(&l);
+		sep_right = skip_separator(&r);
+		if ((sep_left != sep_right) || (sep_left == SEP_NONE)) return EQUIV_DIFFERENT;
+		run = 0;
+	}
+}
+
+static Equivalence file_equivalence(const char *left_path, const char *right_path)
+{
+	GMappedFile *left_map = NULL, *right_map = NULL;
+	const char *left, *right;
+	gsize left_size, right_size;
+	Equivalence equivalence = EQUIV_UNKNOWN;
+	struct stat left_st, right_st;
+
+	if ((stat(left_path, &left_st) != 0) || (stat(right_path, &right_st) != 0) ||
+			!S_ISREG(left_st.st_mode) || !S_ISREG(right_st.st_mode) ||
+			(left_st.st_size > MAX_EQUIV_FILE_SIZE) ||
+			(right_st.st_size > MAX_EQUIV_FILE_SIZE))
+		return EQUIV_UNKNOWN;
+
+	/* Both files are mapped, nothing is copied or normalized in memory */
+	left_map = g_mapped_file_new(left_path, FALSE, NULL);
+	right_map = g_mapped_file_new(right_path, FALSE, NULL);
+
+	if ((left_map != NULL) && (right_map != NULL)) {
+		left = g_mapped_file_get_contents(left_map);
+		right = g_mapped_file_get_contents(right_map);
+		left_size = g_mapped_file_get_length(left_map);
+		right_size = g_mapped_file_get_length(right_map);
+		if (left == NULL) left = "";
+		if (right == NULL) right = "";
+
+		equivalence = compare_text(left, left_size, right, right_size,
+				g_get_monotonic_time() + MAX_EQUIV_CHECK_USEC);
+
+		if ((equivalence == EQUIV_SAME_TEXT) &&
+				((memchr(left, '\0', MIN(left_size, EQUIV_SNIFF_SIZE)) != NULL) ||
+				 (memchr(right, '\0', MIN(right_size, EQUIV_SNIFF_SIZE)) != NULL)))
+			equivalence = EQUIV_DIFFERENT;
+	}
+
+	if (left_map != NULL) g_mapped_file_unref(left_map);
+	if (right_map != NULL) g_mapped_file_unref(right_map);
+	return equivalence;
+}
+
+/*************************************************************
+ *
+ * Line changes of files
+ *
+ *************************************************************/
+
+/* Bounds of the work done in the background */
+#define MAX_DIFFSTAT_FILE_SIZE (4 * 1024 * 1024)
+#define MAX_DIFFSTAT_LINES 50000
+#define MAX_DIFFSTAT_EDITS 2000
+#define MAX_DIFFSTAT_USEC (G_USEC_PER_SEC / 10)
+
+typedef struct {
+	const char *Data;
+	gsize Len;
+	guint64 Hash;
+} TextLine;
+
+static guint64 line_hash(const char *data, gsize len)
+{
+#ifdef USE_XXHASH
+	return XXH3_64bits(data, len);
+#else
+	guint64 h = 14695981039346656037ULL;	/* FNV-1a */
+	gsize i;
+
+	for (i = 0; i < len; i++)
+		h = (h ^ (guchar)data[i]) * 1099511628211ULL;
+	return h;
+#endif
+}
+
+static gboolean same_line(const TextLine *a, const TextLine *b)
+{
+	return (a->Hash == b->Hash) && (a->Len == b->Len) &&
+		(memcmp(a->Data, b->Data, a->Len) == 0);
+}
+
+/* Splits data in lines, returns NULL if there are too many of them */
+static GArray * split_lines(const char *data, gsize size)
+{
+	GArray *lines = g_array_new(FALSE, FALSE, sizeof(TextLine));
+	const char *p = data, *end = data + size, *eol;
+	TextLine line;
+
+	while (p < end) {
+		if (lines->len >= MAX_DIFFSTAT_LINES) {
+			g_array_free(lines, TRUE);
+			return NULL;
+		}
+
+		/* memchr() is vectorized by the C library */
+		eol = memchr(p, '\n', end - p);
+		line.Data = p;
+		line.Len = ((eol != NULL) ? eol : end) - p;
+		line.Hash = line_hash(p, line.Len);
+		g_array_append_val(lines, line);
+		p += line.Len + 1;
+	}
+	return lines;
+}
+
+/*
+ * Length of the shortest edit script between a and b with Myers' O(ND)
+ * algorithm, only the furthest reaching paths are kept.
+ * Returns -1 if it is longer than MAX_DIFFSTAT_EDITS or if the time is up.
+ */
+static int edit_distance(const TextLine *a, int n, const TextLine *b, int m,
+		gint64 deadline)
+{
+	const int offset = MAX_DIFFSTAT_EDITS + 1;
+	int *v = g_new0(int, 2 * MAX_DIFFSTAT_EDITS + 3);
+	int d, k, x, y, result = -1;
+
+	for (d = 0; (d <= MAX_DIFFSTAT_EDITS) && (result < 0); d++) {
+		if (g_get_monotonic_time() > deadline) break;
+
+		for (k = -d; k <= d; k += 2) {
+			x = ((k == -d) || ((k != d) && (v[offset + k - 1] < v[offset + k + 1]))) ?
+				v[offset + k + 1] : v[offset + k - 1] + 1;
+			y = x - k;
+
+			while ((x < n) && (y < m) && same_line(&a[x], &b[y])) {
+				x++;
+				y++;
+			}
+
+			v[offset + k] = x;
+			if ((x >= n) && (y >= m)) {
+				result = d;
+				break;
+			}
+		}
+	}
+
+	g_free(v);
+	return result;
+}
+
+static gboolean count_lines(const char *left, gsize left_size,
+		const char *right, gsize right_size, int *added, int *removed)
+{
+	gint64 deadline = g_get_monotonic_time() + MAX_DIFFSTAT_USEC;
+	GArray *left_lines = split_lines(left, left_size);
+	GArray *right_lines = split_lines(right, right_size);
+	TextLine *a, *b;
+	int n, m, first = 0, d = -1;
+
+	if ((left_lines != NULL) && (right_lines != NULL)) {
+		a = (TextLine *)left_lines->data;
+		b = (TextLine *)right_lines->data;
+		n = left_lines->len;
+		m = right_lines->len;
+
+		/* The common beginning and end are not part of the search */
+		while ((first < n) && (first < m) && same_line(&a[first], &b[first]))
+			first++;
+		while ((n > first) && (m > first) && same_line(&a[n - 1], &b[m - 1])) {
+			n--;
+			m--;
+		}
+
+		d = edit_distance(a + first, n - first, b + first, m - first, deadline);
+
+		/* Every edit adds or removes one line, and they account for the length change */
+		if (d >= 0) {
+			*added = (d + (m - n)) / 2;
+			*removed = (d - (m - n)) / 2;
+		}
+	}
+
+	if (left_lines != NULL) g_array_free(left_lines, TRUE);
+	if (right_lines != NULL) g_array_free(right_lines, TRUE);
+	return (d >= 0);
+}
+
+/* Counts the lines added and removed between two small text files */
+static gboolean diff_stat(const char *left_path, const char *right_path,
+		int *added, int *removed)
+{
+	GMappedFile *left_map = NULL, *right_map = NULL;
+	const char *left, *right;
+	gsize left_size, right_size;
+	struct stat left_st, right_st;
+	gboolean ok = FALSE;
+
+	if ((stat(left_path, &left_st) != 0) || (stat(right_path, &right_st) != 0) ||
+			!S_ISREG(left_st.st_mode) || !S_ISREG(right_st.st_mode) ||
+			(left_st.st_size > MAX_DIFFSTAT_FILE_SIZE) ||
+			(right_st.st_size > MAX_DIFFSTAT_FILE_SIZE))
+		return FALSE;
+
+	left_map = g_mapped_file_new(left_path, FALSE, NULL);
+	right_map = g_mapped_file_new(right_path, FALSE, NULL);
+	if ((left_map == NULL) || (right_map == NULL)) goto done;
+
+	left = g_mapped_file_get_contents(left_map);
+	right = g_mapped_file_get_contents(right_map);
+	left_size = g_mapped_file_get_length(left_map);
+	right_size = g_mapped_file_get_length(right_map);
+	if (left == NULL) left = "";
+	if (right == NULL) right = "";
+
+	if ((memchr(left, '\0', MIN(left_size, EQUIV_SNIFF_SIZE)) != NULL) ||
+			(memchr(right, '\0', MIN(right_size, EQUIV_SNIFF_SIZE)) != NULL))
+		goto done;
+
+	ok = count_lines(left, left_size, right, right_size, added, removed);
+
+done:
+	if (left_map != NULL) g_mapped_file_unref(left_map);
+	if (right_map != NULL) g_mapped_file_unref(right_map);
+	return ok;
+}
+
+/*************************************************************
+ *
+ * Background checks of pairs of files
+ *
+ *************************************************************/
+
+/* Bound of the cache, it is simply emptied when reached */
+#define MAX_CACHED_EQUIVS 1000
+
+typedef struct {
+	Equivalence Equivalence;
+	gboolean HasStat;	/* lines counted for different files */
+	int Added;
+	int Removed;
+} EquivState;
+
+typedef struct {
+	BCompareExt *Ext;
+	gchar *LeftFile;
+	gchar *RightFile;
+	gchar *Key;
+} EquivJob;
+
+G_LOCK_DEFINE_STATIC(equiv_states);
+static GHashTable *equiv_states = NULL;		/* pair of identities -> EquivState */
+static GHashTable *equiv_pending = NULL;	/* pairs of identities being checked */
+
+static void equiv_job_free(EquivJob *job)
+{
+	g_free(job->Key);
+	g_free(job->RightFile);
+	g_free(job->LeftFile);
+	g_free(job);
+}
+
+static gboolean equiv_job_finished(gpointer data)
+{
+	EquivJob *job = (EquivJob *)data;
+
+	G_LOCK(equiv_states);
+	g_hash_table_remove(equiv_pending, job->Key);
+	G_UNLOCK(equiv_states);
+
+	/* The menus are built again, with the result in the cache */
+	alert_updated(job->Ext);
+	equiv_job_free(job);
+	return G_SOURCE_REMOVE;
+}
+
+static gpointer equiv_thread(gpointer data)
+{
+	EquivJob *job = (EquivJob *)data;
+	EquivState *state = g_new0(EquivState, 1);
+
+	state->Equivalence = file_equivalence(job->LeftFile, job->RightFile);
+	if (state->Equivalence == EQUIV_DIFFERENT)
+		state->HasStat = diff_stat(job->LeftFile, job->RightFile,
+				&state->Added, &state->Removed);
+
+	G_LOCK(equiv_states);
+	if (g_hash_table_size(equiv_states) >= MAX_CACHED_EQUIVS)
+		g_hash_table_remove_all(equiv_states);
+	g_hash_table_replace(equiv_states, g_strdup(job->Key), state);
+	G_UNLOCK(equiv_states);
+
+	g_idle_add(equiv_job_finished, job);
+	return NULL;
+}
+
+/*
+ * Tells in the label when the files only differ by whitespace or line
+ * endings, or how many lines changed, so that the user knows whether
+ * starting Beyond Compare is worth it. The result is cached for the
+ * identities of the files, it is computed in the background and the menus
+ * are built again when it is known.
+ */
+static void equiv_state_mitem(BCompareExt *bcobj, BcMenuItem *item)
+{
+	EquivState *known, found = { EQUIV_UNKNOWN, FALSE, 0, 0 };
+	EquivJob *job = NULL;
+	gchar *left_id, *right_id, *key, *label, *state = NULL;
+	gint64 size;
+
+	left_id = file_identity(bcobj->LeftFile->str, &size);
+	right_id = file_identity(bcobj->RightFile->str, &size);
+	if ((left_id == NULL) || (right_id == NULL)) {
+		g_free(left_id);
+		g_free(right_id);
+		return;
+	}
+	key = g_strconcat(left_id, "|", right_id, NULL);
+	g_free(right_id);
+	g_free(left_id);
+
+	G_LOCK(equiv_states);
+	if (equiv_states == NULL) {
+		equiv_states = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+		equiv_pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	}
+
+	known = g_hash_table_lookup(equiv_states, key);
+	if (known != NULL) {
+		found = *known;
+	}
+	else if (!g_hash_table_contains(equiv_pending, key)) {
+		g_hash_table_add(equiv_pending, g_strdup(key));
+		job = g_new0(EquivJob, 1);
+		job->Ext = bcobj;
+		job->LeftFile = g_strdup(bcobj->LeftFile->str);
+		job->RightFile = g_strdup(bcobj->RightFile->str);
+		job->Key = key;
+		key = NULL;
+	}
+	G_UNLOCK(equiv_states);
+
+	if (job != NULL)
+		g_thread_unref(g_thread_new("bcompare-equiv", equiv_thread, job));
+
+	g_object_get(item, "label", &label, NULL);
+
+	switch (found.Equivalence) {
+		case EQUIV_SAME_BYTES:
+			state = g_strdup_printf("%s (identical)", label);
+			break;
+		case EQUIV_SAME_TEXT:
+			state = g_strdup_printf("%s (Identical except whitespace/EOL)", label);
+			break;
+		case EQUIV_DIFFERENT:
+			if (found.HasStat)
+				state = g_strdup_printf("%s (+%d -%d)", label, found.Added, found.Removed);
+			break;
+		default:
+			break;
+	}
+
+	if (state != NULL) g_object_set(item, "label", state, NULL);
+	g_free(state);
+	g_free(label);
+	g_free(key);
+}
+
+/*************************************************************
+ *
+ * Perceptual hashes of pictures
+ *
+ *************************************************************/
+
+/* Side of the downscaled decode the perceptual hash is computed from */
+#define IMAGE_DECODE_SIZE 64
+
+/* Pictures are decoded whole only below this, to check their pixels */
+#define MAX_IMAGE_FULL_PIXELS (16 * 1000 * 1000)
+
+/* Number of the 64 bits of the hashes which may differ in similar pictures */
+#define IMAGE_DHASH_THRESHOLD 3
+
+/* Bound of the cache, it is simply emptied when reached */
+#define MAX_CACHED_IMAGES 10000
+
+typedef enum {
+	IMAGE_UNKNOWN = 0,
+	IMAGE_DIFFERS,
+	IMAGE_VISUALLY_IDENTICAL,
+	IMAGE_PIXEL_IDENTICAL
+} ImageSimilarity;
+
+typedef struct {
+	gboolean Valid;
+	guint64 DHash;
+	int Width;
+	int Height;
+	gchar *PixelHash;	/* NULL if the picture is too large */
+} ImageHash;
+
+typedef struct {
+	BCompareExt *Ext;
+	gchar *LeftFile;
+	gchar *RightFile;
+	gchar *LeftId;
+	gchar *RightId;
+	gchar *Key;
+} ImageJob;
+
+G_LOCK_DEFINE_STATIC(image_hashes);
+static GHashTable *image_hashes = NULL;		/* identity -> ImageHash */
+static GHashTable *image_pending = NULL;	/* pairs of identities being hashed */
+
+static void image_hash_free(gpointer data)
+{
+	ImageHash *hash = (ImageHash *)data;
+
+	g_free(hash->PixelHash);
+	g_free(hash);
+}
+
+static GdkPixbuf * oriented_pixbuf(GdkPixbuf *pixbuf)
+{
+	GdkPixbuf *oriented;
+
+	if (pixbuf == NULL) return NULL;
+	oriented = gdk_pixbuf_apply_embedded_orientation(pixbuf);
+	g_object_unref(pixbuf);
+	return oriented;
+}
+
+/* One bit per pair of neighbour pixels of a 9x8 gray version of the picture */
+static guint64 difference_hash(GdkPixbuf *pixbuf)
+{
+	GdkPixbuf *small = gdk_pixbuf_scale_simple(pixbuf, 9, 8, GDK_INTERP_BILINEAR);
+	const guchar *pixels = gdk_pixbuf_get_pixels(small);
+	int rowstride = gdk_pixbuf_get_rowstride(small);
+	int channels = gdk_pixbuf_get_n_channels(small);
+	guint gray[9];
+	guint64 hash = 0;
+	const guchar *p;
+	int x, y;
+
+	for (y = 0; y < 8; y++) {
+		for (x = 0; x < 9; x++) {
+			p = pixels + y * rowstride + x * channels;
+			gray[x] = (p[0] * 299 + p[1] * 587 + p[2] * 114) / 1000;
+		}
+		for (x = 0; x < 8; x++)
+			hash = (hash << 1) | ((gray[x] < gray[x + 1]) ? 1 : 0);
+	}
+
+	g_object_unref(small);
+	return hash;
+}
+
+/* Hash of the decoded pixels, as RGBA whatever the format of the file */
+static gchar * pixel_hash(const char *filepath)
+{
+	GdkPixbuf *pixbuf = oriented_pixbuf(gdk_pixbuf_new_from_file(filepath, NULL));
+	GChecksum *checksum;
+	const guchar *pixels, *p;
+	guchar *row;
+	gchar *digest;
+	int width, height, rowstride, channels, x, y;
+
+	if (pixbuf == NULL) return NULL;
+
+	pixels = gdk_pixbuf_get_pixels(pixbuf);
+	width = gdk_pixbuf_get_width(pixbuf);
+	height = gdk_pixbuf_get_height(pixbuf);
+	rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+	channels = gdk_pixbuf_get_n_channels(pixbuf);
+	row = g_malloc(width * 4);
+	checksum = g_checksum_new(G_CHECKSUM_SHA1);
+
+	for (y = 0; y < height; y++) {
+		p = pixels + y * rowstride;
+		for (x = 0; x < width; x++, p += channels) {
+			row[x * 4] = p[0];
+			row[x * 4 + 1] = p[1];
+			row[x * 4 + 2] = p[2];
+			row[x * 4 + 3] = (channels == 4) ? p[3] : 0xFF;
+		}
+		g_checksum_update(checksum, row, width * 4);
+	}
+
+	digest = g_strdup(g_checksum_get_string(checksum));
+	g_checksum_free(checksum);
+	g_free(row);
+	g_object_unref(pixbuf);
+	return digest;
+}
+
+static ImageHash * image_hash_compute(const char *filepath)
+{
+	ImageHash *hash = g_new0(ImageHash, 1);
+	GdkPixbufFormat *format;
+	GdkPixbuf *pixbuf;
+	gchar *name;
+	gint64 pixels;
+
+	format = gdk_pixbuf_get_file_info(filepath, &hash->Width, &hash->Height);
+	if ((format == NULL) || (hash->Width <= 0) || (hash->Height <= 0)) return hash;
+
+	/* Only the JPEG loader decodes at a lower resolution, others decode whole first */
+	pixels = (gint64)hash->Width * hash->Height;
+	name = gdk_pixbuf_format_get_name(format);
+	if ((strcmp(name, "jpeg") != 0) && (pixels > MAX_IMAGE_FULL_PIXELS)) {
+		g_free(name);
+		return hash;
+	}
+	g_free(name);
+
+	pixbuf = oriented_pixbuf(gdk_pixbuf_new_from_file_at_scale(filepath,
+			IMAGE_DECODE_SIZE, IMAGE_DECODE_SIZE, FALSE, NULL));
+	if (pixbuf == NULL) return hash;
+
+	hash->DHash = difference_hash(pixbuf);
+	g_object_unref(pixbuf);
+
+	if (pixels <= MAX_IMAGE_FULL_PIXELS)
+		hash->PixelHash = pixel_hash(filepath);
+	hash->Valid = TRUE;
+	return hash;
+}
+
+/* To be called with the image_hashes lock held */
+static ImageSimilarity image_similarity(const ImageHash *left, const ImageHash *right)
+{
+	gint64 cross_left, cross_right;
+	guint64 bits;
+	int distance = 0;
+
+	if (!left->Valid || !right->Valid) return IMAGE_UNKNOWN;
+
+	if ((left->PixelHash != NULL) && (right->PixelHash != NULL) &&
+			(left->Width == right->Width) && (left->Height == right->Height) &&
+			(strcmp(left->PixelHash, right->PixelHash) == 0))
+		return IMAGE_PIXEL_IDENTICAL;
+
+	/* The hashes ignore the proportions of the pictures, which must match within 1% */
+	cross_left = (gint64)left->Width * right->Height;
+	cross_right = (gint64)right->Width * left->Height;
+	if (ABS(cross_left - cross_right) * 100 > cross_left) return IMAGE_DIFFERS;
+
+	for (bits = left->DHash ^ right->DHash; bits != 0; bits &= bits - 1)
+		distance++;
+	return (distance <= IMAGE_DHASH_THRESHOLD) ? IMAGE_VISUALLY_IDENTICAL : IMAGE_DIFFERS;
+}
+
+static void image_job_free(ImageJob *job)
+{
+	g_free(job->Key);
+	g_free(job->RightId);
+	g_free(job->LeftId);
+	g_free(job->RightFile);
+	g_free(job->LeftFile);
+	g_free(job);
+}
+
+static gboolean image_job_finished(gpointer data)
+{
+	ImageJob *job = (ImageJob *)data;
+
+	G_LOCK(image_hashes);
+	g_hash_table_remove(image_pending, job->Key);
+	G_UNLOCK(image_hashes);
+
+	/* The menus are built again, with the hashes in the cache */
+	alert_updated(job->Ext);
+	image_job_free(job);
+	return G_SOURCE_REMOVE;
+}
+
+static void image_hash_store(const char *filepath, const char *identity)
+{
+	ImageHash *hash;
+	gboolean known;
+
+	G_LOCK(image_hashes);
+	known = g_hash_table_contains(image_hashes, identity);
+	G_UNLOCK(image_hashes);
+	if (known) return;
+
+	hash = image_hash_compute(filepath);
+
+	G_LOCK(image_hashes);
+	if (g_hash_table_size(image_hashes) >= MAX_CACHED_IMAGES)
+		g_hash_table_remove_all(image_hashes);
+	g_hash_table_replace(image_hashes, g_strdup(identity), hash);
+	G_UNLOCK(image_hashes);
+}
+
+static gpointer image_thread(gpointer data)
+{
+	ImageJob *job = (ImageJob *)data;
+
+	image_hash_store(job->LeftFile, job->LeftId);
+	image_hash_store(job->RightFile, job->RightId);
+
+	g_idle_add(image_job_finished, job);
+	return NULL;
+}
+
+static gboolean is_picture(const char *filepath)
+{
+	gchar *content_type = g_content_type_guess(filepath, NULL, 0, NULL);
+	gchar *mime_type = g_content_type_get_mime_type(content_type);
+	gboolean picture = (mime_type != NULL) && g_str_has_prefix(mime_type, "image/");
+
+	g_free(mime_type);
+	g_free(content_type);
+	return picture;
+}
+
+static gboolean has_viewer(BCompareExt *bcobj, const char *name)
+{
+	gchar *viewer;
+	gboolean found;
+	int Cnt;
+
+	for (Cnt = 0; Cnt < bcobj->ViewerCnt; Cnt++) {
+		viewer = g_strstrip(g_strdup(bcobj->Viewers[Cnt]));
+		found = (g_ascii_strcasecmp(viewer, name) == 0);
+		g_free(viewer);
+		if (found) return TRUE;
+	}
+	return FALSE;
+}
+
+static gboolean is_picture_pair(BCompareExt *bcobj)
+{
+	return has_viewer(bcobj, "Picture Compare") &&
+		is_picture(bcobj->LeftFile->str) && is_picture(bcobj->RightFile->str);
+}
+
+/*
+ * Tells in the label whether both pictures look the same, from the hashes
+ * cached for their identities. Missing hashes are computed in the background,
+ * and the menus are built again when they are known.
+ */
+static void image_state_mitem(BCompareExt *bcobj, BcMenuItem *item)
+{
+	ImageHash *left, *right;
+	ImageSimilarity similarity = IMAGE_UNKNOWN;
+	ImageJob *job = NULL;
+	gchar *left_id, *right_id, *key, *label, *state = NULL;
+	gint64 size;
+
+	left_id = file_identity(bcobj->LeftFile->str, &size);
+	right_id = file_identity(bcobj->RightFile->str, &size);
+	if ((left_id == NULL) || (right_id == NULL)) {
+		g_free(left_id);
+		g_free(right_id);
+		return;
+	}
+	key = g_strconcat(left_id, "|", right_id, NULL);
+
+	G_LOCK(image_hashes);
+	if (image_hashes == NULL) {
+		image_hashes = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, image_hash_free);
+		image_pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	}
+
+	left = g_hash_table_lookup(image_hashes, left_id);
+	right = g_hash_table_lookup(image_hashes, right_id);
+	if ((left != NULL) && (right != NULL)) {
+		similarity = image_similarity(left, right);
+	}
+	else if (!g_hash_table_contains(image_pending, key)) {
+		g_hash_table_add(image_pending, g_strdup(key));
+		job = g_new0(ImageJob, 1);
+		job->Ext = bcobj;
+		job->LeftFile = g_strdup(bcobj->LeftFile->str);
+		job->RightFile = g_strdup(bcobj->RightFile->str);
+		job->LeftId = left_id;
+		job->RightId = right_id;
+		job->Key = key;
+		left_id = right_id = key = NULL;
+	}
+	G_UNLOCK(image_hashes);
+
+	if (job != NULL)
+		g_thread_unref(g_thread_new("bcompare-image", image_thread, job));
+
+	if (similarity != IMAGE_UNKNOWN) {
+		g_object_get(item, "label", &label, NULL);
+		if (similarity == IMAGE_PIXEL_IDENTICAL)
+			state = g_strdup_printf("%s (pixel-identical)", label);
+		else if (similarity == IMAGE_VISUALLY_IDENTICAL)
+			state = g_strdup_printf("%s (visually identical)", label);
+		else
+			state = g_strdup_printf("%s (differs)", label);
+		g_object_set(item, "label", state, NULL);
+		g_free(state);
+		g_free(label);
+	}
+
+	g_free(key);
+	g_free(right_id);
+	g_free(left_id);
+}
+
+/*************************************************************
+ *
+ * Emblems of files differing from the Left folder
+ *
+ *************************************************************/
+
+/* Files larger than this are not hashed, a different modification time is enough */
+#define MAX_EMBLEM_HASH_SIZE (64 * 1024 * 1024)
+
+/* Items compared in parallel, each emblem is shown as soon as it is known */
+#define MAX_EMBLEM_THREADS 2
+
+/* Bound of the caches, they are simply emptied when reached */
+#define MAX_CACHED_EMBLEMS 100000
+
+#define EMBLEM_MISSING "emblem-new"
+#define EMBLEM_DIFFERS "emblem-important"
+
+typedef enum {
+	DIFF_EMBLEM_SAME = 0,
+	DIFF_EMBLEM_MISSING,
+	DIFF_EMBLEM_DIFFERS
+} DiffEmblem;
+
+typedef struct {
+	BCompareExt *Ext;
+	NemoFileInfo *File;
+	GClosure *UpdateComplete;
+	gchar *Path;
+	gchar *LeftPath;	/* counterpart in the Left folder */
+	gint Cancelled;
+	DiffEmblem State;
+} EmblemJob;
+
+/* Main thread only */
+static GThreadPool *emblem_pool = NULL;
+static gchar *emblem_left = NULL;		/* NULL if the Left selection is not a folder */
+static GFileMonitor *emblem_left_monitor = NULL;
+static GFileMonitor *emblem_storage_monitor = NULL;
+static GHashTable *emblem_files = NULL;	/* name -> GList of the items shown with an emblem state */
+
+/* State of each pair of files, keyed by both identities */
+G_LOCK_DEFINE_STATIC(emblem_states);
+static GHashTable *emblem_states = NULL;
+
+/* Compares the contents of two regular files of the same size */
+static DiffEmblem emblem_compare_files(
+		const char *path, const char *leftpath, gint *cancelled)
+{
+	gchar *identity, *left_identity, *key, *hash = NULL, *left_hash = NULL;
+	gpointer cached;
+	gint64 size;
+	DiffEmblem state = DIFF_EMBLEM_SAME;
+
+	identity = file_identity(path, &size);
+	left_identity = file_identity(leftpath, &size);
+	if ((identity == NULL) || (left_identity == NULL)) {
+		g_free(identity);
+		g_free(left_identity);
+		return DIFF_EMBLEM_SAME;
+	}
+
+	key = g_strconcat(identity, "|", left_identity, NULL);
+	G_LOCK(emblem_states);
+	cached = g_hash_table_lookup(emblem_states, key);
+	G_UNLOCK(emblem_states);
+
+	if (cached != NULL) {
+		state = GPOINTER_TO_INT(cached) - 1;
+	}
+	else {
+		hash = file_content_hash(path, identity, cancelled);
+		if (hash != NULL)
+			left_hash = file_content_hash(leftpath, left_identity, cancelled);
+	}
+
+	/* Unreadable files get no emblem, and are not cached */
+	if ((hash != NULL) && (left_hash != NULL)) {
+		state = (strcmp(hash, left_hash) == 0) ? DIFF_EMBLEM_SAME : DIFF_EMBLEM_DIFFERS;
+
+		G_LOCK(emblem_states);
+		if (g_hash_table_size(emblem_states) >= MAX_CACHED_EMBLEMS)
+			g_hash_table_remove_all(emblem_states);
+		g_hash_table_replace(emblem_states, key, GINT_TO_POINTER(state + 1));
+		G_UNLOCK(emblem_states);
+		key = NULL;
+	}
+
+	g_free(left_hash);
+	g_free(hash);
+	g_free(key);
+	g_free(left_identity);
+	g_free(identity);
+	return state;
+}
+
+static DiffEmblem emblem_compare(
+		const char *path, const char *leftpath, gint *cancelled)
+{
+	struct stat st, left_st;
+	int differing = 0;
+
+	if (stat(path, &st) != 0) return DIFF_EMBLEM_SAME;
+	if (stat(leftpath, &left_st) != 0) return DIFF_EMBLEM_MISSING;
+	if (S_ISDIR(st.st_mode) != S_ISDIR(left_st.st_mode)) return DIFF_EMBLEM_DIFFERS;
+
+	/* Folders are only compared from their indexes, never walked here */
+	if (S_ISDIR(st.st_mode))
+		return (index_compare(path, leftpath, &differing) && (differing > 0)) ?
+			DIFF_EMBLEM_DIFFERS : DIFF_EMBLEM_SAME;
+
+	if (!S_ISREG(st.st_mode) || !S_ISREG(left_st.st_mode)) return DIFF_EMBLEM_SAME;
+	if (st.st_size != left_st.st_size) return DIFF_EMBLEM_DIFFERS;
+	if ((st.st_dev == left_st.st_dev) && (st.st_ino == left_st.st_ino))
+		return DIFF_EMBLEM_SAME;
+
+	if (st.st_size > MAX_EMBLEM_HASH_SIZE)
+		return ((st.st_mtim.tv_sec == left_st.st_mtim.tv_sec) &&
+				(st.st_mtim.tv_nsec == left_st.st_mtim.tv_nsec)) ?
+			DIFF_EMBLEM_SAME : DIFF_EMBLEM_DIFFERS;
+
+	return emblem_compare_files(path, leftpath, cancelled);
+}
+
+static gboolean emblem_job_finished(gpointer data)
+{
+	EmblemJob *job = (EmblemJob *)data;
+
+	if (!g_atomic_int_get(&job->Cancelled)) {
+		if (job->State == DIFF_EMBLEM_MISSING)
+			nemo_file_info_add_emblem(job->File, EMBLEM_MISSING);
+		else if (job->State == DIFF_EMBLEM_DIFFERS)
+			nemo_file_info_add_emblem(job->File, EMBLEM_DIFFERS);
+
+		nemo_info_provider_update_complete_invoke(job->UpdateComplete,
+			(NemoInfoProvider *)job->Ext, (NemoOperationHandle *)job,
+			NEMO_OPERATION_COMPLETE);
+	}
+
+	g_closure_unref(job->UpdateComplete);
+	g_object_unref(job->File);
+	g_free(job->LeftPath);
+	g_free(job->Path);
+	g_free(job);
+	return G_SOURCE_REMOVE;
+}
+
+static void emblem_worker(gpointer data, gpointer user_data)
+{
+	EmblemJob *job = (EmblemJob *)data;
+
+	if (!g_atomic_int_get(&job->Cancelled))
+		job->State = emblem_compare(job->Path, job->LeftPath, &job->Cancelled);
+	g_idle_add(emblem_job_finished, job);
+}
+
+static void emblem_files_free(gpointer data)
+{
+	g_list_free_full((GList *)data, g_object_unref);
+}
+
+/* Asks the file manager for the emblems of the items named like name */
+static void emblem_invalidate(const char *name)
+{
+	GList *l;
+
+	for (l = g_hash_table_lookup(emblem_files, name); l != NULL; l = l->next)
+		nemo_file_info_invalidate_extension_info((NemoFileInfo *)l->data);
+}
+
+static void emblem_left_changed(GFileMonitor *monitor, GFile *file,
+		GFile *other, GFileMonitorEvent event, gpointer data)
+{
+	gchar *name;
+
+	if ((event == G_FILE_MONITOR_EVENT_CHANGED) ||
+			(event == G_FILE_MONITOR_EVENT_PRE_UNMOUNT) ||
+			(event == G_FILE_MONITOR_EVENT_UNMOUNTED))
+		return;
+
+	name = g_file_get_basename(file);
+	emblem_invalidate(name);
+	g_free(name);
+
+	if (other != NULL) {
+		name = g_file_get_basename(other);
+		emblem_invalidate(name);
+		g_free(name);
+	}
+}
+
+static void emblem_reload_left(BCompareExt *bcobj)
+{
+	GHashTableIter iter;
+	GHashTable *shown;
+	gpointer files;
+	GList *l;
+	gchar *left = NULL;
+	GFile *file;
+
+	if (g_file_get_contents(bcobj->LeftFileStorage->str, &left, NULL, NULL))
+		g_strstrip(left);
+	if ((left != NULL) && !g_file_test(left, G_FILE_TEST_IS_DIR)) {
+		g_free(left);
+		left = NULL;
+	}
+
+	if (g_strcmp0(left, emblem_left) == 0) {
+		g_free(left);
+		return;
+	}
+
+	g_free(emblem_left);
+	emblem_left = left;
+	if (emblem_left_monitor != NULL) {
+		g_file_monitor_cancel(emblem_left_monitor);
+		g_object_unref(emblem_left_monitor);
+		emblem_left_monitor = NULL;
+	}
+
+	if (emblem_left != NULL) {
+		file = g_file_new_for_path(emblem_left);
+		emblem_left_monitor = g_file_monitor_directory(file,
+			G_FILE_MONITOR_WATCH_MOVES, NULL, NULL);
+		if (emblem_left_monitor != NULL)
+			g_signal_connect(emblem_left_monitor, "changed",
+				G_CALLBACK(emblem_left_changed), bcobj);
+		g_object_unref(file);
+	}
+
+	/* Every item shown so far is looked at again */
+	shown = emblem_files;
+	emblem_files = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, emblem_files_free);
+	g_hash_table_iter_init(&iter, shown);
+	while (g_hash_table_iter_next(&iter, NULL, &files)) {
+		for (l = files; l != NULL; l = l->next)
+			nemo_file_info_invalidate_extension_info((NemoFileInfo *)l->data);
+	}
+	g_hash_table_unref(shown);
+}
+
+static void emblem_storage_changed(GFileMonitor *monitor, GFile *file,
+		GFile *other, GFileMonitorEvent event, gpointer data)
+{
+	if (event != G_FILE_MONITOR_EVENT_CHANGED)
+		emblem_reload_left((BCompareExt *)data);
+}
 
-	g_string_free(MenuStr, TRUE);
-	g_string_free(HintStr, TRUE);
-	g_string_free(ItemStr, TRUE);
+static void emblem_init(BCompareExt *bcobj)
+{
+	GFile *file;
 
-	return item;
+	if (emblem_pool != NULL) return;
+
+	emblem_pool = g_thread_pool_new(emblem_worker, NULL,
+		MAX_EMBLEM_THREADS, FALSE, NULL);
+	emblem_states = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	emblem_files = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, emblem_files_free);
+
+	/* Follows the Left selection, whichever window or file manager saved it */
+	file = g_file_new_for_path(bcobj->LeftFileStorage->str);
+	emblem_storage_monitor = g_file_monitor_file(file, G_FILE_MONITOR_NONE, NULL, NULL);
+	if (emblem_storage_monitor != NULL)
+		g_signal_connect(emblem_storage_monitor, "changed",
+			G_CALLBACK(emblem_storage_changed), bcobj);
+	g_object_unref(file);
+
+	emblem_reload_left(bcobj);
 }
 
-static BcMenuItem * select_center_mitem(BCompareExt *bcobj)
+static NemoOperationResult beyondcompare_update_file_info(
+		NemoInfoProvider *provider,
+		NemoFileInfo *file,
+		GClosure *update_complete,
+		NemoOperationHandle **handle)
 {
-	BcMenuItem *item;
+	BCompareExt *bcobj = (BCompareExt *)provider;
+	EmblemJob *job;
+	GList *files;
+	gchar *path, *name;
 
-	item = nemo_menu_item_new("BCompareExt::select_center",
-								  "Select Center File",
-								  "Remembers selected item for later comparison using Beyond Compare. Right-click another item to start the comparison",
-								  "bcomparehalf32" /* icon name */);
+	if (!bcobj->Enabled) return NEMO_OPERATION_COMPLETE;
 
-	g_signal_connect(item, "activate",
-			G_CALLBACK (select_center_action), bcobj);
-	g_object_set_data(
-	(GObject*)item, "bcext::center_file", g_string_new(bcobj->RightFile->str));
-	return item;
+	emblem_init(bcobj);
+	if (emblem_left == NULL) return NEMO_OPERATION_COMPLETE;
+
+	path = nemo_to_path(file);
+	if ((path == NULL) || (strcmp(path, emblem_left) == 0) ||
+			(g_str_has_prefix(path, emblem_left) &&
+			 (path[strlen(emblem_left)] == G_DIR_SEPARATOR))) {
+		g_free(path);
+		return NEMO_OPERATION_COMPLETE;
+	}
+
+	name = g_path_get_basename(path);
+	if (g_hash_table_size(emblem_files) >= MAX_CACHED_EMBLEMS)
+		g_hash_table_remove_all(emblem_files);
+	files = g_hash_table_lookup(emblem_files, name);
+	if (files == NULL)
+		g_hash_table_insert(emblem_files, g_strdup(name),
+			g_list_prepend(NULL, g_object_ref(file)));
+	else if (g_list_find(files, file) == NULL)
+		g_list_insert(files, g_object_ref(file), 1);
+
+	job = g_new0(EmblemJob, 1);
+	job->Ext = bcobj;
+	job->File = g_object_ref(file);
+	job->UpdateComplete = g_closure_ref(update_complete);
+	job->Path = path;
+	job->LeftPath = g_build_filename(emblem_left, name, NULL);
+	g_free(name);
+
+	*handle = (NemoOperationHandle *)job;
+	g_thread_pool_push(emblem_pool, job, NULL);
+	return NEMO_OPERATION_IN_PROGRESS;
 }
 
-static BcMenuItem * edit_file_mitem(BCompareExt *bcobj)
+static void beyondcompare_cancel_update(
+		NemoInfoProvider *provider,
+		NemoOperationHandle *handle)
 {
-	BcMenuItem *item;
-	GString *MenuStr = g_string_new("");
+	EmblemJob *job = (EmblemJob *)handle;
 
-	if (bcobj->EditMenuType == MENU_SUBMENU)
-		g_string_printf(MenuStr, "Edit");
-	else
-		g_string_printf(MenuStr, "Edit with Beyond Compare");
+	g_atomic_int_set(&job->Cancelled, 1);
+}
 
-	item = nemo_menu_item_new("BCompareExt::edit_file",
-								  MenuStr->str,
-				  "Edit the file using Beyond Compare",
-								  "bcomparefull32" /* icon name */);
+/*************************************************************
+ *
+ * Earlier versions in snapshots
+ *
+ *************************************************************/
 
-	g_signal_connect(item, "activate",
-			G_CALLBACK (edit_file_action), bcobj);
-	g_object_set_data(
-	(GObject*) item, "bcext::edit_file", g_string_new(bcobj->RightFile->str));
-	g_string_free(MenuStr, TRUE);
-	return item;
+/* Snapshots of a mount are listed again after a minute, new ones are usually hourly */
+#define SNAPSHOTS_LIFETIME_US (60 * G_USEC_PER_SEC)
+#define MAX_SNAPSHOTS 1000
+#define MAX_SNAPSHOT_SEARCH_US (3 * G_USEC_PER_SEC)
+#define MAX_SNAPSHOT_VERSIONS 20
+#define MAX_CACHED_VERSIONS 64
+
+/* Most extents compared, files with more are recognized by inode, time and size */
+#define MAX_SNAPSHOT_EXTENTS 64
+
+typedef struct {
+	gchar *Name;
+	gchar *Root;		/* folder holding the content of the mount in this snapshot */
+} Snapshot;
+
+typedef struct {
+	gchar *MountPath;
+	GPtrArray *Snapshots;	/* of Snapshot, newest first */
+	gint64 Listed;
+} MountSnapshots;
+
+typedef struct {
+	gchar *Path;		/* the file in the snapshot */
+	gchar *Snapshot;	/* newest snapshot holding this version */
+	gint64 Modified;
+} SnapshotVersion;
+
+typedef struct {
+	GPtrArray *Versions;	/* of SnapshotVersion, newest first */
+	gboolean Complete;	/* FALSE if older versions were skipped */
+	gint64 Searched;
+} SnapshotVersions;
+
+typedef struct {
+	BCompareExt *Ext;
+	gchar *FilePath;
+	gchar *Identity;
+} SnapshotJob;
+
+G_LOCK_DEFINE_STATIC(snapshots);
+static GHashTable *mount_snapshots = NULL;	/* MountSnapshots by device */
+static GHashTable *snapshot_versions = NULL;	/* SnapshotVersions by file identity */
+static GHashTable *snapshot_pending = NULL;	/* identities being searched */
+
+static void snapshot_free(gpointer data)
+{
+	Snapshot *snapshot = (Snapshot *)data;
+
+	g_free(snapshot->Root);
+	g_free(snapshot->Name);
+	g_free(snapshot);
 }
 
-static BcMenuItem * compare_mitem(
-		BCompareExt *bcobj,
-		gchar *fileviewer,
-		int SelectedCnt)
+static void mount_snapshots_free(gpointer data)
 {
-	BcMenuItem *item;
-	GString *MenuStr = g_string_new("");
-	GString *HintStr = g_string_new("");
-	GString *NameStr = g_string_new("");
-	gchar *LeftFileName;
+	MountSnapshots *mount = (MountSnapshots *)data;
 
-	if (strcmp(fileviewer, "") == 0) {
-		if (SelectedCnt == 1) {
-			LeftFileName = g_path_get_basename(bcobj->LeftFile->str);
-			g_string_printf(MenuStr, "Compare to '%s'", LeftFileName);
-			g_string_assign(HintStr,
-					"Compare selected items using Beyond Compare");
-			g_free(LeftFileName);
+	g_ptr_array_unref(mount->Snapshots);
+	g_free(mount->MountPath);
+	g_free(mount);
+}
+
+static void snapshot_version_free(gpointer data)
+{
+	SnapshotVersion *version = (SnapshotVersion *)data;
+
+	g_free(version->Snapshot);
+	g_free(version->Path);
+	g_free(version);
+}
+
+static void snapshot_versions_free(gpointer data)
+{
+	SnapshotVersions *found = (SnapshotVersions *)data;
+
+	g_ptr_array_unref(found->Versions);
+	g_free(found);
+}
+
+/* Numbers in snapshot names are compared by value, the newest are usually the greatest */
+static gint snapshot_newer_first(gconstpointer a, gconstpointer b)
+{
+	const Snapshot *left = *(const Snapshot **)a;
+	const Snapshot *right = *(const Snapshot **)b;
+	gchar *left_end, *right_end;
+	gint64 left_value = g_ascii_strtoll(left->Name, &left_end, 10);
+	gint64 right_value = g_ascii_strtoll(right->Name, &right_end, 10);
+
+	if ((left_end != left->Name) && (*left_end == '\0') &&
+			(right_end != right->Name) && (*right_end == '\0'))
+		return (left_value < right_value) ? 1 : (left_value > right_value) ? -1 : 0;
+	return strcmp(right->Name, left->Name);
+}
+
+static gint snapshot_version_newer_first(gconstpointer a, gconstpointer b)
+{
+	const SnapshotVersion *left = *(const SnapshotVersion **)a;
+	const SnapshotVersion *right = *(const SnapshotVersion **)b;
+
+	return (left->Modified < right->Modified) ? 1 : (left->Modified > right->Modified) ? -1 : 0;
+}
+
+/* Adds the snapshots of the parent folder, their content being under suffix */
+static void snapshots_add(GPtrArray *snapshots, const char *parent, const char *suffix)
+{
+	GDir *dir = g_dir_open(parent, 0, NULL);
+	const gchar *name;
+	Snapshot *snapshot;
+
+	if (dir == NULL) return;
+	while ((name = g_dir_read_name(dir)) != NULL) {
+		snapshot = g_new0(Snapshot, 1);
+		snapshot->Name = g_strdup(name);
+		snapshot->Root = g_build_filename(parent, name, suffix, NULL);
+		g_ptr_array_add(snapshots, snapshot);
+	}
+	g_dir_close(dir);
+}
+
+static GPtrArray * snapshots_list(const char *mount_path)
+{
+	GPtrArray *snapshots = g_ptr_array_new_with_free_func(snapshot_free);
+	gchar *parent;
+
+	/* snapper keeps each snapshot in a subvolume next to its description */
+	parent = g_build_filename(mount_path, ".snapshots", NULL);
+	snapshots_add(snapshots, parent, "snapshot");
+	g_free(parent);
+
+	/* Hidden folders, listed without mounting the snapshots */
+	parent = g_build_filename(mount_path, ".zfs", "snapshot", NULL);
+	snapshots_add(snapshots, parent, "");
+	g_free(parent);
+	parent = g_build_filename(mount_path, ".snapshot", NULL);
+	snapshots_add(snapshots, parent, "");
+	g_free(parent);
+
+	g_ptr_array_sort(snapshots, snapshot_newer_first);
+	return snapshots;
+}
+
+/* Path of filepath relative to mount_path, or NULL if it is not under it */
+static const char * path_under_mount(const char *filepath, const char *mount_path)
+{
+	size_t len = strlen(mount_path);
+
+	if (strcmp(mount_path, "/") == 0) return filepath + 1;
+	if ((strncmp(filepath, mount_path, len) == 0) && (filepath[len] == '/'))
+		return filepath + len + 1;
+	return NULL;
+}
+
+/*
+ * Returns the snapshots of the mount holding filepath, newest first, and the
+ * path of the file in them, or NULL if there are none. The root of the mount
+ * is found and its snapshots are listed at most once per minute.
+ */
+static GPtrArray * snapshots_of(const char *filepath, gchar **relpath)
+{
+	MountSnapshots *mount;
+	GPtrArray *snapshots = NULL;
+	struct stat st;
+	const char *rel;
+	gchar *dir, *parent, *key;
+	gint64 now = g_get_monotonic_time();
+	dev_t dev;
+
+	*relpath = NULL;
+	dir = g_path_get_dirname(filepath);
+	if (stat(dir, &st) != 0) {
+		g_free(dir);
+		return NULL;
+	}
+	dev = st.st_dev;
+	key = g_strdup_printf("%lu", (unsigned long)dev);
+
+	G_LOCK(snapshots);
+	if (mount_snapshots == NULL)
+		mount_snapshots = g_hash_table_new_full(g_str_hash, g_str_equal,
+			g_free, mount_snapshots_free);
+	mount = g_hash_table_lookup(mount_snapshots, key);
+	if ((mount != NULL) && (now - mount->Listed < SNAPSHOTS_LIFETIME_US) &&
+			((rel = path_under_mount(filepath, mount->MountPath)) != NULL)) {
+		snapshots = g_ptr_array_ref(mount->Snapshots);
+		*relpath = g_strdup(rel);
+	}
+	G_UNLOCK(snapshots);
+
+	if (snapshots == NULL) {
+		/* The root of the mount is the last parent on the same device */
+		while (strcmp(dir, "/") != 0) {
+			parent = g_path_get_dirname(dir);
+			if ((stat(parent, &st) != 0) || (st.st_dev != dev)) {
+				g_free(parent);
+				break;
+			}
+			g_free(dir);
+			dir = parent;
 		}
-		else {
-			g_string_assign(MenuStr, "Compare");
-			g_string_assign(HintStr,
-					"Compare selected item with previously selected left item, using Beyond Compare");
+
+		mount = g_new0(MountSnapshots, 1);
+		mount->MountPath = dir;
+		mount->Snapshots = snapshots_list(dir);
+		mount->Listed = now;
+		dir = NULL;
+
+		snapshots = g_ptr_array_ref(mount->Snapshots);
+		*relpath = g_strdup(path_under_mount(filepath, mount->MountPath));
+
+		G_LOCK(snapshots);
+		g_hash_table_replace(mount_snapshots, key, mount);
+		G_UNLOCK(snapshots);
+		key = NULL;
+	}
+	g_free(key);
+	g_free(dir);
+
+	if ((snapshots->len == 0) || (*relpath == NULL)) {
+		g_ptr_array_unref(snapshots);
+		g_free(*relpath);
+		*relpath = NULL;
+		return NULL;
+	}
+	return snapshots;
+}
+
+/*
+ * Identifies the content of a file: the list of its extents when the file
+ * system reports them all, otherwise its inode, modification time and size,
+ * which snapshots keep for the files they did not copy.
+ */
+static gchar * snapshot_content_key(const char *filepath, const struct stat *st)
+{
+	union {
+		struct fiemap map;
+		char buffer[sizeof(struct fiemap) +
+			MAX_SNAPSHOT_EXTENTS * sizeof(struct fiemap_extent)];
+	} request;
+	struct fiemap_extent *extent;
+	GString *key = NULL;
+	guint32 i;
+	int fd = open(filepath, O_RDONLY | O_CLOEXEC);
+
+	if (fd >= 0) {
+		memset(&request, 0, sizeof(request));
+		request.map.fm_length = FIEMAP_MAX_OFFSET;
+		request.map.fm_extent_count = MAX_SNAPSHOT_EXTENTS;
+
+		if ((ioctl(fd, FS_IOC_FIEMAP, &request.map) == 0) &&
+				(request.map.fm_mapped_extents > 0) &&
+				(request.map.fm_extents[request.map.fm_mapped_extents - 1].fe_flags &
+					FIEMAP_EXTENT_LAST)) {
+			key = g_string_new("");
+			g_string_printf(key, "x:%lld", (long long)st->st_size);
+
+			for (i = 0; i < request.map.fm_mapped_extents; i++) {
+				extent = &request.map.fm_extents[i];
+
+				/* Extents without a stable address can not be shared */
+				if (extent->fe_flags & (FIEMAP_EXTENT_UNKNOWN |
+						FIEMAP_EXTENT_DELALLOC | FIEMAP_EXTENT_DATA_INLINE)) {
+					g_string_free(key, TRUE);
+					key = NULL;
+					break;
+				}
+				g_string_append_printf(key, ":%llu+%llu",
+					(unsigned long long)extent->fe_physical,
+					(unsigned long long)extent->fe_length);
+			}
 		}
+		close(fd);
 	}
-	else {
-		g_string_assign(MenuStr, fileviewer);
-		g_string_printf(HintStr, "Compare files using the '%s' viewer",
-				fileviewer);
+
+	if (key != NULL) return g_string_free(key, FALSE);
+	return g_strdup_printf("i:%lu:%ld.%09ld:%lld",
+		(unsigned long)st->st_ino,
+		(long)st->st_mtim.tv_sec, (long)st->st_mtim.tv_nsec,
+		(long long)st->st_size);
+}
+
+/* Distinct earlier versions of filepath, within MAX_SNAPSHOTS and MAX_SNAPSHOT_SEARCH_US */
+static SnapshotVersions * snapshot_search(const char *filepath)
+{
+	SnapshotVersions *found = g_new0(SnapshotVersions, 1);
+	SnapshotVersion *version;
+	Snapshot *snapshot;
+	GPtrArray *snapshots;
+	GHashTable *seen;
+	struct stat st;
+	gchar *relpath, *path, *key;
+	gint64 start = g_get_monotonic_time();
+	guint i;
+
+	found->Versions = g_ptr_array_new_with_free_func(snapshot_version_free);
+	found->Complete = TRUE;
+	found->Searched = start;
+
+	snapshots = snapshots_of(filepath, &relpath);
+	if (snapshots == NULL) return found;
+
+	/* The current content is not an earlier version */
+	seen = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	if (stat(filepath, &st) == 0)
+		g_hash_table_add(seen, snapshot_content_key(filepath, &st));
+
+	for (i = 0; i < snapshots->len; i++) {
+		if ((i >= MAX_SNAPSHOTS) ||
+				(g_get_monotonic_time() - start > MAX_SNAPSHOT_SEARCH_US)) {
+			found->Complete = FALSE;
+			break;
+		}
+
+		snapshot = g_ptr_array_index(snapshots, i);
+		path = g_build_filename(snapshot->Root, relpath, NULL);
+		if ((stat(path, &st) != 0) || !S_ISREG(st.st_mode)) {
+			g_free(path);
+			continue;
+		}
+
+		key = snapshot_content_key(path, &st);
+		if (g_hash_table_contains(seen, key)) {
+			g_free(key);
+			g_free(path);
+			continue;
+		}
+		g_hash_table_add(seen, key);
+
+		version = g_new0(SnapshotVersion, 1);
+		version->Path = path;
+		version->Snapshot = g_strdup(snapshot->Name);
+		version->Modified = st.st_mtim.tv_sec;
+		g_ptr_array_add(found->Versions, version);
 	}
 
-	g_string_printf(NameStr, "BCompareExt::compare_using %s", fileviewer);
+	g_ptr_array_sort(found->Versions, snapshot_version_newer_first);
+	if (found->Versions->len > MAX_SNAPSHOT_VERSIONS) {
+		g_ptr_array_set_size(found->Versions, MAX_SNAPSHOT_VERSIONS);
+		found->Complete = FALSE;
+	}
 
-	item = nemo_menu_item_new(NameStr->str,
-								  MenuStr->str,
-								  HintStr->str,
-								  "bcomparefull32" /* icon name */);
-	g_signal_connect(item, "activate",
-			G_CALLBACK (compare_action), bcobj);
-	g_object_set_data(
-	(GObject*)item, "bcext::left_file", g_string_new(bcobj->LeftFile->str));
-	g_object_set_data(
-	(GObject*)item, "bcext::right_file", g_string_new(bcobj->RightFile->str));
-	g_object_set_data((GObject*)item, "bcext::fileviewer", fileviewer);
+	g_hash_table_destroy(seen);
+	g_ptr_array_unref(snapshots);
+	g_free(relpath);
+	return found;
+}
 
-	g_string_free(MenuStr, TRUE);
-	g_string_free(HintStr, TRUE);
-	g_string_free(NameStr, TRUE);
+static gboolean snapshot_job_finished(gpointer data)
+{
+	SnapshotJob *job = (SnapshotJob *)data;
+
+	G_LOCK(snapshots);
+	g_hash_table_remove(snapshot_pending, job->Identity);
+	G_UNLOCK(snapshots);
+
+	/* The menus are built again, with the versions in the cache */
+	alert_updated(job->Ext);
+	g_free(job->Identity);
+	g_free(job->FilePath);
+	g_free(job);
+	return G_SOURCE_REMOVE;
+}
+
+static gpointer snapshot_thread(gpointer data)
+{
+	SnapshotJob *job = (SnapshotJob *)data;
+	SnapshotVersions *found = snapshot_search(job->FilePath);
+
+	G_LOCK(snapshots);
+	if (g_hash_table_size(snapshot_versions) >= MAX_CACHED_VERSIONS)
+		g_hash_table_remove_all(snapshot_versions);
+	g_hash_table_replace(snapshot_versions, g_strdup(job->Identity), found);
+	G_UNLOCK(snapshots);
+
+	g_idle_add(snapshot_job_finished, job);
+	return NULL;
+}
+
+static void compare_snapshot_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	const char *right_file = g_object_get_data((GObject *)item, "bcext::right_file");
+	gchar *basename, *title;
+	char *argv[7];
+
+	basename = g_path_get_basename(right_file);
+	title = g_strdup_printf("-title1=%s (%s)", basename,
+		(const char *)g_object_get_data((GObject *)item, "bcext::snapshot"));
+
+	argv[0] = "bcompare";
+	argv[1] = "bcompare";
+	argv[2] = "-ro1";
+	argv[3] = title;
+	argv[4] = g_object_get_data((GObject *)item, "bcext::left_file");
+	argv[5] = (char *)right_file;
+	argv[6] = 0;
+
+	spawn_bc(bcobj->Winder, argv);
+
+	g_free(basename);
+	g_free(title);
+}
+
+/*
+ * Lists the distinct earlier versions of the selected file kept by the
+ * snapshots of its mount, newest first. They are searched in the background,
+ * and the menus are built again when they are known.
+ */
+static BcMenuItem * compare_snapshot_mitem(BCompareExt *bcobj)
+{
+	NemoMenu *SubMenu;
+	BcMenuItem *item, *sub;
+	SnapshotVersions *found;
+	SnapshotVersion *version;
+	SnapshotJob *job = NULL;
+	GPtrArray *snapshots, *versions = NULL;
+	GDateTime *modified;
+	gboolean complete = TRUE;
+	gchar *relpath, *identity, *name, *date, *label;
+	gint64 size;
+	guint i;
+
+	identity = file_identity(bcobj->RightFile->str, &size);
+	if (identity == NULL) return NULL;
+
+	snapshots = snapshots_of(bcobj->RightFile->str, &relpath);
+	if (snapshots == NULL) {
+		g_free(identity);
+		return NULL;
+	}
+	g_ptr_array_unref(snapshots);
+	g_free(relpath);
+
+	G_LOCK(snapshots);
+	if (snapshot_versions == NULL) {
+		snapshot_versions = g_hash_table_new_full(g_str_hash, g_str_equal,
+			g_free, snapshot_versions_free);
+		snapshot_pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	}
+
+	/* Versions older than a minute are shown while new snapshots are searched */
+	found = g_hash_table_lookup(snapshot_versions, identity);
+	if (found != NULL) {
+		versions = g_ptr_array_ref(found->Versions);
+		complete = found->Complete;
+	}
+	if (((found == NULL) || (g_get_monotonic_time() - found->Searched >= SNAPSHOTS_LIFETIME_US)) &&
+			!g_hash_table_contains(snapshot_pending, identity)) {
+		g_hash_table_add(snapshot_pending, g_strdup(identity));
+		job = g_new0(SnapshotJob, 1);
+		job->Ext = bcobj;
+		job->FilePath = g_strdup(bcobj->RightFile->str);
+		job->Identity = identity;
+		identity = NULL;
+	}
+	G_UNLOCK(snapshots);
+
+	if (job != NULL)
+		g_thread_unref(g_thread_new("bcompare-snapshot", snapshot_thread, job));
+	g_free(identity);
+
+	if (versions == NULL) {
+		item = nemo_menu_item_new("BeyondCompareExt::CompareSnapshot",
+				"Compare with Snapshot (searching...)", "", NULL);
+		g_object_set(item, "sensitive", FALSE, NULL);
+		return item;
+	}
+
+	item = nemo_menu_item_new("BeyondCompareExt::CompareSnapshot",
+				"Compare with Snapshot",
+				"Compare selected file with an earlier version kept by a snapshot, using Beyond Compare",
+				"bcomparefull32");
+	SubMenu = nemo_menu_new();
+	nemo_menu_item_set_submenu(item, SubMenu);
+
+	for (i = 0; i < versions->len; i++) {
+		version = g_ptr_array_index(versions, i);
+		modified = g_date_time_new_from_unix_local(version->Modified);
+		date = g_date_time_format(modified, "%x %X");
+		label = g_strdup_printf("%s, modified %s", version->Snapshot, date);
+		name = g_strdup_printf("BeyondCompareExt::Snapshot%u", i);
+
+		sub = nemo_menu_item_new(name, label,
+				"Compare selected file with this earlier version", "bcomparefull32");
+		g_object_set_data_full((GObject *)sub, "bcext::left_file",
+			g_strdup(version->Path), g_free);
+		g_object_set_data_full((GObject *)sub, "bcext::right_file",
+			g_strdup(bcobj->RightFile->str), g_free);
+		g_object_set_data_full((GObject *)sub, "bcext::snapshot",
+			g_strdup(version->Snapshot), g_free);
+		g_signal_connect(sub, "activate",
+			G_CALLBACK(compare_snapshot_action), bcobj);
+		nemo_menu_append_item(SubMenu, sub);
+
+		g_free(name);
+		g_free(label);
+		g_free(date);
+		g_date_time_unref(modified);
+	}
+
+	if (versions->len == 0) {
+		sub = nemo_menu_item_new("BeyondCompareExt::SnapshotNone",
+				"No earlier version", "", NULL);
+		g_object_set(sub, "sensitive", FALSE, NULL);
+		nemo_menu_append_item(SubMenu, sub);
+	}
+	if (!complete) {
+		sub = nemo_menu_item_new("BeyondCompareExt::SnapshotPartial",
+				"Older versions are not listed", "", NULL);
+		g_object_set(sub, "sensitive", FALSE, NULL);
+		nemo_menu_append_item(SubMenu, sub);
+	}
+
+	g_ptr_array_unref(versions);
 	return item;
 }
 
-static BcMenuItem * sync_mitem(
-		BCompareExt *bcobj,
-		int SelectedCnt)
+#ifdef USE_LIBGIT2
+/*************************************************************
+ *
+ * Git state of files
+ *
+ *************************************************************/
+
+/*
+ * A commit or a resolved conflict does not change the file itself, so a
+ * known state is shown and looked up again in the background once it is
+ * older than this.
+ */
+#define GIT_STATE_LIFETIME_USEC (5 * G_USEC_PER_SEC)
+#define MAX_CACHED_GIT_STATES 1024
+
+typedef struct {
+	gboolean HasHead;	/* a version of the file is committed in HEAD */
+	gboolean HasConflict;	/* the index holds conflicting stages of the file */
+} GitState;
+
+typedef struct {
+	GitState State;
+	gint64 Checked;
+} GitStateEntry;
+
+typedef struct {
+	BCompareExt *Ext;
+	gchar *FilePath;
+	gchar *Identity;
+	gboolean Changed;
+} GitJob;
+
+G_LOCK_DEFINE_STATIC(git_states);
+static GHashTable *git_states = NULL;	/* identity -> GitStateEntry */
+static GHashTable *git_pending = NULL;	/* identities being looked up */
+
+static gboolean git_job_finished(gpointer data)
 {
-	BcMenuItem *item;
-	GString *MenuStr = g_string_new("");
-	GString *HintStr = g_string_new("");
-	gchar *LeftFolderName;
+	GitJob *job = (GitJob *)data;
+
+	G_LOCK(git_states);
+	g_hash_table_remove(git_pending, job->Identity);
+	G_UNLOCK(git_states);
+
+	/* The menus are built again when the items to show changed */
+	if (job->Changed) alert_updated(job->Ext);
+	g_free(job->Identity);
+	g_free(job->FilePath);
+	g_free(job);
+	return G_SOURCE_REMOVE;
+}
 
+static gpointer git_thread(gpointer data)
+{
+	GitJob *job = (GitJob *)data;
+	GitStateEntry *entry = g_new0(GitStateEntry, 1), *known;
+
+	entry->State.HasHead = git_has_head_version(job->FilePath);
+	entry->State.HasConflict = git_has_conflict(job->FilePath);
+	entry->Checked = g_get_monotonic_time();
+
+	G_LOCK(git_states);
+	known = g_hash_table_lookup(git_states, job->Identity);
+	job->Changed = (known == NULL) ||
+		(memcmp(&known->State, &entry->State, sizeof(GitState)) != 0);
+	if ((known == NULL) && (g_hash_table_size(git_states) >= MAX_CACHED_GIT_STATES))
+		g_hash_table_remove_all(git_states);
+	g_hash_table_replace(git_states, g_strdup(job->Identity), entry);
+	G_UNLOCK(git_states);
+
+	g_idle_add(git_job_finished, job);
+	return NULL;
+}
 
-	if (SelectedCnt == 1) {
-		LeftFolderName = g_path_get_basename(bcobj->LeftFile->str);
-		g_string_printf(MenuStr, "Sync with '%s'", LeftFolderName);
-		g_string_assign(HintStr,
-				"Sync to previously selected folder");
-		g_free(LeftFolderName);
+/*
+ * Returns the Git state of the selected file, nothing while it is unknown.
+ * libgit2 is never called while the menus are built: the state is looked up
+ * in the background, and the menus are built again when it is known.
+ */
+static GitState git_state(BCompareExt *bcobj)
+{
+	GitState found = { FALSE, FALSE };
+	GitStateEntry *known;
+	GitJob *job = NULL;
+	gchar *identity;
+	gint64 size;
+
+	identity = file_identity(bcobj->RightFile->str, &size);
+	if (identity == NULL) return found;
+
+	G_LOCK(git_states);
+	if (git_states == NULL) {
+		git_states = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+		git_pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
 	}
-	else {
-		g_string_assign(MenuStr, "Sync");
-		g_string_assign(HintStr,
-				"Sync two selected folders");
+
+	known = g_hash_table_lookup(git_states, identity);
+	if (known != NULL) found = known->State;
+	if (((known == NULL) || (g_get_monotonic_time() - known->Checked >= GIT_STATE_LIFETIME_USEC)) &&
+			!g_hash_table_contains(git_pending, identity)) {
+		g_hash_table_add(git_pending, g_strdup(identity));
+		job = g_new0(GitJob, 1);
+		job->Ext = bcobj;
+		job->FilePath = g_strdup(bcobj->RightFile->str);
+		job->Identity = identity;
+		identity = NULL;
+	}
+	G_UNLOCK(git_states);
+
+	if (job != NULL)
+		g_thread_unref(g_thread_new("bcompare-git", git_thread, job));
+	g_free(identity);
+
+	return found;
+}
+#endif
+
+/*************************************************************
+ *
+ * Backup copies next to files
+ *
+ *************************************************************/
+
+/* Bounds of the listings kept in memory, larger folders are not searched */
+#define MAX_CACHED_LISTINGS 16
+#define MAX_LISTED_NAMES 100000
+
+/* Most siblings offered for one file */
+#define MAX_SIBLINGS 3
+
+/* A folder modified this close to its listing may change again with the same time */
+#define RACY_LISTING_NS G_GINT64_CONSTANT(1000000000)
+
+/* Backup copies left by editors, patch and the package managers */
+static const char *default_backup_suffixes =
+	".orig,.bak,~,.rej,.old,.dpkg-old,.dpkg-dist,.rpmsave,.rpmnew";
+
+typedef struct {
+	gchar Char;		/* character leading to this state, names are read backwards */
+	gint Child;		/* first state reached from this one, or -1 */
+	gint Sibling;		/* next state reached from the same parent, or -1 */
+	gboolean Accept;	/* a suffix starts at this character */
+} SuffixState;
+
+typedef struct {
+	gint64 ModifiedNs;	/* -1 when the folder must be listed again */
+	GPtrArray *Names;	/* sorted names of the entries */
+} FolderListing;
+
+/* Automaton of the backup suffixes, the suffixes it was built from, and the recent folder listings */
+G_LOCK_DEFINE_STATIC(siblings);
+static GArray *suffix_states = NULL;
+static gchar *suffix_source = NULL;
+static GHashTable *folder_listings = NULL;
+
+static gint suffix_step(gint state, gchar c)
+{
+	gint next;
+
+	for (next = g_array_index(suffix_states, SuffixState, state).Child; next >= 0;
+			next = g_array_index(suffix_states, SuffixState, next).Sibling) {
+		if (g_array_index(suffix_states, SuffixState, next).Char == c) return next;
+	}
+	return -1;
+}
+
+/*
+ * Builds the trie of the reversed suffixes, its accepting states start a
+ * suffix. It is built again only when the configured suffixes change.
+ */
+static void suffix_compile(gchar **suffixes)
+{
+	SuffixState state = { 0, -1, -1, FALSE };
+	gchar *source = g_strjoinv(",", suffixes);
+	gint current, next;
+	int i, j;
+
+	if ((suffix_states != NULL) && (g_strcmp0(source, suffix_source) == 0)) {
+		g_free(source);
+		return;
+	}
+	if (suffix_states != NULL) g_array_unref(suffix_states);
+	g_free(suffix_source);
+	suffix_source = source;
+
+	suffix_states = g_array_new(FALSE, FALSE, sizeof(SuffixState));
+	g_array_append_val(suffix_states, state);
+
+	for (i = 0; suffixes[i] != NULL; i++) {
+		current = 0;
+		for (j = (int)strlen(suffixes[i]) - 1; j >= 0; j--) {
+			next = suffix_step(current, suffixes[i][j]);
+			if (next < 0) {
+				next = suffix_states->len;
+				state.Char = suffixes[i][j];
+				state.Sibling = g_array_index(suffix_states, SuffixState, current).Child;
+				g_array_index(suffix_states, SuffixState, current).Child = next;
+				g_array_append_val(suffix_states, state);
+			}
+			current = next;
+		}
+		if (current > 0)
+			g_array_index(suffix_states, SuffixState, current).Accept = TRUE;
+	}
+}
+
+/* Returns TRUE if name ends with one of the suffixes right after its first stem_len bytes */
+static gboolean suffix_matches(const char *name, size_t stem_len)
+{
+	gint state = 0;
+	size_t i;
+
+	for (i = strlen(name); i > stem_len; i--) {
+		state = suffix_step(state, name[i - 1]);
+		if (state < 0) return FALSE;
 	}
+	return g_array_index(suffix_states, SuffixState, state).Accept;
+}
 
-	item = nemo_menu_item_new("BCompareExt::sync",
-								  MenuStr->str,
-								  HintStr->str,
-								  "bcomparefull32" /* icon name */);
-	g_signal_connect(item, "activate",
-			G_CALLBACK (sync_action), bcobj);
-	g_object_set_data(
-			(GObject*)item, "bcext::left_folder", g_string_new(bcobj->LeftFile->str));
-	g_object_set_data(
-		(GObject*)item, "bcext::right_folder", g_string_new(bcobj->RightFile->str));
+static void folder_listing_free(gpointer data)
+{
+	FolderListing *listing = (FolderListing *)data;
 
-	g_string_free(MenuStr, TRUE);
-	g_string_free(HintStr, TRUE);
-	return item;
+	g_ptr_array_unref(listing->Names);
+	g_free(listing);
+}
 
+static gint compare_names(gconstpointer a, gconstpointer b)
+{
+	return strcmp(*(const char **)a, *(const char **)b);
 }
 
-static BcMenuItem * merge_mitem(
-		BCompareExt *bcobj,
-		int SelectedCnt)
+/* Index of the first of the sorted names which is not before name */
+static guint names_lower_bound(GPtrArray *names, const char *name)
 {
-	BcMenuItem *item;
-	GString *MenuStr = g_string_new("");
-	GString *HintStr = g_string_new("");
-	gchar *File1, *File2;
+	guint low = 0, high = names->len, middle;
 
-	if (SelectedCnt == 1){
-		if (bcobj->CenterFile == NULL) {
-			File1 = g_path_get_basename(bcobj->LeftFile->str);
-			g_string_printf(MenuStr, "Merge with '%s'", File1);
-			g_string_assign(HintStr,
-				"Merge file with previously selected left file using Beyond Compare");
-			g_free(File1);
-		}
-		else {
-			File1 = g_path_get_basename(bcobj->LeftFile->str);
-			File2 = g_path_get_basename(bcobj->CenterFile->str);
-			g_string_printf(MenuStr, "Merge with '%s', '%s'", File1, File2);
-			g_string_assign(HintStr,
-				"Merge file with previously selected left and center files using Beyond Compare");
-			g_free(File1);
-			g_free(File2);
-		}
+	while (low < high) {
+		middle = (low + high) / 2;
+		if (strcmp(g_ptr_array_index(names, middle), name) < 0) low = middle + 1;
+		else high = middle;
 	}
-	else if (SelectedCnt == 2){
-		if (bcobj->CenterFile == NULL) {
-			g_string_assign(MenuStr, "Merge");
-			g_string_assign(HintStr,
-				"Merge selected files (left, right)");
-		}
-		else {
-			File1 = g_path_get_basename(bcobj->CenterFile->str);
-			g_string_printf(MenuStr, "Merge with '%s'", File1);
-			g_string_assign(HintStr,
-				"Merge selected files (left, right) with previously selected center file");
-			g_free(File1);
+	return low;
+}
+
+/*
+ * Returns the sorted names of the entries of folder, listed again only when
+ * it was modified. To be called with the siblings lock held.
+ */
+static GPtrArray * folder_listing(const char *folder)
+{
+	FolderListing *listing;
+	struct stat st;
+	GDir *dir;
+	const gchar *name;
+	gint64 modified_ns, listed_ns;
+
+	if (stat(folder, &st) != 0) return NULL;
+	modified_ns = (gint64)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+
+	if (folder_listings == NULL)
+		folder_listings = g_hash_table_new_full(g_str_hash, g_str_equal,
+			g_free, folder_listing_free);
+	listing = g_hash_table_lookup(folder_listings, folder);
+	if ((listing != NULL) && (listing->ModifiedNs == modified_ns)) return listing->Names;
+
+	listed_ns = g_get_real_time() * 1000;
+	listing = g_new0(FolderListing, 1);
+	listing->Names = g_ptr_array_new_with_free_func(g_free);
+	listing->ModifiedNs = (listed_ns - modified_ns < RACY_LISTING_NS) ? -1 : modified_ns;
+
+	dir = g_dir_open(folder, 0, NULL);
+	while ((dir != NULL) && ((name = g_dir_read_name(dir)) != NULL)) {
+		/* Huge folders are remembered empty, so they are not listed on every popup */
+		if (listing->Names->len >= MAX_LISTED_NAMES) {
+			g_ptr_array_set_size(listing->Names, 0);
+			break;
 		}
+		g_ptr_array_add(listing->Names, g_strdup(name));
 	}
-	else if (SelectedCnt == 3) {
-		g_string_assign(MenuStr, "Merge");
-		g_string_assign(HintStr,
-				"Merge selected files (left, right, center)");
-	}
-	else return NULL;
+	if (dir != NULL) g_dir_close(dir);
+	g_ptr_array_sort(listing->Names, compare_names);
 
+	if (g_hash_table_size(folder_listings) >= MAX_CACHED_LISTINGS)
+		g_hash_table_remove_all(folder_listings);
+	g_hash_table_replace(folder_listings, g_strdup(folder), listing);
+	return listing->Names;
+}
 
-	item = nemo_menu_item_new("BCompareExt::merge",
-								  MenuStr->str,
-								  HintStr->str,
-								  "bcomparefull32" /* icon name */);
-	g_signal_connect(item, "activate",
-			G_CALLBACK(merge_action), bcobj);
-	g_object_set_data(
-			(GObject*)item, "bcext::left_file", g_string_new(bcobj->LeftFile->str));
-	g_object_set_data(
-			(GObject*)item, "bcext::right_file", g_string_new(bcobj->RightFile->str));
-	if (bcobj->CenterFile != NULL) {
-	g_object_set_data(
-			(GObject*)item, "bcext::center_file", g_string_new(bcobj->CenterFile->str));
+/*
+ * Returns the backup copies next to filepath, named after it with one of the
+ * suffixes, and the file it was made from if it is itself a backup. The paths
+ * are in pairs, the backup first.
+ */
+static GPtrArray * sibling_pairs(BCompareExt *bcobj, const char *filepath)
+{
+	GPtrArray *pairs = g_ptr_array_new_with_free_func(g_free);
+	GPtrArray *names;
+	gchar *folder = g_path_get_dirname(filepath);
+	gchar *name = g_path_get_basename(filepath);
+	gchar *stem;
+	const char *entry;
+	size_t len = strlen(name);
+	gint state = 0;
+	guint i, index;
+
+	G_LOCK(siblings);
+	suffix_compile(bcobj->BackupSuffixes);
+	names = folder_listing(folder);
+
+	/* Backups of the file: the names starting with its name, followed by a suffix */
+	for (i = (names != NULL) ? names_lower_bound(names, name) : 0;
+			(names != NULL) && (i < names->len) && (pairs->len < 2 * MAX_SIBLINGS); i++) {
+		entry = g_ptr_array_index(names, i);
+		if (!g_str_has_prefix(entry, name)) break;
+		if ((strlen(entry) > len) && suffix_matches(entry, len)) {
+			g_ptr_array_add(pairs, g_build_filename(folder, entry, NULL));
+			g_ptr_array_add(pairs, g_strdup(filepath));
+		}
 	}
 
-	g_string_free(MenuStr, TRUE);
-	g_string_free(HintStr, TRUE);
+	/* The file the selected backup was made from: its name without a suffix */
+	for (i = len - 1; (names != NULL) && (i > 0) && (state >= 0) &&
+			(pairs->len < 2 * MAX_SIBLINGS); i--) {
+		state = suffix_step(state, name[i]);
+		if ((state < 0) || !g_array_index(suffix_states, SuffixState, state).Accept)
+			continue;
+
+		stem = g_strndup(name, i);
+		index = names_lower_bound(names, stem);
+		if ((index < names->len) && (strcmp(g_ptr_array_index(names, index), stem) == 0)) {
+			g_ptr_array_add(pairs, g_strdup(filepath));
+			g_ptr_array_add(pairs, g_build_filename(folder, stem, NULL));
+		}
+		g_free(stem);
+	}
+	G_UNLOCK(siblings);
 
-	return item;
+	g_free(name);
+	g_free(folder);
+	return pairs;
+}
+
+static void compare_sibling_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	char *argv[5];
+
+	argv[0] = "bcompare";
+	argv[1] = "bcompare";
+	argv[2] = g_object_get_data((GObject *)item, "bcext::left_file");
+	argv[3] = g_object_get_data((GObject *)item, "bcext::right_file");
+	argv[4] = 0;
+	spawn_bc(bcobj->Winder, argv);
 }
 
+/* One "Compare with" item for each backup copy of the selected file, or for its original */
+static GList * compare_sibling_mitems(BCompareExt *bcobj)
+{
+	GList *items = NULL;
+	GPtrArray *pairs = sibling_pairs(bcobj, bcobj->RightFile->str);
+	BcMenuItem *item;
+	const char *left, *right, *sibling, *hint;
+	gchar *basename, *label, *name;
+	guint i;
+
+	for (i = 0; i + 1 < pairs->len; i += 2) {
+		left = g_ptr_array_index(pairs, i);
+		right = g_ptr_array_index(pairs, i + 1);
+		sibling = (strcmp(left, bcobj->RightFile->str) == 0) ? right : left;
+		if (!g_file_test(sibling, G_FILE_TEST_IS_REGULAR)) continue;
+
+		/* The backup is on the left, either the selected file or its sibling */
+		hint = (sibling == left) ?
+			"Compare selected file with its backup copy, using Beyond Compare" :
+			"Compare the selected backup copy with the file it was made from, using Beyond Compare";
+
+		basename = g_path_get_basename(sibling);
+		label = g_strdup_printf("Compare with \"%s\"", basename);
+		name = g_strdup_printf("BeyondCompareExt::CompareSibling%u", i / 2);
+
+		item = nemo_menu_item_new(name, label, hint, "bcomparefull32");
+		g_object_set_data_full((GObject *)item, "bcext::left_file",
+			g_strdup(left), g_free);
+		g_object_set_data_full((GObject *)item, "bcext::right_file",
+			g_strdup(right), g_free);
+		g_signal_connect(item, "activate",
+			G_CALLBACK(compare_sibling_action), bcobj);
+		items = g_list_append(items, item);
+
+		g_free(name);
+		g_free(label);
+		g_free(basename);
+	}
+
+	g_ptr_array_unref(pairs);
+	return items;
+}
 
 /*************************************************************
  *
@@ -582,10 +6746,20 @@ static GList *beyondcompare_create_dir_menus(
 			(bcobj->LeftFile != NULL) && (bcobj->RightFile != NULL)) {
 		if (CurrentMenuType == bcobj->CompareMenuType) {
 			item = compare_mitem(bcobj, "", SelectedCnt);
+			if (item != NULL) index_state_mitem(bcobj, item);
 			if (item != NULL) items = g_list_append(items, item);
 		}
 		if (CurrentMenuType == bcobj->SyncMenuType) {
 			item = sync_mitem(bcobj, SelectedCnt);
+			if (item != NULL) index_state_mitem(bcobj, item);
+			if (item != NULL) items = g_list_append(items, item);
+			item = sync_background_mitem(bcobj);
+			if (item != NULL) items = g_list_append(items, item);
+			item = verify_mitem(bcobj);
+			if (item != NULL) items = g_list_append(items, item);
+			item = report_mitem(bcobj);
+			if (item != NULL) items = g_list_append(items, item);
+			item = show_unchanged_mitem(bcobj);
 			if (item != NULL) items = g_list_append(items, item);
 		}
 	}
@@ -622,6 +6796,8 @@ static GList *beyondcompare_create_file_menus(
 		if (SelectedCnt < 3) {
 			if (bcobj->CompareMenuType == CurrentMenuType) {
 				item = compare_mitem(bcobj, "", SelectedCnt);
+				if ((item != NULL) && is_picture_pair(bcobj)) image_state_mitem(bcobj, item);
+				else if (item != NULL) equiv_state_mitem(bcobj, item);
 				if (item != NULL) items = g_list_append(items, item);
 			}
 			if (bcobj->CompareUsingMenuType == CurrentMenuType &&
@@ -645,29 +6821,500 @@ static GList *beyondcompare_create_file_menus(
 
 	if (SelectedCnt == 1) {
 		if (bcobj->CompareMenuType == CurrentMenuType) {
+			if ((bcobj->LeftFile == NULL) || bcobj->LeftIsDir)
+				items = g_list_concat(items, compare_sibling_mitems(bcobj));
 			item = select_left_mitem(bcobj, FALSE);
 			if (item != NULL) items = g_list_append(items, item);
 			if ((!bcobj->LeftIsDir) && (bcobj->LeftFile != NULL)) {
 				item = select_center_mitem(bcobj);
 				if (item != NULL) items = g_list_append(items, item);
 			}
+#ifdef USE_LIBGIT2
+			if (git_state(bcobj).HasHead) {
+				item = compare_head_mitem(bcobj);
+				if (item != NULL) items = g_list_append(items, item);
+			}
+#endif
+			item = compare_snapshot_mitem(bcobj);
+			if (item != NULL) items = g_list_append(items, item);
+		}
+#ifdef USE_LIBGIT2
+		if ((bcobj->MergeMenuType == CurrentMenuType) &&
+				git_state(bcobj).HasConflict) {
+			item = resolve_conflict_mitem(bcobj);
+			if (item != NULL) items = g_list_append(items, item);
 		}
+#endif
 		if (bcobj->EditMenuType == CurrentMenuType) {
 			item = edit_file_mitem(bcobj);
 			if (item != NULL) items = g_list_append(items, item);
 		}
+		if (bcobj->CompareMenuType == CurrentMenuType) {
+			item = compare_clipboard_mitem(bcobj);
+			if (item != NULL) items = g_list_append(items, item);
+		}
 	}
 
 	return items;
 }
 
+/*************************************************************
+ *
+ * Identical files in large selections
+ *
+ *************************************************************/
+
+/* Bounds of the work done for one selection */
+#define MAX_DUP_FILES 10000
+#define MAX_DUP_HASH_BYTES (8LL * 1024 * 1024 * 1024)
+#define MAX_DUP_ITEMS 25
+
+typedef struct _DupJob {
+	gint RefCount;
+	gint Cancelled;
+	gint Pending;
+	BCompareExt *Ext;
+	gchar *Key;
+	GPtrArray *Paths;	/* owns the selected paths */
+	GMutex Lock;
+	GHashTable *Hashes;	/* path -> content digest */
+	GPtrArray *Buckets;	/* paths of the files sharing the same size */
+	GPtrArray *Groups;	/* paths of the files sharing the same content */
+	GPtrArray *Pairs;	/* left, right... same size, different content */
+	gboolean Complete;
+	gboolean Done;
+} DupJob;
+
+typedef struct {
+	DupJob *Job;
+	const gchar *Path;
+	gchar *Identity;
+} DupTask;
+
+static GThreadPool *hash_pool = NULL;
+
+static void dup_job_unref(DupJob *job)
+{
+	if (!g_atomic_int_dec_and_test(&job->RefCount)) return;
+
+	g_ptr_array_unref(job->Pairs);
+	g_ptr_array_unref(job->Groups);
+	g_ptr_array_unref(job->Buckets);
+	g_hash_table_destroy(job->Hashes);
+	g_mutex_clear(&job->Lock);
+	g_ptr_array_unref(job->Paths);
+	g_free(job->Key);
+	g_free(job);
+}
+
+/* Splits every bucket by digest, in the order of the selection */
+static void dup_job_results(DupJob *job)
+{
+	GPtrArray *bucket, *digests, *members;
+	const gchar *path, *digest;
+	guint b, i, j;
+
+	g_mutex_lock(&job->Lock);
+	for (b = 0; b < job->Buckets->len; b++) {
+		bucket = g_ptr_array_index(job->Buckets, b);
+		digests = g_ptr_array_new();
+		members = g_ptr_array_new_with_free_func(
+						(GDestroyNotify)g_ptr_array_unref);
+
+		for (i = 0; i < bucket->len; i++) {
+			path = g_ptr_array_index(bucket, i);
+			digest = g_hash_table_lookup(job->Hashes, path);
+			if (digest == NULL) {
+				job->Complete = FALSE;
+				continue;
+			}
+
+			for (j = 0; j < digests->len; j++)
+				if (strcmp(g_ptr_array_index(digests, j), digest) == 0)
+					break;
+			if (j == digests->len) {
+				g_ptr_array_add(digests, (gpointer)digest);
+				g_ptr_array_add(members, g_ptr_array_new());
+			}
+			g_ptr_array_add(g_ptr_array_index(members, j), (gpointer)path);
+		}
+
+		for (i = 0; i < members->len; i++) {
+			if (((GPtrArray *)g_ptr_array_index(members, i))->len > 1)
+				g_ptr_array_add(job->Groups,
+					g_ptr_array_ref(g_ptr_array_index(members, i)));
+
+			for (j = i + 1; (j < members->len) &&
+					(job->Pairs->len < 2 * MAX_DUP_ITEMS); j++) {
+				g_ptr_array_add(job->Pairs, g_ptr_array_index(
+					(GPtrArray *)g_ptr_array_index(members, i), 0));
+				g_ptr_array_add(job->Pairs, g_ptr_array_index(
+					(GPtrArray *)g_ptr_array_index(members, j), 0));
+			}
+		}
+
+		g_ptr_array_unref(members);
+		g_ptr_array_free(digests, TRUE);
+	}
+	g_mutex_unlock(&job->Lock);
+}
+
+static gboolean dup_job_finished(gpointer data)
+{
+	DupJob *job = (DupJob *)data;
+
+	job->Done = TRUE;
+	if (job->Ext->DupJob == job) alert_updated(job->Ext);
+	dup_job_unref(job);
+
+	return G_SOURCE_REMOVE;
+}
+
+static void dup_job_task_done(DupJob *job)
+{
+	if (g_atomic_int_dec_and_test(&job->Pending)) {
+		if (!g_atomic_int_get(&job->Cancelled)) {
+			dup_job_results(job);
+			g_atomic_int_inc(&job->RefCount);
+			g_idle_add(dup_job_finished, job);
+		}
+	}
+}
+
+typedef struct {
+	gint64 Size;
+	const gchar *Path;
+	gchar *Identity;
+} DupEntry;
+
+static gint dup_entry_compare(gconstpointer a, gconstpointer b)
+{
+	gint64 sa = ((const DupEntry *)a)->Size;
+	gint64 sb = ((const DupEntry *)b)->Size;
+
+	return (sa < sb) ? -1 : ((sa > sb) ? 1 : 0);
+}
+
+/*
+ * Only files sharing their size with another one can be identical, so they
+ * are the only ones hashed, smallest first within the byte budget.
+ */
+static void dup_job_bucket(DupJob *job)
+{
+	GArray *entries = g_array_new(FALSE, FALSE, sizeof(DupEntry));
+	GPtrArray *tasks = g_ptr_array_new();
+	GPtrArray *bucket;
+	DupEntry entry, *first;
+	DupTask *task;
+	gint64 budget = MAX_DUP_HASH_BYTES;
+	guint i, j, end;
+
+	for (i = 0; i < job->Paths->len; i++) {
+		if (g_atomic_int_get(&job->Cancelled)) break;
+
+		entry.Path = g_ptr_array_index(job->Paths, i);
+		entry.Identity = file_identity(entry.Path, &entry.Size);
+		if (entry.Identity != NULL) g_array_append_val(entries, entry);
+	}
+	g_array_sort(entries, dup_entry_compare);
+
+	for (i = 0; i < entries->len; i = end) {
+		first = &g_array_index(entries, DupEntry, i);
+		for (end = i + 1; (end < entries->len) &&
+				(g_array_index(entries, DupEntry, end).Size == first->Size); end++);
+		if (end - i < 2) continue;
+
+		if ((first->Size > 0) &&
+				(first->Size * (gint64)(end - i) > budget)) {
+			job->Complete = FALSE;
+			continue;
+		}
+		budget -= first->Size * (gint64)(end - i);
+
+		bucket = g_ptr_array_new();
+		for (j = i; j < end; j++) {
+			entry = g_array_index(entries, DupEntry, j);
+			g_ptr_array_add(bucket, (gpointer)entry.Path);
+			if (entry.Size == 0) {
+				g_hash_table_insert(job->Hashes,
+					(gpointer)entry.Path, g_strdup(""));
+			} else {
+				task = g_new0(DupTask, 1);
+				task->Job = job;
+				task->Path = entry.Path;
+				task->Identity = g_strdup(entry.Identity);
+				g_ptr_array_add(tasks, task);
+			}
+		}
+		g_ptr_array_add(job->Buckets, bucket);
+	}
+
+	for (i = 0; i < entries->len; i++)
+		g_free(g_array_index(entries, DupEntry, i).Identity);
+	g_array_free(entries, TRUE);
+
+	/* Pending already counts this task, which is released last */
+	g_atomic_int_add(&job->Pending, tasks->len);
+	g_atomic_int_add(&job->RefCount, tasks->len);
+	for (i = 0; i < tasks->len; i++)
+		g_thread_pool_push(hash_pool, g_ptr_array_index(tasks, i), NULL);
+	g_ptr_array_free(tasks, TRUE);
+}
+
+static void dup_job_cancel(BCompareExt *bcobj)
+{
+	if (bcobj->DupJob == NULL) return;
+
+	g_atomic_int_set(&bcobj->DupJob->Cancelled, 1);
+	dup_job_unref(bcobj->DupJob);
+	bcobj->DupJob = NULL;
+}
+
+static void dup_task_run(gpointer data, gpointer user_data)
+{
+	DupTask *task = (DupTask *)data;
+	DupJob *job = task->Job;
+	gchar *digest;
+
+	if (task->Path == NULL) {
+		dup_job_bucket(job);
+	} else if (!g_atomic_int_get(&job->Cancelled)) {
+		digest = file_content_hash(task->Path, task->Identity, &job->Cancelled);
+		if (digest != NULL) {
+			g_mutex_lock(&job->Lock);
+			g_hash_table_insert(job->Hashes, (gpointer)task->Path, digest);
+			g_mutex_unlock(&job->Lock);
+		}
+	}
+
+	dup_job_task_done(job);
+	dup_job_unref(job);
+	g_free(task->Identity);
+	g_free(task);
+}
+
+/* Takes ownership of paths */
+static DupJob * dup_job_start(BCompareExt *bcobj, gchar *key, GPtrArray *paths)
+{
+	DupJob *job = g_new0(DupJob, 1);
+	DupTask *task;
+
+	job->RefCount = 2;	/* bcobj->DupJob and the bucketing task */
+	job->Pending = 1;
+	job->Ext = bcobj;
+	job->Key = key;
+	job->Paths = paths;
+	g_mutex_init(&job->Lock);
+	job->Hashes = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_free);
+	job->Buckets = g_ptr_array_new_with_free_func(
+						(GDestroyNotify)g_ptr_array_unref);
+	job->Groups = g_ptr_array_new_with_free_func(
+						(GDestroyNotify)g_ptr_array_unref);
+	job->Pairs = g_ptr_array_new();
+	job->Complete = (paths->len <= MAX_DUP_FILES);
+	if (!job->Complete) g_ptr_array_set_size(paths, MAX_DUP_FILES);
+
+	if (hash_pool == NULL)
+		hash_pool = g_thread_pool_new(dup_task_run, NULL,
+						g_get_num_processors(), FALSE, NULL);
+
+	task = g_new0(DupTask, 1);
+	task->Job = job;
+	g_thread_pool_push(hash_pool, task, NULL);
+
+	return job;
+}
+
+static void compare_pair_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	char *argv[5];
+
+	argv[0] = "bcompare";
+	argv[1] = "bcompare";
+	argv[2] = g_object_get_data((GObject *)item, "bcext::left_file");
+	argv[3] = g_object_get_data((GObject *)item, "bcext::right_file");
+	argv[4] = 0;
+	spawn_bc(bcobj->Winder, argv);
+}
+
+static BcMenuItem * label_mitem(const char *name, const char *label)
+{
+	BcMenuItem *item = nemo_menu_item_new(name, label, "", NULL);
+
+	g_object_set(item, "sensitive", FALSE, NULL);
+	return item;
+}
+
+static BcMenuItem * group_identical_mitem(BCompareExt *bcobj, DupJob *job)
+{
+	NemoMenu *SubMenu;
+	BcMenuItem *item, *sub;
+	GPtrArray *group;
+	GString *label;
+	gchar *left_name, *right_name, *name;
+	guint i, j;
+
+	if (!job->Done) {
+		label = g_string_new("");
+		g_string_printf(label,
+			"Group Identical Files (scanning %u files...)", job->Paths->len);
+		item = label_mitem("BeyondCompareExt::GroupIdentical", label->str);
+		g_string_free(label, TRUE);
+		return item;
+	}
+
+	item = nemo_menu_item_new("BeyondCompareExt::GroupIdentical",
+							"Group Identical Files",
+							"Selected files having the same content",
+							"bcomparefull32");
+	SubMenu = nemo_menu_new();
+	nemo_menu_item_set_submenu(item, SubMenu);
+
+	for (i = 0; (i < job->Groups->len) && (i < MAX_DUP_ITEMS); i++) {
+		group = g_ptr_array_index(job->Groups, i);
+		label = g_string_new("");
+		g_string_printf(label, "%u identical: ", group->len);
+		for (j = 0; (j < group->len) && (j < 3); j++) {
+			name = g_path_get_basename(g_ptr_array_index(group, j));
+			g_string_append_printf(label, "%s%s", (j > 0) ? ", " : "", name);
+			g_free(name);
+		}
+		if (group->len > 3) g_string_append(label, ", ...");
+
+		name = g_strdup_printf("BeyondCompareExt::Group%u", i);
+		nemo_menu_append_item(SubMenu, label_mitem(name, label->str));
+		g_free(name);
+		g_string_free(label, TRUE);
+	}
+	if (job->Groups->len == 0)
+		nemo_menu_append_item(SubMenu,
+			label_mitem("BeyondCompareExt::GroupNone", "No identical files"));
+
+	for (i = 0; i + 1 < job->Pairs->len; i += 2) {
+		left_name = g_path_get_basename(g_ptr_array_index(job->Pairs, i));
+		right_name = g_path_get_basename(g_ptr_array_index(job->Pairs, i + 1));
+		name = g_strdup_printf("BeyondCompareExt::ComparePair%u", i / 2);
+		label = g_string_new("");
+		g_string_printf(label, "Compare \"%s\" and \"%s\"", left_name, right_name);
+
+		sub = nemo_menu_item_new(name, label->str,
+				"Same size, different content", "bcomparefull32");
+		g_object_set_data_full((GObject *)sub, "bcext::left_file",
+			g_strdup(g_ptr_array_index(job->Pairs, i)), g_free);
+		g_object_set_data_full((GObject *)sub, "bcext::right_file",
+			g_strdup(g_ptr_array_index(job->Pairs, i + 1)), g_free);
+		g_signal_connect(sub, "activate",
+			G_CALLBACK(compare_pair_action), bcobj);
+		nemo_menu_append_item(SubMenu, sub);
+
+		g_string_free(label, TRUE);
+		g_free(name);
+		g_free(right_name);
+		g_free(left_name);
+	}
+
+	if (!job->Complete)
+		nemo_menu_append_item(SubMenu, label_mitem(
+			"BeyondCompareExt::GroupPartial",
+			"Some files were too large to be checked"));
+
+	return item;
+}
+
+static void group_identical_action(BcMenuItem *item, BCompareExt *bcobj)
+{
+	GPtrArray *paths = g_object_get_data((GObject *)item, "bcext::paths");
+
+	dup_job_cancel(bcobj);
+	bcobj->DupJob = dup_job_start(bcobj,
+		g_strdup(g_object_get_data((GObject *)item, "bcext::key")),
+		g_ptr_array_ref(paths));
+}
+
+/* Takes ownership of key and paths, nothing is read before the item is activated */
+static BcMenuItem * group_identical_start_mitem(
+		BCompareExt *bcobj,
+		gchar *key,
+		GPtrArray *paths)
+{
+	BcMenuItem *item = nemo_menu_item_new("BeyondCompareExt::GroupIdentical",
+							"Group Identical Files",
+							"Look for the selected files having the same content",
+							"bcomparefull32");
+
+	g_object_set_data_full((GObject *)item, "bcext::key", key, g_free);
+	g_object_set_data_full((GObject *)item, "bcext::paths", paths,
+		(GDestroyNotify)g_ptr_array_unref);
+	g_signal_connect(item, "activate",
+		G_CALLBACK(group_identical_action), bcobj);
+	return item;
+}
+
+/*
+ * Selections of more than 3 files only offer to group the identical ones.
+ * Hashing starts when the item is activated and runs in the background, the
+ * menus are refreshed when it is done.
+ */
+static GList * beyondcompare_group_identical_menus(
+		BCompareExt *bcobj,
+		GList *files)
+{
+	NemoMenu *SubMenu;
+	BcMenuItem *item, *top;
+	GPtrArray *paths;
+	GString *key;
+	GList *l;
+	gchar *path;
+
+	if (bcobj->CompareMenuType == MENU_NONE) return NULL;
+
+	paths = g_ptr_array_new_with_free_func(g_free);
+	key = g_string_new("");
+	for (l = files; l != NULL; l = l->next) {
+		path = nemo_to_path((NemoFileInfo *)l->data);
+		if ((path == NULL) ||
+				nemo_file_info_is_directory((NemoFileInfo *)l->data)) {
+			g_free(path);
+			g_ptr_array_unref(paths);
+			g_string_free(key, TRUE);
+			return NULL;
+		}
+		g_ptr_array_add(paths, path);
+		g_string_append(key, path);
+		g_string_append_c(key, '\n');
+	}
+
+	if ((bcobj->DupJob != NULL) && (strcmp(bcobj->DupJob->Key, key->str) == 0)) {
+		g_ptr_array_unref(paths);
+		g_string_free(key, TRUE);
+		item = group_identical_mitem(bcobj, bcobj->DupJob);
+	} else {
+		/* Another selection, the search of the previous one is useless */
+		dup_job_cancel(bcobj);
+		item = group_identical_start_mitem(bcobj,
+				g_string_free(key, FALSE), paths);
+	}
+	if (bcobj->CompareMenuType == MENU_SUBMENU) {
+		top = nemo_menu_item_new("BeyondCompareExt::Top",
+								"Beyond Compare",
+								"Beyond Compare functions",
+								"bcomparefull32");
+		SubMenu = nemo_menu_new();
+		nemo_menu_item_set_submenu(top, SubMenu);
+		nemo_menu_append_item(SubMenu, item);
+		item = top;
+	}
+
+	return g_list_append(NULL, item);
+}
+
 /*************************************************************
  *
  * Extension functions for XXXMenuProvider Interface
  *
  *************************************************************/
 
-static GList * beyondcompare_get_file_items(
+static GList * beyondcompare_build_menus(
 					NemoMenuProvider *provider,
 					GtkWidget *window,
 					GList *files)
@@ -680,6 +7327,7 @@ static GList * beyondcompare_get_file_items(
 	gchar leftfilepath[256];
 	gchar centerfilepath[256];
 	char *leftfileptr, *centerfileptr;
+	ProbeType left_type;
 	FILE *filestrptr;
 	int Cnt;
 	gboolean FirstIsDir;
@@ -688,14 +7336,16 @@ static GList * beyondcompare_get_file_items(
 	if ((provider == NULL) || (files == NULL) || (!bcobj->Enabled)) return NULL;
 	g_return_val_if_fail(GTK_IS_WIDGET(window), NULL);
 
-	FirstIsDir =
-		file_is_dir(bcobj, nemo_to_path((NemoFileInfo *)files->data));
+	if (g_list_length(files) > 3)
+		return beyondcompare_group_identical_menus(bcobj, files);
+
+	FirstIsDir = file_info_is_dir(bcobj, (NemoFileInfo *)files->data);
 
 	SelectedCnt = g_list_length(files);
 	if (SelectedCnt > 1) {
 		for (Cnt = 1; Cnt < g_list_length(files); Cnt++) {
-			if (FirstIsDir != file_is_dir(bcobj,
-					   nemo_to_path((NemoFileInfo *)(g_list_nth_data(files, Cnt))))) {
+			if (FirstIsDir != file_info_is_dir(bcobj,
+					(NemoFileInfo *)g_list_nth_data(files, Cnt))) {
 				return NULL;
 			}
 		}
@@ -715,6 +7365,12 @@ static GList * beyondcompare_get_file_items(
 		fclose(filestrptr);
 	}
 
+	/* Saved paths on a hung mount are ignored rather than waited for */
+	left_type = (leftfileptr != NULL) ? path_type(bcobj, leftfileptr) : PROBE_UNKNOWN;
+	if (left_type == PROBE_UNKNOWN) leftfileptr = NULL;
+	if ((centerfileptr != NULL) && (path_type(bcobj, centerfileptr) == PROBE_UNKNOWN))
+		centerfileptr = NULL;
+
 	if (SelectedCnt == 3) {
 		if (bcobj->CenterFile != NULL)
 			g_string_free(bcobj->CenterFile, TRUE);
@@ -739,8 +7395,8 @@ static GList * beyondcompare_get_file_items(
 			if (bcobj->LeftFile != NULL)
 				g_string_free(bcobj->LeftFile, TRUE);
 			bcobj->LeftFile = g_string_new(leftfileptr);
-			bcobj->LeftIsDir =
-			  file_is_dir(bcobj, bcobj->LeftFile->str);
+			bcobj->LeftIsDir = (left_type == PROBE_FOLDER) ||
+			  file_is_archive(bcobj, bcobj->LeftFile->str);
 		}
 
 		if (bcobj->RightFile != NULL)
@@ -798,6 +7454,30 @@ static GList * beyondcompare_get_file_items(
 	return ret;
 }
 
+/*
+ * Times the building of the menus when BCOMPARE_EXT_TRACE_LATENCY is set, to
+ * measure the worst popup latency, for instance on a slow network mount.
+ */
+static GList * beyondcompare_get_file_items(
+					NemoMenuProvider *provider,
+					GtkWidget *window,
+					GList *files)
+{
+	static gint64 worst = 0;
+	gint64 start = g_get_monotonic_time();
+	gint64 elapsed;
+	GList *items = beyondcompare_build_menus(provider, window, files);
+
+	if (g_getenv("BCOMPARE_EXT_TRACE_LATENCY") != NULL) {
+		elapsed = g_get_monotonic_time() - start;
+		worst = MAX(worst, elapsed);
+		g_message("bcompare-ext-nemo: menus built in %.1f ms, worst %.1f ms",
+			elapsed / 1000.0, worst / 1000.0);
+	}
+	warm_start();
+	return items;
+}
+
 /*************************************************************
  *
  * Beyond Compare Extension Management Functions
@@ -811,6 +7491,8 @@ bcompare_ext_init(BCompareExt *object)
 	GError *gerr = NULL;
 	gchar *enb;
 	gchar *list;
+	int Cnt;
+	GFile *file;
 	const gchar *env;
 	gchar configdir[256];
 	gchar pathname[256];
@@ -892,6 +7574,15 @@ bcompare_ext_init(BCompareExt *object)
 		g_free(list);
 	}
 
+	gerr = NULL;
+	list = g_key_file_get_string(
+	  MenuIni, "ContextMenus", "BackupSuffixes", &gerr);
+	object->BackupSuffixes = g_strsplit(
+	  (list != NULL) ? list : default_backup_suffixes, ",", 255);
+	for (Cnt = 0; object->BackupSuffixes[Cnt] != NULL; Cnt++)
+		g_strstrip(object->BackupSuffixes[Cnt]);
+	g_free(list);
+
 	g_key_file_free(MenuIni);
 
 	object->LeftFile = NULL;
@@ -906,6 +7597,29 @@ bcompare_ext_init(BCompareExt *object)
 
 	object->CenterFileStorage = g_string_new("");
 	g_string_printf(object->CenterFileStorage, "%s/center_file", configdir);
+
+	object->ShowUnchangedStorage = g_string_new("");
+	g_string_printf(object->ShowUnchangedStorage, "%s/show_unchanged", configdir);
+
+	object->GenerationStorage = g_string_new("");
+	g_string_printf(object->GenerationStorage, "%s/selection_generation", configdir);
+	object->Generation = generation_read(object);
+	object->UpdateSource = 0;
+
+	/* Follows the selections, whichever window or file manager saved them */
+	file = g_file_new_for_path(object->GenerationStorage->str);
+	object->GenerationMonitor = g_file_monitor_file(file, G_FILE_MONITOR_NONE, NULL, NULL);
+	if (object->GenerationMonitor != NULL)
+		g_signal_connect(object->GenerationMonitor, "changed",
+			G_CALLBACK(generation_changed), object);
+	g_object_unref(file);
+
+	object->PathTypes =
+		g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	object->PathTypeOrder = g_queue_new();
+#ifdef USE_LIBGIT2
+	git_libgit2_init();
+#endif
 }
 
 static void
@@ -922,6 +7636,14 @@ bcompare_menu_provider_init(
 	iface->get_file_items = beyondcompare_get_file_items;
 }
 
+static void
+bcompare_info_provider_init(
+		NemoInfoProviderIface *iface)
+{
+	iface->update_file_info = beyondcompare_update_file_info;
+	iface->cancel_update = beyondcompare_cancel_update;
+}
+
 /* Registration function */
 static void bcompare_ext_register_type(GTypeModule *module)
 {
@@ -943,6 +7665,12 @@ static void bcompare_ext_register_type(GTypeModule *module)
 		NULL
 	};
 
+	static const GInterfaceInfo info_provider_iface_info = {
+		(GInterfaceInitFunc) bcompare_info_provider_init,
+		NULL,
+		NULL
+	};
+
 	type_list[0] = g_type_module_register_type(module,
 										G_TYPE_OBJECT,
 										"BeyondCompareExt",
@@ -953,6 +7681,11 @@ static void bcompare_ext_register_type(GTypeModule *module)
 					 NEMO_TYPE_MENU_PROVIDER,
 					 &menu_provider_iface_info);
 
+	g_type_module_add_interface(module,
+					 type_list[0],
+					 NEMO_TYPE_INFO_PROVIDER,
+					 &info_provider_iface_info);
+
 }
 
 /*************************************************************